@@ -0,0 +1,96 @@
+// multiply and dot_product on var matrices, whose values and adjoints live
+// in arena_matrix storage. Build against the tree before and after arena
+// storage became cache line aligned to compare.
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <chrono>
+
+template <typename F>
+static void time_gradient(benchmark::State& state, F&& f) {
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    f();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+}
+
+static void multiply_var_matrix(benchmark::State& state) {
+  using stan::math::var_value;
+  const int n = state.range(0);
+  Eigen::MatrixXd a_val = Eigen::MatrixXd::Random(n, n);
+  Eigen::MatrixXd b_val = Eigen::MatrixXd::Random(n, n);
+  time_gradient(state, [&]() {
+    var_value<Eigen::MatrixXd> a = a_val;
+    var_value<Eigen::MatrixXd> b = b_val;
+    stan::math::sum(stan::math::multiply(a, b)).grad();
+  });
+}
+
+static void multiply_matrix_var(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  Eigen::MatrixXd a_val = Eigen::MatrixXd::Random(n, n);
+  Eigen::MatrixXd b_val = Eigen::MatrixXd::Random(n, n);
+  time_gradient(state, [&]() {
+    Eigen::Matrix<var, -1, -1> a = a_val;
+    Eigen::Matrix<var, -1, -1> b = b_val;
+    stan::math::sum(stan::math::multiply(a, b)).grad();
+  });
+}
+
+static void dot_product_var_vector(benchmark::State& state) {
+  using stan::math::var_value;
+  const int n = state.range(0);
+  Eigen::VectorXd a_val = Eigen::VectorXd::Random(n);
+  Eigen::VectorXd b_val = Eigen::VectorXd::Random(n);
+  time_gradient(state, [&]() {
+    var_value<Eigen::VectorXd> a = a_val;
+    var_value<Eigen::VectorXd> b = b_val;
+    stan::math::dot_product(a, b).grad();
+  });
+}
+
+static void dot_product_vector_var(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  Eigen::VectorXd a_val = Eigen::VectorXd::Random(n);
+  Eigen::VectorXd b_val = Eigen::VectorXd::Random(n);
+  time_gradient(state, [&]() {
+    Eigen::Matrix<var, -1, 1> a = a_val;
+    Eigen::Matrix<var, -1, 1> b = b_val;
+    stan::math::dot_product(a, b).grad();
+  });
+}
+
+BENCHMARK(multiply_var_matrix)
+    ->RangeMultiplier(2)
+    ->Range(8, 512)
+    ->UseManualTime();
+BENCHMARK(multiply_matrix_var)
+    ->RangeMultiplier(2)
+    ->Range(8, 512)
+    ->UseManualTime();
+BENCHMARK(dot_product_var_vector)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 20)
+    ->UseManualTime();
+BENCHMARK(dot_product_vector_var)
+    ->RangeMultiplier(8)
+    ->Range(64, 1 << 20)
+    ->UseManualTime();
+
+int main(int argc, char** argv) {
+  stan::math::ChainableStack::instance_->memalloc_.alloc(1 << 28);
+  stan::math::recover_memory();
+
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
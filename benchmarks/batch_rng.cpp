@@ -0,0 +1,40 @@
+// Throughput of drawing a vector of normal variates one at a time with the
+// default engine and in one batch with the default and the counter-based
+// engine:
+//
+//   make benchmarks/batch_rng
+#include <benchmark/benchmark.h>
+#include <stan/math/prim.hpp>
+#include <boost/random/additive_combine.hpp>
+
+static void normal_scalar(benchmark::State& state) {
+  boost::ecuyer1988 rng(1234);
+  Eigen::VectorXd out(state.range(0));
+  for (auto _ : state) {
+    for (Eigen::Index i = 0; i < out.size(); ++i) {
+      out.coeffRef(i) = stan::math::normal_rng(0.0, 1.0, rng);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+template <typename RNG>
+static void normal_batch(benchmark::State& state) {
+  RNG rng(1234);
+  Eigen::VectorXd out(state.range(0));
+  for (auto _ : state) {
+    stan::math::normal_rng(0.0, 1.0, rng, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * out.size());
+}
+
+BENCHMARK(normal_scalar)->RangeMultiplier(10)->Range(100, 1000000);
+BENCHMARK_TEMPLATE(normal_batch, boost::ecuyer1988)
+    ->RangeMultiplier(10)
+    ->Range(100, 1000000);
+BENCHMARK_TEMPLATE(normal_batch, stan::math::philox4x32)
+    ->RangeMultiplier(10)
+    ->Range(100, 1000000);
+BENCHMARK_MAIN();
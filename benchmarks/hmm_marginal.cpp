@@ -0,0 +1,69 @@
+// Gradient of the sum of hmm_marginal over many short sequences sharing
+// the transition matrix, one call per sequence against one batched call:
+//
+//   make benchmarks/hmm_marginal
+//   make CXXFLAGS_OPTIM=-DSTAN_THREADS benchmarks/hmm_marginal
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <chrono>
+#include <vector>
+
+template <typename F>
+static void time_gradient(benchmark::State& state, F&& f) {
+  using stan::math::var;
+  const int n_sequences = state.range(0);
+  const int n_states = 4;
+  const int n_steps = 20;
+  std::vector<Eigen::MatrixXd> log_omegas;
+  for (int i = 0; i < n_sequences; ++i) {
+    log_omegas.push_back(
+        -Eigen::MatrixXd::Random(n_states, n_steps).cwiseAbs());
+  }
+  Eigen::MatrixXd Gamma_val
+      = Eigen::MatrixXd::Constant(n_states, n_states, 1.0 / n_states);
+  Eigen::VectorXd rho_val = Eigen::VectorXd::Constant(n_states, 1.0 / n_states);
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> Gamma = Gamma_val;
+    Eigen::Matrix<var, Eigen::Dynamic, 1> rho = rho_val;
+    var lp = f(log_omegas, Gamma, rho);
+    lp.grad();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+}
+
+static void hmm_marginal_loop(benchmark::State& state) {
+  time_gradient(state, [](const auto& log_omegas, const auto& Gamma,
+                          const auto& rho) {
+    stan::math::var lp = 0;
+    for (const auto& log_omega : log_omegas) {
+      lp += stan::math::hmm_marginal(log_omega, Gamma, rho);
+    }
+    return lp;
+  });
+}
+
+static void hmm_marginal_batch(benchmark::State& state) {
+  time_gradient(state, [](const auto& log_omegas, const auto& Gamma,
+                          const auto& rho) {
+    return stan::math::hmm_marginal(log_omegas, Gamma, rho);
+  });
+}
+
+BENCHMARK(hmm_marginal_loop)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->UseManualTime();
+BENCHMARK(hmm_marginal_batch)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000)
+    ->UseManualTime();
+BENCHMARK_MAIN();
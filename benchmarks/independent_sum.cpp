@@ -0,0 +1,86 @@
+// Reverse pass time of a wide sum of independent terms, chained serially
+// by grad() and in parallel segments by independent_sum(). The parallel
+// sweep needs the thread local AD stacks:
+//
+//   make CXXFLAGS_OPTIM=-DSTAN_THREADS benchmarks/independent_sum
+//   STAN_NUM_THREADS=8 ./benchmarks/independent_sum
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <chrono>
+#include <vector>
+
+// logistic regression terms start through end (inclusive)
+struct logistic_terms {
+  const std::vector<double>& x_;
+  const std::vector<int>& y_;
+
+  template <typename T>
+  T operator()(int start, int end, std::ostream* msgs, const T& alpha,
+               const T& beta) const {
+    T lp = 0;
+    for (int i = start; i <= end; ++i) {
+      lp += stan::math::bernoulli_logit_lpmf(y_[i], alpha + beta * x_[i]);
+    }
+    return lp;
+  }
+};
+
+template <typename F>
+static void time_reverse_pass(benchmark::State& state, F&& f) {
+  const int n = state.range(0);
+  std::vector<double> x(n);
+  std::vector<int> y(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = (i % 17) / 17.0 - 0.5;
+    y[i] = i % 3 == 0;
+  }
+  logistic_terms terms{x, y};
+  for (auto _ : state) {
+    stan::math::var alpha = 0.3;
+    stan::math::var beta = -1.2;
+    stan::math::var lp = f(terms, n, alpha, beta);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    lp.grad();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void serial_grad(benchmark::State& state) {
+  time_reverse_pass(state, [](const auto& terms, int n, const auto& alpha,
+                              const auto& beta) {
+    return terms(0, n - 1, nullptr, alpha, beta);
+  });
+}
+
+static void independent_sum_grad(benchmark::State& state) {
+  const int grainsize = state.range(1);
+  time_reverse_pass(state, [grainsize](const auto& terms, int n,
+                                       const auto& alpha, const auto& beta) {
+    return stan::math::independent_sum(terms, n, grainsize, nullptr, alpha,
+                                       beta);
+  });
+}
+
+BENCHMARK(serial_grad)
+    ->RangeMultiplier(10)
+    ->Range(10000, 1000000)
+    ->UseManualTime();
+BENCHMARK(independent_sum_grad)
+    ->RangeMultiplier(10)
+    ->Ranges({{10000, 1000000}, {1000, 10000}})
+    ->UseManualTime();
+
+int main(int argc, char** argv) {
+  stan::math::init_threadpool_tbb();
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
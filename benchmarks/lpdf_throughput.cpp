@@ -0,0 +1,98 @@
+// Throughput of the value and gradient of the vectorized log densities
+// with a vector of observations, a vector of location-like parameters and
+// a scalar scale-like parameter, reported as bytes of the value and
+// partial arrays touched per second:
+//
+//   make benchmarks/lpdf_throughput
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <vector>
+
+template <typename Y, typename F>
+static void time_gradient(benchmark::State& state, const Y& y, F&& f) {
+  using stan::math::var;
+  const int N = state.range(0);
+  Eigen::VectorXd theta_val = 0.5 * Eigen::VectorXd::Random(N);
+  for (auto _ : state) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> theta = theta_val;
+    var scale = 1.5;
+    var lp = f(y, theta, scale);
+    lp.grad();
+    benchmark::DoNotOptimize(scale.adj());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+  // observation and parameter values read, parameter partials written
+  state.SetBytesProcessed(state.iterations() * N * 3 * sizeof(double));
+}
+
+static Eigen::VectorXd positive_data(int N) {
+  return Eigen::VectorXd::Random(N).cwiseAbs().array() + 0.1;
+}
+
+static std::vector<int> count_data(int N, int max) {
+  std::vector<int> n(N);
+  for (int i = 0; i < N; ++i) {
+    n[i] = i % (max + 1);
+  }
+  return n;
+}
+
+static void normal(benchmark::State& state) {
+  time_gradient(state, Eigen::VectorXd::Random(state.range(0)).eval(),
+                [](const auto& y, const auto& mu, const auto& sigma) {
+                  return stan::math::normal_lpdf(y, mu, sigma);
+                });
+}
+
+static void student_t(benchmark::State& state) {
+  time_gradient(state, Eigen::VectorXd::Random(state.range(0)).eval(),
+                [](const auto& y, const auto& mu, const auto& sigma) {
+                  return stan::math::student_t_lpdf(y, 4.0, mu, sigma);
+                });
+}
+
+static void lognormal(benchmark::State& state) {
+  time_gradient(state, positive_data(state.range(0)),
+                [](const auto& y, const auto& mu, const auto& sigma) {
+                  return stan::math::lognormal_lpdf(y, mu, sigma);
+                });
+}
+
+static void gamma(benchmark::State& state) {
+  time_gradient(state, positive_data(state.range(0)),
+                [](const auto& y, const auto& alpha, const auto& beta) {
+                  return stan::math::gamma_lpdf(y, stan::math::exp(alpha),
+                                                beta);
+                });
+}
+
+static void poisson_log(benchmark::State& state) {
+  time_gradient(state, count_data(state.range(0), 10),
+                [](const auto& n, const auto& alpha, const auto& scale) {
+                  return stan::math::poisson_log_lpmf(n, alpha);
+                });
+}
+
+static void bernoulli_logit(benchmark::State& state) {
+  time_gradient(state, count_data(state.range(0), 1),
+                [](const auto& n, const auto& theta, const auto& scale) {
+                  return stan::math::bernoulli_logit_lpmf(n, theta);
+                });
+}
+
+static void neg_binomial_2_log(benchmark::State& state) {
+  time_gradient(state, count_data(state.range(0), 10),
+                [](const auto& n, const auto& eta, const auto& phi) {
+                  return stan::math::neg_binomial_2_log_lpmf(n, eta, phi);
+                });
+}
+
+BENCHMARK(normal)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(student_t)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(lognormal)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(gamma)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(poisson_log)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(bernoulli_logit)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK(neg_binomial_2_log)->RangeMultiplier(10)->Range(10, 1000000);
+BENCHMARK_MAIN();
@@ -0,0 +1,55 @@
+// Gradient of matrix_exp with the Fréchet derivative adjoint against the
+// autodiffed Padé approximation, for square matrices of size 2 to 100:
+//
+//   make benchmarks/matrix_exp
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <chrono>
+
+template <typename F>
+static void time_gradient(benchmark::State& state, F&& f) {
+  using stan::math::var;
+  const int n = state.range(0);
+  Eigen::MatrixXd A_val(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      A_val(i, j) = (i == j ? -1.0 : 0.0) + ((i + 2 * j) % 7 - 3) / (7.0 * n);
+    }
+  }
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> A = A_val;
+    var lp = stan::math::sum(f(A));
+    lp.grad();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+}
+
+// matrix_exp of a matrix of vars, value in double and one callback
+static void matrix_exp_frechet(benchmark::State& state) {
+  time_gradient(state, [](const auto& A) { return stan::math::matrix_exp(A); });
+}
+
+// Padé approximation autodiffed through the matrix products and solve
+static void matrix_exp_autodiff(benchmark::State& state) {
+  time_gradient(state,
+                [](const auto& A) { return stan::math::matrix_exp_pade(A); });
+}
+
+static void sizes(benchmark::internal::Benchmark* b) {
+  for (int n : {2, 5, 10, 20, 50, 100}) {
+    b->Arg(n);
+  }
+}
+
+BENCHMARK(matrix_exp_frechet)->Apply(sizes)->UseManualTime();
+BENCHMARK(matrix_exp_autodiff)->Apply(sizes)->UseManualTime();
+BENCHMARK_MAIN();
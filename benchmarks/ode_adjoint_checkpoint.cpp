@@ -0,0 +1,72 @@
+// Gradient of a one compartment pharmacokinetic model of n subjects solved
+// with ode_adjoint_tol_ctl, allocating CVODES memory for every subject,
+// reusing one workspace for all subjects and reusing one workspace with a
+// checkpoint memory budget of 8 KiB:
+//
+//   make benchmarks/ode_adjoint_checkpoint
+//   ./benchmarks/ode_adjoint_checkpoint
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <memory>
+#include <vector>
+
+// absorption rate theta[0] and elimination rate theta[1]
+struct one_compartment_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(2);
+    dy << -theta[0] * y(0), theta[0] * y(0) - theta[1] * y(1);
+    return dy;
+  }
+};
+
+// 0: no workspace, 1: workspace, 2: workspace with a memory budget
+template <int Mode>
+static void one_compartment(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  std::vector<double> ts;
+  for (int j = 0; j < 8; ++j) {
+    ts.push_back(0.5 + j);
+  }
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(2, 1e-8);
+  auto workspace = std::make_shared<stan::math::cvodes_adjoint_workspace>(
+      Mode == 2 ? 8192 : 0);
+  for (auto _ : state) {
+    std::vector<std::vector<var>> theta(n);
+    var lp = 0;
+    for (int i = 0; i < n; ++i) {
+      theta[i] = {1.0 + 0.01 * (i % 11), 0.2 + 0.01 * (i % 3)};
+      Eigen::VectorXd y0 = Eigen::VectorXd::Zero(2);
+      y0(0) = 100.0 + i % 7;
+      std::vector<Eigen::Matrix<var, -1, 1>> ys;
+      if (Mode == 0) {
+        ys = stan::math::ode_adjoint_tol_ctl(
+            one_compartment_rhs(), y0, 0.0, ts, 1e-8, atol, 1e-8, atol, 1e-8,
+            1e-8, 10000, 150, CV_HERMITE, CV_BDF, CV_BDF, nullptr, theta[i]);
+      } else {
+        ys = stan::math::ode_adjoint_tol_ctl(
+            one_compartment_rhs(), y0, 0.0, ts, 1e-8, atol, 1e-8, atol, 1e-8,
+            1e-8, 10000, 150, CV_HERMITE, CV_BDF, CV_BDF,
+            stan::math::sundials_linear_solver(), workspace, nullptr,
+            theta[i]);
+      }
+      for (const auto& y : ys) {
+        lp += y(1);
+      }
+    }
+    lp.grad();
+    benchmark::DoNotOptimize(theta[0][0].adj());
+    stan::math::recover_memory();
+  }
+  state.counters["subjects"] = n;
+  state.counters["allocations"] = workspace->num_allocations();
+  state.counters["recomputations"] = workspace->num_recomputations();
+}
+
+BENCHMARK_TEMPLATE(one_compartment, 0)->Arg(100);
+BENCHMARK_TEMPLATE(one_compartment, 1)->Arg(100);
+BENCHMARK_TEMPLATE(one_compartment, 2)->Arg(100);
+BENCHMARK_MAIN();
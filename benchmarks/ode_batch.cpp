@@ -0,0 +1,69 @@
+// Value and gradient of a one compartment pharmacokinetic model of n
+// subjects with their own parameters and sampling times, solved one
+// subject at a time with ode_bdf and as a batch with ode_bdf_batch. The
+// batch runs in parallel with the thread local AD stacks:
+//
+//   make CXXFLAGS_OPTIM=-DSTAN_THREADS benchmarks/ode_batch
+//   STAN_NUM_THREADS=8 ./benchmarks/ode_batch
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <vector>
+
+// absorption rate theta[0] and elimination rate theta[1]
+struct one_compartment_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(2);
+    dy << -theta[0] * y(0), theta[0] * y(0) - theta[1] * y(1);
+    return dy;
+  }
+};
+
+template <bool Batch>
+static void one_compartment(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  std::vector<Eigen::VectorXd> y0(n, Eigen::VectorXd::Zero(2));
+  std::vector<double> t0(n, 0.0);
+  std::vector<std::vector<double>> ts(n);
+  for (int i = 0; i < n; ++i) {
+    y0[i](0) = 100.0 + i % 7;
+    for (int j = 0; j < 8; ++j) {
+      ts[i].push_back(0.5 + j + 0.1 * (i % 5));
+    }
+  }
+  stan::math::init_threadpool_tbb();
+  for (auto _ : state) {
+    std::vector<std::vector<var>> theta(n);
+    for (int i = 0; i < n; ++i) {
+      theta[i] = {1.0 + 0.01 * (i % 11), 0.2 + 0.01 * (i % 3)};
+    }
+    std::vector<std::vector<Eigen::Matrix<var, -1, 1>>> ys;
+    if (Batch) {
+      ys = stan::math::ode_bdf_batch_tol(one_compartment_rhs(), y0, t0, ts,
+                                         1e-8, 1e-8, 10000, nullptr, theta);
+    } else {
+      for (int i = 0; i < n; ++i) {
+        ys.push_back(stan::math::ode_bdf_tol(one_compartment_rhs(), y0[i],
+                                             t0[i], ts[i], 1e-8, 1e-8, 10000,
+                                             nullptr, theta[i]));
+      }
+    }
+    var lp = 0;
+    for (const auto& ys_i : ys) {
+      for (const auto& y : ys_i) {
+        lp += y(1);
+      }
+    }
+    lp.grad();
+    benchmark::DoNotOptimize(theta[0][0].adj());
+    stan::math::recover_memory();
+  }
+  state.counters["subjects"] = n;
+}
+
+BENCHMARK_TEMPLATE(one_compartment, false)->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(one_compartment, true)->Arg(100)->Arg(1000);
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+// Stiff advection-diffusion-reaction system of n states with a tridiagonal
+// Jacobian, solved with ode_bdf and with ode_adjoint_tol_ctl using the
+// sparse linear solver. The Jacobian of the Newton iterations comes from
+// one reverse sweep per state, from an analytic sparse Jacobian or from
+// three colored forward mode evaluations:
+//
+//   make benchmarks/ode_jacobian
+//   ./benchmarks/ode_jacobian
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+#include <vector>
+
+// diffusion theta[0], upwind advection 0.5 * theta[0] and quadratic decay
+// theta[1]
+struct advection_diffusion_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int n = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(n);
+    for (int i = 0; i < n; ++i) {
+      const auto left = i > 0 ? y(i - 1) : y(i);
+      const auto right = i + 1 < n ? y(i + 1) : y(i);
+      dy(i) = theta[0] * (left - 2.0 * y(i) + right)
+              + 0.5 * theta[0] * (left - y(i)) - theta[1] * y(i) * y(i);
+    }
+    return dy;
+  }
+};
+
+struct advection_diffusion_jacobian {
+  Eigen::SparseMatrix<double> operator()(
+      double t, const Eigen::VectorXd& y, std::ostream* msgs,
+      const std::vector<double>& theta) const {
+    const int n = y.size();
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < n; ++i) {
+      double diagonal = -2.5 * theta[0] - 2.0 * theta[1] * y(i);
+      if (i > 0) {
+        triplets.emplace_back(i, i - 1, 1.5 * theta[0]);
+      } else {
+        diagonal += 1.5 * theta[0];
+      }
+      if (i + 1 < n) {
+        triplets.emplace_back(i, i + 1, theta[0]);
+      } else {
+        diagonal += theta[0];
+      }
+      triplets.emplace_back(i, i, diagonal);
+    }
+    Eigen::SparseMatrix<double> jacobian(n, n);
+    jacobian.setFromTriplets(triplets.begin(), triplets.end());
+    return jacobian;
+  }
+};
+
+static Eigen::SparseMatrix<double> tridiagonal_pattern(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 1); j < std::min(n, i + 2); ++j) {
+      triplets.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(n, n);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  return pattern;
+}
+
+// 0: reverse sweeps, 1: analytic Jacobian, 2: colored Jacobian
+template <int Mode, typename Solve>
+static void solve_with(const Solve& solve) {
+  const advection_diffusion_rhs f;
+  if (Mode == 0) {
+    solve(f);
+  } else if (Mode == 1) {
+    solve(stan::math::analytic_jacobian(f, advection_diffusion_jacobian()));
+  } else {
+    static const auto f_colored
+        = stan::math::colored_jacobian(f, tridiagonal_pattern(200));
+    solve(f_colored);
+  }
+}
+
+template <int Mode>
+static void bdf_values(benchmark::State& state) {
+  const int n = 200;
+  const Eigen::VectorXd y0 = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5);
+  const std::vector<double> theta{2000.0, 2.0};
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  const auto linear_solver
+      = stan::math::sundials_linear_solver::sparse(tridiagonal_pattern(n));
+  for (auto _ : state) {
+    solve_with<Mode>([&](const auto& f) {
+      auto ys = stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-8, 1e-8, 100000,
+                                        linear_solver, nullptr, theta);
+      benchmark::DoNotOptimize(ys.back()(0));
+    });
+  }
+}
+
+template <int Mode>
+static void adjoint_gradient(benchmark::State& state) {
+  using stan::math::var;
+  const int n = 200;
+  const Eigen::VectorXd y0 = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5);
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(n, 1e-8);
+  const auto linear_solver
+      = stan::math::sundials_linear_solver::sparse(tridiagonal_pattern(n));
+  for (auto _ : state) {
+    std::vector<var> theta{2000.0, 2.0};
+    solve_with<Mode>([&](const auto& f) {
+      auto ys = stan::math::ode_adjoint_tol_ctl(
+          f, y0, 0.0, ts, 1e-8, atol, 1e-8, atol, 1e-8, 1e-8, 100000, 150,
+          CV_HERMITE, CV_BDF, CV_BDF, linear_solver, nullptr, theta);
+      stan::math::sum(ys.back()).grad();
+    });
+    benchmark::DoNotOptimize(theta[0].adj());
+    stan::math::recover_memory();
+  }
+}
+
+BENCHMARK_TEMPLATE(bdf_values, 0);
+BENCHMARK_TEMPLATE(bdf_values, 1);
+BENCHMARK_TEMPLATE(bdf_values, 2);
+BENCHMARK_TEMPLATE(adjoint_gradient, 0);
+BENCHMARK_TEMPLATE(adjoint_gradient, 1);
+BENCHMARK_TEMPLATE(adjoint_gradient, 2);
+BENCHMARK_MAIN();
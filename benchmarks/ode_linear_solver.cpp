@@ -0,0 +1,114 @@
+// Value and gradient of the method of lines solution of a 1-D
+// diffusion-reaction equation with n grid points, with ode_bdf and
+// ode_adjoint_tol_ctl and each of the linear solvers of CVODES:
+//
+//   make benchmarks/ode_linear_solver
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <vector>
+
+using stan::math::sundials_linear_solver;
+
+// diffusion theta[0] with reflecting boundaries and quadratic decay
+// theta[1], which has a tridiagonal Jacobian
+struct diffusion_reaction_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int n = y.size();
+    const double h2 = 1.0 / ((n - 1.0) * (n - 1.0));
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(n);
+    for (int i = 0; i < n; ++i) {
+      const auto left = i > 0 ? y(i - 1) : y(i + 1);
+      const auto right = i + 1 < n ? y(i + 1) : y(i - 1);
+      dy(i) = theta[0] / h2 * (left - 2.0 * y(i) + right)
+              - theta[1] * y(i) * y(i);
+    }
+    return dy;
+  }
+};
+
+enum class solver { dense, band, sparse, spgmr, spgmr_band };
+
+static sundials_linear_solver make_linear_solver(solver s, int n) {
+  switch (s) {
+    case solver::band:
+      return sundials_linear_solver::band(1, 1);
+    case solver::sparse: {
+      std::vector<Eigen::Triplet<double>> triplets;
+      for (int i = 0; i < n; ++i) {
+        for (int j = std::max(0, i - 1); j < std::min(n, i + 2); ++j) {
+          triplets.emplace_back(i, j, 1.0);
+        }
+      }
+      Eigen::SparseMatrix<double> pattern(n, n);
+      pattern.setFromTriplets(triplets.begin(), triplets.end());
+      return sundials_linear_solver::sparse(pattern);
+    }
+    case solver::spgmr:
+      return sundials_linear_solver::spgmr();
+    case solver::spgmr_band:
+      return sundials_linear_solver::spgmr(0, 1, 1);
+    default:
+      return sundials_linear_solver::dense();
+  }
+}
+
+template <solver S, bool Adjoint>
+static void diffusion_reaction(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  const sundials_linear_solver linear_solver = make_linear_solver(S, n);
+  const std::vector<double> ts{0.25, 0.5, 1.0};
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(n, 1e-8);
+  Eigen::VectorXd y0(n);
+  for (int i = 0; i < n; ++i) {
+    y0(i) = 1.0 + std::cos(3.14159265358979 * i / (n - 1.0));
+  }
+  for (auto _ : state) {
+    std::vector<var> theta{0.1, 1.0};
+    std::vector<Eigen::Matrix<var, -1, 1>> ys;
+    if (Adjoint) {
+      ys = stan::math::ode_adjoint_tol_ctl(
+          diffusion_reaction_rhs(), y0, 0.0, ts, 1e-6, atol, 1e-6, atol, 1e-6,
+          1e-8, 100000, 150, CV_HERMITE, CV_BDF, CV_BDF, linear_solver,
+          nullptr, theta);
+    } else {
+      ys = stan::math::ode_bdf_tol(diffusion_reaction_rhs(), y0, 0.0, ts, 1e-6,
+                                   1e-8, 100000, linear_solver, nullptr,
+                                   theta);
+    }
+    var lp = 0;
+    for (const auto& y : ys) {
+      lp += stan::math::sum(y);
+    }
+    lp.grad();
+    benchmark::DoNotOptimize(theta[0].adj());
+    stan::math::recover_memory();
+  }
+  state.counters["states"] = n;
+}
+
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::dense, false)->Arg(100);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::band, false)->Arg(100);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::sparse, false)->Arg(100);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::spgmr_band, false)->Arg(100);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::dense, true)->Arg(100)->Arg(500);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::band, true)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::sparse, true)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::spgmr, true)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000);
+BENCHMARK_TEMPLATE(diffusion_reaction, solver::spgmr_band, true)
+    ->Arg(100)
+    ->Arg(500)
+    ->Arg(2000);
+BENCHMARK_MAIN();
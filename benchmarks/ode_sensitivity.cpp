@@ -0,0 +1,132 @@
+// Value and gradient of ODE solutions with the default reverse mode
+// sensitivity right hand side and with ode_forward_sensitivity, for the
+// harmonic oscillator and Lorenz test problems and for a chain of n states
+// with 1.5 n parameters:
+//
+//   make benchmarks/ode_sensitivity
+#include <benchmark/benchmark.h>
+#include <stan/math/mix.hpp>
+#include <test/unit/math/prim/functor/harmonic_oscillator.hpp>
+#include <vector>
+
+struct lorenz_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const Eigen::Matrix<T1, -1, 1>& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(3);
+    dy << theta[0] * (y(1) - y(0)), theta[1] * y(0) - y(1) - y(0) * y(2),
+        -theta[2] * y(2) + y(0) * y(1);
+    return dy;
+  }
+};
+
+// linear chain with rates theta[0:n) and quadratic losses shared by groups
+// of states, with weights theta[n:n + n / 2)
+struct chain_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const Eigen::Matrix<T1, -1, 1>& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int n = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(n);
+    for (int i = 0; i < n; ++i) {
+      dy(i) = -theta[i] * y(i) - 0.01 * theta[n + i % (n / 2)] * y(i) * y(i);
+      if (i > 0) {
+        dy(i) += theta[i - 1] * y(i - 1);
+      }
+    }
+    return dy;
+  }
+};
+
+struct rk45 {
+  template <typename... Args>
+  auto operator()(const Args&... args) const {
+    return stan::math::ode_rk45(args...);
+  }
+};
+
+struct bdf {
+  template <typename... Args>
+  auto operator()(const Args&... args) const {
+    return stan::math::ode_bdf(args...);
+  }
+};
+
+template <typename Solver, typename F, typename... Args>
+static void solve_grad(benchmark::State& state, const F& f,
+                       const Eigen::VectorXd& y0,
+                       const std::vector<double>& theta,
+                       const Args&... args) {
+  using stan::math::var;
+  const std::vector<double> ts{1.0, 2.0, 3.0, 4.0, 5.0};
+  for (auto _ : state) {
+    Eigen::Matrix<var, -1, 1> y0_v = y0;
+    std::vector<var> theta_v(theta.begin(), theta.end());
+    auto ys = Solver()(f, y0_v, 0.0, ts, nullptr, theta_v, args...);
+    var lp = 0;
+    for (const auto& y : ys) {
+      lp += stan::math::sum(y);
+    }
+    lp.grad();
+    benchmark::DoNotOptimize(theta_v[0].adj());
+    stan::math::recover_memory();
+  }
+}
+
+template <typename Solver, bool Forward>
+static void harmonic_oscillator(benchmark::State& state) {
+  Eigen::VectorXd y0(2);
+  y0 << 1.0, 0.5;
+  harm_osc_ode_fun_eigen f;
+  if (Forward) {
+    solve_grad<Solver>(state, stan::math::ode_forward_sensitivity(f), y0,
+                       {0.15}, std::vector<double>(), std::vector<int>());
+  } else {
+    solve_grad<Solver>(state, f, y0, {0.15}, std::vector<double>(),
+                       std::vector<int>());
+  }
+}
+
+template <typename Solver, bool Forward>
+static void lorenz(benchmark::State& state) {
+  Eigen::VectorXd y0(3);
+  y0 << 10.0, 1.0, 1.0;
+  const std::vector<double> theta{10.0, 28.0, 8.0 / 3.0};
+  if (Forward) {
+    solve_grad<Solver>(state, stan::math::ode_forward_sensitivity(lorenz_rhs()),
+                       y0, theta);
+  } else {
+    solve_grad<Solver>(state, lorenz_rhs(), y0, theta);
+  }
+}
+
+template <typename Solver, bool Forward>
+static void chain(benchmark::State& state) {
+  const int n = state.range(0);
+  Eigen::VectorXd y0 = Eigen::VectorXd::LinSpaced(n, 1.0, 2.0);
+  std::vector<double> theta(n + n / 2);
+  for (size_t i = 0; i < theta.size(); ++i) {
+    theta[i] = 0.5 + 0.01 * i;
+  }
+  if (Forward) {
+    solve_grad<Solver>(state, stan::math::ode_forward_sensitivity(chain_rhs()),
+                       y0, theta);
+  } else {
+    solve_grad<Solver>(state, chain_rhs(), y0, theta);
+  }
+  state.counters["states"] = n;
+}
+
+BENCHMARK_TEMPLATE(harmonic_oscillator, rk45, false);
+BENCHMARK_TEMPLATE(harmonic_oscillator, rk45, true);
+BENCHMARK_TEMPLATE(harmonic_oscillator, bdf, false);
+BENCHMARK_TEMPLATE(harmonic_oscillator, bdf, true);
+BENCHMARK_TEMPLATE(lorenz, rk45, false);
+BENCHMARK_TEMPLATE(lorenz, rk45, true);
+BENCHMARK_TEMPLATE(chain, rk45, false)->Arg(10)->Arg(40);
+BENCHMARK_TEMPLATE(chain, rk45, true)->Arg(10)->Arg(40);
+BENCHMARK_TEMPLATE(chain, bdf, false)->Arg(10)->Arg(40);
+BENCHMARK_TEMPLATE(chain, bdf, true)->Arg(10)->Arg(40);
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+// Gradient throughput of scalar heavy models. Build once as is and once
+// with the op tape enabled to compare the virtual and the switch
+// dispatched reverse pass:
+//
+//   make benchmarks/opcode_tape
+//   make CXXFLAGS_OPTIM=-DSTAN_OPCODE_TAPE benchmarks/opcode_tape
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <chrono>
+#include <vector>
+
+template <typename F>
+static void time_reverse_pass(benchmark::State& state, F&& f) {
+  for (auto _ : state) {
+    stan::math::var lp = f();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    lp.grad();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// logistic regression written with scalar operations
+static void scalar_logistic_regression(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  std::vector<double> x(n), y(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = (i % 17) / 17.0 - 0.5;
+    y[i] = i % 3 == 0;
+  }
+  time_reverse_pass(state, [&]() {
+    var alpha = 0.3;
+    var beta = -1.2;
+    var lp = 0;
+    for (int i = 0; i < n; ++i) {
+      var eta = alpha + beta * x[i];
+      var p = 1.0 / (1.0 + exp(-eta));
+      lp += y[i] * log(p) + (1.0 - y[i]) * log(1.0 - p);
+    }
+    return lp;
+  });
+}
+
+// normal log density written with scalar operations
+static void scalar_normal(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  std::vector<double> y(n);
+  for (int i = 0; i < n; ++i) {
+    y[i] = (i % 11) / 11.0;
+  }
+  time_reverse_pass(state, [&]() {
+    var mu = 0.3;
+    var log_sigma = -0.5;
+    var sigma = exp(log_sigma);
+    var lp = 0;
+    for (int i = 0; i < n; ++i) {
+      var z = (y[i] - mu) / sigma;
+      lp -= 0.5 * z * z + log_sigma;
+    }
+    return lp;
+  });
+}
+
+BENCHMARK(scalar_logistic_regression)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->UseManualTime();
+BENCHMARK(scalar_normal)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->UseManualTime();
+
+BENCHMARK_MAIN();
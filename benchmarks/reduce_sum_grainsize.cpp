@@ -0,0 +1,105 @@
+// Gradient time of reduce_sum with fixed grainsizes against
+// reduce_sum_auto, sweeping the cost of a term and the size of the
+// shared argument. reduce_sum only runs in parallel with STAN_THREADS:
+//
+//   make CXXFLAGS_OPTIM=-DSTAN_THREADS benchmarks/reduce_sum_grainsize
+//   STAN_NUM_THREADS=8 ./benchmarks/reduce_sum_grainsize
+//
+// The arguments of every benchmark are the work per term (number of
+// shared parameters each term reads), the size of the shared parameter
+// vector and, for reduce_sum, the grainsize.
+#include <benchmark/benchmark.h>
+#include <stan/math.hpp>
+#include <chrono>
+#include <vector>
+
+// sum of normal_lpdf(y[i] | dot(beta[segment of i], ...), 1)
+struct regression_terms {
+  template <typename T>
+  T operator()(const std::vector<double>& y_slice, int start, int end,
+               std::ostream* msgs, int work,
+               const Eigen::Matrix<T, -1, 1>& beta) const {
+    T lp = 0;
+    const int num_beta = beta.size();
+    for (int i = start; i <= end; ++i) {
+      T mu = 0;
+      for (int k = 0; k < work; ++k) {
+        mu += beta.coeff((i + k) % num_beta) * (k + 1.0);
+      }
+      lp += stan::math::normal_lpdf(y_slice[i - start], mu, 1.0);
+    }
+    return lp;
+  }
+};
+
+static const int num_terms = 10000;
+
+template <typename F>
+static void time_gradient(benchmark::State& state, F&& f) {
+  using stan::math::var;
+  const int work = state.range(0);
+  const int num_beta = state.range(1);
+  std::vector<double> y(num_terms);
+  for (int i = 0; i < num_terms; ++i) {
+    y[i] = (i % 13) / 13.0;
+  }
+  Eigen::VectorXd beta_d = Eigen::VectorXd::Constant(num_beta, 1e-3);
+  for (auto _ : state) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    Eigen::Matrix<var, -1, 1> beta = beta_d;
+    var lp = f(y, work, beta);
+    lp.grad();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+}
+
+static void fixed_grainsize(benchmark::State& state) {
+  const int grainsize = state.range(2);
+  time_gradient(state, [grainsize](auto& y, int work, auto& beta) {
+    return stan::math::reduce_sum<regression_terms>(y, grainsize, nullptr,
+                                                    work, beta);
+  });
+}
+
+static void auto_grainsize(benchmark::State& state) {
+  stan::math::internal::reduce_sum_tuner<regression_terms>().reset();
+  time_gradient(state, [](auto& y, int work, auto& beta) {
+    return stan::math::reduce_sum_auto<regression_terms>(y, nullptr, work,
+                                                         beta);
+  });
+}
+
+static void fixed_grainsize_args(benchmark::internal::Benchmark* b) {
+  for (int work : {1, 10, 100}) {
+    for (int num_beta : {10, 1000, 50000}) {
+      for (int grainsize : {1, 16, 256, 4096}) {
+        b->Args({work, num_beta, grainsize});
+      }
+    }
+  }
+}
+
+static void auto_grainsize_args(benchmark::internal::Benchmark* b) {
+  for (int work : {1, 10, 100}) {
+    for (int num_beta : {10, 1000, 50000}) {
+      b->Args({work, num_beta});
+    }
+  }
+}
+
+BENCHMARK(fixed_grainsize)->Apply(fixed_grainsize_args)->UseManualTime();
+BENCHMARK(auto_grainsize)->Apply(auto_grainsize_args)->UseManualTime();
+
+int main(int argc, char** argv) {
+  stan::math::init_threadpool_tbb();
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,46 @@
+// Value and gradient of the log determinant of the sparse precision matrix
+// of a Gaussian Markov random field on an n x n grid, from the sparse
+// Cholesky factor and the Takahashi selected inverse:
+//
+//   make benchmarks/sparse_cholesky
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <vector>
+
+static Eigen::SparseMatrix<double> grid_precision(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n * n; ++i) {
+    triplets.emplace_back(i, i, 4.1);
+    if (i % n + 1 < n) {
+      triplets.emplace_back(i, i + 1, -1.0);
+      triplets.emplace_back(i + 1, i, -1.0);
+    }
+    if (i + n < n * n) {
+      triplets.emplace_back(i, i + n, -1.0);
+      triplets.emplace_back(i + n, i, -1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> q(n * n, n * n);
+  q.setFromTriplets(triplets.begin(), triplets.end());
+  q.makeCompressed();
+  return q;
+}
+
+static void log_determinant_spd_grad(benchmark::State& state) {
+  const int n = state.range(0);
+  Eigen::SparseMatrix<double> q = grid_precision(n);
+  for (auto _ : state) {
+    stan::math::var_value<Eigen::SparseMatrix<double>> q_v(q);
+    stan::math::var lp = stan::math::log_determinant_spd(q_v);
+    lp.grad();
+    benchmark::DoNotOptimize(q_v.adj().valuePtr());
+    stan::math::recover_memory();
+  }
+  state.counters["dim"] = n * n;
+}
+
+BENCHMARK(log_determinant_spd_grad)
+    ->RangeMultiplier(2)
+    ->Range(32, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
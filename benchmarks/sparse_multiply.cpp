@@ -0,0 +1,55 @@
+// Gradient of the squared norm of A * B for a sparse n x n matrix variable
+// A with 5 nonzeros per column and a dense n x 10 matrix B, with A as a
+// sparse matrix variable and as a dense matrix of variables:
+//
+//   make benchmarks/sparse_multiply
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <vector>
+
+static constexpr int nnz_per_col = 5;
+
+static Eigen::SparseMatrix<double> random_sparse(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int j = 0; j < n; ++j) {
+    for (int k = 0; k < nnz_per_col; ++k) {
+      triplets.emplace_back((j + k * 7919) % n, j, 1.0 + k);
+    }
+  }
+  Eigen::SparseMatrix<double> a(n, n);
+  a.setFromTriplets(triplets.begin(), triplets.end());
+  a.makeCompressed();
+  return a;
+}
+
+static void sparse_var(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  Eigen::SparseMatrix<double> a = random_sparse(n);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(n, 10);
+  for (auto _ : state) {
+    stan::math::var_value<Eigen::SparseMatrix<double>> a_v(a);
+    var lp = stan::math::sum(stan::math::square(stan::math::multiply(a_v, b)));
+    lp.grad();
+    benchmark::DoNotOptimize(a_v.adj().valuePtr());
+    stan::math::recover_memory();
+  }
+}
+
+static void dense_var(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  Eigen::MatrixXd a = random_sparse(n);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(n, 10);
+  for (auto _ : state) {
+    Eigen::Matrix<var, -1, -1> a_v = a.cast<var>();
+    var lp = stan::math::sum(stan::math::square(stan::math::multiply(a_v, b)));
+    lp.grad();
+    benchmark::DoNotOptimize(a_v.data());
+    stan::math::recover_memory();
+  }
+}
+
+BENCHMARK(sparse_var)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(dense_var)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK_MAIN();
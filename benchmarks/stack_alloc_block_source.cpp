@@ -0,0 +1,58 @@
+// Reverse pass time on a 10M vari tape for the stack_alloc block sources.
+//
+// The block source of the AD stack is fixed when the stack is created, so
+// run this once per policy:
+//
+//   make benchmarks/stack_alloc_block_source
+//   for src in malloc thp hugetlb numa; do
+//     STAN_MEMORY_BLOCK_SOURCE=$src ./benchmarks/stack_alloc_block_source
+//   done
+#include <benchmark/benchmark.h>
+#include <stan/math/rev.hpp>
+#include <chrono>
+#include <string>
+
+static const char* block_source_name(stan::math::block_source_t source) {
+  switch (source) {
+    case stan::math::block_source_t::transparent_huge_pages:
+      return "thp";
+    case stan::math::block_source_t::hugetlb:
+      return "hugetlb";
+    case stan::math::block_source_t::numa_first_touch:
+      return "numa";
+    default:
+      return "malloc";
+  }
+}
+
+static void reverse_pass(benchmark::State& state) {
+  using stan::math::var;
+  const int n = state.range(0);
+  state.SetLabel(block_source_name(
+      stan::math::ChainableStack::instance_->memalloc_.block_source()));
+  for (auto _ : state) {
+    var x = 0.5;
+    var lp = 0;
+    // three varis per iteration
+    for (int i = 0; i < n / 3; ++i) {
+      lp += stan::math::exp(x * 1e-7);
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+
+    lp.grad();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+    stan::math::recover_memory();
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(reverse_pass)
+    ->RangeMultiplier(10)
+    ->Range(100000, 10000000)
+    ->UseManualTime();
+
+BENCHMARK_MAIN();
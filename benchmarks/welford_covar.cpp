@@ -0,0 +1,49 @@
+// Cost of adding 100 draws of dimension d to the Welford covariance
+// estimators, one at a time, as one block, and in low-rank plus diagonal
+// form of rank 10:
+//
+//   make benchmarks/welford_covar
+#include <benchmark/benchmark.h>
+#include <stan/math/prim.hpp>
+
+static constexpr int n_draws = 100;
+
+static void dense_sequential(benchmark::State& state) {
+  const int d = state.range(0);
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(d, n_draws);
+  stan::math::welford_covar_estimator estimator(d);
+  for (auto _ : state) {
+    for (int i = 0; i < n_draws; ++i) {
+      estimator.add_sample(qs.col(i));
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n_draws);
+}
+
+static void dense_block(benchmark::State& state) {
+  const int d = state.range(0);
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(d, n_draws);
+  stan::math::welford_covar_estimator estimator(d);
+  for (auto _ : state) {
+    estimator.add_samples(qs);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n_draws);
+}
+
+static void lowrank_block(benchmark::State& state) {
+  const int d = state.range(0);
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(d, n_draws);
+  stan::math::welford_lowrank_covar_estimator estimator(d, 10);
+  for (auto _ : state) {
+    estimator.add_samples(qs);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n_draws);
+}
+
+BENCHMARK(dense_sequential)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK(dense_block)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK(lowrank_block)->RangeMultiplier(10)->Range(100, 10000);
+BENCHMARK_MAIN();
@@ -0,0 +1,277 @@
+#ifndef STAN_MATH_MEMORY_BLOCK_SOURCE_HPP
+#define STAN_MATH_MEMORY_BLOCK_SOURCE_HPP
+
+#include <stdint.h>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace stan {
+namespace math {
+
+/**
+ * Policies for obtaining the raw memory blocks backing a
+ * <code>stack_alloc</code>.
+ *
+ * - <code>malloc</code>: blocks come from <code>malloc()</code>. This is
+ *   the default and the only policy available on every platform.
+ * - <code>transparent_huge_pages</code>: blocks are anonymous
+ *   <code>mmap()</code> regions aligned and sized to 2MB huge pages and
+ *   marked with <code>madvise(MADV_HUGEPAGE)</code> so the kernel backs
+ *   them with transparent huge pages, cutting TLB misses on large tapes.
+ * - <code>hugetlb</code>: blocks are <code>mmap()</code>ed with
+ *   <code>MAP_HUGETLB</code> from the reserved huge page pool. If no huge
+ *   pages are reserved this falls back to
+ *   <code>transparent_huge_pages</code>.
+ * - <code>numa_first_touch</code>: blocks come from <code>malloc()</code>
+ *   but every page is written by the allocating thread before the block
+ *   is handed out. As each thread owns its own AD stack, this places the
+ *   pages on the NUMA node of the thread that uses them.
+ *
+ * On platforms without <code>mmap()</code> every policy behaves like
+ * <code>malloc</code>.
+ */
+enum class block_source_t {
+  malloc,
+  transparent_huge_pages,
+  hugetlb,
+  numa_first_touch
+};
+
+namespace internal {
+const size_t HUGE_PAGE_NBYTES = 1 << 21;  // 2MB
+const size_t SMALL_PAGE_NBYTES = 1 << 12;  // 4KB
+const size_t BLOCK_ALIGN_NBYTES = 64;      // cache line
+
+/**
+ * Round <code>nbytes</code> up to the next multiple of <code>align</code>,
+ * which must be a power of 2.
+ *
+ * @param nbytes Number of bytes.
+ * @param align Alignment in bytes.
+ * @return Rounded number of bytes.
+ */
+inline size_t round_up_to(size_t nbytes, size_t align) {
+  return (nbytes + align - 1) & ~(align - 1);
+}
+
+/**
+ * Parse the name of a block source policy.
+ *
+ * Accepted names are <code>malloc</code>, <code>thp</code>,
+ * <code>hugetlb</code> and <code>numa</code>.
+ *
+ * @param name Name of the policy.
+ * @return The policy.
+ * @throws std::invalid_argument if the name is not recognized.
+ */
+inline block_source_t parse_block_source(const char* name) {
+  const std::string source(name);
+  if (source == "malloc") {
+    return block_source_t::malloc;
+  } else if (source == "thp") {
+    return block_source_t::transparent_huge_pages;
+  } else if (source == "hugetlb") {
+    return block_source_t::hugetlb;
+  } else if (source == "numa") {
+    return block_source_t::numa_first_touch;
+  }
+  std::stringstream s;
+  s << "The STAN_MEMORY_BLOCK_SOURCE environment variable is '" << source
+    << "' but it must be one of malloc, thp, hugetlb or numa";
+  throw std::invalid_argument(s.str());
+}
+
+/**
+ * Return the block source policy to use for newly constructed stack
+ * allocators.
+ *
+ * The compile time default is <code>malloc</code> and can be changed by
+ * defining one of <code>STAN_MEMORY_THP</code>,
+ * <code>STAN_MEMORY_HUGETLB</code> or <code>STAN_MEMORY_NUMA</code>. The
+ * environment variable <code>STAN_MEMORY_BLOCK_SOURCE</code>, if set,
+ * overrides the compile time default at run time.
+ *
+ * @return block source policy
+ * @throws std::invalid_argument if the value of
+ * <code>STAN_MEMORY_BLOCK_SOURCE</code> is invalid
+ */
+inline block_source_t default_block_source() {
+  const char* env_block_source = std::getenv("STAN_MEMORY_BLOCK_SOURCE");
+  if (env_block_source != nullptr) {
+    return parse_block_source(env_block_source);
+  }
+#if defined(STAN_MEMORY_THP)
+  return block_source_t::transparent_huge_pages;
+#elif defined(STAN_MEMORY_HUGETLB)
+  return block_source_t::hugetlb;
+#elif defined(STAN_MEMORY_NUMA)
+  return block_source_t::numa_first_touch;
+#else
+  return block_source_t::malloc;
+#endif
+}
+
+/**
+ * Write one byte in every page of a block so that the pages are
+ * faulted in by, and placed on the NUMA node of, the calling thread.
+ *
+ * @param ptr Start of the block.
+ * @param nbytes Size of the block in bytes.
+ */
+inline void first_touch(char* ptr, size_t nbytes) {
+  volatile char* p = ptr;
+  for (size_t i = 0; i < nbytes; i += SMALL_PAGE_NBYTES) {
+    p[i] = 0;
+  }
+}
+
+/**
+ * Allocate <code>nbytes</code> with <code>malloc()</code> aligned to
+ * <code>BLOCK_ALIGN_NBYTES</code>. The pointer returned by
+ * <code>malloc()</code> is stored just in front of the aligned block so
+ * that it can be recovered by <code>aligned_block_free()</code>.
+ *
+ * @param nbytes Number of bytes.
+ * @return Pointer to the block or <code>nullptr</code> on failure.
+ */
+inline char* aligned_block_malloc(size_t nbytes) {
+  void* raw = std::malloc(nbytes + BLOCK_ALIGN_NBYTES);
+  if (!raw) {
+    return nullptr;
+  }
+  // always leave room for the raw pointer in front of the block
+  char* aligned = reinterpret_cast<char*>(round_up_to(
+      reinterpret_cast<uintptr_t>(raw) + sizeof(void*), BLOCK_ALIGN_NBYTES));
+  std::memcpy(aligned - sizeof(void*), &raw, sizeof(void*));
+  return aligned;
+}
+
+/**
+ * Free a block allocated with <code>aligned_block_malloc()</code>.
+ *
+ * @param ptr Pointer to the block.
+ */
+inline void aligned_block_free(char* ptr) {
+  void* raw;
+  std::memcpy(&raw, ptr - sizeof(void*), sizeof(void*));
+  std::free(raw);
+}
+
+#if defined(__linux__)
+/**
+ * Map an anonymous region of <code>nbytes</code> aligned to a huge page
+ * boundary. The region is over-allocated by one huge page and the
+ * unaligned head and tail are unmapped again.
+ *
+ * @param nbytes Number of bytes, a multiple of the huge page size.
+ * @return Pointer to the region or <code>nullptr</code> on failure.
+ */
+inline char* mmap_huge_page_aligned(size_t nbytes) {
+  const size_t padded = nbytes + HUGE_PAGE_NBYTES;
+  void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  char* base = static_cast<char*>(raw);
+  char* aligned = reinterpret_cast<char*>(
+      round_up_to(reinterpret_cast<uintptr_t>(base), HUGE_PAGE_NBYTES));
+  const size_t head = aligned - base;
+  const size_t tail = padded - head - nbytes;
+  if (head > 0) {
+    munmap(base, head);
+  }
+  if (tail > 0) {
+    munmap(aligned + nbytes, tail);
+  }
+#ifdef MADV_HUGEPAGE
+  madvise(aligned, nbytes, MADV_HUGEPAGE);
+#endif
+  return aligned;
+}
+#endif
+
+/**
+ * Allocate a block of at least <code>nbytes</code> bytes from the
+ * specified source. The huge page sources round the block size up to a
+ * multiple of the huge page size, in which case <code>nbytes</code> is
+ * updated to the usable size of the block. Blocks from every source are
+ * aligned to at least <code>BLOCK_ALIGN_NBYTES</code>.
+ *
+ * @param source Block source policy.
+ * @param[in, out] nbytes Requested size on input, usable size on output.
+ * @return Pointer to the block or <code>nullptr</code> on failure.
+ */
+inline char* allocate_block(block_source_t source, size_t& nbytes) {
+  switch (source) {
+#if defined(__linux__)
+    case block_source_t::hugetlb: {
+#ifdef MAP_HUGETLB
+      const size_t huge_nbytes = round_up_to(nbytes, HUGE_PAGE_NBYTES);
+      void* ptr = mmap(nullptr, huge_nbytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED) {
+        nbytes = huge_nbytes;
+        return static_cast<char*>(ptr);
+      }
+#endif
+      // no reserved huge pages, fall back to transparent huge pages
+    }
+    // fall through
+    case block_source_t::transparent_huge_pages: {
+      const size_t huge_nbytes = round_up_to(nbytes, HUGE_PAGE_NBYTES);
+      char* ptr = mmap_huge_page_aligned(huge_nbytes);
+      if (ptr) {
+        nbytes = huge_nbytes;
+      }
+      return ptr;
+    }
+#endif
+    case block_source_t::numa_first_touch: {
+      char* ptr = aligned_block_malloc(nbytes);
+      if (ptr) {
+        first_touch(ptr, nbytes);
+      }
+      return ptr;
+    }
+    default:
+      return aligned_block_malloc(nbytes);
+  }
+}
+
+/**
+ * Return a block obtained from <code>allocate_block()</code> to the
+ * system.
+ *
+ * @param source Block source policy the block was allocated with.
+ * @param ptr Pointer to the block.
+ * @param nbytes Usable size of the block as returned by
+ * <code>allocate_block()</code>.
+ */
+inline void free_block(block_source_t source, char* ptr, size_t nbytes) {
+  if (!ptr) {
+    return;
+  }
+#if defined(__linux__)
+  if (source == block_source_t::transparent_huge_pages
+      || source == block_source_t::hugetlb) {
+    munmap(ptr, nbytes);
+    return;
+  }
+#endif
+  aligned_block_free(ptr);
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
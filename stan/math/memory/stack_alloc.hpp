@@ -5,10 +5,15 @@
 //            is best we can do to get safe pointer casts to uints.
 #include <stdint.h>
 #include <stan/math/prim/meta.hpp>
+#include <stan/math/memory/block_source.hpp>
 #include <cstdlib>
+#include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace stan {
@@ -48,8 +53,92 @@ inline char* eight_byte_aligned_malloc(size_t size) {
   }
   return ptr;
 }
+
+/**
+ * Allocate a block from the specified source, checking that it is
+ * aligned to <code>BLOCK_ALIGN_NBYTES</code>.
+ *
+ * @param source Block source policy.
+ * @param[in, out] nbytes Requested size on input, usable size on output.
+ * @return Pointer to the block or <code>nullptr</code> on failure.
+ * @throws std::runtime_error if the block is not aligned.
+ */
+inline char* aligned_block(block_source_t source, size_t& nbytes) {
+  char* ptr = allocate_block(source, nbytes);
+  if (ptr && !is_aligned(ptr, BLOCK_ALIGN_NBYTES)) {
+    std::stringstream s;
+    s << "invalid alignment to " << BLOCK_ALIGN_NBYTES
+      << " bytes, ptr=" << reinterpret_cast<uintptr_t>(ptr) << std::endl;
+    free_block(source, ptr, nbytes);
+    throw std::runtime_error(s.str());
+  }
+  return ptr;
+}
 }  // namespace internal
 
+/**
+ * Growth and retention policy of a <code>stack_alloc</code>.
+ *
+ * The defaults reproduce the classic behaviour: every new block is twice
+ * as large as the last one, blocks are never trimmed on
+ * <code>recover_all()</code> and <code>free_all()</code> keeps only the
+ * first block.
+ */
+struct stack_alloc_policy {
+  /**
+   * Size of a new block relative to the last block.  Must be at least 1.
+   */
+  double growth_factor = 2.0;
+  /**
+   * Upper bound on the size of new blocks in bytes.  A single request
+   * larger than this still gets a block large enough to hold it.
+   */
+  size_t max_block_nbytes = std::numeric_limits<size_t>::max();
+  /**
+   * If positive, every <code>trim_after</code> calls to
+   * <code>recover_all()</code> the blocks that were not reached by any
+   * of those tapes (blocks above the high-water mark of the window) are
+   * freed.  Zero disables trimming.
+   */
+  size_t trim_after = 0;
+  /**
+   * Number of blocks retained by <code>free_all()</code>.  With the
+   * default of 1 only the initial block is kept; larger values keep the
+   * <code>keep_blocks</code> largest blocks.  Must be at least 1.
+   */
+  size_t keep_blocks = 1;
+};
+
+/**
+ * Memory usage counters of a <code>stack_alloc</code>.
+ */
+struct stack_alloc_stats {
+  /**
+   * Number of bytes currently held in blocks obtained from the system.
+   */
+  size_t bytes_reserved = 0;
+  /**
+   * Number of bytes from the start of the first block up to the next
+   * free location, including unused space at the end of earlier blocks.
+   */
+  size_t bytes_used = 0;
+  /**
+   * Largest value of <code>bytes_used</code> seen at a call to
+   * <code>recover_all()</code>, <code>free_all()</code> or
+   * <code>stats()</code>.
+   */
+  size_t peak_bytes_used = 0;
+  /**
+   * Number of blocks obtained from the system so far.
+   */
+  size_t blocks_allocated = 0;
+  /**
+   * Number of blocks returned to the system so far, not counting the
+   * destructor.
+   */
+  size_t blocks_freed = 0;
+};
+
 /**
  * An instance of this class provides a memory pool through
  * which blocks of raw memory may be allocated and then collected
@@ -59,18 +148,29 @@ inline char* eight_byte_aligned_malloc(size_t size) {
  * objects are allocated and then collected all at once.  This may
  * include objects whose destructors have no effect.
  *
- * Memory is allocated on a stack of blocks.  Each block allocated
- * is twice as large as the previous one.  The memory may be
+ * Memory is allocated on a stack of blocks.  By default each block
+ * allocated is twice as large as the previous one.  The memory may be
  * recovered, with the blocks being reused, or all blocks may be
- * freed, resetting the stack of blocks to its original state.
+ * freed, resetting the stack of blocks to its original state.  How
+ * blocks grow, when unused blocks are trimmed and which blocks survive
+ * <code>free_all()</code> is configured with a
+ * <code>stack_alloc_policy</code>.
+ *
+ * Every block starts on a 64 byte (cache line) boundary.  Plain
+ * <code>alloc()</code> calls return whatever alignment the sizes of the
+ * previous requests leave, so on 64-bit architectures all struct values
+ * should be padded to 8-byte boundaries if they contain an 8-byte
+ * member or a virtual function.  Use <code>alloc_aligned()</code> or
+ * <code>alloc_array()</code> with an alignment for storage that
+ * benefits from stronger alignment, such as Eigen matrices.
  *
- * Alignment up to 8 byte boundaries guaranteed for the first malloc,
- * and after that it's up to the caller.  On 64-bit architectures,
- * all struct values should be padded to 8-byte boundaries if they
- * contain an 8-byte member or a virtual function.
+ * Where the blocks come from is controlled by a
+ * <code>block_source_t</code> policy, see <code>block_source_t</code> and
+ * <code>internal::default_block_source()</code>.
  */
 class stack_alloc {
  private:
+  block_source_t source_;      // where blocks come from
   std::vector<char*> blocks_;  // storage for blocks,
                                // may be bigger than cur_block_
   std::vector<size_t> sizes_;  // could store initial & shift for others
@@ -82,6 +182,38 @@ class stack_alloc {
   std::vector<size_t> nested_cur_blocks_;
   std::vector<char*> nested_next_locs_;
   std::vector<char*> nested_cur_block_ends_;
+  stack_alloc_policy policy_;
+  size_t peak_bytes_used_{0};
+  size_t blocks_allocated_{1};
+  size_t blocks_freed_{0};
+  // highest block reached and recover_all calls since the last trim
+  size_t window_max_block_{0};
+  size_t window_calls_{0};
+
+  /**
+   * Return the blocks with index <code>i</code> for which
+   * <code>drop(i)</code> is true to the system, compacting the remaining
+   * blocks in order.
+   *
+   * @tparam F type of predicate
+   * @param drop Predicate on the block index.
+   */
+  template <typename F>
+  inline void free_blocks_if(F&& drop) {
+    size_t kept = 0;
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      if (drop(i)) {
+        internal::free_block(source_, blocks_[i], sizes_[i]);
+        ++blocks_freed_;
+      } else {
+        blocks_[kept] = blocks_[i];
+        sizes_[kept] = sizes_[i];
+        ++kept;
+      }
+    }
+    blocks_.resize(kept);
+    sizes_.resize(kept);
+  }
 
   /**
    * Moves us to the next block of memory, allocating that block
@@ -100,16 +232,21 @@ class stack_alloc {
     }
     // Allocate a new block if necessary.
     if (unlikely(cur_block_ >= blocks_.size())) {
-      // New block should be max(2*size of last block, len) bytes.
-      size_t newsize = sizes_.back() * 2;
+      // New block should be max(min(growth * size of last block,
+      // max block size), len) bytes.
+      size_t newsize = std::min(
+          static_cast<size_t>(sizes_.back() * policy_.growth_factor),
+          policy_.max_block_nbytes);
       if (newsize < len) {
         newsize = len;
       }
-      blocks_.push_back(internal::eight_byte_aligned_malloc(newsize));
-      if (!blocks_.back()) {
+      char* block = internal::aligned_block(source_, newsize);
+      if (!block) {
         throw std::bad_alloc();
       }
+      blocks_.push_back(block);
       sizes_.push_back(newsize);
+      ++blocks_allocated_;
     }
     result = blocks_[cur_block_];
     // Get the object's state back in order.
@@ -125,11 +262,16 @@ class stack_alloc {
    *
    * @param initial_nbytes Initial number of bytes for the
    * allocator.  Defaults to <code>(1 << 16) = 64KB</code> initial bytes.
-   * @throws std::runtime_error if the underlying malloc is not 8-byte
+   * @param source Where memory blocks are obtained from.  Defaults to
+   * the value of <code>internal::default_block_source()</code>.
+   * @throws std::runtime_error if the underlying block is not 64-byte
    * aligned.
    */
-  explicit stack_alloc(size_t initial_nbytes = internal::DEFAULT_INITIAL_NBYTES)
-      : blocks_(1, internal::eight_byte_aligned_malloc(initial_nbytes)),
+  explicit stack_alloc(
+      size_t initial_nbytes = internal::DEFAULT_INITIAL_NBYTES,
+      block_source_t source = internal::default_block_source())
+      : source_(source),
+        blocks_(1, internal::aligned_block(source, initial_nbytes)),
         sizes_(1, initial_nbytes),
         cur_block_(0),
         cur_block_end_(blocks_[0] + initial_nbytes),
@@ -147,10 +289,8 @@ class stack_alloc {
    */
   ~stack_alloc() {
     // free ALL blocks
-    for (auto& block : blocks_) {
-      if (block) {
-        free(block);
-      }
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      internal::free_block(source_, blocks_[i], sizes_[i]);
     }
   }
 
@@ -177,26 +317,73 @@ class stack_alloc {
     return reinterpret_cast<void*>(result);
   }
 
+  /**
+   * Return a newly allocated block of memory of the appropriate
+   * size managed by the stack allocator, aligned to
+   * <code>Align</code> bytes.
+   *
+   * @tparam Align Alignment in bytes, a power of 2 of at most 64.
+   * @param len Number of bytes to allocate.
+   * @return A pointer to the allocated memory.
+   */
+  template <size_t Align>
+  inline void* alloc_aligned(size_t len) {
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of 2");
+    static_assert(Align <= internal::BLOCK_ALIGN_NBYTES,
+                  "Align must not exceed the block alignment");
+    char* result = reinterpret_cast<char*>(internal::round_up_to(
+        reinterpret_cast<uintptr_t>(next_loc_), Align));
+    next_loc_ = result + len;
+    // Blocks are aligned, so a fresh block needs no padding.
+    if (unlikely(next_loc_ >= cur_block_end_)) {
+      result = move_to_next_block(len);
+    }
+    return reinterpret_cast<void*>(result);
+  }
+
   /**
    * Allocate an array on the arena of the specified size to hold
    * values of the specified template parameter type.
    *
    * @tparam T type of entries in allocated array.
+   * @tparam Align Alignment of the array in bytes.  Values up to 8 do
+   * not add padding and give the alignment of <code>alloc()</code>.
    * @param[in] n size of array to allocate.
    * @return new array allocated on the arena.
    */
-  template <typename T>
+  template <typename T, size_t Align = 1,
+            std::enable_if_t<(Align <= 8)>* = nullptr>
   inline T* alloc_array(size_t n) {
     return static_cast<T*>(alloc(n * sizeof(T)));
   }
 
+  template <typename T, size_t Align,
+            std::enable_if_t<(Align > 8)>* = nullptr>
+  inline T* alloc_array(size_t n) {
+    return static_cast<T*>(alloc_aligned<Align>(n * sizeof(T)));
+  }
+
   /**
    * Recover all the memory used by the stack allocator.  The stack
    * of memory blocks allocated so far will be available for further
    * allocations.  To free memory back to the system, use the
    * function free_all().
+   *
+   * If the policy enables trimming, every
+   * <code>policy().trim_after</code> calls the blocks above the
+   * high-water mark of those calls are freed.
    */
   inline void recover_all() {
+    peak_bytes_used_ = std::max(peak_bytes_used_, bytes_used());
+    if (policy_.trim_after > 0 && nested_cur_blocks_.empty()) {
+      window_max_block_ = std::max(window_max_block_, cur_block_);
+      if (++window_calls_ >= policy_.trim_after) {
+        const size_t high_water = window_max_block_;
+        free_blocks_if([high_water](size_t i) { return i > high_water; });
+        window_max_block_ = 0;
+        window_calls_ = 0;
+      }
+    }
     cur_block_ = 0;
     next_loc_ = blocks_[0];
     cur_block_end_ = next_loc_ + sizes_[0];
@@ -232,19 +419,123 @@ class stack_alloc {
 
   /**
    * Free all memory used by the stack allocator other than the
-   * initial block allocation back to the system.  Note:  the
-   * destructor will free all memory.
+   * initial block allocation back to the system.  If
+   * <code>policy().keep_blocks</code> is larger than 1, that many of the
+   * largest blocks are kept instead.  Note:  the destructor will free
+   * all memory.
    */
   inline void free_all() {
-    // frees all BUT the first (index 0) block
-    for (size_t i = 1; i < blocks_.size(); ++i) {
-      if (blocks_[i]) {
-        free(blocks_[i]);
+    peak_bytes_used_ = std::max(peak_bytes_used_, bytes_used());
+    if (policy_.keep_blocks == 1) {
+      // frees all BUT the first (index 0) block
+      free_blocks_if([](size_t i) { return i > 0; });
+    } else if (policy_.keep_blocks < blocks_.size()) {
+      std::vector<size_t> sorted_sizes(sizes_);
+      std::nth_element(sorted_sizes.begin(),
+                       sorted_sizes.begin() + policy_.keep_blocks - 1,
+                       sorted_sizes.end(), std::greater<size_t>());
+      // keep blocks strictly larger than the K-th largest size, then fill
+      // up with blocks of exactly that size
+      const size_t threshold = sorted_sizes[policy_.keep_blocks - 1];
+      size_t num_above = 0;
+      for (size_t size : sizes_) {
+        num_above += size > threshold;
+      }
+      size_t ties_left = policy_.keep_blocks - num_above;
+      std::vector<bool> drop(blocks_.size());
+      for (size_t i = 0; i < blocks_.size(); ++i) {
+        if (sizes_[i] > threshold) {
+          drop[i] = false;
+        } else if (sizes_[i] == threshold && ties_left > 0) {
+          drop[i] = false;
+          --ties_left;
+        } else {
+          drop[i] = true;
+        }
       }
+      free_blocks_if([&drop](size_t i) { return drop[i]; });
+    }
+    window_max_block_ = 0;
+    window_calls_ = 0;
+    cur_block_ = 0;
+    next_loc_ = blocks_[0];
+    cur_block_end_ = next_loc_ + sizes_[0];
+  }
+
+  /**
+   * Set the growth and retention policy.  The policy applies to
+   * blocks allocated and calls made from now on.
+   *
+   * @param policy New policy.
+   * @throws std::invalid_argument if the growth factor is less than 1 or
+   * the number of blocks to keep is 0.
+   */
+  inline void set_policy(const stack_alloc_policy& policy) {
+    if (!(policy.growth_factor >= 1.0)) {
+      throw std::invalid_argument(
+          "stack_alloc_policy: growth_factor must be at least 1");
+    }
+    if (policy.keep_blocks == 0) {
+      throw std::invalid_argument(
+          "stack_alloc_policy: keep_blocks must be at least 1");
+    }
+    policy_ = policy;
+    window_max_block_ = 0;
+    window_calls_ = 0;
+  }
+
+  /**
+   * Return the growth and retention policy.
+   *
+   * @return policy of this instance
+   */
+  inline const stack_alloc_policy& policy() const { return policy_; }
+
+  /**
+   * Return the number of bytes held in blocks obtained from the
+   * system, whether or not they are currently in use.
+   *
+   * @return number of reserved bytes
+   */
+  inline size_t bytes_reserved() const {
+    size_t sum = 0;
+    for (size_t size : sizes_) {
+      sum += size;
+    }
+    return sum;
+  }
+
+  /**
+   * Return the number of bytes from the start of the first block up
+   * to the next free location.  This includes space wasted at the
+   * end of earlier blocks and blocks skipped because they were too
+   * small for a request.
+   *
+   * @return number of used bytes
+   */
+  inline size_t bytes_used() const {
+    size_t sum = 0;
+    for (size_t i = 0; i < cur_block_; ++i) {
+      sum += sizes_[i];
     }
-    sizes_.resize(1);
-    blocks_.resize(1);
-    recover_all();
+    return sum + (next_loc_ - blocks_[cur_block_]);
+  }
+
+  /**
+   * Return the memory usage counters of this instance and update
+   * the peak usage with the current usage.
+   *
+   * @return usage counters
+   */
+  inline stack_alloc_stats stats() {
+    stack_alloc_stats stats;
+    stats.bytes_reserved = bytes_reserved();
+    stats.bytes_used = bytes_used();
+    peak_bytes_used_ = std::max(peak_bytes_used_, stats.bytes_used);
+    stats.peak_bytes_used = peak_bytes_used_;
+    stats.blocks_allocated = blocks_allocated_;
+    stats.blocks_freed = blocks_freed_;
+    return stats;
   }
 
   /**
@@ -265,6 +556,13 @@ class stack_alloc {
     return sum;
   }
 
+  /**
+   * Return the policy used to obtain memory blocks for this instance.
+   *
+   * @return block source policy
+   */
+  inline block_source_t block_source() const { return source_; }
+
   /**
    * Indicates whether the memory in the pointer
    * is in the stack.
@@ -13,6 +13,7 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/fun.hpp>
 #include <stan/math/rev/functor.hpp>
+#include <stan/math/rev/prob.hpp>
 
 #include <stan/math/fwd/core.hpp>
 #include <stan/math/fwd/meta.hpp>
@@ -0,0 +1,247 @@
+#ifndef STAN_MATH_MIX_FUNCTOR_COLORED_JACOBIAN_HPP
+#define STAN_MATH_MIX_FUNCTOR_COLORED_JACOBIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/functor/sundials_jacobian.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <algorithm>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Partition the columns of a sparsity pattern into groups of structurally
+ * orthogonal columns, which have no nonzero row in common, by greedy
+ * coloring of the column intersection graph in the natural order.
+ *
+ * @param pattern sparsity pattern in compressed sparse column format
+ * @return the columns of each group
+ */
+inline std::vector<std::vector<int>> color_jacobian_columns(
+    const Eigen::SparseMatrix<double>& pattern) {
+  const Eigen::SparseMatrix<double, Eigen::RowMajor> pattern_by_rows
+      = pattern;
+  const int n = pattern.cols();
+  std::vector<int> color(n, -1);
+  // forbidden[c] == j if color c is used by a neighbour of column j
+  std::vector<int> forbidden(n, -1);
+  std::vector<std::vector<int>> groups;
+  for (int j = 0; j < n; ++j) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(pattern, j); it; ++it) {
+      for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it_row(
+               pattern_by_rows, it.row());
+           it_row; ++it_row) {
+        if (color[it_row.col()] >= 0) {
+          forbidden[color[it_row.col()]] = j;
+        }
+      }
+    }
+    int c = 0;
+    while (forbidden[c] == j) {
+      ++c;
+    }
+    color[j] = c;
+    if (c == static_cast<int>(groups.size())) {
+      groups.emplace_back();
+    }
+    groups[c].push_back(j);
+  }
+  return groups;
+}
+
+}  // namespace internal
+
+/**
+ * Wrapper of an ODE right hand side or a DAE residual functor together
+ * with the sparsity pattern of its Jacobian with respect to the states and
+ * a grouping of the columns of the pattern into structurally orthogonal
+ * columns. Calls are forwarded to the wrapped functor unchanged.
+ *
+ * @tparam F ODE right hand side or DAE residual functor
+ */
+template <typename F>
+struct colored_jacobian_functor {
+  F f_;
+  Eigen::SparseMatrix<double> pattern_;
+  std::vector<std::vector<int>> groups_;
+
+  /**
+   * Wrap a functor and color the columns of its Jacobian pattern.
+   *
+   * @tparam T type of the sparse matrix
+   * @param f ODE right hand side or DAE residual functor
+   * @param pattern square sparse matrix whose nonzeros give the pattern
+   * @throw std::invalid_argument if the pattern is not square
+   */
+  template <typename T>
+  colored_jacobian_functor(const F& f, const T& pattern) : f_(f) {
+    check_square("colored_jacobian", "Jacobian pattern", pattern);
+    pattern_ = pattern;
+    pattern_.makeCompressed();
+    pattern_.coeffs().setOnes();
+    groups_ = internal::color_jacobian_columns(pattern_);
+  }
+
+  template <typename... T_args>
+  auto operator()(const T_args&... args) const {
+    return f_(args...);
+  }
+
+  /**
+   * Return the number of column groups, which is the number of forward
+   * mode evaluations per Jacobian.
+   */
+  size_t num_colors() const { return groups_.size(); }
+};
+
+/**
+ * Return the ODE right hand side or DAE residual functor wrapped so that
+ * the stiff solvers (<code>ode_bdf</code>, <code>ode_adams</code>,
+ * <code>ode_adjoint_tol_ctl</code> and <code>integrate_dae</code>) compute
+ * the sparse Jacobian of their Newton iterations with compressed forward
+ * mode seeds instead of one nested reverse sweep per state.
+ *
+ * The columns of the pattern are colored once so that the columns of a
+ * color have no nonzero row in common. The Jacobian is then recovered
+ * from one evaluation of the functor in <code>fvar<double></code> per
+ * color, whose state tangents are one for the columns of the color: three
+ * evaluations for a tridiagonal Jacobian of any size. For a DAE the
+ * tangents of the derivative of the state are scaled by \f$c_j\f$, which
+ * gives \f$\partial F / \partial y + c_j \partial F / \partial y'\f$.
+ *
+ * The pattern must contain every nonzero of the Jacobian, since a missing
+ * one is added to the entries of other columns of its color. The functor
+ * must accept <code>fvar<double></code> states. It is usually combined
+ * with <code>sundials_linear_solver::sparse</code> with the same pattern.
+ *
+ * @tparam F ODE right hand side or DAE residual functor
+ * @tparam T type of the sparse matrix
+ * @param f ODE right hand side or DAE residual functor
+ * @param pattern square sparse matrix whose nonzeros give the pattern
+ * @return wrapped functor, to be passed to the solvers in place of
+ * <code>f</code>
+ * @throw std::invalid_argument if the pattern is not square
+ */
+template <typename F, typename T, require_eigen_sparse_base_t<T>* = nullptr>
+inline colored_jacobian_functor<F> colored_jacobian(const F& f,
+                                                    const T& pattern) {
+  return colored_jacobian_functor<F>(f, pattern);
+}
+
+namespace internal {
+
+/**
+ * Recover the entries of the Jacobian in the columns of a color from the
+ * directional derivative along their seed.
+ *
+ * @param[in, out] jacobian Jacobian with the pattern of the functor
+ * @param columns columns of the color
+ * @param tangent directional derivative of the functor
+ */
+template <typename Vec>
+inline void uncompress_jacobian_columns(Eigen::SparseMatrix<double>& jacobian,
+                                        const std::vector<int>& columns,
+                                        const Vec& tangent) {
+  for (int j : columns) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(jacobian, j); it;
+         ++it) {
+      it.valueRef() = tangent[it.row()].d_;
+    }
+  }
+}
+
+/**
+ * Jacobian of an ODE right hand side with a colored sparsity pattern.
+ */
+template <typename F>
+struct sundials_ode_jacobian<colored_jacobian_functor<F>> {
+  template <typename... Args>
+  static void store(const char* function,
+                    const colored_jacobian_functor<F>& f, double t,
+                    const Eigen::VectorXd& y, std::ostream* msgs,
+                    const std::tuple<Args...>& args_tuple,
+                    const sundials_linear_solver& linear_solver, SUNMatrix J,
+                    bool transpose, double scale) {
+    const Eigen::Index N = y.size();
+    check_size_match(function, "rows of the Jacobian pattern",
+                     f.pattern_.rows(), "states", N);
+
+    Eigen::SparseMatrix<double> jacobian = f.pattern_;
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> y_fvar
+        = y.template cast<fvar<double>>();
+    for (const auto& columns : f.groups_) {
+      for (int j : columns) {
+        y_fvar.coeffRef(j).d_ = 1.0;
+      }
+      Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> fy_fvar = apply(
+          [&](auto&&... args) { return f.f_(t, y_fvar, msgs, args...); },
+          args_tuple);
+      check_size_match(function, "dy_dt", fy_fvar.size(), "states", N);
+      uncompress_jacobian_columns(jacobian, columns, fy_fvar);
+      for (int j : columns) {
+        y_fvar.coeffRef(j).d_ = 0.0;
+      }
+    }
+
+    if (transpose) {
+      linear_solver.set_jacobian(J, jacobian.transpose(), scale);
+    } else {
+      linear_solver.set_jacobian(J, jacobian, scale);
+    }
+  }
+};
+
+/**
+ * Jacobian of a DAE residual with a colored sparsity pattern.
+ */
+template <typename F>
+struct sundials_dae_jacobian<colored_jacobian_functor<F>> {
+  static constexpr bool supplied = true;
+
+  static void store(const colored_jacobian_functor<F>& f, double t,
+                    double cj, const std::vector<double>& yy,
+                    const std::vector<double>& yp,
+                    const std::vector<double>& theta,
+                    const std::vector<double>& x_r,
+                    const std::vector<int>& x_i, std::ostream* msgs,
+                    const sundials_linear_solver& linear_solver, SUNMatrix J) {
+    const size_t N = yy.size();
+    check_size_match("idas_integrator", "rows of the Jacobian pattern",
+                     f.pattern_.rows(), "states", N);
+
+    Eigen::SparseMatrix<double> jacobian = f.pattern_;
+    std::vector<fvar<double>> yy_fvar(yy.begin(), yy.end());
+    std::vector<fvar<double>> yp_fvar(yp.begin(), yp.end());
+    for (const auto& columns : f.groups_) {
+      for (int j : columns) {
+        yy_fvar[j].d_ = 1.0;
+        yp_fvar[j].d_ = cj;
+      }
+      std::vector<fvar<double>> res
+          = f.f_(t, yy_fvar, yp_fvar, theta, x_r, x_i, msgs);
+      check_size_match("idas_integrator", "residual", res.size(), "states",
+                       N);
+      uncompress_jacobian_columns(jacobian, columns, res);
+      for (int j : columns) {
+        yy_fvar[j].d_ = 0.0;
+        yp_fvar[j].d_ = 0.0;
+      }
+    }
+
+    linear_solver.set_jacobian(J, jacobian);
+  }
+};
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,329 @@
+#ifndef STAN_MATH_MIX_FUNCTOR_ODE_FORWARD_SENSITIVITY_HPP
+#define STAN_MATH_MIX_FUNCTOR_ODE_FORWARD_SENSITIVITY_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/functor/coupled_ode_system.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/functor/for_each.hpp>
+#include <ostream>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Wrapper of an ODE right hand side functor which selects forward mode
+ * directional derivatives for the sensitivity equations of the ODE
+ * solvers. Calls are forwarded to the wrapped functor unchanged.
+ *
+ * @tparam F ODE right hand side functor
+ */
+template <typename F>
+struct ode_forward_sensitivity_functor {
+  F f_;
+
+  template <typename T_t, typename T_y, typename... T_args>
+  auto operator()(const T_t& t, const T_y& y, std::ostream* msgs,
+                  const T_args&... args) const {
+    return f_(t, y, msgs, args...);
+  }
+};
+
+/**
+ * Return the ODE right hand side functor wrapped so that the ODE solvers
+ * compute the right hand side of the forward sensitivities with one
+ * forward mode evaluation per sensitivity instead of one reverse sweep per
+ * state.
+ *
+ * Each evaluation gives the directional derivative
+ * \f$J_y s_j + \partial f / \partial \theta_j\f$ of a whole sensitivity
+ * column at once, without recording an autodiff tape or forming the
+ * Jacobian, which pays off when there are more states than sensitivities
+ * or when taping the right hand side is expensive. The functor must
+ * accept <code>fvar<double></code> states and arguments.
+ *
+ * @tparam F ODE right hand side functor
+ * @param f ODE right hand side functor
+ * @return wrapped functor, to be passed to the ODE solvers in place of
+ * <code>f</code>
+ */
+template <typename F>
+inline ode_forward_sensitivity_functor<F> ode_forward_sensitivity(
+    const F& f) {
+  return ode_forward_sensitivity_functor<F>{f};
+}
+
+namespace internal {
+
+/**
+ * Forward arguments that do not contain vars.
+ *
+ * @tparam Arith type with arithmetic scalars
+ * @param arg argument, passed by reference for lvalues
+ */
+template <typename Arith, require_st_arithmetic<Arith>* = nullptr>
+inline Arith to_fvar_values(Arith&& arg) {
+  return std::forward<Arith>(arg);
+}
+
+/**
+ * Return a forward mode copy of the value of a var with a zero tangent.
+ *
+ * @param arg var
+ */
+inline fvar<double> to_fvar_values(const var& arg) {
+  return fvar<double>(arg.val(), 0.0);
+}
+
+/**
+ * Return forward mode copies of the values of a std::vector of vars or of
+ * containers of vars with zero tangents.
+ *
+ * @tparam VecVar std::vector containing vars
+ * @param arg std::vector containing vars
+ */
+template <typename VecVar, require_std_vector_t<VecVar>* = nullptr,
+          require_st_var<VecVar>* = nullptr>
+inline auto to_fvar_values(const VecVar& arg) {
+  std::vector<decltype(to_fvar_values(arg[0]))> copy;
+  copy.reserve(arg.size());
+  for (const auto& x : arg) {
+    copy.emplace_back(to_fvar_values(x));
+  }
+  return copy;
+}
+
+/**
+ * Return forward mode copies of the values of an Eigen container of vars
+ * with zero tangents.
+ *
+ * @tparam EigT Eigen container of vars
+ * @param arg Eigen container of vars
+ */
+template <typename EigT, require_eigen_vt<is_var, EigT>* = nullptr>
+inline auto to_fvar_values(const EigT& arg) {
+  return Eigen::Matrix<fvar<double>, EigT::RowsAtCompileTime,
+                       EigT::ColsAtCompileTime>(
+      arg.val().template cast<fvar<double>>());
+}
+
+/**
+ * Arguments without forward mode scalars have no tangents.
+ */
+template <typename Arith, require_st_arithmetic<Arith>* = nullptr>
+inline void collect_tangents(std::vector<double*>& /* tangents */,
+                             const Arith& /* arg */) {}
+
+/**
+ * Append the address of the tangent of a forward mode scalar.
+ *
+ * @param[in, out] tangents addresses of the tangents
+ * @param arg forward mode scalar
+ */
+inline void collect_tangents(std::vector<double*>& tangents,
+                             fvar<double>& arg) {
+  tangents.push_back(&arg.d_);
+}
+
+/**
+ * Append the addresses of the tangents of a std::vector, in the order in
+ * which <code>count_vars</code> and <code>accumulate_adjoints</code> visit
+ * the vars it was copied from.
+ *
+ * @tparam T type of the elements
+ * @param[in, out] tangents addresses of the tangents
+ * @param arg std::vector of forward mode scalars or containers
+ */
+template <typename T, require_not_st_arithmetic<T>* = nullptr>
+inline void collect_tangents(std::vector<double*>& tangents,
+                             std::vector<T>& arg) {
+  for (auto& x : arg) {
+    collect_tangents(tangents, x);
+  }
+}
+
+/**
+ * Append the addresses of the tangents of an Eigen container in column
+ * major order.
+ *
+ * @tparam R rows at compile time
+ * @tparam C columns at compile time
+ * @param[in, out] tangents addresses of the tangents
+ * @param arg Eigen container of forward mode scalars
+ */
+template <int R, int C>
+inline void collect_tangents(std::vector<double*>& tangents,
+                             Eigen::Matrix<fvar<double>, R, C>& arg) {
+  for (Eigen::Index i = 0; i < arg.size(); ++i) {
+    tangents.push_back(&arg.coeffRef(i).d_);
+  }
+}
+
+}  // namespace internal
+
+/**
+ * The <code>coupled_ode_system_impl</code> template specialization for a
+ * right hand side wrapped by <code>ode_forward_sensitivity</code>, when the
+ * state or parameters are autodiff types.
+ *
+ * <p>The coupled system has the same layout as the reverse mode
+ * specialization: the N states, then the N sensitivities with respect to
+ * each initial condition, then the N sensitivities with respect to each
+ * parameter. The right hand side of sensitivity column \f$s_j\f$ is the
+ * directional derivative of the base right hand side in the direction
+ * \f$(s_j, e_j)\f$, so it is computed with one evaluation in
+ * <code>fvar<double></code> whose state tangents are \f$s_j\f$ and whose
+ * only nonzero parameter tangent is the one of parameter \f$j\f$.
+ *
+ * <p>The values of the parameters are copied to forward mode scalars once,
+ * upon construction, and nothing is recorded on the autodiff tape.
+ *
+ * @tparam F base ode system functor
+ */
+template <typename F, typename T_y0, typename... Args>
+struct coupled_ode_system_impl<false, ode_forward_sensitivity_functor<F>,
+                               T_y0, Args...> {
+  const ode_forward_sensitivity_functor<F>& f_;
+  const Eigen::Matrix<T_y0, Eigen::Dynamic, 1>& y0_;
+  std::tuple<decltype(internal::to_fvar_values(std::declval<const Args&>()))...>
+      local_args_tuple_;
+  const size_t num_y0_vars_;
+  const size_t num_args_vars;
+  const size_t N_;
+  std::vector<double*> args_tangents_;
+  std::ostream* msgs_;
+
+  /**
+   * Construct a coupled ode system from the base system function,
+   * initial state of the base system, parameters, and a stream for
+   * messages.
+   *
+   * @param[in] f the wrapped base ODE system functor
+   * @param[in] y0 the initial state of the base ode
+   * @param[in, out] msgs stream for messages
+   * @param[in] args other additional arguments
+   */
+  coupled_ode_system_impl(const ode_forward_sensitivity_functor<F>& f,
+                          const Eigen::Matrix<T_y0, Eigen::Dynamic, 1>& y0,
+                          std::ostream* msgs, const Args&... args)
+      : f_(f),
+        y0_(y0),
+        local_args_tuple_(internal::to_fvar_values(args)...),
+        num_y0_vars_(count_vars(y0_)),
+        num_args_vars(count_vars(args...)),
+        N_(y0.size()),
+        msgs_(msgs) {
+    args_tangents_.reserve(num_args_vars);
+  }
+
+  /**
+   * Calculates the right hand side of the coupled ode system (the regular
+   * ode system with forward sensitivities).
+   *
+   * @param[in] z state of the coupled ode system; this must be size
+   *   <code>size()</code>
+   * @param[out] dz_dt a vector of size <code>size()</code> with the
+   *    derivatives of the coupled system with respect to time
+   * @param[in] t time
+   * @throw exception if the base ode function does not return the
+   *    expected number of derivatives, N.
+   */
+  void operator()(const std::vector<double>& z, std::vector<double>& dz_dt,
+                  double t) {
+    dz_dt.resize(size());
+
+    // The addresses are taken on every call, as this system may have been
+    // copied since the last one
+    args_tangents_.clear();
+    stan::math::for_each(
+        [&](auto&& arg) { internal::collect_tangents(args_tangents_, arg); },
+        local_args_tuple_);
+
+    Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> y_fvar(N_);
+    for (size_t n = 0; n < N_; ++n) {
+      y_fvar.coeffRef(n) = fvar<double>(z[n], 0.0);
+    }
+
+    // With no directions, as when the only autodiff arguments are empty
+    // containers, the coupled system is the base system and is evaluated
+    // once with zero tangents
+    const size_t num_directions = num_y0_vars_ + num_args_vars;
+    if (num_directions == 0) {
+      Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> f_y_t_fvar = apply(
+          [&](auto&&... args) { return f_.f_(t, y_fvar, msgs_, args...); },
+          local_args_tuple_);
+      check_size_match("coupled_ode_system", "dy_dt", f_y_t_fvar.size(),
+                       "states", N_);
+      for (size_t k = 0; k < N_; ++k) {
+        dz_dt[k] = f_y_t_fvar.coeffRef(k).val_;
+      }
+      return;
+    }
+    for (size_t j = 0; j < num_directions; ++j) {
+      const size_t offset = N_ + N_ * j;
+      for (size_t k = 0; k < N_; ++k) {
+        y_fvar.coeffRef(k).d_ = z[offset + k];
+      }
+      double* arg_tangent
+          = j < num_y0_vars_ ? nullptr : args_tangents_[j - num_y0_vars_];
+      if (arg_tangent != nullptr) {
+        *arg_tangent = 1.0;
+      }
+
+      Eigen::Matrix<fvar<double>, Eigen::Dynamic, 1> f_y_t_fvar = apply(
+          [&](auto&&... args) { return f_.f_(t, y_fvar, msgs_, args...); },
+          local_args_tuple_);
+
+      if (arg_tangent != nullptr) {
+        *arg_tangent = 0.0;
+      }
+
+      if (j == 0) {
+        check_size_match("coupled_ode_system", "dy_dt", f_y_t_fvar.size(),
+                         "states", N_);
+        for (size_t k = 0; k < N_; ++k) {
+          dz_dt[k] = f_y_t_fvar.coeffRef(k).val_;
+        }
+      }
+      for (size_t k = 0; k < N_; ++k) {
+        dz_dt[offset + k] = f_y_t_fvar.coeffRef(k).d_;
+      }
+    }
+  }
+
+  /**
+   * Returns the size of the coupled system.
+   *
+   * @return size of the coupled system.
+   */
+  size_t size() const { return N_ + N_ * num_y0_vars_ + N_ * num_args_vars; }
+
+  /**
+   * Returns the initial state of the coupled system, the initial state of
+   * the base system followed by the identity for the sensitivities with
+   * respect to the initial conditions and zeros for the sensitivities with
+   * respect to the parameters.
+   *
+   * @return the initial condition of the coupled system
+   */
+  std::vector<double> initial_state() const {
+    std::vector<double> initial(size(), 0.0);
+    for (size_t i = 0; i < N_; i++) {
+      initial[i] = value_of(y0_(i));
+    }
+    for (size_t i = 0; i < num_y0_vars_; i++) {
+      initial[N_ + i * N_ + i] = 1.0;
+    }
+    return initial;
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
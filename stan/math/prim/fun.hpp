@@ -248,6 +248,7 @@
 #include <stan/math/prim/fun/positive_ordered_constrain.hpp>
 #include <stan/math/prim/fun/positive_ordered_free.hpp>
 #include <stan/math/prim/fun/pow.hpp>
+#include <stan/math/prim/fun/prepared_data.hpp>
 #include <stan/math/prim/fun/primitive_value.hpp>
 #include <stan/math/prim/fun/prob_constrain.hpp>
 #include <stan/math/prim/fun/prob_free.hpp>
@@ -305,6 +306,7 @@
 #include <stan/math/prim/fun/sort_indices.hpp>
 #include <stan/math/prim/fun/sort_indices_asc.hpp>
 #include <stan/math/prim/fun/sort_indices_desc.hpp>
+#include <stan/math/prim/fun/sparse_cholesky_factor.hpp>
 #include <stan/math/prim/fun/sqrt.hpp>
 #include <stan/math/prim/fun/square.hpp>
 #include <stan/math/prim/fun/squared_distance.hpp>
@@ -350,6 +352,7 @@
 #include <stan/math/prim/fun/vector_seq_view.hpp>
 #include <stan/math/prim/fun/variance.hpp>
 #include <stan/math/prim/fun/welford_covar_estimator.hpp>
+#include <stan/math/prim/fun/welford_lowrank_covar_estimator.hpp>
 #include <stan/math/prim/fun/welford_var_estimator.hpp>
 #include <stan/math/prim/fun/zeros_array.hpp>
 #include <stan/math/prim/fun/zeros_int_array.hpp>
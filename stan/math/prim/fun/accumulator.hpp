@@ -4,6 +4,9 @@
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/prim/fun/sum.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <cmath>
+#include <cstddef>
 #include <vector>
 #include <type_traits>
 
@@ -14,17 +17,57 @@ namespace math {
  * Class to accumulate values and eventually return their sum.  If
  * no values are ever added, the return value is 0.
  *
- * This class is useful for speeding up autodiff of long sums
- * because it uses the <code>sum()</code> operation (either from
- * <code>stan::math</code> or one defined by argument-dependent lookup.
+ * Arithmetic values, including the coefficients of arithmetic Eigen
+ * expressions, are summed eagerly in double precision with Neumaier's
+ * compensated summation, so they take no memory and do not lose
+ * precision in long sums. Values of type <code>T</code> are buffered and
+ * the buffer is collapsed into a single value with the
+ * <code>sum()</code> operation (either from <code>stan::math</code> or
+ * one defined by argument-dependent lookup) whenever it is full; for
+ * autodiff variables this creates one n-ary sum node per buffer, which is
+ * much faster than a chain of additions. Eigen expressions of type
+ * <code>T</code> are reduced with a single <code>sum()</code>.
+ *
+ * Accumulators can be merged with <code>add()</code>, for example to
+ * combine thread-local partial sums, such as ones kept by the partial sum
+ * functions of <code>reduce_sum</code>.
  *
  * @tparam T Type of scalar added
  */
 template <typename T>
 class accumulator {
  private:
+  static constexpr size_t max_buffer_size_ = 1024;
+  double sum_{0};
+  double compensation_{0};
   std::vector<T> buf_;
 
+  /**
+   * Add a value to the arithmetic sum with Neumaier's compensated
+   * summation. Infinite and NaN values and sums are not compensated, so
+   * that they propagate like in a plain sum.
+   *
+   * @param x Value to add
+   */
+  inline void add_compensated(double x) {
+    const double t = sum_ + x;
+    if (std::isfinite(t)) {
+      compensation_ += std::fabs(sum_) >= std::fabs(x) ? (sum_ - t) + x
+                                                       : (x - t) + sum_;
+    }
+    sum_ = t;
+  }
+
+  /**
+   * Replace the buffered values by their sum.
+   */
+  inline void collapse() {
+    using math::sum;
+    T buf_sum = sum(buf_);
+    buf_.clear();
+    buf_.push_back(buf_sum);
+  }
+
  public:
   /**
    * Construct an accumulator.
@@ -37,8 +80,8 @@ class accumulator {
   ~accumulator() {}
 
   /**
-   * Add the specified arithmetic type value to the buffer after
-   * static casting it to the class type <code>T</code>.
+   * Add the specified arithmetic type value to the compensated sum of
+   * arithmetic values.
    *
    * <p>See the std library doc for <code>std::is_arithmetic</code>
    * for information on what counts as an arithmetic type.
@@ -48,11 +91,12 @@ class accumulator {
    */
   template <typename S, typename = require_arithmetic_t<S>>
   void add(S x) {
-    buf_.push_back(static_cast<T>(x));
+    add_compensated(static_cast<double>(x));
   }
 
   /**
-   * Add the specified non-arithmetic value to the buffer.
+   * Add the specified non-arithmetic value to the buffer, collapsing
+   * the buffer first if it is full.
    *
    * <p>This function is disabled if the type <code>S</code> is
    * arithmetic or if it's not the same as <code>T</code>.
@@ -66,24 +110,43 @@ class accumulator {
   template <typename S, typename = require_not_arithmetic_t<S>,
             typename = require_same_t<S, T>>
   void add(const S& x) {
+    if (buf_.empty()) {
+      buf_.reserve(max_buffer_size_);
+    } else if (buf_.size() == max_buffer_size_) {
+      collapse();
+    }
     buf_.push_back(x);
   }
 
   /**
-   * Add each entry in the specified matrix, vector, or row vector
-   * of values to the buffer.
+   * Add the entries of the specified arithmetic matrix, vector, row
+   * vector or expression to the compensated sum of arithmetic values.
    *
    * @tparam S type of the matrix
    * @param m Matrix of values to add
    */
-  template <typename S, require_eigen_t<S>* = nullptr>
+  template <typename S, require_eigen_vt<std::is_arithmetic, S>* = nullptr>
   void add(const S& m) {
-    const auto& m_eval = m.eval();
-    for (int i = 0; i < m.size(); ++i) {
-      this->add(m_eval.coeff(i));
+    const auto& m_ref = to_ref(m);
+    for (Eigen::Index i = 0; i < m_ref.size(); ++i) {
+      add_compensated(m_ref.coeff(i));
     }
   }
 
+  /**
+   * Add the sum of the entries of the specified matrix, vector, row
+   * vector or expression of values of type <code>T</code> to the buffer.
+   *
+   * @tparam S type of the matrix
+   * @param m Matrix of values to add
+   */
+  template <typename S, require_eigen_t<S>* = nullptr,
+            require_not_vt_arithmetic<S>* = nullptr>
+  void add(const S& m) {
+    using math::sum;
+    this->add(sum(m));
+  }
+
   /**
    * Recursively add each entry in the specified standard vector
    * to the buffer.  This will allow vectors of primitives,
@@ -100,6 +163,20 @@ class accumulator {
     }
   }
 
+  /**
+   * Add the values accumulated by another accumulator, for example a
+   * thread-local partial sum.
+   *
+   * @param other Accumulator to merge into this one
+   */
+  void add(const accumulator<T>& other) {
+    add_compensated(other.sum_);
+    add_compensated(other.compensation_);
+    for (const T& x : other.buf_) {
+      this->add(x);
+    }
+  }
+
   /**
    * Return the sum of the accumulated values.
    *
@@ -107,7 +184,11 @@ class accumulator {
    */
   T sum() const {
     using math::sum;
-    return sum(buf_);
+    const double arithmetic_sum = sum_ + compensation_;
+    if (buf_.empty()) {
+      return static_cast<T>(arithmetic_sum);
+    }
+    return sum(buf_) + arithmetic_sum;
   }
 };
 
@@ -27,6 +27,7 @@ namespace math {
  *   if m is not positive definite (if m has more than 0 elements)
  */
 template <typename EigMat, require_eigen_t<EigMat>* = nullptr,
+          require_not_eigen_sparse_base_t<EigMat>* = nullptr,
           require_not_eigen_vt<is_var, EigMat>* = nullptr>
 inline Eigen::Matrix<value_type_t<EigMat>, EigMat::RowsAtCompileTime,
                      EigMat::ColsAtCompileTime>
@@ -41,6 +42,42 @@ cholesky_decompose(const EigMat& m) {
   return llt.matrixL();
 }
 
+/**
+ * Return the lower-triangular Cholesky factor of the specified sparse,
+ * symmetric, positive definite matrix. The rows and columns are not
+ * reordered, so that \f$A = L L^T\f$, and the fill-in of the factor
+ * depends on the ordering of the matrix. Functions which only need the
+ * factorization, like <code>log_determinant_spd</code> and
+ * <code>mdivide_left_spd</code>, use a fill-reducing ordering instead.
+ *
+ * Only the lower triangle of the matrix is read.
+ *
+ * @tparam EigMat type of the sparse matrix
+ * @param m Symmetric, positive definite sparse matrix.
+ * @return Sparse Cholesky factor of the matrix.
+ * @throw std::domain_error if m is not a symmetric matrix or
+ *   if m is not positive definite
+ */
+template <typename EigMat, require_eigen_sparse_base_t<EigMat>* = nullptr,
+          require_vt_arithmetic<EigMat>* = nullptr>
+inline Eigen::SparseMatrix<double> cholesky_decompose(const EigMat& m) {
+  const Eigen::SparseMatrix<double> m_c = m;
+  check_symmetric("cholesky_decompose", "m", m_c);
+  check_not_nan("cholesky_decompose", "m",
+                Eigen::Map<const Eigen::VectorXd>(m_c.valuePtr(),
+                                                  m_c.nonZeros()));
+  Eigen::SimplicialLLT<Eigen::SparseMatrix<double>, Eigen::Lower,
+                       Eigen::NaturalOrdering<int>>
+      llt(m_c);
+  if (llt.info() != Eigen::Success) {
+    throw_domain_error("cholesky_decompose", "m", "is not positive definite.",
+                       "");
+  }
+  Eigen::SparseMatrix<double> L = llt.matrixL();
+  L.makeCompressed();
+  return L;
+}
+
 }  // namespace math
 }  // namespace stan
 
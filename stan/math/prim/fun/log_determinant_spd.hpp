@@ -4,6 +4,7 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/prim/fun/log.hpp>
+#include <stan/math/prim/fun/sparse_cholesky_factor.hpp>
 #include <stan/math/prim/fun/sum.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <cmath>
@@ -21,6 +22,7 @@ namespace math {
  * @throw std::domain_error if matrix is not square and symmetric
  */
 template <typename EigMat, require_eigen_t<EigMat>* = nullptr,
+          require_not_eigen_sparse_base_t<EigMat>* = nullptr,
           require_not_vt_var<EigMat>* = nullptr>
 inline value_type_t<EigMat> log_determinant_spd(const EigMat& m) {
   const auto& m_ref = to_ref(m);
@@ -31,6 +33,29 @@ inline value_type_t<EigMat> log_determinant_spd(const EigMat& m) {
   return sum(log(m_ref.ldlt().vectorD().array()));
 }
 
+/**
+ * Returns the log determinant of the specified symmetric, positive
+ * definite sparse matrix, from its sparse Cholesky factorization with a
+ * fill-reducing ordering.
+ *
+ * @tparam EigMat type of the sparse matrix
+ *
+ * @param m specified sparse matrix
+ * @return log determinant of the matrix
+ * @throw std::domain_error if matrix is not symmetric or not positive
+ * definite
+ */
+template <typename EigMat, require_eigen_sparse_base_t<EigMat>* = nullptr,
+          require_vt_arithmetic<EigMat>* = nullptr>
+inline double log_determinant_spd(const EigMat& m) {
+  check_square("log_determinant_spd", "m", m);
+  if (m.size() == 0) {
+    return 0;
+  }
+  return sparse_cholesky_factor("log_determinant_spd", "m", m)
+      .log_determinant();
+}
+
 }  // namespace math
 }  // namespace stan
 
@@ -4,6 +4,7 @@
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/sparse_cholesky_factor.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 
 namespace stan {
@@ -24,6 +25,7 @@ namespace math {
  */
 template <typename EigMat1, typename EigMat2,
           require_all_eigen_t<EigMat1, EigMat2>* = nullptr,
+          require_all_not_eigen_sparse_base_t<EigMat1, EigMat2>* = nullptr,
           require_all_not_vt_var<EigMat1, EigMat2>* = nullptr>
 inline Eigen::Matrix<return_type_t<EigMat1, EigMat2>,
                      EigMat1::RowsAtCompileTime, EigMat2::ColsAtCompileTime>
@@ -48,6 +50,36 @@ mdivide_left_spd(const EigMat1& A, const EigMat2& b) {
                     EigMat2::ColsAtCompileTime>(b));
 }
 
+/**
+ * Returns the solution of the system Ax=b where A is a symmetric, positive
+ * definite sparse matrix, from its sparse Cholesky factorization with a
+ * fill-reducing ordering.
+ *
+ * @tparam SpMat type of the sparse matrix
+ * @tparam EigMat type of the right-hand side matrix or vector
+ *
+ * @param A Sparse matrix.
+ * @param b Right hand side matrix or vector.
+ * @return x = A^-1 b, solution of the linear system.
+ * @throws std::invalid_argument if A is not square or the rows of b don't
+ * match the size of A.
+ * @throws std::domain_error if A is not symmetric or not positive definite
+ */
+template <typename SpMat, typename EigMat,
+          require_eigen_sparse_base_t<SpMat>* = nullptr,
+          require_eigen_t<EigMat>* = nullptr,
+          require_not_eigen_sparse_base_t<EigMat>* = nullptr,
+          require_all_vt_arithmetic<SpMat, EigMat>* = nullptr>
+inline Eigen::Matrix<double, Eigen::Dynamic, EigMat::ColsAtCompileTime>
+mdivide_left_spd(const SpMat& A, const EigMat& b) {
+  static const char* function = "mdivide_left_spd";
+  check_multiplicable(function, "A", A, "b", b);
+  if (A.size() == 0) {
+    return {0, b.cols()};
+  }
+  return sparse_cholesky_factor(function, "A", A).solve(b);
+}
+
 }  // namespace math
 }  // namespace stan
 
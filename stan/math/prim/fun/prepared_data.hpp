@@ -0,0 +1,154 @@
+#ifndef STAN_MATH_PRIM_FUN_PREPARED_DATA_HPP
+#define STAN_MATH_PRIM_FUN_PREPARED_DATA_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/as_array_or_scalar.hpp>
+#include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
+#include <stan/math/prim/fun/constants.hpp>
+#include <stan/math/prim/fun/lgamma.hpp>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+
+/**
+ * Data argument of a log density or mass function, prepared for repeated
+ * evaluation on the same data.
+ *
+ * The data is copied and summarized once, at construction: the summary
+ * replaces the validation of the data (NaN, minimum and maximum) and the
+ * data-only summands and sufficient statistics (sum, mean, sum of squared
+ * deviations and sum of <code>lgamma(n + 1)</code>) in every later
+ * evaluation. Pass it in place of the data to <code>normal_lpdf</code>
+ * with scalar location and scale, and to <code>poisson_lpmf</code> and
+ * <code>poisson_log_lpmf</code>.
+ *
+ * The object is immutable after construction, so it may be shared between
+ * threads.
+ *
+ * @tparam T type of the data, a <code>std::vector</code> or Eigen vector of
+ * <code>int</code> or <code>double</code>
+ */
+template <typename T>
+class prepared_data {
+  using value_t = value_type_t<T>;
+  static_assert(std::is_arithmetic<value_t>::value,
+                "prepared_data requires a vector of int or double");
+
+  T data_;
+  bool has_nan_{false};
+  double min_{INFTY};
+  double max_{NEGATIVE_INFTY};
+  double sum_{0};
+  double mean_{0};
+  double sum_sq_dev_{0};
+  double sum_lgamma_plus_one_{0};
+
+ public:
+  /**
+   * Copy and summarize the data.
+   *
+   * @param data data
+   */
+  explicit prepared_data(const T& data) : data_(data) {
+    const auto& x = as_array_or_scalar(as_column_vector_or_scalar(data_));
+    double count = 0;
+    for (Eigen::Index i = 0; i < x.size(); ++i) {
+      const double x_i = x.coeff(i);
+      if (std::isnan(x_i)) {
+        has_nan_ = true;
+        continue;
+      }
+      min_ = std::fmin(min_, x_i);
+      max_ = std::fmax(max_, x_i);
+      sum_ += x_i;
+      // Welford's update of the mean and the sum of squared deviations
+      const double delta = x_i - mean_;
+      mean_ += delta / ++count;
+      sum_sq_dev_ += delta * (x_i - mean_);
+      sum_lgamma_plus_one_ += lgamma(x_i + 1.0);
+    }
+  }
+
+  /**
+   * Return the data.
+   */
+  inline const T& data() const noexcept { return data_; }
+
+  /**
+   * Return the number of elements of the data.
+   */
+  inline size_t size() const noexcept { return data_.size(); }
+
+  /**
+   * Return true if any element of the data is NaN. The statistics below
+   * are only meaningful if this is false.
+   */
+  inline bool has_nan() const noexcept { return has_nan_; }
+
+  /**
+   * Return the smallest element of the data, or infinity if it is empty.
+   */
+  inline double min() const noexcept { return min_; }
+
+  /**
+   * Return the largest element of the data, or negative infinity if it is
+   * empty.
+   */
+  inline double max() const noexcept { return max_; }
+
+  /**
+   * Return the sum of the data.
+   */
+  inline double sum() const noexcept { return sum_; }
+
+  /**
+   * Return the mean of the data.
+   */
+  inline double mean() const noexcept { return mean_; }
+
+  /**
+   * Return the sum of the squared deviations of the data from its mean.
+   */
+  inline double sum_sq_dev() const noexcept { return sum_sq_dev_; }
+
+  /**
+   * Return the sum of <code>lgamma(n + 1)</code> over the data, the
+   * data-only summand of the Poisson mass functions.
+   */
+  inline double sum_lgamma_plus_one() const noexcept {
+    return sum_lgamma_plus_one_;
+  }
+};
+
+/**
+ * Return the data prepared for repeated evaluation of log densities and
+ * mass functions, see <code>prepared_data</code>.
+ *
+ * @tparam T type of the data
+ * @param data a <code>std::vector</code> or Eigen vector of <code>int</code>
+ * or <code>double</code>
+ * @return prepared data
+ */
+template <typename T>
+inline prepared_data<plain_type_t<T>> prepare_data(const T& data) {
+  return prepared_data<plain_type_t<T>>(data);
+}
+
+}  // namespace math
+
+/**
+ * The scalar type of prepared data is the scalar type of the data.
+ *
+ * @tparam T type of the prepared data
+ */
+template <typename T>
+struct scalar_type<math::prepared_data<T>> {
+  using type = scalar_type_t<T>;
+};
+
+}  // namespace stan
+#endif
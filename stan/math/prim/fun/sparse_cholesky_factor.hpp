@@ -0,0 +1,206 @@
+#ifndef STAN_MATH_PRIM_FUN_SPARSE_CHOLESKY_FACTOR_HPP
+#define STAN_MATH_PRIM_FUN_SPARSE_CHOLESKY_FACTOR_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Sparse Cholesky factorization \f$P A P^T = L L^T\f$ of a symmetric,
+ * positive definite sparse matrix, with the fill-reducing approximate
+ * minimum degree ordering \f$P\f$.
+ *
+ * Besides the log determinant and solves, the factor gives the entries of
+ * \f$A^{-1}\f$ on the sparsity pattern of \f$L\f$ through the Takahashi
+ * recurrence, at about the cost of the factorization. This is all that
+ * is needed for the gradients of the log determinant and of solves with
+ * respect to the nonzeros of \f$A\f$.
+ *
+ * Only the lower triangle of the matrix is read.
+ */
+class sparse_cholesky_factor {
+ public:
+  using sparse_t = Eigen::SparseMatrix<double>;
+  using permutation_t = Eigen::PermutationMatrix<Eigen::Dynamic,
+                                                 Eigen::Dynamic, int>;
+
+  /**
+   * Factor a symmetric, positive definite sparse matrix.
+   *
+   * @tparam T type of the sparse matrix
+   * @param function name of the calling function (for error messages)
+   * @param name name of the matrix (for error messages)
+   * @param A symmetric, positive definite sparse matrix
+   * @throw std::invalid_argument if the matrix is not square
+   * @throw std::domain_error if the matrix is not symmetric, has NaN
+   * values or is not positive definite
+   */
+  template <typename T, require_eigen_sparse_base_t<T>* = nullptr>
+  sparse_cholesky_factor(const char* function, const char* name, const T& A) {
+    const sparse_t A_c = A;
+    check_symmetric(function, name, A_c);
+    check_not_nan(function, name,
+                  Eigen::Map<const Eigen::VectorXd>(A_c.valuePtr(),
+                                                    A_c.nonZeros()));
+    Eigen::SimplicialLLT<sparse_t, Eigen::Lower, Eigen::AMDOrdering<int>> llt(
+        A_c);
+    if (llt.info() != Eigen::Success) {
+      throw_domain_error(function, name, "is not positive definite.", "");
+    }
+    L_ = llt.matrixL();
+    L_.makeCompressed();
+    P_ = llt.permutationP();
+    if (P_.size() != A_c.rows()) {
+      P_.setIdentity(A_c.rows());
+    }
+  }
+
+  /**
+   * Return the lower triangular factor of the permuted matrix.
+   */
+  const sparse_t& matrixL() const { return L_; }
+
+  /**
+   * Return the fill-reducing permutation. Row and column <code>i</code>
+   * of the matrix are row and column <code>permutationP().indices()(i)</code>
+   * of the factored matrix.
+   */
+  const permutation_t& permutationP() const { return P_; }
+
+  /**
+   * Return the number of rows and columns of the factored matrix.
+   */
+  Eigen::Index rows() const { return L_.rows(); }
+
+  /**
+   * Return the log determinant of the factored matrix.
+   */
+  double log_determinant() const {
+    return 2.0 * L_.diagonal().array().log().sum();
+  }
+
+  /**
+   * Return the solution <code>x</code> of <code>A x = b</code>.
+   *
+   * @tparam EigMat type of the right hand side
+   * @param b right hand side of arithmetic scalars
+   * @return solution of the system
+   */
+  template <typename EigMat, require_eigen_t<EigMat>* = nullptr>
+  Eigen::Matrix<double, Eigen::Dynamic, EigMat::ColsAtCompileTime> solve(
+      const EigMat& b) const {
+    Eigen::Matrix<double, Eigen::Dynamic, EigMat::ColsAtCompileTime> x
+        = P_ * b;
+    L_.triangularView<Eigen::Lower>().solveInPlace(x);
+    L_.transpose().triangularView<Eigen::Upper>().solveInPlace(x);
+    return P_.transpose() * x;
+  }
+
+  /**
+   * Return the lower triangle of the inverse of the permuted matrix
+   * \f$\Sigma = (L L^T)^{-1}\f$ on the sparsity pattern of \f$L\f$.
+   *
+   * Columns are computed from last to first with the Takahashi recurrence
+   * \f$\Sigma_{ij} = \delta_{ij} / L_{jj}^2 - L_{jj}^{-1}
+   * \sum_{k > j} L_{kj} \Sigma_{ik}\f$, which only reads entries of
+   * \f$\Sigma\f$ on the pattern of \f$L\f$.
+   *
+   * @return selected inverse, with the sparsity pattern of
+   * <code>matrixL()</code>
+   */
+  sparse_t selected_inverse() const {
+    const int n = L_.cols();
+    sparse_t sigma = L_;
+    const int* outer = L_.outerIndexPtr();
+    const int* inner = L_.innerIndexPtr();
+    const double* l = L_.valuePtr();
+    double* s = sigma.valuePtr();
+    // column j of L scattered into l_j, and the sums over k of the
+    // recurrence in acc, both only touched on the pattern of column j
+    Eigen::VectorXd l_j = Eigen::VectorXd::Zero(n);
+    Eigen::VectorXd acc = Eigen::VectorXd::Zero(n);
+    std::vector<int> marker(n, -1);
+    for (int j = n - 1; j >= 0; --j) {
+      const int p_begin = outer[j];
+      const int p_end = outer[j + 1];
+      const double l_jj = l[p_begin];
+      for (int q = p_begin + 1; q < p_end; ++q) {
+        l_j(inner[q]) = l[q];
+        marker[inner[q]] = j;
+      }
+      // the rows i >= k of column k of sigma contain those of column j, so
+      // walking them gives sigma(i, k) and, by symmetry, sigma(k, i)
+      for (int q = p_begin + 1; q < p_end; ++q) {
+        const int k = inner[q];
+        for (int t = outer[k]; t < outer[k + 1]; ++t) {
+          const int i = inner[t];
+          if (marker[i] == j) {
+            acc(i) += l[q] * s[t];
+            if (i > k) {
+              acc(k) += l_j(i) * s[t];
+            }
+          }
+        }
+      }
+      double acc_jj = 0;
+      for (int q = p_begin + 1; q < p_end; ++q) {
+        const int i = inner[q];
+        s[q] = -acc(i) / l_jj;
+        acc_jj += l[q] * s[q];
+        acc(i) = 0;
+        l_j(i) = 0;
+      }
+      s[p_begin] = 1.0 / (l_jj * l_jj) - acc_jj / l_jj;
+    }
+    return sigma;
+  }
+
+  /**
+   * Return the entries of the inverse of the factored matrix on the
+   * sparsity pattern of a sparse matrix, which must be contained in the
+   * pattern of the factored matrix.
+   *
+   * @tparam T type of the sparse matrix
+   * @param A sparse matrix giving the pattern, usually the factored matrix
+   * @return sparse matrix with the pattern of <code>A</code>
+   */
+  template <typename T, require_eigen_sparse_base_t<T>* = nullptr>
+  sparse_t inverse_on_pattern(const T& A) const {
+    const sparse_t sigma = selected_inverse();
+    sparse_t inv = A;
+    inv.makeCompressed();
+    const auto& perm = P_.indices();
+    for (Eigen::Index k = 0; k < inv.outerSize(); ++k) {
+      for (sparse_t::InnerIterator it(inv, k); it; ++it) {
+        const int i = perm(it.row());
+        const int j = perm(it.col());
+        it.valueRef() = sigma.valuePtr()[position(std::max(i, j),
+                                                  std::min(i, j))];
+      }
+    }
+    return inv;
+  }
+
+ private:
+  sparse_t L_;
+  permutation_t P_;
+
+  // index of the entry (i, j) in the values of L_, for i >= j in the
+  // sparsity pattern of L_
+  int position(int i, int j) const {
+    const int* begin = L_.innerIndexPtr() + L_.outerIndexPtr()[j];
+    const int* end = L_.innerIndexPtr() + L_.outerIndexPtr()[j + 1];
+    return std::lower_bound(begin, end, i) - L_.innerIndexPtr();
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -13,7 +13,8 @@ namespace math {
  * @param m matrix or expression
  * @return transposed matrix
  */
-template <typename T, require_matrix_t<T>* = nullptr>
+template <typename T, require_matrix_t<T>* = nullptr,
+          require_not_var_sparse_matrix_t<T>* = nullptr>
 auto inline transpose(const T& m) {
   return m.transpose();
 }
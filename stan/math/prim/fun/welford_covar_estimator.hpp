@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_PRIM_FUN_WELFORD_COVAR_ESTIMATOR_HPP
 #define STAN_MATH_PRIM_FUN_WELFORD_COVAR_ESTIMATOR_HPP
 
+#include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <vector>
 
@@ -28,6 +29,44 @@ class welford_covar_estimator {
     m2_ += (q - m_) * delta.transpose();
   }
 
+  /**
+   * Add a block of samples, one per column, with a matrix-matrix update
+   * of the sum of squared deviations.
+   *
+   * @param qs samples, one per column
+   * @throw std::invalid_argument if the number of rows is not the
+   * dimension of the estimator
+   */
+  void add_samples(const Eigen::MatrixXd& qs) {
+    check_size_match("welford_covar_estimator::add_samples", "rows of qs",
+                     qs.rows(), "dimension", m_.size());
+    if (qs.cols() == 0) {
+      return;
+    }
+    const double n_b = qs.cols();
+    const Eigen::VectorXd m_b = qs.rowwise().mean();
+    const Eigen::MatrixXd centered = qs.colwise() - m_b;
+    m2_.noalias() += centered * centered.transpose();
+    combine(n_b, m_b);
+  }
+
+  /**
+   * Add the samples of another estimator of the same dimension, for
+   * example one of a parallel chain, with the pairwise update of Chan,
+   * Golub and LeVeque (1979).
+   *
+   * @param other estimator to merge into this one
+   * @throw std::invalid_argument if the dimensions do not match
+   */
+  void merge(const welford_covar_estimator& other) {
+    check_size_match("welford_covar_estimator::merge", "other dimension",
+                     other.m_.size(), "dimension", m_.size());
+    if (other.num_samples_ > 0) {
+      m2_ += other.m2_;
+      combine(other.num_samples_, other.m_);
+    }
+  }
+
   int num_samples() { return num_samples_; }
 
   void sample_mean(Eigen::VectorXd& mean) { mean = m_; }
@@ -42,6 +81,17 @@ class welford_covar_estimator {
   double num_samples_;
   Eigen::VectorXd m_;
   Eigen::MatrixXd m2_;
+
+  // Chan's update of the mean and the cross term of the sum of squared
+  // deviations for n_b samples with mean m_b; the caller adds the samples'
+  // own sum of squared deviations to m2_
+  void combine(double n_b, const Eigen::VectorXd& m_b) {
+    const double n = num_samples_ + n_b;
+    const Eigen::VectorXd delta = m_b - m_;
+    m_ += delta * (n_b / n);
+    m2_.noalias() += (num_samples_ * n_b / n) * delta * delta.transpose();
+    num_samples_ = n;
+  }
 };
 
 }  // namespace math
@@ -0,0 +1,196 @@
+#ifndef STAN_MATH_PRIM_FUN_WELFORD_LOWRANK_COVAR_ESTIMATOR_HPP
+#define STAN_MATH_PRIM_FUN_WELFORD_LOWRANK_COVAR_ESTIMATOR_HPP
+
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace stan {
+namespace math {
+
+/**
+ * Streaming estimator of a covariance matrix in low-rank plus diagonal
+ * form, using memory proportional to the dimension times the rank.
+ *
+ * The mean and the variances are exact Welford estimates. The sum of
+ * squared deviations is approximated by a frequent directions sketch
+ * (Liberty, 2013) with twice the requested rank, to which each sample
+ * contributes its scaled deviation from the running mean. The estimate of
+ * the covariance is <code>diag(d) + U * U'</code> for the leading
+ * <code>rank</code> directions <code>U</code> of the sketch and the
+ * remaining variance <code>d</code>. If the centered samples span at most
+ * <code>rank</code> dimensions the estimate is exact.
+ *
+ * Like <code>welford_covar_estimator</code>, samples can be added one at
+ * a time or in blocks, and estimators of parallel chains can be merged.
+ */
+class welford_lowrank_covar_estimator {
+ public:
+  welford_lowrank_covar_estimator(int n, int rank) : rank_(rank) {
+    static const char* function = "welford_lowrank_covar_estimator";
+    check_nonnegative(function, "n", n);
+    check_positive(function, "rank", rank);
+    m_.resize(n);
+    m2_diag_.resize(n);
+    sketch_.resize(n, 2 * rank);
+    restart();
+  }
+
+  void restart() {
+    num_samples_ = 0;
+    m_.setZero();
+    m2_diag_.setZero();
+    sketch_.setZero();
+    sketch_cols_ = 0;
+  }
+
+  void add_sample(const Eigen::VectorXd& q) {
+    ++num_samples_;
+
+    Eigen::VectorXd delta(q - m_);
+    m_ += delta / num_samples_;
+    m2_diag_ += delta.cwiseProduct(q - m_);
+    if (num_samples_ > 1) {
+      append(delta * std::sqrt((num_samples_ - 1) / num_samples_));
+    }
+  }
+
+  /**
+   * Add a block of samples, one per column.
+   *
+   * @param qs samples, one per column
+   * @throw std::invalid_argument if the number of rows is not the
+   * dimension of the estimator
+   */
+  void add_samples(const Eigen::MatrixXd& qs) {
+    check_size_match("welford_lowrank_covar_estimator::add_samples",
+                     "rows of qs", qs.rows(), "dimension", m_.size());
+    if (qs.cols() == 0) {
+      return;
+    }
+    const Eigen::VectorXd m_b = qs.rowwise().mean();
+    const Eigen::MatrixXd centered = qs.colwise() - m_b;
+    m2_diag_ += centered.rowwise().squaredNorm();
+    append(centered);
+    combine(qs.cols(), m_b);
+  }
+
+  /**
+   * Add the samples of another estimator of the same dimension and rank,
+   * for example one of a parallel chain. The sketches are concatenated,
+   * together with the deviation of the means of Chan's update.
+   *
+   * @param other estimator to merge into this one
+   * @throw std::invalid_argument if the dimensions or ranks do not match
+   */
+  void merge(const welford_lowrank_covar_estimator& other) {
+    static const char* function = "welford_lowrank_covar_estimator::merge";
+    check_size_match(function, "other dimension", other.m_.size(),
+                     "dimension", m_.size());
+    check_size_match(function, "other rank", other.rank_, "rank", rank_);
+    if (other.num_samples_ > 0) {
+      m2_diag_ += other.m2_diag_;
+      append(other.sketch_.leftCols(other.sketch_cols_));
+      combine(other.num_samples_, other.m_);
+    }
+  }
+
+  int num_samples() { return num_samples_; }
+
+  void sample_mean(Eigen::VectorXd& mean) { mean = m_; }
+
+  void sample_variance(Eigen::VectorXd& var) {
+    if (num_samples_ > 1) {
+      var = m2_diag_ / (num_samples_ - 1.0);
+    }
+  }
+
+  /**
+   * Return the estimate of the covariance matrix as
+   * <code>diag(diag) + factor * factor'</code>.
+   *
+   * @param[out] diag diagonal part, of size <code>n</code>
+   * @param[out] factor low-rank factor, of size <code>n</code> by
+   * <code>rank</code>
+   */
+  void sample_covariance(Eigen::VectorXd& diag, Eigen::MatrixXd& factor) {
+    if (num_samples_ > 1) {
+      const Eigen::Index l = sketch_cols_;
+      const Eigen::Index k = std::min<Eigen::Index>(rank_, l);
+      factor = Eigen::MatrixXd::Zero(m_.size(), rank_);
+      if (k > 0) {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(
+            sketch_.leftCols(l).transpose() * sketch_.leftCols(l));
+        factor.leftCols(k) = sketch_.leftCols(l)
+                             * eig.eigenvectors().rightCols(k).rowwise()
+                                   .reverse()
+                             / std::sqrt(num_samples_ - 1.0);
+      }
+      diag = (m2_diag_ / (num_samples_ - 1.0)
+              - factor.rowwise().squaredNorm())
+                 .cwiseMax(0.0);
+    }
+  }
+
+ protected:
+  int rank_;
+  double num_samples_;
+  Eigen::VectorXd m_;
+  Eigen::VectorXd m2_diag_;
+  Eigen::MatrixXd sketch_;
+  Eigen::Index sketch_cols_;
+
+  // Chan's update of the mean and the sketch for n_b samples with mean m_b,
+  // whose own deviations were already added
+  void combine(double n_b, const Eigen::VectorXd& m_b) {
+    const double n = num_samples_ + n_b;
+    const Eigen::VectorXd delta = m_b - m_;
+    m_ += delta * (n_b / n);
+    if (num_samples_ > 0) {
+      m2_diag_ += (num_samples_ * n_b / n) * delta.cwiseAbs2();
+      append(delta * std::sqrt(num_samples_ * n_b / n));
+    }
+    num_samples_ = n;
+  }
+
+  // add columns to the sketch, shrinking it whenever it is full
+  template <typename Cols>
+  void append(const Cols& cols) {
+    for (Eigen::Index j = 0; j < cols.cols();) {
+      const Eigen::Index n_copy
+          = std::min(cols.cols() - j, sketch_.cols() - sketch_cols_);
+      sketch_.middleCols(sketch_cols_, n_copy) = cols.middleCols(j, n_copy);
+      sketch_cols_ += n_copy;
+      j += n_copy;
+      if (sketch_cols_ == sketch_.cols()) {
+        shrink();
+      }
+    }
+  }
+
+  // shrink the squared singular values of the sketch by the one of index
+  // rank_, which zeros all but the leading rank_ directions
+  void shrink() {
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(sketch_.transpose()
+                                                       * sketch_);
+    const Eigen::VectorXd& lambda = eig.eigenvalues();
+    const Eigen::Index l = sketch_.cols();
+    const double shift = lambda(l - 1 - rank_);
+    Eigen::VectorXd scale(rank_);
+    for (int i = 0; i < rank_; ++i) {
+      const double lambda_i = lambda(l - 1 - i);
+      scale(i) = lambda_i > shift ? std::sqrt((lambda_i - shift) / lambda_i)
+                                  : 0.0;
+    }
+    const Eigen::MatrixXd directions
+        = sketch_ * eig.eigenvectors().rightCols(rank_).rowwise().reverse();
+    sketch_.leftCols(rank_) = directions * scale.asDiagonal();
+    sketch_.rightCols(l - rank_).setZero();
+    sketch_cols_ = rank_;
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
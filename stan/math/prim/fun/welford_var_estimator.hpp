@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_PRIM_FUN_WELFORD_VAR_ESTIMATOR_HPP
 #define STAN_MATH_PRIM_FUN_WELFORD_VAR_ESTIMATOR_HPP
 
+#include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <vector>
 
@@ -28,6 +29,40 @@ class welford_var_estimator {
     m2_ += delta.cwiseProduct(q - m_);
   }
 
+  /**
+   * Add a block of samples, one per column.
+   *
+   * @param qs samples, one per column
+   * @throw std::invalid_argument if the number of rows is not the
+   * dimension of the estimator
+   */
+  void add_samples(const Eigen::MatrixXd& qs) {
+    check_size_match("welford_var_estimator::add_samples", "rows of qs",
+                     qs.rows(), "dimension", m_.size());
+    if (qs.cols() == 0) {
+      return;
+    }
+    const double n_b = qs.cols();
+    const Eigen::VectorXd m_b = qs.rowwise().mean();
+    combine(n_b, m_b, (qs.colwise() - m_b).rowwise().squaredNorm());
+  }
+
+  /**
+   * Add the samples of another estimator of the same dimension, for
+   * example one of a parallel chain, with the pairwise update of Chan,
+   * Golub and LeVeque (1979).
+   *
+   * @param other estimator to merge into this one
+   * @throw std::invalid_argument if the dimensions do not match
+   */
+  void merge(const welford_var_estimator& other) {
+    check_size_match("welford_var_estimator::merge", "other dimension",
+                     other.m_.size(), "dimension", m_.size());
+    if (other.num_samples_ > 0) {
+      combine(other.num_samples_, other.m_, other.m2_);
+    }
+  }
+
   int num_samples() { return num_samples_; }
 
   void sample_mean(Eigen::VectorXd& mean) { mean = m_; }
@@ -42,6 +77,17 @@ class welford_var_estimator {
   double num_samples_;
   Eigen::VectorXd m_;
   Eigen::VectorXd m2_;
+
+  // Chan's update for n_b samples with mean m_b and sum of squared
+  // deviations m2_b
+  template <typename M2>
+  void combine(double n_b, const Eigen::VectorXd& m_b, const M2& m2_b) {
+    const double n = num_samples_ + n_b;
+    const Eigen::VectorXd delta = m_b - m_;
+    m_ += delta * (n_b / n);
+    m2_ += m2_b + (num_samples_ * n_b / n) * delta.cwiseAbs2();
+    num_samples_ = n;
+  }
 };
 
 }  // namespace math
@@ -0,0 +1,170 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_FUSED_LPDF_HPP
+#define STAN_MATH_PRIM_FUNCTOR_FUSED_LPDF_HPP
+
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/meta.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Return the <code>i</code>-th value of an argument of a fused log density
+ * loop. Scalars are broadcast to every index.
+ *
+ * @tparam T scalar type
+ * @param x scalar
+ * @return <code>x</code>
+ */
+template <typename T, require_stan_scalar_t<T>* = nullptr>
+inline const T& fused_value(const T& x, size_t /* i */) {
+  return x;
+}
+
+/**
+ * Return the <code>i</code>-th value of an argument of a fused log density
+ * loop.
+ *
+ * @tparam T type of the Eigen column array or expression
+ * @param x values
+ * @param i index
+ * @return <code>x[i]</code>
+ */
+template <typename T, require_eigen_t<T>* = nullptr>
+inline auto fused_value(const T& x, size_t i) {
+  return x.coeff(i);
+}
+
+/**
+ * Apply a function to an argument of a fused log density loop. A scalar
+ * is transformed once, up front, so that the loop does not recompute the
+ * function for every index.
+ *
+ * @tparam T scalar type
+ * @tparam F type of the function
+ * @param x scalar
+ * @param f function
+ * @return <code>f(x)</code>
+ */
+template <typename T, typename F, require_stan_scalar_t<T>* = nullptr>
+inline auto fused_map(const T& x, const F& f) {
+  return f(x);
+}
+
+/**
+ * Apply a function to an argument of a fused log density loop. For
+ * vectors the function is applied lazily, when the loop reads the
+ * coefficient, so that it does not take a separate pass over the data.
+ *
+ * @tparam T type of the Eigen column array or expression
+ * @tparam F type of the function
+ * @param x values
+ * @param f function
+ * @return unary Eigen expression applying <code>f</code> to <code>x</code>
+ */
+template <typename T, typename F, require_eigen_t<T>* = nullptr>
+inline auto fused_map(const T& x, const F& f) {
+  return x.unaryExpr(f);
+}
+
+/**
+ * Apply a function to an argument of a fused log density loop only when
+ * the loop uses the result, as for the terms of a dropped summand or the
+ * partials of a constant operand. Otherwise return zero, which
+ * <code>fused_value</code> broadcasts, without evaluating the function.
+ *
+ * @tparam Cond whether the loop uses the result
+ * @tparam T type of the scalar, Eigen column array or expression
+ * @tparam F type of the function
+ * @param x values
+ * @param f function
+ * @return <code>fused_map(x, f)</code> if <code>Cond</code>, else zero
+ */
+template <bool Cond, typename T, typename F, std::enable_if_t<Cond>* = nullptr>
+inline auto fused_map_if(const T& x, const F& f) {
+  return fused_map(x, f);
+}
+
+template <bool Cond, typename T, typename F, std::enable_if_t<!Cond>* = nullptr>
+inline double fused_map_if(const T& /* x */, const F& /* f */) {
+  return 0;
+}
+
+/**
+ * Writes the partials computed by a fused log density loop into an edge
+ * of <code>operands_and_partials</code>. This specialization is for
+ * constant operands and discards the partials. The arguments are still
+ * evaluated, so loops guard partials that call special functions with
+ * <code>is_constant_all</code>.
+ *
+ * @tparam T_op type of the operand
+ * @tparam Edge type of the <code>operands_and_partials</code> edge
+ */
+template <typename T_op, typename Edge, typename = void>
+class fused_partials {
+ public:
+  explicit fused_partials(Edge& /* edge */) {}
+  template <typename T>
+  inline void operator()(size_t /* i */, const T& /* d */) {}
+  inline void finish() {}
+};
+
+/**
+ * Specialization for scalar autodiff operands, which sums the partials of
+ * all indices and writes the sum to the edge in <code>finish()</code>.
+ */
+template <typename T_op, typename Edge>
+class fused_partials<T_op, Edge,
+                     std::enable_if_t<!is_constant<T_op>::value
+                                      && is_stan_scalar<T_op>::value>> {
+  Edge& edge_;
+  partials_return_t<T_op> sum_{0};
+
+ public:
+  explicit fused_partials(Edge& edge) : edge_(edge) {}
+  template <typename T>
+  inline void operator()(size_t /* i */, const T& d) {
+    sum_ += d;
+  }
+  inline void finish() { edge_.partials_[0] = sum_; }
+};
+
+/**
+ * Specialization for vector autodiff operands, which stores the partial
+ * of each index directly in the partials of the edge.
+ */
+template <typename T_op, typename Edge>
+class fused_partials<T_op, Edge,
+                     std::enable_if_t<!is_constant<T_op>::value
+                                      && !is_stan_scalar<T_op>::value>> {
+  Edge& edge_;
+
+ public:
+  explicit fused_partials(Edge& edge) : edge_(edge) {}
+  template <typename T>
+  inline void operator()(size_t i, const T& d) {
+    edge_.partials_.coeffRef(i) = d;
+  }
+  inline void finish() {}
+};
+
+/**
+ * Return the writer of the partials of one operand of a fused log density
+ * loop.
+ *
+ * @tparam T_op type of the operand
+ * @tparam Edge type of the <code>operands_and_partials</code> edge
+ * @param edge edge of the operand
+ * @return writer of the partials
+ */
+template <typename T_op, typename Edge>
+inline auto make_fused_partials(Edge& edge) {
+  return fused_partials<T_op, Edge>(edge);
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,179 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_GRAINSIZE_TUNER_HPP
+#define STAN_MATH_PRIM_FUNCTOR_GRAINSIZE_TUNER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Chooses the grainsize of <code>reduce_sum_auto()</code> from the cost
+ * measured on earlier calls.
+ *
+ * The work of a chunk of <code>m</code> terms is modelled as
+ * <code>overhead + m * cost</code>, where the overhead is the time spent
+ * setting up the chunk and collecting its results (in reverse mode
+ * mostly <code>deep_copy_vars()</code> of the shared arguments and
+ * <code>accumulate_adjoints()</code>) and the cost is the time spent per
+ * term in the reduce function, including its reverse pass. Both are
+ * measured by the reducers and folded into running averages after every
+ * call.
+ *
+ * The grainsize is the smallest chunk for which the overhead is at most
+ * <code>MAX_OVERHEAD_FRACTION</code> of the work and which takes at least
+ * <code>MIN_CHUNK_SECONDS</code>, so that TBB scheduling is amortized. It
+ * is capped such that every thread gets a chunk. With the auto
+ * partitioner TBB may still run larger chunks and split them when other
+ * threads steal work.
+ *
+ * Before the first measurement the terms are split into about
+ * <code>INITIAL_CHUNKS_PER_THREAD</code> chunks per thread.
+ *
+ * The tuner is shared by all threads calling <code>reduce_sum_auto()</code>
+ * with the same reduce function and is protected by a mutex.
+ */
+class grainsize_tuner {
+ public:
+  static constexpr double MAX_OVERHEAD_FRACTION = 0.1;
+  static constexpr double MIN_CHUNK_SECONDS = 1e-5;
+  static constexpr size_t INITIAL_CHUNKS_PER_THREAD = 8;
+  // weight of the latest call in the running averages
+  static constexpr double UPDATE_WEIGHT = 0.5;
+
+  /**
+   * Timings accumulated by the reducers of one call.
+   */
+  struct chunk_stats {
+    size_t num_chunks_{0};
+    size_t num_terms_{0};
+    double term_seconds_{0};
+    double overhead_seconds_{0};
+
+    inline void add(const chunk_stats& other) {
+      num_chunks_ += other.num_chunks_;
+      num_terms_ += other.num_terms_;
+      term_seconds_ += other.term_seconds_;
+      overhead_seconds_ += other.overhead_seconds_;
+    }
+  };
+
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * Return the number of seconds elapsed between two time points.
+   */
+  static inline double seconds(const clock::time_point& start,
+                               const clock::time_point& end) {
+    return std::chrono::duration<double>(end - start).count();
+  }
+
+  /**
+   * Return the grainsize for a call with the specified number of terms.
+   *
+   * @param num_terms number of terms of the sum
+   * @param num_threads number of threads available
+   * @return grainsize, at least 1
+   */
+  int grainsize(size_t num_terms, size_t num_threads) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_threads = std::max(num_threads, static_cast<size_t>(1));
+    const double per_thread
+        = std::ceil(static_cast<double>(num_terms) / num_threads);
+    double size;
+    if (num_updates_ == 0 || cost_per_term_ <= 0) {
+      size = std::ceil(per_thread / INITIAL_CHUNKS_PER_THREAD);
+    } else {
+      const double for_overhead = overhead_per_chunk_
+                                  / (MAX_OVERHEAD_FRACTION * cost_per_term_);
+      const double for_scheduling = MIN_CHUNK_SECONDS / cost_per_term_;
+      size = std::min(std::ceil(std::max(for_overhead, for_scheduling)),
+                      per_thread);
+    }
+    return static_cast<int>(std::max(size, 1.0));
+  }
+
+  /**
+   * Fold the timings of a call into the cost estimates.
+   *
+   * @param stats timings of the chunks of the call
+   */
+  void update(const chunk_stats& stats) {
+    if (stats.num_chunks_ == 0 || stats.num_terms_ == 0) {
+      return;
+    }
+    const double cost = stats.term_seconds_ / stats.num_terms_;
+    const double overhead = stats.overhead_seconds_ / stats.num_chunks_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (num_updates_ == 0) {
+      cost_per_term_ = cost;
+      overhead_per_chunk_ = overhead;
+    } else {
+      cost_per_term_ += UPDATE_WEIGHT * (cost - cost_per_term_);
+      overhead_per_chunk_ += UPDATE_WEIGHT * (overhead - overhead_per_chunk_);
+    }
+    ++num_updates_;
+  }
+
+  /**
+   * Forget all measurements.
+   */
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cost_per_term_ = 0;
+    overhead_per_chunk_ = 0;
+    num_updates_ = 0;
+  }
+
+  /**
+   * Return the estimated time per term in seconds.
+   */
+  double cost_per_term() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cost_per_term_;
+  }
+
+  /**
+   * Return the estimated overhead per chunk in seconds.
+   */
+  double overhead_per_chunk() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return overhead_per_chunk_;
+  }
+
+  /**
+   * Return the number of calls measured.
+   */
+  size_t num_updates() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_updates_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  double cost_per_term_{0};
+  double overhead_per_chunk_{0};
+  size_t num_updates_{0};
+};
+
+/**
+ * Return the grainsize tuner used by <code>reduce_sum_auto()</code> for
+ * the specified reduce function.
+ *
+ * @tparam ReduceFunction type of reducer function
+ * @return tuner shared by all calls with this reduce function
+ */
+template <typename ReduceFunction>
+inline grainsize_tuner& reduce_sum_tuner() {
+  static grainsize_tuner tuner;
+  return tuner;
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
+#include <stan/math/prim/functor/grainsize_tuner.hpp>
 
 #include <tbb/task_arena.h>
 #include <tbb/parallel_reduce.h>
@@ -47,10 +48,14 @@ struct reduce_sum_impl<ReduceFunction, require_arithmetic_t<ReturnType>,
     std::stringstream msgs_;
     std::tuple<Args...> args_tuple_;
     return_type_t<Vec, Args...> sum_{0.0};
+    grainsize_tuner* tuner_;
+    grainsize_tuner::chunk_stats stats_;
 
-    recursive_reducer(Vec&& vmapped, std::ostream* msgs, Args&&... args)
+    recursive_reducer(Vec&& vmapped, std::ostream* msgs, grainsize_tuner* tuner,
+                      Args&&... args)
         : vmapped_(std::forward<Vec>(vmapped)),
-          args_tuple_(std::forward<Args>(args)...) {}
+          args_tuple_(std::forward<Args>(args)...),
+          tuner_(tuner) {}
 
     /**
      * This is the copy operator as required for tbb::parallel_reduce
@@ -59,13 +64,17 @@ struct reduce_sum_impl<ReduceFunction, require_arithmetic_t<ReturnType>,
      *   partial sum.
      */
     recursive_reducer(recursive_reducer& other, tbb::split)
-        : vmapped_(other.vmapped_), args_tuple_(other.args_tuple_) {}
+        : vmapped_(other.vmapped_),
+          args_tuple_(other.args_tuple_),
+          tuner_(other.tuner_) {}
 
     /**
      * Compute the value and of `ReduceFunction` over the range defined by r
      *   and accumulate those in member variable sum_. This function may
      *   be called multiple times per object instantiation (so the sum_
-     *   must be accumulated, not just assigned).
+     *   must be accumulated, not just assigned). If a grainsize tuner is
+     *   set, the time spent copying the slice and evaluating the terms is
+     *   accumulated in stats_.
      *
      * @param r Range over which to compute `ReduceFunction`
      */
@@ -74,18 +83,36 @@ struct reduce_sum_impl<ReduceFunction, require_arithmetic_t<ReturnType>,
         return;
       }
 
+      grainsize_tuner::clock::time_point start;
+      if (tuner_) {
+        start = grainsize_tuner::clock::now();
+      }
+
       std::decay_t<Vec> sub_slice;
       sub_slice.reserve(r.size());
       for (size_t i = r.begin(); i < r.end(); ++i) {
         sub_slice.emplace_back(vmapped_[i]);
       }
 
+      grainsize_tuner::clock::time_point copied;
+      if (tuner_) {
+        copied = grainsize_tuner::clock::now();
+      }
+
       sum_ += apply(
           [&](auto&&... args) {
             return ReduceFunction()(sub_slice, r.begin(), r.end() - 1, &msgs_,
                                     args...);
           },
           args_tuple_);
+
+      if (tuner_) {
+        stats_.num_chunks_ += 1;
+        stats_.num_terms_ += r.size();
+        stats_.overhead_seconds_ += grainsize_tuner::seconds(start, copied);
+        stats_.term_seconds_
+            += grainsize_tuner::seconds(copied, grainsize_tuner::clock::now());
+      }
     }
 
     /**
@@ -96,9 +123,22 @@ struct reduce_sum_impl<ReduceFunction, require_arithmetic_t<ReturnType>,
     inline void join(const recursive_reducer& rhs) {
       sum_ += rhs.sum_;
       msgs_ << rhs.msgs_.str();
+      stats_.add(rhs.stats_);
     }
   };
 
+  grainsize_tuner* tuner_{nullptr};
+
+  reduce_sum_impl() = default;
+
+  /**
+   * Construct an implementation which measures the cost of the terms and
+   * reports it to the tuner after every call.
+   *
+   * @param tuner grainsize tuner
+   */
+  explicit reduce_sum_impl(grainsize_tuner* tuner) : tuner_(tuner) {}
+
   /**
    * Call an instance of the function `ReduceFunction` on every element
    *   of an input sequence and sum these terms.
@@ -148,7 +188,7 @@ struct reduce_sum_impl<ReduceFunction, require_arithmetic_t<ReturnType>,
     if (vmapped.empty()) {
       return 0.0;
     }
-    recursive_reducer worker(std::forward<Vec>(vmapped), msgs,
+    recursive_reducer worker(std::forward<Vec>(vmapped), msgs, tuner_,
                              std::forward<Args>(args)...);
 
     if (auto_partitioning) {
@@ -163,6 +203,9 @@ struct reduce_sum_impl<ReduceFunction, require_arithmetic_t<ReturnType>,
     if (msgs) {
       *msgs << worker.msgs_.str();
     }
+    if (tuner_) {
+      tuner_->update(worker.stats_);
+    }
 
     return worker.sum_;
   }
@@ -0,0 +1,71 @@
+#ifndef STAN_MATH_PRIM_FUNCTOR_REDUCE_SUM_AUTO_HPP
+#define STAN_MATH_PRIM_FUNCTOR_REDUCE_SUM_AUTO_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/functor/grainsize_tuner.hpp>
+#include <stan/math/prim/functor/reduce_sum.hpp>
+#include <tbb/task_arena.h>
+
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Call an instance of the function `ReduceFunction` on every element
+ *   of an input sequence and sum these terms, choosing the grainsize
+ *   automatically.
+ *
+ * This defers to reduce_sum_impl for the appropriate implementation
+ *   with auto partitioning. The cost per term and the overhead per chunk
+ *   (copying the shared arguments and collecting their adjoints in
+ *   reverse mode) are measured on every call and the grainsize of the
+ *   next call is chosen from them by the grainsize tuner of
+ *   `ReduceFunction` (see internal::grainsize_tuner). The first call
+ *   splits the terms into a few chunks per thread.
+ *
+ * ReduceFunction must define an operator() with the same signature as:
+ *   T f(Vec&& vmapped_subset, int start, int end, std::ostream* msgs, Args&&...
+ * args)
+ *
+ * `ReduceFunction` must be default constructible without any arguments
+ *
+ * If STAN_THREADS is not defined, do all the work with one ReduceFunction call.
+ *
+ * @tparam ReduceFunction Type of reducer function
+ * @tparam Vec Type of sliced argument
+ * @tparam Args Types of shared arguments
+ * @param vmapped Vector containing one element per term of sum
+ * @param[in, out] msgs The print stream for warning messages
+ * @param args Shared arguments used in every sum term
+ * @return Sum of terms
+ */
+template <typename ReduceFunction, typename Vec,
+          typename = require_vector_like_t<Vec>, typename... Args>
+inline auto reduce_sum_auto(Vec&& vmapped, std::ostream* msgs,
+                            Args&&... args) {
+  using return_type = return_type_t<Vec, Args...>;
+
+#ifdef STAN_THREADS
+  auto& tuner = internal::reduce_sum_tuner<ReduceFunction>();
+  const int grainsize = tuner.grainsize(
+      vmapped.size(), tbb::this_task_arena::max_concurrency());
+  return internal::reduce_sum_impl<ReduceFunction, void, return_type, Vec,
+                                   ref_type_t<Args&&>...>(&tuner)(
+      std::forward<Vec>(vmapped), true, grainsize, msgs,
+      std::forward<Args>(args)...);
+#else
+  if (vmapped.empty()) {
+    return return_type(0.0);
+  }
+
+  return ReduceFunction()(std::forward<Vec>(vmapped), 0, vmapped.size() - 1,
+                          msgs, std::forward<Args>(args)...);
+#endif
+}
+
+}  // namespace math
+}  // namespace stan
+
+#endif
@@ -209,6 +209,7 @@
 #include <stan/math/prim/meta/is_var_dense_dynamic.hpp>
 #include <stan/math/prim/meta/is_var_eigen.hpp>
 #include <stan/math/prim/meta/is_rev_matrix.hpp>
+#include <stan/math/prim/meta/is_sparse_matrix.hpp>
 #include <stan/math/prim/meta/is_vari.hpp>
 #include <stan/math/prim/meta/is_var_or_arithmetic.hpp>
 #include <stan/math/prim/meta/is_vector.hpp>
@@ -0,0 +1,42 @@
+#ifndef STAN_MATH_PRIM_META_IS_SPARSE_MATRIX_HPP
+#define STAN_MATH_PRIM_META_IS_SPARSE_MATRIX_HPP
+
+#include <stan/math/prim/meta/bool_constant.hpp>
+#include <stan/math/prim/meta/conjunction.hpp>
+#include <stan/math/prim/meta/disjunction.hpp>
+#include <stan/math/prim/meta/is_eigen_sparse_base.hpp>
+#include <stan/math/prim/meta/is_var.hpp>
+#include <stan/math/prim/meta/require_helpers.hpp>
+#include <stan/math/prim/meta/value_type.hpp>
+
+namespace stan {
+/**
+ * Check if a type is a `var_value` whose `value_type` is derived from
+ * `Eigen::SparseMatrixBase`
+ * @tparam T type to check.
+ * @ingroup type_trait
+ */
+template <typename T>
+struct is_var_sparse_matrix
+    : bool_constant<math::conjunction<
+          is_var<T>, is_eigen_sparse_base<value_type_t<T>>>::value> {};
+
+STAN_ADD_REQUIRE_UNARY(var_sparse_matrix, is_var_sparse_matrix,
+                       require_eigens_types);
+
+/**
+ * Check if a type is derived from `Eigen::SparseMatrixBase` or is a
+ * `var_value` whose `value_type` is derived from `Eigen::SparseMatrixBase`
+ * @tparam T type to check.
+ * @ingroup type_trait
+ */
+template <typename T>
+struct is_sparse_matrix
+    : bool_constant<math::disjunction<is_eigen_sparse_base<T>,
+                                      is_var_sparse_matrix<T>>::value> {};
+
+STAN_ADD_REQUIRE_UNARY(sparse_matrix, is_sparse_matrix, require_eigens_types);
+
+}  // namespace stan
+
+#endif
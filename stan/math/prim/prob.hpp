@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_PRIM_PROB_HPP
 #define STAN_MATH_PRIM_PROB_HPP
 
+#include <stan/math/prim/prob/batch_rng.hpp>
 #include <stan/math/prim/prob/bernoulli_ccdf_log.hpp>
 #include <stan/math/prim/prob/bernoulli_cdf.hpp>
 #include <stan/math/prim/prob/bernoulli_cdf_log.hpp>
@@ -267,6 +268,7 @@
 #include <stan/math/prim/prob/pareto_type_2_log.hpp>
 #include <stan/math/prim/prob/pareto_type_2_lpdf.hpp>
 #include <stan/math/prim/prob/pareto_type_2_rng.hpp>
+#include <stan/math/prim/prob/philox4x32.hpp>
 #include <stan/math/prim/prob/poisson_binomial_ccdf_log.hpp>
 #include <stan/math/prim/prob/poisson_binomial_cdf.hpp>
 #include <stan/math/prim/prob/poisson_binomial_cdf_log.hpp>
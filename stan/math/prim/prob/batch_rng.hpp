@@ -0,0 +1,122 @@
+#ifndef STAN_MATH_PRIM_PROB_BATCH_RNG_HPP
+#define STAN_MATH_PRIM_PROB_BATCH_RNG_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/constants.hpp>
+#include <stan/math/prim/prob/philox4x32.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <cmath>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Return uniform variates in the open interval (0, 1), drawn one at a time
+ * from a generic random number engine.
+ *
+ * @tparam RNG type of random number generator
+ * @param rng random number generator
+ * @param n number of variates
+ * @return uniform variates
+ */
+template <class RNG>
+inline Eigen::ArrayXd batch_uniform_01(RNG& rng, Eigen::Index n) {
+  boost::random::uniform_real_distribution<double> uniform(0.0, 1.0);
+  Eigen::ArrayXd u(n);
+  for (Eigen::Index i = 0; i < n; ++i) {
+    do {
+      u.coeffRef(i) = uniform(rng);
+    } while (u.coeff(i) == 0.0);
+  }
+  return u;
+}
+
+/**
+ * Return uniform variates in the open interval (0, 1), generated a buffer
+ * at a time by the counter-based engine.
+ *
+ * @param rng random number generator
+ * @param n number of variates
+ * @return uniform variates
+ */
+inline Eigen::ArrayXd batch_uniform_01(philox4x32& rng, Eigen::Index n) {
+  Eigen::ArrayXd u(n);
+  rng.fill_uniform_01(u.data(), n);
+  return u;
+}
+
+/**
+ * Return standard normal variates, transformed from uniform variates in
+ * pairs by the Box-Muller transform with Eigen's vectorized
+ * <code>log</code>, <code>sqrt</code>, <code>cos</code> and
+ * <code>sin</code>.
+ *
+ * @tparam RNG type of random number generator
+ * @param rng random number generator
+ * @param n number of variates
+ * @return standard normal variates
+ */
+template <class RNG>
+inline Eigen::ArrayXd batch_std_normal(RNG& rng, Eigen::Index n) {
+  const Eigen::Index m = (n + 1) / 2;
+  const Eigen::ArrayXd u = batch_uniform_01(rng, 2 * m);
+  const Eigen::ArrayXd r = (-2.0 * u.head(m).log()).sqrt();
+  const Eigen::ArrayXd theta = TWO_PI * u.tail(m);
+  Eigen::ArrayXd z(n);
+  z.head(m) = r * theta.cos();
+  z.tail(n - m) = (r * theta.sin()).head(n - m);
+  return z;
+}
+
+/**
+ * Return gamma variates with unit scale by the squeeze and rejection
+ * method of Marsaglia and Tsang (2000). The candidates of the whole batch
+ * are computed from one batch of normal and one batch of uniform
+ * variates; the rare rejected ones are retried one at a time. Shapes below
+ * one are boosted by a power of a uniform variate.
+ *
+ * @tparam T_shape type of the Eigen array of shapes, or a scalar
+ * @tparam RNG type of random number generator
+ * @param alpha (Sequence of) positive shape parameter(s)
+ * @param rng random number generator
+ * @param n number of variates
+ * @return gamma variates
+ */
+template <typename T_shape, class RNG>
+inline Eigen::ArrayXd batch_gamma(const T_shape& alpha, RNG& rng,
+                                  Eigen::Index n) {
+  const Eigen::ArrayXd alpha_arr = Eigen::ArrayXd::Constant(n, 1.0) * alpha;
+  const Eigen::ArrayXd d = (alpha_arr < 1).select(alpha_arr + 1, alpha_arr)
+                           - 1.0 / 3.0;
+  const Eigen::ArrayXd c = (9 * d).rsqrt();
+  Eigen::ArrayXd z = batch_std_normal(rng, n);
+  Eigen::ArrayXd u = batch_uniform_01(rng, n);
+  Eigen::ArrayXd x(n);
+  for (Eigen::Index i = 0; i < n; ++i) {
+    while (true) {
+      const double v_cbrt = 1 + c.coeff(i) * z.coeff(i);
+      const double v = v_cbrt * v_cbrt * v_cbrt;
+      if (v > 0
+          && std::log(u.coeff(i)) < 0.5 * z.coeff(i) * z.coeff(i)
+                                         + d.coeff(i) - d.coeff(i) * v
+                                         + d.coeff(i) * std::log(v)) {
+        x.coeffRef(i) = d.coeff(i) * v;
+        break;
+      }
+      z.coeffRef(i) = batch_std_normal(rng, 1).coeff(0);
+      u.coeffRef(i) = batch_uniform_01(rng, 1).coeff(0);
+    }
+  }
+  if ((alpha_arr < 1).any()) {
+    const Eigen::ArrayXd boost = batch_uniform_01(rng, n);
+    x = (alpha_arr < 1).select(x * boost.pow(alpha_arr.inverse()), x);
+  }
+  return x;
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
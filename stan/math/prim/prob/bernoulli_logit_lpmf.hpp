@@ -4,14 +4,16 @@
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
-#include <stan/math/prim/fun/as_value_array_or_scalar.hpp>
+#include <stan/math/prim/fun/as_value_column_array_or_scalar.hpp>
 #include <stan/math/prim/fun/exp.hpp>
+#include <stan/math/prim/fun/is_nan.hpp>
 #include <stan/math/prim/fun/log1p.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
 #include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -35,7 +37,6 @@ template <bool propto, typename T_n, typename T_prob,
               T_n, T_prob>* = nullptr>
 return_type_t<T_prob> bernoulli_logit_lpmf(const T_n& n, const T_prob& theta) {
   using T_partials_return = partials_return_t<T_n, T_prob>;
-  using T_partials_array = Eigen::Array<T_partials_return, Eigen::Dynamic, 1>;
   using std::exp;
   using T_n_ref = ref_type_if_t<!is_constant<T_n>::value, T_n>;
   using T_theta_ref = ref_type_if_t<!is_constant<T_prob>::value, T_prob>;
@@ -47,44 +48,58 @@ return_type_t<T_prob> bernoulli_logit_lpmf(const T_n& n, const T_prob& theta) {
   }
   T_n_ref n_ref = n;
   T_theta_ref theta_ref = theta;
-  check_bounded(function, "n", n_ref, 0, 1);
 
+  decltype(auto) n_val = to_ref(as_value_column_array_or_scalar(n_ref));
   decltype(auto) theta_val = to_ref(as_value_column_array_or_scalar(theta_ref));
 
-  check_not_nan(function, "Logit transformed probability parameter", theta_val);
+  auto check_args = [&]() {
+    check_bounded(function, "n", n_ref, 0, 1);
+    check_not_nan(function, "Logit transformed probability parameter",
+                  theta_val);
+  };
   if (!include_summand<propto, T_prob>::value) {
+    check_args();
     return 0.0;
   }
 
-  const auto& n_col = as_column_vector_or_scalar(n_ref);
-  const auto& n_double = value_of_rec(n_col);
+  operands_and_partials<T_theta_ref> ops_partials(theta_ref);
+  auto d_theta
+      = internal::make_fused_partials<T_theta_ref>(ops_partials.edge1_);
 
-  auto signs = to_ref_if<!is_constant<T_prob>::value>(
-      (2 * as_array_or_scalar(n_double) - 1));
-  T_partials_array ntheta;
-  if (is_vector<T_n>::value || is_vector<T_prob>::value) {
-    ntheta = forward_as<T_partials_array>(signs * theta_val);
-  } else {
-    T_partials_return ntheta_s
-        = forward_as<T_partials_return>(signs * theta_val);
-    ntheta = T_partials_array::Constant(1, 1, ntheta_s);
-  }
-  T_partials_array exp_m_ntheta = exp(-ntheta);
+  // Single pass validating the arguments and computing the mass and the
+  // partials, without temporaries for the intermediate terms.
   static const double cutoff = 20.0;
-  T_partials_return logp = sum(
-      (ntheta > cutoff)
-          .select(-exp_m_ntheta,
-                  (ntheta < -cutoff).select(ntheta, -log1p(exp_m_ntheta))));
+  size_t N = max_size(n, theta);
+  T_partials_return logp(0.0);
+  bool valid = true;
+  for (size_t i = 0; i < N; i++) {
+    const auto n_i = internal::fused_value(n_val, i);
+    const T_partials_return theta_i = internal::fused_value(theta_val, i);
+    const bool valid_i
+        = (n_i >= 0) & (n_i <= 1) & !is_nan(value_of_rec(theta_i));
+    if (!valid_i) {
+      valid = false;
+      break;
+    }
 
-  operands_and_partials<T_theta_ref> ops_partials(theta_ref);
-  if (!is_constant_all<T_prob>::value) {
-    ops_partials.edge1_.partials_
-        = (ntheta > cutoff)
-              .select(-exp_m_ntheta,
-                      (ntheta >= -cutoff)
-                          .select(signs * exp_m_ntheta / (exp_m_ntheta + 1),
-                                  signs));
+    const int sign = 2 * n_i - 1;
+    const T_partials_return ntheta = sign * theta_i;
+    const T_partials_return exp_m_ntheta = exp(-ntheta);
+    if (ntheta > cutoff) {
+      logp -= exp_m_ntheta;
+      d_theta(i, -exp_m_ntheta);
+    } else if (ntheta < -cutoff) {
+      logp += ntheta;
+      d_theta(i, sign);
+    } else {
+      logp -= log1p(exp_m_ntheta);
+      d_theta(i, sign * exp_m_ntheta / (exp_m_ntheta + 1));
+    }
+  }
+  if (!valid) {
+    check_args();
   }
+  d_theta.finish();
   return ops_partials.build(logp);
 }
 
@@ -5,6 +5,12 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/scalar_seq_view.hpp>
 #include <stan/math/prim/fun/size.hpp>
+#include <stan/math/prim/fun/as_array_or_scalar.hpp>
+#include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
+#include <stan/math/prim/fun/max_size.hpp>
+#include <stan/math/prim/fun/promote_scalar.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/prob/batch_rng.hpp>
 #include <boost/random/exponential_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 
@@ -47,6 +53,41 @@ inline typename VectorBuilder<true, double, T_inv>::type exponential_rng(
   return output.data();
 }
 
+/** \ingroup prob_dists
+ * Fill a vector with exponential random variates for the given inverse
+ * scale. The variates are generated as one batch, from a buffer of
+ * uniform variates transformed with vectorized arithmetic, so this is
+ * much faster than drawing them one at a time, in particular with the
+ * counter-based <code>philox4x32</code> engine.
+ *
+ * If beta is a vector, it must have the size of the output; otherwise
+ * every element of the output is drawn from the same distribution.
+ *
+ * @tparam T_inv type of inverse scale
+ * @tparam RNG type of random number generator
+ * @tparam EigVec type of the output Eigen vector
+ * @param beta (Sequence of) positive inverse scale parameter(s)
+ * @param rng random number generator
+ * @param[out] out vector to fill with the variates
+ * @throw std::domain_error if beta is nonpositive
+ * @throw std::invalid_argument if beta is a vector of another size than
+ * the output
+ */
+template <typename T_inv, class RNG, typename EigVec,
+          require_eigen_vector_t<EigVec>* = nullptr>
+inline void exponential_rng(const T_inv& beta, RNG& rng, EigVec&& out) {
+  static const char* function = "exponential_rng";
+  const auto beta_dbl = promote_scalar<double>(to_ref(beta));
+  check_positive_finite(function, "Inverse scale parameter", beta_dbl);
+  if (is_vector<T_inv>::value) {
+    check_size_match(function, "Output size", out.size(), "parameter size",
+                     max_size(beta));
+  }
+
+  out.array() = -internal::batch_uniform_01(rng, out.size()).log()
+                / as_array_or_scalar(as_column_vector_or_scalar(beta_dbl));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -9,14 +9,16 @@
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/digamma.hpp>
 #include <stan/math/prim/fun/grad_reg_inc_gamma.hpp>
+#include <stan/math/prim/fun/is_nan.hpp>
 #include <stan/math/prim/fun/lgamma.hpp>
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
-#include <stan/math/prim/fun/scalar_seq_view.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -68,54 +70,84 @@ return_type_t<T_y, T_shape, T_inv_scale> gamma_lpdf(const T_y& y,
   decltype(auto) alpha_val = to_ref(as_value_column_array_or_scalar(alpha_ref));
   decltype(auto) beta_val = to_ref(as_value_column_array_or_scalar(beta_ref));
 
-  check_not_nan(function, "Random variable", y_val);
-  check_positive_finite(function, "Shape parameter", alpha_val);
-  check_positive_finite(function, "Inverse scale parameter", beta_val);
-
-  if (size_zero(y, alpha, beta)) {
-    return 0.0;
-  }
-  if (!include_summand<propto, T_y, T_shape, T_inv_scale>::value) {
+  auto check_args = [&]() {
+    check_not_nan(function, "Random variable", y_val);
+    check_positive_finite(function, "Shape parameter", alpha_val);
+    check_positive_finite(function, "Inverse scale parameter", beta_val);
+  };
+  if (size_zero(y, alpha, beta)
+      || !include_summand<propto, T_y, T_shape, T_inv_scale>::value) {
+    check_args();
     return 0.0;
   }
 
   operands_and_partials<T_y_ref, T_alpha_ref, T_beta_ref> ops_partials(
       y_ref, alpha_ref, beta_ref);
+  auto d_y = internal::make_fused_partials<T_y_ref>(ops_partials.edge1_);
+  auto d_alpha
+      = internal::make_fused_partials<T_alpha_ref>(ops_partials.edge2_);
+  auto d_beta = internal::make_fused_partials<T_beta_ref>(ops_partials.edge3_);
 
-  scalar_seq_view<decltype(y_val)> y_vec(y_val);
-  for (size_t n = 0; n < stan::math::size(y); n++) {
-    if (y_vec[n] < 0) {
-      return LOG_ZERO;
-    }
-  }
+  const auto& log_y = internal::fused_map(
+      y_val, [](const T_partials_return& x) { return log(x); });
+  const auto& lgamma_alpha
+      = internal::fused_map_if<include_summand<propto, T_shape>::value>(
+          alpha_val, [](const T_partials_return& x) { return lgamma(x); });
+  const auto& digamma_alpha
+      = internal::fused_map_if<!is_constant_all<T_shape>::value>(
+          alpha_val, [](const T_partials_return& x) { return digamma(x); });
+  const auto& log_beta = internal::fused_map(
+      beta_val, [](const T_partials_return& x) { return log(x); });
 
+  // Single pass validating the arguments and computing the density and
+  // all partials, without temporaries for the intermediate terms.
   size_t N = max_size(y, alpha, beta);
   T_partials_return logp(0.0);
-  if (include_summand<propto, T_shape>::value) {
-    logp = -sum(lgamma(alpha_val)) * N / size(alpha);
-  }
-  const auto& log_y = to_ref_if<is_constant_all<T_shape>::value>(log(y_val));
-  if (include_summand<propto, T_shape, T_inv_scale>::value) {
-    const auto& log_beta
-        = to_ref_if<!is_constant_all<T_shape>::value>(log(beta_val));
-    logp += sum(alpha_val * log_beta) * N / max_size(alpha, beta);
-    if (!is_constant_all<T_shape>::value) {
-      ops_partials.edge2_.partials_ = log_beta + log_y - digamma(alpha_val);
+  bool valid = true;
+  bool zero = false;
+  for (size_t n = 0; n < N; n++) {
+    const T_partials_return y_n = internal::fused_value(y_val, n);
+    const T_partials_return alpha_n = internal::fused_value(alpha_val, n);
+    const T_partials_return beta_n = internal::fused_value(beta_val, n);
+    const bool valid_i = !is_nan(value_of_rec(y_n)) & (alpha_n > 0)
+                         & std::isfinite(value_of_rec(alpha_n)) & (beta_n > 0)
+                         & std::isfinite(value_of_rec(beta_n));
+    if (!valid_i) {
+      valid = false;
+      break;
     }
-  }
-  if (include_summand<propto, T_y, T_shape>::value) {
-    logp += sum((alpha_val - 1.0) * log_y) * N / max_size(alpha, y);
-  }
-  if (include_summand<propto, T_y, T_inv_scale>::value) {
-    logp -= sum(beta_val * y_val) * N / max_size(beta, y);
-  }
+    zero |= y_n < 0;
 
-  if (!is_constant_all<T_y>::value) {
-    ops_partials.edge1_.partials_ = (alpha_val - 1) / y_val - beta_val;
+    const T_partials_return log_y_n = internal::fused_value(log_y, n);
+    if (include_summand<propto, T_shape>::value) {
+      logp -= internal::fused_value(lgamma_alpha, n);
+    }
+    if (include_summand<propto, T_shape, T_inv_scale>::value) {
+      const T_partials_return log_beta_n = internal::fused_value(log_beta, n);
+      logp += alpha_n * log_beta_n;
+      if (!is_constant_all<T_shape>::value) {
+        d_alpha(n, log_beta_n + log_y_n
+                       - internal::fused_value(digamma_alpha, n));
+      }
+    }
+    if (include_summand<propto, T_y, T_shape>::value) {
+      logp += (alpha_n - 1.0) * log_y_n;
+    }
+    if (include_summand<propto, T_y, T_inv_scale>::value) {
+      logp -= beta_n * y_n;
+    }
+    d_y(n, (alpha_n - 1) / y_n - beta_n);
+    d_beta(n, alpha_n / beta_n - y_n);
+  }
+  if (!valid) {
+    check_args();
   }
-  if (!is_constant_all<T_inv_scale>::value) {
-    ops_partials.edge3_.partials_ = alpha_val / beta_val - y_val;
+  if (zero) {
+    return LOG_ZERO;
   }
+  d_y.finish();
+  d_alpha.finish();
+  d_beta.finish();
   return ops_partials.build(logp);
 }
 
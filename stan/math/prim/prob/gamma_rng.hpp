@@ -5,6 +5,11 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/scalar_seq_view.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
+#include <stan/math/prim/fun/as_array_or_scalar.hpp>
+#include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
+#include <stan/math/prim/fun/promote_scalar.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/prob/batch_rng.hpp>
 #include <boost/random/gamma_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 
@@ -60,6 +65,51 @@ inline typename VectorBuilder<true, double, T_shape, T_inv>::type gamma_rng(
   return output.data();
 }
 
+/** \ingroup prob_dists
+ * Fill a vector with gamma random variates for the given shape and
+ * inverse scale. The candidates of the rejection sampler are generated as
+ * one batch, from buffers of normal and uniform variates, so this is much
+ * faster than drawing the variates one at a time, in particular with the
+ * counter-based <code>philox4x32</code> engine.
+ *
+ * alpha and beta can each be a scalar or a vector. Non-scalar inputs must
+ * have the size of the output; if both are scalars, every element of the
+ * output is drawn from the same distribution.
+ *
+ * @tparam T_shape type of shape parameter
+ * @tparam T_inv type of inverse scale parameter
+ * @tparam RNG type of random number generator
+ * @tparam EigVec type of the output Eigen vector
+ * @param alpha (Sequence of) positive shape parameter(s)
+ * @param beta (Sequence of) positive inverse scale parameter(s)
+ * @param rng random number generator
+ * @param[out] out vector to fill with the variates
+ * @throw std::domain_error if alpha or beta are nonpositive
+ * @throw std::invalid_argument if non-scalar arguments are of different
+ * sizes
+ */
+template <typename T_shape, typename T_inv, class RNG, typename EigVec,
+          require_eigen_vector_t<EigVec>* = nullptr>
+inline void gamma_rng(const T_shape& alpha, const T_inv& beta, RNG& rng,
+                      EigVec&& out) {
+  static const char* function = "gamma_rng";
+  check_consistent_sizes(function, "Shape parameter", alpha,
+                         "Inverse scale Parameter", beta);
+  const auto alpha_dbl = promote_scalar<double>(to_ref(alpha));
+  const auto beta_dbl = promote_scalar<double>(to_ref(beta));
+  check_positive_finite(function, "Shape parameter", alpha_dbl);
+  check_positive_finite(function, "Inverse scale parameter", beta_dbl);
+  if (is_vector<T_shape>::value || is_vector<T_inv>::value) {
+    check_size_match(function, "Output size", out.size(), "parameter size",
+                     max_size(alpha, beta));
+  }
+
+  out.array() = internal::batch_gamma(
+                    as_array_or_scalar(as_column_vector_or_scalar(alpha_dbl)),
+                    rng, out.size())
+                / as_array_or_scalar(as_column_vector_or_scalar(beta_dbl));
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -73,7 +73,8 @@ inline auto hmm_marginal_val(
  */
 template <typename T_omega, typename T_Gamma, typename T_rho,
           require_all_eigen_t<T_omega, T_Gamma>* = nullptr,
-          require_eigen_col_vector_t<T_rho>* = nullptr>
+          require_eigen_col_vector_t<T_rho>* = nullptr,
+          require_all_not_vt_var<T_omega, T_Gamma, T_rho>* = nullptr>
 inline auto hmm_marginal(const T_omega& log_omegas, const T_Gamma& Gamma,
                          const T_rho& rho) {
   using T_partial_type = partials_return_t<T_omega, T_Gamma, T_rho>;
@@ -180,6 +181,43 @@ inline auto hmm_marginal(const T_omega& log_omegas, const T_Gamma& Gamma,
   return ops_partials.build(log_marginal_density);
 }
 
+/**
+ * Return the sum of the log marginal densities of independent sequences
+ * of a hidden Markov model that share the transition matrix Gamma and
+ * the initial state rho. Each sequence has its own log matrix of
+ * observational densities; see the single sequence
+ * <code>hmm_marginal()</code> for the model.
+ *
+ * @tparam T_omega type of the log likelihood matrices
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial guess vector
+ * @param[in] log_omegas log matrices of observational densities, one
+ *            per sequence.
+ * @param[in] Gamma transition density between hidden states.
+ * @param[in] rho initial state
+ * @return sum of the log marginal densities.
+ * @throw `std::invalid_argument` if Gamma is not square, when we have
+ *         at least one transition, or if the size of rho is not the
+ *         number of rows of each log_omegas.
+ * @throw `std::domain_error` if rho is not a simplex and of the rows
+ *         of Gamma are not a simplex (when there is at least one transition).
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho,
+          require_all_eigen_t<T_omega, T_Gamma>* = nullptr,
+          require_eigen_col_vector_t<T_rho>* = nullptr,
+          require_all_not_vt_var<T_omega, T_Gamma, T_rho>* = nullptr>
+inline return_type_t<T_omega, T_Gamma, T_rho> hmm_marginal(
+    const std::vector<T_omega>& log_omegas, const T_Gamma& Gamma,
+    const T_rho& rho) {
+  const auto& Gamma_ref = to_ref(Gamma);
+  const auto& rho_ref = to_ref(rho);
+  return_type_t<T_omega, T_Gamma, T_rho> log_marginal_density(0);
+  for (const auto& log_omega : log_omegas) {
+    log_marginal_density += hmm_marginal(log_omega, Gamma_ref, rho_ref);
+  }
+  return log_marginal_density;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -10,11 +10,12 @@
 #include <stan/math/prim/fun/inv.hpp>
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
-#include <stan/math/prim/fun/promote_scalar.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -43,60 +44,75 @@ return_type_t<T_y, T_loc, T_scale> lognormal_lpdf(const T_y& y, const T_loc& mu,
   decltype(auto) mu_val = to_ref(as_value_column_array_or_scalar(mu_ref));
   decltype(auto) sigma_val = to_ref(as_value_column_array_or_scalar(sigma_ref));
 
-  check_nonnegative(function, "Random variable", y_val);
-  check_finite(function, "Location parameter", mu_val);
-  check_positive_finite(function, "Scale parameter", sigma_val);
-
-  if (size_zero(y, mu, sigma)) {
-    return 0;
-  }
-  if (!include_summand<propto, T_y, T_loc, T_scale>::value) {
+  auto check_args = [&]() {
+    check_nonnegative(function, "Random variable", y_val);
+    check_finite(function, "Location parameter", mu_val);
+    check_positive_finite(function, "Scale parameter", sigma_val);
+  };
+  if (size_zero(y, mu, sigma)
+      || !include_summand<propto, T_y, T_loc, T_scale>::value) {
+    check_args();
     return 0;
   }
 
   operands_and_partials<T_y_ref, T_mu_ref, T_sigma_ref> ops_partials(
       y_ref, mu_ref, sigma_ref);
+  auto d_y = internal::make_fused_partials<T_y_ref>(ops_partials.edge1_);
+  auto d_mu = internal::make_fused_partials<T_mu_ref>(ops_partials.edge2_);
+  auto d_sigma
+      = internal::make_fused_partials<T_sigma_ref>(ops_partials.edge3_);
 
-  if (sum(promote_scalar<int>(y_val == 0))) {
-    return ops_partials.build(LOG_ZERO);
-  }
-
-  const auto& inv_sigma
-      = to_ref_if<!is_constant_all<T_scale>::value>(inv(sigma_val));
-  const auto& inv_sigma_sq
-      = to_ref_if<!is_constant_all<T_y, T_loc, T_scale>::value>(
-          square(inv_sigma));
-  const auto& log_y
-      = to_ref_if<include_summand<propto, T_y>::value>(log(y_val));
-  const auto& logy_m_mu = to_ref(log_y - mu_val);
+  const auto& log_y = internal::fused_map(
+      y_val, [](const T_partials_return& x) { return log(x); });
+  const auto& inv_sigma = internal::fused_map(
+      sigma_val, [](const T_partials_return& x) { return inv(x); });
+  const auto& log_sigma = internal::fused_map(
+      sigma_val, [](const T_partials_return& x) { return log(x); });
 
+  // Single pass validating the arguments and computing the density and
+  // all partials, without temporaries for the intermediate terms.
   size_t N = max_size(y, mu, sigma);
-  T_partials_return logp
-      = N * NEG_LOG_SQRT_TWO_PI - 0.5 * sum(square(logy_m_mu) * inv_sigma_sq);
-  if (include_summand<propto, T_scale>::value) {
-    logp -= sum(log(sigma_val)) * N / size(sigma);
-  }
-  if (include_summand<propto, T_y>::value) {
-    logp -= sum(log_y) * N / size(y);
-  }
-
-  if (!is_constant_all<T_y, T_loc, T_scale>::value) {
-    const auto& logy_m_mu_div_sigma
-        = to_ref_if<!is_constant_all<T_y>::value
-                        + !is_constant_all<T_loc>::value
-                        + !is_constant_all<T_scale>::value
-                    >= 2>(logy_m_mu * inv_sigma_sq);
-    if (!is_constant_all<T_y>::value) {
-      ops_partials.edge1_.partials_ = -(1 + logy_m_mu_div_sigma) / y_val;
+  T_partials_return logp = N * NEG_LOG_SQRT_TWO_PI;
+  bool valid = true;
+  bool zero = false;
+  for (size_t n = 0; n < N; n++) {
+    const T_partials_return y_n = internal::fused_value(y_val, n);
+    const T_partials_return mu_n = internal::fused_value(mu_val, n);
+    const T_partials_return sigma_n = internal::fused_value(sigma_val, n);
+    const bool valid_i = (y_n >= 0) & std::isfinite(value_of_rec(mu_n))
+                         & (sigma_n > 0) & std::isfinite(value_of_rec(sigma_n));
+    if (!valid_i) {
+      valid = false;
+      break;
     }
-    if (!is_constant_all<T_loc>::value) {
-      ops_partials.edge2_.partials_ = logy_m_mu_div_sigma;
+    zero |= y_n == 0;
+
+    const T_partials_return log_y_n = internal::fused_value(log_y, n);
+    const T_partials_return inv_sigma_n = internal::fused_value(inv_sigma, n);
+    const T_partials_return inv_sigma_sq = inv_sigma_n * inv_sigma_n;
+    const T_partials_return logy_m_mu = log_y_n - mu_n;
+    logp -= 0.5 * logy_m_mu * logy_m_mu * inv_sigma_sq;
+    if (include_summand<propto, T_scale>::value) {
+      logp -= internal::fused_value(log_sigma, n);
     }
-    if (!is_constant_all<T_scale>::value) {
-      ops_partials.edge3_.partials_
-          = (logy_m_mu_div_sigma * logy_m_mu - 1) * inv_sigma;
+    if (include_summand<propto, T_y>::value) {
+      logp -= log_y_n;
     }
+
+    const T_partials_return logy_m_mu_div_sigma = logy_m_mu * inv_sigma_sq;
+    d_y(n, -(1 + logy_m_mu_div_sigma) / y_n);
+    d_mu(n, logy_m_mu_div_sigma);
+    d_sigma(n, (logy_m_mu_div_sigma * logy_m_mu - 1) * inv_sigma_n);
+  }
+  if (!valid) {
+    check_args();
+  }
+  if (zero) {
+    return LOG_ZERO;
   }
+  d_y.finish();
+  d_mu.finish();
+  d_sigma.finish();
   return ops_partials.build(logp);
 }
 
@@ -3,17 +3,20 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/as_value_column_array_or_scalar.hpp>
 #include <stan/math/prim/fun/binomial_coefficient_log.hpp>
 #include <stan/math/prim/fun/digamma.hpp>
+#include <stan/math/prim/fun/exp.hpp>
 #include <stan/math/prim/fun/inv.hpp>
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/log1p_exp.hpp>
-#include <stan/math/prim/fun/log_sum_exp.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
-#include <stan/math/prim/fun/scalar_seq_view.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -28,8 +31,6 @@ template <bool propto, typename T_n, typename T_log_location,
 return_type_t<T_log_location, T_precision> neg_binomial_2_log_lpmf(
     const T_n& n, const T_log_location& eta, const T_precision& phi) {
   using T_partials_return = partials_return_t<T_n, T_log_location, T_precision>;
-  using std::exp;
-  using std::log;
   using T_n_ref = ref_type_t<T_n>;
   using T_eta_ref = ref_type_t<T_log_location>;
   using T_phi_ref = ref_type_t<T_precision>;
@@ -42,92 +43,80 @@ return_type_t<T_log_location, T_precision> neg_binomial_2_log_lpmf(
   T_eta_ref eta_ref = eta;
   T_phi_ref phi_ref = phi;
 
-  check_nonnegative(function, "Failures variable", n_ref);
-  check_finite(function, "Log location parameter", eta_ref);
-  check_positive_finite(function, "Precision parameter", phi_ref);
-
-  if (size_zero(n, eta, phi)) {
-    return 0.0;
-  }
-  if (!include_summand<propto, T_log_location, T_precision>::value) {
+  decltype(auto) n_val = to_ref(as_value_column_array_or_scalar(n_ref));
+  decltype(auto) eta_val = to_ref(as_value_column_array_or_scalar(eta_ref));
+  decltype(auto) phi_val = to_ref(as_value_column_array_or_scalar(phi_ref));
+
+  auto check_args = [&]() {
+    check_nonnegative(function, "Failures variable", n_val);
+    check_finite(function, "Log location parameter", eta_val);
+    check_positive_finite(function, "Precision parameter", phi_val);
+  };
+  if (size_zero(n, eta, phi)
+      || !include_summand<propto, T_log_location, T_precision>::value) {
+    check_args();
     return 0.0;
   }
 
-  T_partials_return logp(0.0);
   operands_and_partials<T_eta_ref, T_phi_ref> ops_partials(eta_ref, phi_ref);
-
-  scalar_seq_view<T_n> n_vec(n_ref);
-  scalar_seq_view<T_eta_ref> eta_vec(eta_ref);
-  scalar_seq_view<T_phi_ref> phi_vec(phi_ref);
-  size_t size_eta = stan::math::size(eta);
-  size_t size_phi = stan::math::size(phi);
-  size_t size_eta_phi = max_size(eta, phi);
-  size_t size_n_phi = max_size(n, phi);
+  auto d_eta = internal::make_fused_partials<T_eta_ref>(ops_partials.edge1_);
+  auto d_phi = internal::make_fused_partials<T_phi_ref>(ops_partials.edge2_);
+
+  const auto& exp_eta = internal::fused_map(
+      eta_val, [](const T_partials_return& x) { return exp(x); });
+  const auto& log_phi = internal::fused_map(
+      phi_val, [](const T_partials_return& x) { return log(x); });
+  const auto& digamma_phi
+      = internal::fused_map_if<!is_constant_all<T_precision>::value>(
+          phi_val, [](const T_partials_return& x) { return digamma(x); });
+
+  // Single pass validating the arguments and computing the mass and all
+  // partials, without temporaries for the intermediate terms.
   size_t size_all = max_size(n, eta, phi);
-
-  VectorBuilder<true, T_partials_return, T_log_location> eta_val(size_eta);
-  for (size_t i = 0; i < size_eta; ++i) {
-    eta_val[i] = eta_vec.val(i);
-  }
-
-  VectorBuilder<true, T_partials_return, T_precision> phi_val(size_phi);
-  VectorBuilder<true, T_partials_return, T_precision> log_phi(size_phi);
-  for (size_t i = 0; i < size_phi; ++i) {
-    phi_val[i] = phi_vec.val(i);
-    log_phi[i] = log(phi_val[i]);
-  }
-
-  VectorBuilder<!is_constant_all<T_log_location, T_precision>::value,
-                T_partials_return, T_log_location>
-      exp_eta(size_eta);
-  if (!is_constant_all<T_log_location, T_precision>::value) {
-    for (size_t i = 0; i < size_eta; ++i) {
-      exp_eta[i] = exp(eta_val[i]);
-    }
-  }
-
-  VectorBuilder<!is_constant_all<T_log_location, T_precision>::value,
-                T_partials_return, T_log_location, T_precision>
-      exp_eta_over_exp_eta_phi(size_eta_phi);
-  if (!is_constant_all<T_log_location, T_precision>::value) {
-    for (size_t i = 0; i < size_eta_phi; ++i) {
-      exp_eta_over_exp_eta_phi[i] = inv(phi_val[i] / exp_eta[i] + 1);
+  T_partials_return logp(0.0);
+  bool valid = true;
+  for (size_t i = 0; i < size_all; i++) {
+    const auto n_i = internal::fused_value(n_val, i);
+    const T_partials_return eta_i = internal::fused_value(eta_val, i);
+    const T_partials_return phi_i = internal::fused_value(phi_val, i);
+    const bool valid_i = (n_i >= 0) & std::isfinite(value_of_rec(eta_i))
+                         & (phi_i > 0) & std::isfinite(value_of_rec(phi_i));
+    if (!valid_i) {
+      valid = false;
+      break;
     }
-  }
-
-  VectorBuilder<true, T_partials_return, T_log_location, T_precision>
-      log1p_exp_eta_m_logphi(size_eta_phi);
-  for (size_t i = 0; i < size_eta_phi; ++i) {
-    log1p_exp_eta_m_logphi[i] = log1p_exp(eta_val[i] - log_phi[i]);
-  }
+    const T_partials_return exp_eta_i = internal::fused_value(exp_eta, i);
+    const T_partials_return log_phi_i = internal::fused_value(log_phi, i);
 
-  VectorBuilder<true, T_partials_return, T_n, T_precision> n_plus_phi(
-      size_n_phi);
-  for (size_t i = 0; i < size_n_phi; ++i) {
-    n_plus_phi[i] = n_vec[i] + phi_val[i];
-  }
-
-  for (size_t i = 0; i < size_all; i++) {
+    const T_partials_return log1p_exp_eta_m_logphi
+        = log1p_exp(eta_i - log_phi_i);
+    const T_partials_return n_plus_phi = n_i + phi_i;
     if (include_summand<propto, T_precision>::value) {
-      logp += binomial_coefficient_log(n_plus_phi[i] - 1, n_vec[i]);
+      logp += binomial_coefficient_log(n_plus_phi - 1, n_i);
     }
     if (include_summand<propto, T_log_location>::value) {
-      logp += n_vec[i] * eta_val[i];
+      logp += n_i * eta_i;
     }
-    logp += -phi_val[i] * log1p_exp_eta_m_logphi[i]
-            - n_vec[i] * (log_phi[i] + log1p_exp_eta_m_logphi[i]);
-
-    if (!is_constant_all<T_log_location>::value) {
-      ops_partials.edge1_.partials_[i]
-          += n_vec[i] - n_plus_phi[i] * exp_eta_over_exp_eta_phi[i];
-    }
-    if (!is_constant_all<T_precision>::value) {
-      ops_partials.edge2_.partials_[i]
-          += exp_eta_over_exp_eta_phi[i] - n_vec[i] / (exp_eta[i] + phi_val[i])
-             - log1p_exp_eta_m_logphi[i]
-             - (digamma(phi_val[i]) - digamma(n_plus_phi[i]));
+    logp += -phi_i * log1p_exp_eta_m_logphi
+            - n_i * (log_phi_i + log1p_exp_eta_m_logphi);
+
+    if (!is_constant_all<T_log_location, T_precision>::value) {
+      const T_partials_return exp_eta_over_exp_eta_phi
+          = inv(phi_i / exp_eta_i + 1);
+      d_eta(i, n_i - n_plus_phi * exp_eta_over_exp_eta_phi);
+      if (!is_constant_all<T_precision>::value) {
+        d_phi(i, exp_eta_over_exp_eta_phi - n_i / (exp_eta_i + phi_i)
+                     - log1p_exp_eta_m_logphi
+                     - (internal::fused_value(digamma_phi, i)
+                        - digamma(n_plus_phi)));
+      }
     }
   }
+  if (!valid) {
+    check_args();
+  }
+  d_eta.finish();
+  d_phi.finish();
   return ops_partials.build(logp);
 }
 
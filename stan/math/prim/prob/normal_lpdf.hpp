@@ -7,12 +7,17 @@
 #include <stan/math/prim/fun/as_array_or_scalar.hpp>
 #include <stan/math/prim/fun/as_value_column_array_or_scalar.hpp>
 #include <stan/math/prim/fun/constants.hpp>
+#include <stan/math/prim/fun/inv.hpp>
+#include <stan/math/prim/fun/is_nan.hpp>
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
+#include <stan/math/prim/fun/prepared_data.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -59,50 +64,124 @@ inline return_type_t<T_y, T_loc, T_scale> normal_lpdf(const T_y& y,
   decltype(auto) mu_val = to_ref(as_value_column_array_or_scalar(mu_ref));
   decltype(auto) sigma_val = to_ref(as_value_column_array_or_scalar(sigma_ref));
 
-  check_not_nan(function, "Random variable", y_val);
-  check_finite(function, "Location parameter", mu_val);
-  check_positive(function, "Scale parameter", sigma_val);
-
-  if (size_zero(y, mu, sigma)) {
-    return 0.0;
-  }
-  if (!include_summand<propto, T_y, T_loc, T_scale>::value) {
+  auto check_args = [&]() {
+    check_not_nan(function, "Random variable", y_val);
+    check_finite(function, "Location parameter", mu_val);
+    check_positive(function, "Scale parameter", sigma_val);
+  };
+  if (size_zero(y, mu, sigma)
+      || !include_summand<propto, T_y, T_loc, T_scale>::value) {
+    check_args();
     return 0.0;
   }
 
   operands_and_partials<T_y_ref, T_mu_ref, T_sigma_ref> ops_partials(
       y_ref, mu_ref, sigma_ref);
+  auto d_y = internal::make_fused_partials<T_y_ref>(ops_partials.edge1_);
+  auto d_mu = internal::make_fused_partials<T_mu_ref>(ops_partials.edge2_);
+  auto d_sigma
+      = internal::make_fused_partials<T_sigma_ref>(ops_partials.edge3_);
 
-  const auto& inv_sigma
-      = to_ref_if<!is_constant_all<T_y, T_scale, T_loc>::value>(inv(sigma_val));
-  const auto& y_scaled = to_ref((y_val - mu_val) * inv_sigma);
-  const auto& y_scaled_sq
-      = to_ref_if<!is_constant_all<T_scale>::value>(y_scaled * y_scaled);
+  const auto& inv_sigma = internal::fused_map(
+      sigma_val, [](const T_partials_return& x) { return inv(x); });
+  const auto& log_sigma = internal::fused_map(
+      sigma_val, [](const T_partials_return& x) { return log(x); });
 
+  // Single pass validating the arguments and computing the density and
+  // all partials, without temporaries for the intermediate terms.
   size_t N = max_size(y, mu, sigma);
-  T_partials_return logp = -0.5 * sum(y_scaled_sq);
+  T_partials_return logp(0.0);
+  bool valid = true;
+  for (size_t n = 0; n < N; ++n) {
+    const T_partials_return y_n = internal::fused_value(y_val, n);
+    const T_partials_return mu_n = internal::fused_value(mu_val, n);
+    const T_partials_return sigma_n = internal::fused_value(sigma_val, n);
+    const bool valid_i = !is_nan(value_of_rec(y_n))
+                         & std::isfinite(value_of_rec(mu_n)) & (sigma_n > 0);
+    if (!valid_i) {
+      valid = false;
+      break;
+    }
+    const T_partials_return inv_sigma_n = internal::fused_value(inv_sigma, n);
+
+    const T_partials_return y_scaled = (y_n - mu_n) * inv_sigma_n;
+    const T_partials_return y_scaled_sq = y_scaled * y_scaled;
+    logp -= 0.5 * y_scaled_sq;
+    if (include_summand<propto, T_scale>::value) {
+      logp -= internal::fused_value(log_sigma, n);
+    }
+    const T_partials_return scaled_diff = inv_sigma_n * y_scaled;
+    d_y(n, -scaled_diff);
+    d_mu(n, scaled_diff);
+    d_sigma(n, inv_sigma_n * y_scaled_sq - inv_sigma_n);
+  }
+  if (!valid) {
+    check_args();
+  }
+  d_y.finish();
+  d_mu.finish();
+  d_sigma.finish();
+
   if (include_summand<propto>::value) {
     logp += NEG_LOG_SQRT_TWO_PI * N;
   }
-  if (include_summand<propto, T_scale>::value) {
-    logp -= sum(log(sigma_val)) * N / size(sigma);
+  return ops_partials.build(logp);
+}
+
+/** \ingroup prob_dists
+ * The log of the normal density of prepared data given scalar location
+ * and scale, see <code>prepared_data</code>. The density and its partials
+ * are computed in constant time from the size, the mean and the sum of
+ * squared deviations of the data.
+ *
+ * @tparam T_data type of the data
+ * @tparam T_loc type of location parameter
+ * @tparam T_scale type of scale parameter
+ * @param y prepared data
+ * @param mu location parameter
+ * @param sigma scale parameter
+ * @return The log of the product of the densities.
+ * @throw std::domain_error if the data is NaN, the location is not finite
+ * or the scale is not positive.
+ */
+template <bool propto, typename T_data, typename T_loc, typename T_scale,
+          require_all_stan_scalar_t<T_loc, T_scale>* = nullptr>
+inline return_type_t<T_loc, T_scale> normal_lpdf(
+    const prepared_data<T_data>& y, const T_loc& mu, const T_scale& sigma) {
+  using T_partials_return = partials_return_t<T_loc, T_scale>;
+  static const char* function = "normal_lpdf";
+  const T_partials_return mu_val = value_of(mu);
+  const T_partials_return sigma_val = value_of(sigma);
+  if (y.has_nan()) {
+    check_not_nan(function, "Random variable", y.data());
   }
+  check_finite(function, "Location parameter", mu_val);
+  check_positive(function, "Scale parameter", sigma_val);
 
-  if (!is_constant_all<T_y, T_scale, T_loc>::value) {
-    auto scaled_diff = to_ref_if<!is_constant_all<T_y>::value
-                                     + !is_constant_all<T_scale>::value
-                                     + !is_constant_all<T_loc>::value
-                                 >= 2>(inv_sigma * y_scaled);
-    if (!is_constant_all<T_y>::value) {
-      ops_partials.edge1_.partials_ = -scaled_diff;
-    }
-    if (!is_constant_all<T_scale>::value) {
-      ops_partials.edge3_.partials_ = inv_sigma * y_scaled_sq - inv_sigma;
-    }
-    if (!is_constant_all<T_loc>::value) {
-      ops_partials.edge2_.partials_ = std::move(scaled_diff);
-    }
+  const size_t N = y.size();
+  if (N == 0 || !include_summand<propto, T_loc, T_scale>::value) {
+    return 0.0;
+  }
+
+  operands_and_partials<T_loc, T_scale> ops_partials(mu, sigma);
+  auto d_mu = internal::make_fused_partials<T_loc>(ops_partials.edge1_);
+  auto d_sigma = internal::make_fused_partials<T_scale>(ops_partials.edge2_);
+
+  // sum((y - mu)^2) = sum((y - mean(y))^2) + N (mean(y) - mu)^2
+  const T_partials_return inv_sigma = inv(sigma_val);
+  const T_partials_return diff = y.mean() - mu_val;
+  const T_partials_return sum_sq = y.sum_sq_dev() + N * diff * diff;
+  T_partials_return logp = -0.5 * sum_sq * inv_sigma * inv_sigma;
+  if (include_summand<propto>::value) {
+    logp += NEG_LOG_SQRT_TWO_PI * N;
+  }
+  if (include_summand<propto, T_scale>::value) {
+    logp -= N * log(sigma_val);
   }
+  d_mu(0, N * diff * inv_sigma * inv_sigma);
+  d_sigma(0, sum_sq * inv_sigma * inv_sigma * inv_sigma - N * inv_sigma);
+  d_mu.finish();
+  d_sigma.finish();
   return ops_partials.build(logp);
 }
 
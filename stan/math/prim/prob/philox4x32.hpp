@@ -0,0 +1,201 @@
+#ifndef STAN_MATH_PRIM_PROB_PHILOX4X32_HPP
+#define STAN_MATH_PRIM_PROB_PHILOX4X32_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#ifdef STAN_THREADS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace stan {
+namespace math {
+
+/**
+ * Counter-based Philox4x32-10 random number engine (Salmon et al., 2011,
+ * "Parallel random numbers: as easy as 1, 2, 3").
+ *
+ * The engine encrypts a 128 bit counter with a 64 bit key (the seed),
+ * producing four 32 bit outputs per counter value. The counter is split
+ * into a 64 bit block index and a 64 bit stream number, so that
+ * <code>split(i)</code> returns an independent, reproducible stream, for
+ * example one per thread, and any block of a stream can be computed
+ * directly without generating the ones before it.
+ *
+ * The engine satisfies the requirements of a uniform random bit
+ * generator, so it can be passed to every <code>*_rng</code> function.
+ * <code>fill_uniform_01()</code> generates whole buffers of uniform
+ * variates at once, in parallel with <code>STAN_THREADS</code>, and is
+ * used by the <code>*_rng</code> overloads writing into Eigen vectors.
+ */
+class philox4x32 {
+ public:
+  using result_type = std::uint32_t;
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFF; }
+
+  /**
+   * Construct an engine for the specified seed and stream.
+   *
+   * @param seed seed, the key of the cipher
+   * @param stream stream number
+   */
+  explicit philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0) {
+    this->seed(seed, stream);
+  }
+
+  /**
+   * Reset the engine to the start of the specified stream.
+   *
+   * @param seed seed, the key of the cipher
+   * @param stream stream number
+   */
+  void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+    key_ = {static_cast<std::uint32_t>(seed),
+            static_cast<std::uint32_t>(seed >> 32)};
+    stream_ = stream;
+    block_ = 0;
+    index_ = 4;
+  }
+
+  /**
+   * Return an engine with the same seed positioned at the start of the
+   * specified stream.
+   *
+   * @param stream stream number
+   * @return engine for the stream
+   */
+  philox4x32 split(std::uint64_t stream) const {
+    philox4x32 rng(*this);
+    rng.stream_ = stream;
+    rng.block_ = 0;
+    rng.index_ = 4;
+    return rng;
+  }
+
+  /**
+   * Return the next 32 bit output.
+   */
+  inline result_type operator()() {
+    if (index_ == 4) {
+      buffer_ = generate_block(block_++);
+      index_ = 0;
+    }
+    return buffer_[index_++];
+  }
+
+  /**
+   * Skip the specified number of outputs.
+   *
+   * @param z number of outputs to skip
+   */
+  void discard(unsigned long long z) {
+    for (; z > 0 && index_ < 4; --z) {
+      ++index_;
+    }
+    block_ += z / 4;
+    if (z % 4 != 0) {
+      buffer_ = generate_block(block_++);
+      index_ = z % 4;
+    }
+  }
+
+  /**
+   * Fill a buffer with uniform variates in the open interval (0, 1), each
+   * with 53 random bits from two outputs.
+   *
+   * Generation starts at the next unused block of the stream, skipping
+   * the outputs left in the current block. The blocks are independent, so
+   * with <code>STAN_THREADS</code> large buffers are filled in parallel
+   * with the same result as a serial fill.
+   *
+   * @param out buffer of size at least <code>n</code>
+   * @param n number of variates
+   */
+  void fill_uniform_01(double* out, size_t n) {
+    const size_t n_blocks = (n + 1) / 2;
+    const std::uint64_t first = block_;
+    auto fill = [this, out, n, first](size_t begin, size_t end) {
+      for (size_t b = begin; b < end; ++b) {
+        const std::array<std::uint32_t, 4> r = generate_block(first + b);
+        out[2 * b] = to_uniform_01(r[0], r[1]);
+        if (2 * b + 1 < n) {
+          out[2 * b + 1] = to_uniform_01(r[2], r[3]);
+        }
+      }
+    };
+#ifdef STAN_THREADS
+    if (n_blocks >= 4096) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, n_blocks, 1024),
+                        [&fill](const tbb::blocked_range<size_t>& r) {
+                          fill(r.begin(), r.end());
+                        });
+    } else {
+      fill(0, n_blocks);
+    }
+#else
+    fill(0, n_blocks);
+#endif
+    block_ += n_blocks;
+    index_ = 4;
+  }
+
+  /**
+   * Return the four outputs of the cipher for the specified counter and
+   * key.
+   *
+   * @param ctr counter
+   * @param key key
+   * @return encrypted counter
+   */
+  static inline std::array<std::uint32_t, 4> encrypt(
+      std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> key) {
+    for (int round = 0; round < 10; ++round) {
+      const std::uint64_t p0 = std::uint64_t{0xD2511F53} * ctr[0];
+      const std::uint64_t p1 = std::uint64_t{0xCD9E8D57} * ctr[2];
+      ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+             static_cast<std::uint32_t>(p1),
+             static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+             static_cast<std::uint32_t>(p0)};
+      key[0] += 0x9E3779B9;
+      key[1] += 0xBB67AE85;
+    }
+    return ctr;
+  }
+
+  friend bool operator==(const philox4x32& a, const philox4x32& b) {
+    return a.key_ == b.key_ && a.stream_ == b.stream_ && a.block_ == b.block_
+           && a.index_ == b.index_;
+  }
+
+  friend bool operator!=(const philox4x32& a, const philox4x32& b) {
+    return !(a == b);
+  }
+
+ private:
+  std::array<std::uint32_t, 2> key_;
+  std::uint64_t stream_;
+  std::uint64_t block_;  // next block of the stream to generate
+  std::array<std::uint32_t, 4> buffer_;
+  int index_;  // next output of buffer_, 4 if it is used up
+
+  inline std::array<std::uint32_t, 4> generate_block(
+      std::uint64_t block) const {
+    return encrypt({static_cast<std::uint32_t>(block),
+                    static_cast<std::uint32_t>(block >> 32),
+                    static_cast<std::uint32_t>(stream_),
+                    static_cast<std::uint32_t>(stream_ >> 32)},
+                   key_);
+  }
+
+  static inline double to_uniform_01(std::uint32_t a, std::uint32_t b) {
+    return ((a >> 5) * 67108864.0 + (b >> 6) + 0.5)
+           * (1.0 / 9007199254740992.0);
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
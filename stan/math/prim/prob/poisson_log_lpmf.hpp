@@ -8,14 +8,16 @@
 #include <stan/math/prim/fun/as_value_column_array_or_scalar.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/exp.hpp>
+#include <stan/math/prim/fun/is_nan.hpp>
 #include <stan/math/prim/fun/lgamma.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
-#include <stan/math/prim/fun/promote_scalar.hpp>
-#include <stan/math/prim/fun/scalar_seq_view.hpp>
+#include <stan/math/prim/fun/prepared_data.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -32,7 +34,6 @@ return_type_t<T_log_rate> poisson_log_lpmf(const T_n& n,
   using T_n_ref = ref_type_if_t<!is_constant<T_n>::value, T_n>;
   using T_alpha_ref
       = ref_type_if_t<!is_constant<T_log_rate>::value, T_log_rate>;
-  using std::isinf;
   static const char* function = "poisson_log_lpmf";
   check_consistent_sizes(function, "Random variable", n, "Log rate parameter",
                          alpha);
@@ -43,49 +44,130 @@ return_type_t<T_log_rate> poisson_log_lpmf(const T_n& n,
   decltype(auto) n_val = to_ref(as_value_column_array_or_scalar(n_ref));
   decltype(auto) alpha_val = to_ref(as_value_column_array_or_scalar(alpha_ref));
 
-  check_nonnegative(function, "Random variable", n_val);
-  check_not_nan(function, "Log rate parameter", alpha_val);
-
-  if (size_zero(n, alpha)) {
-    return 0.0;
-  }
-  if (!include_summand<propto, T_log_rate>::value) {
+  auto check_args = [&]() {
+    check_nonnegative(function, "Random variable", n_val);
+    check_not_nan(function, "Log rate parameter", alpha_val);
+  };
+  if (size_zero(n, alpha) || !include_summand<propto, T_log_rate>::value) {
+    check_args();
     return 0.0;
   }
 
-  if (sum(promote_scalar<int>(INFTY == alpha_val))) {
-    return LOG_ZERO;
-  }
+  operands_and_partials<T_alpha_ref> ops_partials(alpha_ref);
+  auto d_alpha
+      = internal::make_fused_partials<T_alpha_ref>(ops_partials.edge1_);
+
+  const auto& exp_alpha = internal::fused_map(
+      alpha_val, [](const T_partials_return& x) { return exp(x); });
+  const auto& lgamma_n_plus_one
+      = internal::fused_map_if<include_summand<propto>::value>(
+          n_val, [](const double& x) { return lgamma(x + 1.0); });
 
+  // Single pass validating the arguments and computing the mass and the
+  // partials, without temporaries for the intermediate terms.
   size_t N = max_size(n, alpha);
-  scalar_seq_view<decltype(n_val)> n_vec(n_val);
-  scalar_seq_view<decltype(alpha_val)> alpha_vec(alpha_val);
+  T_partials_return logp(0.0);
+  bool valid = true;
+  bool zero = false;
   for (size_t i = 0; i < N; i++) {
-    if (NEGATIVE_INFTY == alpha_vec[i] && n_vec[i] != 0) {
-      return LOG_ZERO;
+    const auto n_i = internal::fused_value(n_val, i);
+    const T_partials_return alpha_i = internal::fused_value(alpha_val, i);
+    const bool valid_i = (n_i >= 0) & !is_nan(value_of_rec(alpha_i));
+    if (!valid_i) {
+      valid = false;
+      break;
     }
-  }
+    const T_partials_return exp_alpha_i = internal::fused_value(exp_alpha, i);
+    zero |= (alpha_i == INFTY) | ((alpha_i == NEGATIVE_INFTY) & (n_i != 0));
 
-  operands_and_partials<T_alpha_ref> ops_partials(alpha_ref);
+    logp += n_i * alpha_i - exp_alpha_i;
+    if (include_summand<propto>::value) {
+      logp -= internal::fused_value(lgamma_n_plus_one, i);
+    }
+    d_alpha(i, n_i - exp_alpha_i);
+  }
+  if (!valid) {
+    check_args();
+  }
+  if (zero) {
+    return LOG_ZERO;
+  }
+  d_alpha.finish();
+  return ops_partials.build(logp);
+}
 
-  const auto& exp_alpha
-      = to_ref_if<!is_constant_all<T_log_rate>::value>(exp(alpha_val));
+/** \ingroup prob_dists
+ * The log of the Poisson mass of prepared data given a scalar log rate,
+ * see <code>prepared_data</code>. The mass and its partial are computed in
+ * constant time from the size, the sum and the cached sum of
+ * <code>lgamma(n + 1)</code> of the data.
+ *
+ * @tparam T_data type of the data
+ * @tparam T_log_rate type of log rate parameter
+ * @param n prepared data
+ * @param alpha log rate parameter
+ * @return log probability mass
+ * @throw std::domain_error if the data is negative or the log rate is NaN
+ */
+template <bool propto, typename T_data, typename T_log_rate,
+          require_stan_scalar_t<T_log_rate>* = nullptr>
+inline return_type_t<T_log_rate> poisson_log_lpmf(
+    const prepared_data<T_data>& n, const T_log_rate& alpha) {
+  using T_partials_return = partials_return_t<T_log_rate>;
+  static const char* function = "poisson_log_lpmf";
+  const T_partials_return alpha_val = value_of(alpha);
+  if (n.min() < 0) {
+    check_nonnegative(function, "Random variable", n.data());
+  }
+  check_not_nan(function, "Log rate parameter", alpha_val);
 
-  T_partials_return logp = sum(n_val * alpha_val);
-  if (include_summand<propto, T_log_rate>::value) {
-    logp -= sum(exp_alpha) * N / size(alpha);
+  const size_t N = n.size();
+  if (N == 0 || !include_summand<propto, T_log_rate>::value) {
+    return 0.0;
   }
-  if (include_summand<propto>::value) {
-    logp -= sum(lgamma(n_val + 1.0)) * N / size(n);
+  if (alpha_val == INFTY || (alpha_val == NEGATIVE_INFTY && n.max() > 0)) {
+    return LOG_ZERO;
   }
 
-  if (!is_constant_all<T_log_rate>::value) {
-    ops_partials.edge1_.partials_ = n_val - exp_alpha;
+  operands_and_partials<T_log_rate> ops_partials(alpha);
+  auto d_alpha
+      = internal::make_fused_partials<T_log_rate>(ops_partials.edge1_);
+  const T_partials_return exp_alpha = exp(alpha_val);
+  T_partials_return logp = n.sum() * alpha_val - N * exp_alpha;
+  if (include_summand<propto>::value) {
+    logp -= n.sum_lgamma_plus_one();
   }
-
+  d_alpha(0, n.sum() - N * exp_alpha);
+  d_alpha.finish();
   return ops_partials.build(logp);
 }
 
+/** \ingroup prob_dists
+ * The log of the Poisson mass of prepared data given a vector of log
+ * rates, see <code>prepared_data</code>. The vectorized mass is evaluated
+ * without its data-only summand, which is taken from the prepared data.
+ *
+ * @tparam T_data type of the data
+ * @tparam T_log_rate type of log rate parameter
+ * @param n prepared data
+ * @param alpha log rate parameters
+ * @return log probability mass
+ * @throw std::domain_error if the data is negative or a log rate is NaN
+ */
+template <bool propto, typename T_data, typename T_log_rate,
+          require_not_stan_scalar_t<T_log_rate>* = nullptr>
+inline return_type_t<T_log_rate> poisson_log_lpmf(
+    const prepared_data<T_data>& n, const T_log_rate& alpha) {
+  if (is_constant_all<T_log_rate>::value) {
+    return poisson_log_lpmf<propto>(n.data(), alpha);
+  }
+  return_type_t<T_log_rate> logp = poisson_log_lpmf<true>(n.data(), alpha);
+  if (include_summand<propto>::value) {
+    logp -= n.sum_lgamma_plus_one();
+  }
+  return logp;
+}
+
 template <typename T_n, typename T_log_rate>
 inline return_type_t<T_log_rate> poisson_log_lpmf(const T_n& n,
                                                   const T_log_rate& alpha) {
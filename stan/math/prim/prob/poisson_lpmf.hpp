@@ -11,12 +11,14 @@
 #include <stan/math/prim/fun/lgamma.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
 #include <stan/math/prim/fun/multiply_log.hpp>
+#include <stan/math/prim/fun/prepared_data.hpp>
 #include <stan/math/prim/fun/promote_scalar.hpp>
 #include <stan/math/prim/fun/scalar_seq_view.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
 #include <stan/math/prim/fun/sum.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 
 namespace stan {
@@ -81,6 +83,76 @@ return_type_t<T_rate> poisson_lpmf(const T_n& n, const T_rate& lambda) {
   return ops_partials.build(logp);
 }
 
+/** \ingroup prob_dists
+ * The log of the Poisson mass of prepared data given a scalar rate, see
+ * <code>prepared_data</code>. The mass and its partial are computed in
+ * constant time from the size, the sum and the cached sum of
+ * <code>lgamma(n + 1)</code> of the data.
+ *
+ * @tparam T_data type of the data
+ * @tparam T_rate type of rate parameter
+ * @param n prepared data
+ * @param lambda rate parameter
+ * @return log probability mass
+ * @throw std::domain_error if the data or the rate is negative
+ */
+template <bool propto, typename T_data, typename T_rate,
+          require_stan_scalar_t<T_rate>* = nullptr>
+inline return_type_t<T_rate> poisson_lpmf(const prepared_data<T_data>& n,
+                                          const T_rate& lambda) {
+  using T_partials_return = partials_return_t<T_rate>;
+  static const char* function = "poisson_lpmf";
+  const T_partials_return lambda_val = value_of(lambda);
+  if (n.min() < 0) {
+    check_nonnegative(function, "Random variable", n.data());
+  }
+  check_nonnegative(function, "Rate parameter", lambda_val);
+
+  const size_t N = n.size();
+  if (N == 0 || !include_summand<propto, T_rate>::value) {
+    return 0.0;
+  }
+  if (is_inf(lambda_val) || (lambda_val == 0 && n.max() > 0)) {
+    return LOG_ZERO;
+  }
+
+  operands_and_partials<T_rate> ops_partials(lambda);
+  auto d_lambda = internal::make_fused_partials<T_rate>(ops_partials.edge1_);
+  T_partials_return logp = multiply_log(n.sum(), lambda_val) - N * lambda_val;
+  if (include_summand<propto>::value) {
+    logp -= n.sum_lgamma_plus_one();
+  }
+  d_lambda(0, n.sum() / lambda_val - N);
+  d_lambda.finish();
+  return ops_partials.build(logp);
+}
+
+/** \ingroup prob_dists
+ * The log of the Poisson mass of prepared data given a vector of rates,
+ * see <code>prepared_data</code>. The vectorized mass is evaluated without
+ * its data-only summand, which is taken from the prepared data.
+ *
+ * @tparam T_data type of the data
+ * @tparam T_rate type of rate parameter
+ * @param n prepared data
+ * @param lambda rate parameters
+ * @return log probability mass
+ * @throw std::domain_error if the data or a rate is negative
+ */
+template <bool propto, typename T_data, typename T_rate,
+          require_not_stan_scalar_t<T_rate>* = nullptr>
+inline return_type_t<T_rate> poisson_lpmf(const prepared_data<T_data>& n,
+                                          const T_rate& lambda) {
+  if (is_constant_all<T_rate>::value) {
+    return poisson_lpmf<propto>(n.data(), lambda);
+  }
+  return_type_t<T_rate> logp = poisson_lpmf<true>(n.data(), lambda);
+  if (include_summand<propto>::value) {
+    logp -= n.sum_lgamma_plus_one();
+  }
+  return logp;
+}
+
 template <typename T_n, typename T_rate>
 inline return_type_t<T_rate> poisson_lpmf(const T_n& n, const T_rate& lambda) {
   return poisson_lpmf<false>(n, lambda);
@@ -8,15 +8,17 @@
 #include <stan/math/prim/fun/as_value_column_array_or_scalar.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/digamma.hpp>
+#include <stan/math/prim/fun/is_nan.hpp>
 #include <stan/math/prim/fun/lgamma.hpp>
 #include <stan/math/prim/fun/log.hpp>
 #include <stan/math/prim/fun/log1p.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
 #include <stan/math/prim/fun/size.hpp>
 #include <stan/math/prim/fun/size_zero.hpp>
-#include <stan/math/prim/fun/square.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/fun/value_of_rec.hpp>
+#include <stan/math/prim/functor/fused_lpdf.hpp>
 #include <stan/math/prim/functor/operands_and_partials.hpp>
 #include <cmath>
 
@@ -79,74 +81,101 @@ return_type_t<T_y, T_dof, T_loc, T_scale> student_t_lpdf(const T_y& y,
   decltype(auto) mu_val = to_ref(as_value_column_array_or_scalar(mu_ref));
   decltype(auto) sigma_val = to_ref(as_value_column_array_or_scalar(sigma_ref));
 
-  check_not_nan(function, "Random variable", y_val);
-  check_positive_finite(function, "Degrees of freedom parameter", nu_val);
-  check_finite(function, "Location parameter", mu_val);
-  check_positive_finite(function, "Scale parameter", sigma_val);
-
-  if (size_zero(y, nu, mu, sigma)) {
-    return 0.0;
-  }
-  if (!include_summand<propto, T_y, T_dof, T_loc, T_scale>::value) {
+  auto check_args = [&]() {
+    check_not_nan(function, "Random variable", y_val);
+    check_positive_finite(function, "Degrees of freedom parameter", nu_val);
+    check_finite(function, "Location parameter", mu_val);
+    check_positive_finite(function, "Scale parameter", sigma_val);
+  };
+  if (size_zero(y, nu, mu, sigma)
+      || !include_summand<propto, T_y, T_dof, T_loc, T_scale>::value) {
+    check_args();
     return 0.0;
   }
 
   operands_and_partials<T_y_ref, T_nu_ref, T_mu_ref, T_sigma_ref> ops_partials(
       y_ref, nu_ref, mu_ref, sigma_ref);
+  auto d_y = internal::make_fused_partials<T_y_ref>(ops_partials.edge1_);
+  auto d_nu = internal::make_fused_partials<T_nu_ref>(ops_partials.edge2_);
+  auto d_mu = internal::make_fused_partials<T_mu_ref>(ops_partials.edge3_);
+  auto d_sigma
+      = internal::make_fused_partials<T_sigma_ref>(ops_partials.edge4_);
 
-  const auto& half_nu
-      = to_ref_if<include_summand<propto, T_dof>::value>(0.5 * nu_val);
-  const auto& square_y_scaled = square((y_val - mu_val) / sigma_val);
-  const auto& square_y_scaled_over_nu
-      = to_ref_if<!is_constant_all<T_y, T_dof, T_loc, T_scale>::value>(
-          square_y_scaled / nu_val);
-  const auto& log1p_val = to_ref_if<!is_constant_all<T_dof>::value>(
-      log1p(square_y_scaled_over_nu));
+  const auto& lgamma_nu_terms
+      = internal::fused_map_if<include_summand<propto, T_dof>::value>(
+          nu_val, [](const T_partials_return& x) {
+            return lgamma(0.5 * x + 0.5) - lgamma(0.5 * x) - 0.5 * log(x);
+          });
+  const auto& digamma_nu_terms
+      = internal::fused_map_if<!is_constant_all<T_dof>::value>(
+          nu_val, [](const T_partials_return& x) {
+            return digamma(0.5 * x + 0.5) - digamma(0.5 * x);
+          });
+  const auto& log_sigma = internal::fused_map(
+      sigma_val, [](const T_partials_return& x) { return log(x); });
 
+  // Single pass validating the arguments and computing the density and
+  // all partials, without temporaries for the intermediate terms.
   size_t N = max_size(y, nu, mu, sigma);
-  T_partials_return logp = -sum((half_nu + 0.5) * log1p_val);
-  if (include_summand<propto>::value) {
-    logp -= LOG_SQRT_PI * N;
-  }
-  if (include_summand<propto, T_dof>::value) {
-    logp += (sum(lgamma(half_nu + 0.5)) - sum(lgamma(half_nu))
-             - 0.5 * sum(log(nu_val)))
-            * N / size(nu);
-  }
-  if (include_summand<propto, T_scale>::value) {
-    logp -= sum(log(sigma_val)) * N / size(sigma);
-  }
+  T_partials_return logp(0.0);
+  bool valid = true;
+  for (size_t n = 0; n < N; ++n) {
+    const T_partials_return y_n = internal::fused_value(y_val, n);
+    const T_partials_return nu_n = internal::fused_value(nu_val, n);
+    const T_partials_return mu_n = internal::fused_value(mu_val, n);
+    const T_partials_return sigma_n = internal::fused_value(sigma_val, n);
+    const bool valid_i = !is_nan(value_of_rec(y_n)) & (nu_n > 0)
+                         & std::isfinite(value_of_rec(nu_n))
+                         & std::isfinite(value_of_rec(mu_n)) & (sigma_n > 0)
+                         & std::isfinite(value_of_rec(sigma_n));
+    if (!valid_i) {
+      valid = false;
+      break;
+    }
 
-  if (!is_constant_all<T_y, T_loc>::value) {
-    const auto& square_sigma = square(sigma_val);
-    auto deriv_y_mu = to_ref_if<(!is_constant_all<T_y>::value
-                                 && !is_constant_all<T_loc>::value)>(
-        (nu_val + 1) * (y_val - mu_val)
-        / ((1 + square_y_scaled_over_nu) * square_sigma * nu_val));
-    if (!is_constant_all<T_y>::value) {
-      ops_partials.edge1_.partials_ = -deriv_y_mu;
+    const T_partials_return y_m_mu = y_n - mu_n;
+    const T_partials_return square_y_scaled_over_nu
+        = y_m_mu * y_m_mu / (sigma_n * sigma_n * nu_n);
+    const T_partials_return log1p_val = log1p(square_y_scaled_over_nu);
+    logp -= (0.5 * nu_n + 0.5) * log1p_val;
+    if (include_summand<propto, T_dof>::value) {
+      logp += internal::fused_value(lgamma_nu_terms, n);
     }
-    if (!is_constant_all<T_loc>::value) {
-      ops_partials.edge3_.partials_ = std::move(deriv_y_mu);
+    if (include_summand<propto, T_scale>::value) {
+      logp -= internal::fused_value(log_sigma, n);
     }
-  }
-  if (!is_constant_all<T_dof, T_scale>::value) {
-    const auto& rep_deriv = to_ref_if<(!is_constant_all<T_dof>::value
-                                       && !is_constant_all<T_scale>::value)>(
-        (nu_val + 1) * square_y_scaled_over_nu / (1 + square_y_scaled_over_nu)
-        - 1);
-    if (!is_constant_all<T_dof>::value) {
-      const auto& digamma_half_nu_plus_half = digamma(half_nu + 0.5);
-      const auto& digamma_half_nu = digamma(half_nu);
-      ops_partials.edge2_.partials_
-          = 0.5
-            * (digamma_half_nu_plus_half - digamma_half_nu - log1p_val
-               + rep_deriv / nu_val);
+
+    if (!is_constant_all<T_y, T_loc>::value) {
+      const T_partials_return deriv_y_mu
+          = (nu_n + 1) * y_m_mu
+            / ((1 + square_y_scaled_over_nu) * sigma_n * sigma_n * nu_n);
+      d_y(n, -deriv_y_mu);
+      d_mu(n, deriv_y_mu);
     }
-    if (!is_constant_all<T_scale>::value) {
-      ops_partials.edge4_.partials_ = rep_deriv / sigma_val;
+    if (!is_constant_all<T_dof, T_scale>::value) {
+      const T_partials_return rep_deriv
+          = (nu_n + 1) * square_y_scaled_over_nu
+                / (1 + square_y_scaled_over_nu)
+            - 1;
+      if (!is_constant_all<T_dof>::value) {
+        d_nu(n, 0.5
+                    * (internal::fused_value(digamma_nu_terms, n) - log1p_val
+                       + rep_deriv / nu_n));
+      }
+      d_sigma(n, rep_deriv / sigma_n);
     }
   }
+  if (!valid) {
+    check_args();
+  }
+  d_y.finish();
+  d_nu.finish();
+  d_mu.finish();
+  d_sigma.finish();
+
+  if (include_summand<propto>::value) {
+    logp -= LOG_SQRT_PI * N;
+  }
   return ops_partials.build(logp);
 }
 
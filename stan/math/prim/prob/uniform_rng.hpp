@@ -3,10 +3,15 @@
 
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/as_array_or_scalar.hpp>
+#include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/max_size.hpp>
+#include <stan/math/prim/fun/promote_scalar.hpp>
 #include <stan/math/prim/fun/scalar_seq_view.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/prob/batch_rng.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
 #include <boost/random/variate_generator.hpp>
 
@@ -61,6 +66,54 @@ inline typename VectorBuilder<true, double, T_alpha, T_beta>::type uniform_rng(
   return output.data();
 }
 
+/** \ingroup prob_dists
+ * Fill a vector with uniform random variates for the given lower and
+ * upper bounds. The variates are generated as one batch, so this is much
+ * faster than drawing them one at a time, in particular with the
+ * counter-based <code>philox4x32</code> engine.
+ *
+ * alpha and beta can each be a scalar or a vector. Non-scalar inputs must
+ * have the size of the output; if both are scalars, every element of the
+ * output is drawn from the same distribution.
+ *
+ * @tparam T_alpha type of the lower bound
+ * @tparam T_beta type of the upper bound
+ * @tparam RNG type of random number generator
+ * @tparam EigVec type of the output Eigen vector
+ * @param alpha (Sequence of) lower bound parameter(s)
+ * @param beta (Sequence of) upper bound parameter(s)
+ * @param rng random number generator
+ * @param[out] out vector to fill with the variates
+ * @throw std::domain_error if alpha or beta are non-finite or beta is less
+ * than alpha
+ * @throw std::invalid_argument if non-scalar arguments are of different
+ * sizes
+ */
+template <typename T_alpha, typename T_beta, class RNG, typename EigVec,
+          require_eigen_vector_t<EigVec>* = nullptr>
+inline void uniform_rng(const T_alpha& alpha, const T_beta& beta, RNG& rng,
+                        EigVec&& out) {
+  static const char* function = "uniform_rng";
+  check_consistent_sizes(function, "Lower bound parameter", alpha,
+                         "Upper bound parameter", beta);
+  const auto alpha_dbl = promote_scalar<double>(to_ref(alpha));
+  const auto beta_dbl = promote_scalar<double>(to_ref(beta));
+  check_finite(function, "Lower bound parameter", alpha_dbl);
+  check_finite(function, "Upper bound parameter", beta_dbl);
+  check_greater(function, "Upper bound parameter", beta_dbl, alpha_dbl);
+  if (is_vector<T_alpha>::value || is_vector<T_beta>::value) {
+    check_size_match(function, "Output size", out.size(), "parameter size",
+                     max_size(alpha, beta));
+  }
+
+  const auto& alpha_arr
+      = as_array_or_scalar(as_column_vector_or_scalar(alpha_dbl));
+  out.array() = alpha_arr
+                + (as_array_or_scalar(as_column_vector_or_scalar(beta_dbl))
+                   - alpha_arr)
+                      * internal::batch_uniform_01(rng, out.size());
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -15,13 +15,14 @@ struct arena_allocator {
   using value_type = T;
 
   /**
-   * Allocates space for `n` items of type `T`.
+   * Allocates space for `n` items of type `T`, aligned as required by `T`
+   * (for example fixed size vectorizable Eigen types).
    *
    * @param n number of items to allocate space for
    * @return pointer to allocated space
    */
   T* allocate(std::size_t n) {
-    return ChainableStack::instance_->memalloc_.alloc_array<T>(n);
+    return ChainableStack::instance_->memalloc_.alloc_array<T, alignof(T)>(n);
   }
 
   /**
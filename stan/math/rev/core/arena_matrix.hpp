@@ -12,6 +12,10 @@ namespace math {
  * Equivalent to `Eigen::Matrix`, except that the data is stored on AD stack.
  * That makes these objects triviali destructible and usable in `vari`s.
  *
+ * Storage allocated by `arena_matrix` starts on a cache line boundary, so
+ * that vectorized Eigen kernels operating on it do not straddle cache
+ * lines.
+ *
  * @tparam MatrixType Eigen matrix type this works as (`MatrixXd`, `VectorXd`
  * ...)
  */
@@ -39,9 +43,7 @@ class arena_matrix : public Eigen::Map<MatrixType> {
    * @param cols number of columns
    */
   arena_matrix(Eigen::Index rows, Eigen::Index cols)
-      : Base::Map(ChainableStack::instance_->memalloc_.alloc_array<Scalar>(
-                      rows * cols),
-                  rows, cols) {}
+      : Base::Map(allocate(rows * cols), rows, cols) {}
 
   /**
    * Constructs `arena_matrix` with given size. This only works if
@@ -49,9 +51,7 @@ class arena_matrix : public Eigen::Map<MatrixType> {
    * @param size number of elements
    */
   explicit arena_matrix(Eigen::Index size)
-      : Base::Map(
-            ChainableStack::instance_->memalloc_.alloc_array<Scalar>(size),
-            size) {}
+      : Base::Map(allocate(size), size) {}
 
   /**
    * Constructs `arena_matrix` from an expression.
@@ -60,8 +60,7 @@ class arena_matrix : public Eigen::Map<MatrixType> {
   template <typename T, require_eigen_t<T>* = nullptr>
   arena_matrix(const T& other)  // NOLINT
       : Base::Map(
-            ChainableStack::instance_->memalloc_.alloc_array<Scalar>(
-                other.size()),
+            allocate(other.size()),
             (RowsAtCompileTime == 1 && T::ColsAtCompileTime == 1)
                     || (ColsAtCompileTime == 1 && T::RowsAtCompileTime == 1)
                 ? other.cols()
@@ -116,18 +115,25 @@ class arena_matrix : public Eigen::Map<MatrixType> {
     if ((RowsAtCompileTime == 1 && T::ColsAtCompileTime == 1)
         || (ColsAtCompileTime == 1 && T::RowsAtCompileTime == 1)) {
       // placement new changes what data map points to - there is no allocation
-      new (this) Base(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(a.size()),
-          a.cols(), a.rows());
+      new (this) Base(allocate(a.size()), a.cols(), a.rows());
 
     } else {
-      new (this) Base(
-          ChainableStack::instance_->memalloc_.alloc_array<Scalar>(a.size()),
-          a.rows(), a.cols());
+      new (this) Base(allocate(a.size()), a.rows(), a.cols());
     }
     Base::operator=(a);
     return *this;
   }
+
+ private:
+  /**
+   * Allocates cache line aligned space for `size` scalars on the AD stack.
+   * @param size number of scalars
+   * @return pointer to allocated space
+   */
+  static Scalar* allocate(Eigen::Index size) {
+    return ChainableStack::instance_->memalloc_
+        .alloc_array<Scalar, internal::BLOCK_ALIGN_NBYTES>(size);
+  }
 };
 
 }  // namespace math
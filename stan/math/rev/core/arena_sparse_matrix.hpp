@@ -0,0 +1,161 @@
+#ifndef STAN_MATH_REV_CORE_ARENA_SPARSE_MATRIX_HPP
+#define STAN_MATH_REV_CORE_ARENA_SPARSE_MATRIX_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/var.hpp>
+#include <algorithm>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Return a compressed copy of a sparse matrix of doubles whose values and
+ * indices are stored in the arena, so that it can be captured by the
+ * reverse pass callback of a sparse kernel.
+ *
+ * @tparam T type of the sparse matrix or expression
+ * @param x sparse matrix
+ * @return map of the copy in the arena
+ */
+template <typename T, require_eigen_sparse_base_t<T>* = nullptr>
+inline Eigen::Map<const Eigen::SparseMatrix<double>> to_arena_sparse(
+    const T& x) {
+  Eigen::SparseMatrix<double> x_c(x);
+  x_c.makeCompressed();
+  auto& memalloc = ChainableStack::instance_->memalloc_;
+  int* outer = memalloc.alloc_array<int>(x_c.outerSize() + 1);
+  int* inner = memalloc.alloc_array<int>(x_c.nonZeros());
+  double* values = memalloc.alloc_array<double>(x_c.nonZeros());
+  std::copy_n(x_c.outerIndexPtr(), x_c.outerSize() + 1, outer);
+  std::copy_n(x_c.innerIndexPtr(), x_c.nonZeros(), inner);
+  std::copy_n(x_c.valuePtr(), x_c.nonZeros(), values);
+  return Eigen::Map<const Eigen::SparseMatrix<double>>(
+      x_c.rows(), x_c.cols(), x_c.nonZeros(), outer, inner, values);
+}
+
+/**
+ * Return a sparse matrix variable, whose value and adjoint are already
+ * kept until the memory of the autodiff stack is recovered.
+ *
+ * @param x sparse matrix variable
+ * @return <code>x</code>
+ */
+inline const var_value<Eigen::SparseMatrix<double>>& to_arena_sparse(
+    const var_value<Eigen::SparseMatrix<double>>& x) {
+  return x;
+}
+
+/**
+ * Return the value of a sparse matrix variable.
+ *
+ * @param x sparse matrix variable
+ * @return value of <code>x</code>
+ */
+inline const Eigen::SparseMatrix<double>& sparse_value_of(
+    const var_value<Eigen::SparseMatrix<double>>& x) {
+  return x.val();
+}
+
+/**
+ * Return a constant sparse matrix.
+ *
+ * @param x sparse matrix in the arena
+ * @return <code>x</code>
+ */
+inline const Eigen::Map<const Eigen::SparseMatrix<double>>& sparse_value_of(
+    const Eigen::Map<const Eigen::SparseMatrix<double>>& x) {
+  return x;
+}
+
+/**
+ * Add <code>f(i, j, x_ij)</code> to the adjoint of each nonzero
+ * <code>x_ij</code> of a sparse matrix variable. The adjoint has the
+ * sparsity pattern of the value, so no other coefficient is touched.
+ *
+ * @tparam F type of the functor
+ * @param x sparse matrix variable
+ * @param f functor returning the adjoint increment
+ */
+template <typename F>
+inline void add_sparse_adjoints(
+    const var_value<Eigen::SparseMatrix<double>>& x, F&& f) {
+  using sparse_t = Eigen::SparseMatrix<double>;
+  const sparse_t& val = x.val();
+  sparse_t& adj = x.adj();
+  for (Eigen::Index k = 0; k < adj.outerSize(); ++k) {
+    sparse_t::InnerIterator it_val(val, k);
+    for (sparse_t::InnerIterator it(adj, k); it; ++it, ++it_val) {
+      it.valueRef() += f(it.row(), it.col(), it_val.value());
+    }
+  }
+}
+
+/**
+ * Constant sparse matrices have no adjoints, so this is a no-op.
+ */
+template <typename F>
+inline void add_sparse_adjoints(
+    const Eigen::Map<const Eigen::SparseMatrix<double>>& /* x */,
+    F&& /* f */) {}
+
+/**
+ * Add the coefficients of a sparse matrix to the adjoint of a sparse
+ * matrix variable, restricted to the sparsity pattern of the variable.
+ * Coefficients outside of the pattern are dropped.
+ *
+ * @param x sparse matrix variable
+ * @param y column major sparse matrix of the same size
+ */
+inline void add_sparse_adjoints_on_pattern(
+    const var_value<Eigen::SparseMatrix<double>>& x,
+    const Eigen::SparseMatrix<double>& y) {
+  using sparse_t = Eigen::SparseMatrix<double>;
+  sparse_t& adj = x.adj();
+  for (Eigen::Index k = 0; k < adj.outerSize(); ++k) {
+    sparse_t::InnerIterator it_y(y, k);
+    for (sparse_t::InnerIterator it(adj, k); it; ++it) {
+      while (it_y && it_y.index() < it.index()) {
+        ++it_y;
+      }
+      if (it_y && it_y.index() == it.index()) {
+        it.valueRef() += it_y.value();
+      }
+    }
+  }
+}
+
+/**
+ * Constant sparse matrices have no adjoints, so this is a no-op.
+ */
+inline void add_sparse_adjoints_on_pattern(
+    const Eigen::Map<const Eigen::SparseMatrix<double>>& /* x */,
+    const Eigen::SparseMatrix<double>& /* y */) {}
+
+/**
+ * Add to the adjoint of a dense matrix of variables or a dense matrix
+ * variable.
+ *
+ * @tparam T type of the arena matrix
+ * @tparam S type of the increment
+ * @param x dense matrix of variables
+ * @param y increment of the adjoint
+ */
+template <typename T, typename S, require_rev_matrix_t<T>* = nullptr>
+inline void add_dense_adjoints(T& x, const S& y) {
+  x.adj() += y;
+}
+
+/**
+ * Constant dense matrices have no adjoints, so this is a no-op and does
+ * not evaluate the increment.
+ */
+template <typename T, typename S, require_st_arithmetic<T>* = nullptr>
+inline void add_dense_adjoints(T& /* x */, const S& /* y */) {}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_AUTODIFFSTACKSTORAGE_HPP
 
 #include <stan/math/memory/stack_alloc.hpp>
+#include <stan/math/rev/core/tape_op.hpp>
 #include <vector>
 
 namespace stan {
@@ -104,12 +105,17 @@ struct AutodiffStackSingleton {
     std::vector<ChainableT *> var_stack_;
     std::vector<ChainableT *> var_nochain_stack_;
     std::vector<ChainableAllocT *> var_alloc_stack_;
+    std::vector<tape_op> op_stack_;
     stack_alloc memalloc_;
 
+    // record comparisons of vars on the op stack (see retaped_gradient)
+    bool record_branches_{false};
+
     // nested positions
     std::vector<size_t> nested_var_stack_sizes_;
     std::vector<size_t> nested_var_nochain_stack_sizes_;
     std::vector<size_t> nested_var_alloc_stack_starts_;
+    std::vector<size_t> nested_op_stack_sizes_;
   };
 
   explicit AutodiffStackSingleton(AutodiffStackSingleton_t const &) = delete;
@@ -0,0 +1,191 @@
+#ifndef STAN_MATH_REV_CORE_CHAIN_HISTOGRAM_HPP
+#define STAN_MATH_REV_CORE_CHAIN_HISTOGRAM_HPP
+
+#include <stan/math/rev/core/tape_op.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <stan/math/rev/core/vari_type_name.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#ifndef STAN_CHAIN_HISTOGRAM_SAMPLE_PERIOD
+#define STAN_CHAIN_HISTOGRAM_SAMPLE_PERIOD 1
+#endif
+
+namespace stan {
+namespace math {
+
+/**
+ * Row of the reverse pass histogram: the number of <code>chain()</code>
+ * calls of one dynamic vari type (or op tape record) and their
+ * cumulative time.
+ */
+struct chain_histogram_entry {
+  std::string type_;
+  size_t calls_;
+  double seconds_;
+};
+
+namespace internal {
+
+/**
+ * Counters of the reverse pass histogram of one thread.
+ */
+struct chain_histogram_counters {
+  struct counter {
+    size_t calls_{0};
+    size_t timed_calls_{0};
+    double seconds_{0};
+  };
+  std::unordered_map<std::type_index, counter> varis_;
+  counter ops_[3];  // per op_code
+  size_t num_calls_{0};
+
+  /**
+   * Return the counters of the calling thread.
+   */
+  static chain_histogram_counters& instance() {
+    static thread_local chain_histogram_counters counters;
+    return counters;
+  }
+};
+
+/**
+ * Call <code>f</code> and add the call to <code>c</code>. Every
+ * <code>STAN_CHAIN_HISTOGRAM_SAMPLE_PERIOD</code>-th call is timed.
+ */
+template <typename F>
+inline void count_chain(chain_histogram_counters& counters,
+                        chain_histogram_counters::counter& c, F&& f) {
+  c.calls_++;
+  if (counters.num_calls_++ % STAN_CHAIN_HISTOGRAM_SAMPLE_PERIOD != 0) {
+    f();
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  c.seconds_ += std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  c.timed_calls_++;
+}
+
+}  // namespace internal
+
+/**
+ * Call the <code>chain()</code> method of a vari in the reverse pass.
+ *
+ * With <code>STAN_CHAIN_HISTOGRAM</code> defined, the call is counted and
+ * timed per dynamic vari type for <code>chain_histogram()</code>.
+ * Otherwise this is just the virtual call.
+ *
+ * @param vi vari to chain
+ */
+inline void chain_vari(vari_base* vi) {
+#ifdef STAN_CHAIN_HISTOGRAM
+  auto& counters = internal::chain_histogram_counters::instance();
+  internal::count_chain(counters, counters.varis_[typeid(*vi)],
+                        [vi]() { vi->chain(); });
+#else
+  vi->chain();
+#endif
+}
+
+/**
+ * Chain a record of the op tape in the reverse pass, counting it for
+ * <code>chain_histogram()</code> if <code>STAN_CHAIN_HISTOGRAM</code> is
+ * defined.
+ *
+ * @param op record to chain
+ */
+inline void chain_tape_op(const tape_op& op) {
+#ifdef STAN_CHAIN_HISTOGRAM
+  auto& counters = internal::chain_histogram_counters::instance();
+  internal::count_chain(counters,
+                        counters.ops_[static_cast<unsigned int>(op.code_)],
+                        [&op]() { op.chain(); });
+#else
+  op.chain();
+#endif
+}
+
+/**
+ * Return the number of <code>chain()</code> calls and their cumulative
+ * time per dynamic vari type in the reverse passes run by this thread
+ * since the last <code>reset_chain_histogram()</code>, sorted by
+ * decreasing time. If every call is not timed (see
+ * <code>STAN_CHAIN_HISTOGRAM_SAMPLE_PERIOD</code>), the time is
+ * extrapolated from the timed calls.
+ *
+ * The histogram is only collected if Stan Math is compiled with
+ * <code>STAN_CHAIN_HISTOGRAM</code> defined; otherwise it is empty.
+ *
+ * @return histogram rows
+ */
+inline std::vector<chain_histogram_entry> chain_histogram() {
+  std::vector<chain_histogram_entry> rows;
+  const auto& counters = internal::chain_histogram_counters::instance();
+  auto add_row = [&rows](std::string type,
+                         const internal::chain_histogram_counters::counter& c) {
+    if (c.calls_ == 0) {
+      return;
+    }
+    const double seconds
+        = c.timed_calls_ == 0 ? 0.0 : c.seconds_ * c.calls_ / c.timed_calls_;
+    rows.push_back({std::move(type), c.calls_, seconds});
+  };
+  for (const auto& v : counters.varis_) {
+    add_row(internal::vari_type_name(v.first), v.second);
+  }
+  add_row("stan::math::tape_op (v)", counters.ops_[0]);
+  add_row("stan::math::tape_op (vv)", counters.ops_[1]);
+  add_row("stan::math::tape_op (branch)", counters.ops_[2]);
+  std::sort(rows.begin(), rows.end(),
+            [](const chain_histogram_entry& a, const chain_histogram_entry& b) {
+              return a.seconds_ > b.seconds_
+                     || (a.seconds_ == b.seconds_ && a.calls_ > b.calls_);
+            });
+  return rows;
+}
+
+/**
+ * Clear the reverse pass histogram of this thread.
+ */
+inline void reset_chain_histogram() {
+  internal::chain_histogram_counters::instance()
+      = internal::chain_histogram_counters();
+}
+
+/**
+ * Print the reverse pass histogram of this thread as a table with the
+ * share of time, the time in seconds, the number of calls and the vari
+ * type per row. This function is used for debugging purposes.
+ *
+ * @param o ostream to modify
+ */
+inline void print_chain_histogram(std::ostream& o) {
+  const auto rows = chain_histogram();
+  double total = 0;
+  for (const auto& row : rows) {
+    total += row.seconds_;
+  }
+  o << "CHAIN HISTOGRAM, types=" << rows.size() << std::endl;
+  for (const auto& row : rows) {
+    o << std::setw(6) << std::fixed << std::setprecision(1)
+      << (total > 0 ? 100 * row.seconds_ / total : 0.0) << "% "
+      << std::setw(12) << std::scientific << std::setprecision(3)
+      << row.seconds_ << "s " << std::setw(12) << row.calls_ << "  "
+      << row.type_ << std::endl;
+  }
+  o << std::defaultfloat;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
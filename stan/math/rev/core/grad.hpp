@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_GRAD_HPP
 
 #include <stan/math/rev/core/chainable_alloc.hpp>
+#include <stan/math/rev/core/chain_histogram.hpp>
 #include <stan/math/rev/core/chainablestack.hpp>
 #include <stan/math/rev/core/empty_nested.hpp>
 #include <stan/math/rev/core/nested_size.hpp>
@@ -22,12 +23,40 @@ namespace math {
  *
  * <p>This function does not recover any memory from the computation.
  *
+ * <p>If the op stack holds records (see <code>tape_op</code>), they are
+ * swept in the same loop, each record being chained right before the
+ * vari that preceded it on the var stack.
+ *
+ * <p>With <code>STAN_CHAIN_HISTOGRAM</code> defined, every call is counted
+ * per vari type, see <code>chain_histogram()</code>.
+ *
  */
 static void grad() {
-  size_t end = ChainableStack::instance_->var_stack_.size();
+  auto& var_stack = ChainableStack::instance_->var_stack_;
+  const auto& op_stack = ChainableStack::instance_->op_stack_;
+  size_t end = var_stack.size();
   size_t beginning = empty_nested() ? 0 : end - nested_size();
-  for (size_t i = end; i-- > beginning;) {
-    ChainableStack::instance_->var_stack_[i]->chain();
+  size_t op_end = op_stack.size();
+  size_t op_beginning
+      = empty_nested()
+            ? 0
+            : ChainableStack::instance_->nested_op_stack_sizes_.back();
+  if (op_end == op_beginning) {
+    for (size_t i = end; i-- > beginning;) {
+      chain_vari(var_stack[i]);
+    }
+    return;
+  }
+  size_t i = end;
+  for (size_t j = op_end; j-- > op_beginning;) {
+    const size_t pos = op_stack[j].pos_;
+    while (i > pos) {
+      chain_vari(var_stack[--i]);
+    }
+    chain_tape_op(op_stack[j]);
+  }
+  while (i-- > beginning) {
+    chain_vari(var_stack[i]);
   }
 }
 
@@ -0,0 +1,112 @@
+#ifndef STAN_MATH_REV_CORE_MAKE_OP_VARI_HPP
+#define STAN_MATH_REV_CORE_MAKE_OP_VARI_HPP
+
+#include <stan/math/prim/meta.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <stan/math/rev/core/callback_vari.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/precomp_vv_vari.hpp>
+#include <stan/math/rev/core/tape_op.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Return a vari for the result of a scalar operation of one variable
+ * with a precomputed partial derivative.
+ *
+ * With <code>STAN_OPCODE_TAPE</code> defined the result is a vari that is
+ * not chained and the operation is recorded as a <code>tape_op</code> on
+ * the op stack, so the reverse pass handles it without a virtual call.
+ * Otherwise this is a callback vari applying the partial.
+ *
+ * @param val value of the result
+ * @param avi operand
+ * @param da partial derivative of the result with respect to the operand
+ * @param fun function computing the result from the operand and
+ * <code>c</code>, if the tape is to be replayable
+ * @param c constant operand of <code>fun</code>
+ * @return vari holding the result
+ */
+inline vari* make_op_vari(double val, vari* avi, double da,
+                          op_fun fun = op_fun::none, double c = 0.0) {
+#ifdef STAN_OPCODE_TAPE
+  vari* res = new vari(val, false);
+  ChainableStack::instance_->op_stack_.push_back(
+      {&res->adj_, &avi->adj_, nullptr, da, c,
+       ChainableStack::instance_->var_stack_.size(), op_code::v, fun, false});
+  return res;
+#else
+  return make_callback_vari(val, [avi, da](const auto& vi) mutable {
+    avi->adj_ += vi.adj_ * da;
+  });
+#endif
+}
+
+/**
+ * Return a vari for the result of a scalar operation of two variables
+ * with precomputed partial derivatives.
+ *
+ * With <code>STAN_OPCODE_TAPE</code> defined the result is a vari that is
+ * not chained and the operation is recorded as a <code>tape_op</code> on
+ * the op stack, so the reverse pass handles it without a virtual call.
+ * Otherwise this is a <code>precomp_vv_vari</code>.
+ *
+ * @param val value of the result
+ * @param avi first operand
+ * @param bvi second operand
+ * @param da partial derivative of the result with respect to the first
+ * operand
+ * @param db partial derivative of the result with respect to the second
+ * operand
+ * @param fun function computing the result from the operands, if the
+ * tape is to be replayable
+ * @return vari holding the result
+ */
+inline vari* make_op_vari(double val, vari* avi, vari* bvi, double da,
+                          double db, op_fun fun = op_fun::none) {
+#ifdef STAN_OPCODE_TAPE
+  vari* res = new vari(val, false);
+  ChainableStack::instance_->op_stack_.push_back(
+      {&res->adj_, &avi->adj_, &bvi->adj_, da, db,
+       ChainableStack::instance_->var_stack_.size(), op_code::vv, fun,
+       false});
+  return res;
+#else
+  return new precomp_vv_vari(val, avi, bvi, da, db);
+#endif
+}
+
+/**
+ * Return the outcome of a comparison of a variable with a variable or a
+ * constant.
+ *
+ * With <code>STAN_OPCODE_TAPE</code> defined and the AD stack recording
+ * branches, as it does while <code>retaped_gradient</code> records a
+ * function, the comparison is recorded as an <code>op_code::branch</code>
+ * record on the op stack, so that a replay of the tape can tell when the
+ * control flow of the function would differ.
+ *
+ * @param taken outcome of the comparison
+ * @param fun comparison
+ * @param avi first operand
+ * @param bvi second operand, or nullptr to compare with <code>c</code>
+ * @param c constant second operand
+ * @return <code>taken</code>
+ */
+inline bool make_op_branch(bool taken, op_fun fun, vari* avi, vari* bvi,
+                           double c = 0.0) {
+#ifdef STAN_OPCODE_TAPE
+  if (unlikely(ChainableStack::instance_->record_branches_)) {
+    ChainableStack::instance_->op_stack_.push_back(
+        {nullptr, &avi->adj_, bvi == nullptr ? nullptr : &bvi->adj_, 0.0, c,
+         ChainableStack::instance_->var_stack_.size(), op_code::branch, fun,
+         taken});
+  }
+#endif
+  return taken;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
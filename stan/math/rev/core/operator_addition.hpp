@@ -3,8 +3,10 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/arena_sparse_matrix.hpp>
 #include <stan/math/prim/err/check_matching_dims.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
 #include <stan/math/prim/fun/as_array_or_scalar.hpp>
 #include <stan/math/prim/fun/constants.hpp>
@@ -51,11 +53,16 @@ namespace math {
  * @return Variable result of adding two variables.
  */
 inline var operator+(const var& a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a.vi_->val_ + b.vi_->val_, a.vi_, b.vi_, 1.0, 1.0,
+                      op_fun::add);
+#else
   return make_callback_vari(a.vi_->val_ + b.vi_->val_,
                             [avi = a.vi_, bvi = b.vi_](const auto& vi) mutable {
                               avi->adj_ += vi.adj_;
                               bvi->adj_ += vi.adj_;
                             });
+#endif
 }
 
 /**
@@ -75,9 +82,13 @@ inline var operator+(const var& a, Arith b) {
   if (unlikely(b == 0.0)) {
     return a;
   }
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a.vi_->val_ + b, a.vi_, 1.0, op_fun::add_const, b);
+#else
   return make_callback_vari(
       a.vi_->val_ + b,
       [avi = a.vi_, b](const auto& vi) mutable { avi->adj_ += vi.adj_; });
+#endif
 }
 
 /**
@@ -107,7 +118,8 @@ inline var operator+(Arith a, const var& b) {
  * @return Variable result of adding two variables.
  */
 template <typename VarMat1, typename VarMat2,
-          require_all_rev_matrix_t<VarMat1, VarMat2>* = nullptr>
+          require_all_rev_matrix_t<VarMat1, VarMat2>* = nullptr,
+          require_all_not_var_sparse_matrix_t<VarMat1, VarMat2>* = nullptr>
 inline auto add(const VarMat1& a, const VarMat2& b) {
   check_matching_dims("add", "a", a, "b", b);
   using op_ret_type = decltype(a.val() + b.val());
@@ -138,7 +150,8 @@ inline auto add(const VarMat1& a, const VarMat2& b) {
  */
 template <typename Arith, typename VarMat,
           require_st_arithmetic<Arith>* = nullptr,
-          require_rev_matrix_t<VarMat>* = nullptr>
+          require_rev_matrix_t<VarMat>* = nullptr,
+          require_not_var_sparse_matrix_t<VarMat>* = nullptr>
 inline auto add(const VarMat& a, const Arith& b) {
   if (is_eigen<Arith>::value) {
     check_matching_dims("add", "a", a, "b", b);
@@ -164,7 +177,8 @@ inline auto add(const VarMat& a, const Arith& b) {
  */
 template <typename Arith, typename VarMat,
           require_st_arithmetic<Arith>* = nullptr,
-          require_rev_matrix_t<VarMat>* = nullptr>
+          require_rev_matrix_t<VarMat>* = nullptr,
+          require_not_var_sparse_matrix_t<VarMat>* = nullptr>
 inline auto add(const Arith& a, const VarMat& b) {
   return add(b, a);
 }
@@ -263,6 +277,37 @@ inline auto add(const T1& a, const T2& b) {
   return a + b;
 }
 
+/**
+ * Addition operator for sparse matrices, at least one of which is a sparse
+ * matrix variable.
+ *
+ * The sparsity pattern of the result is the union of the patterns of the
+ * operands, and the adjoint of each operand is only updated on its own
+ * nonzeros.
+ *
+ * @tparam T1 A sparse matrix of doubles or a `var_value` of one.
+ * @tparam T2 A sparse matrix of doubles or a `var_value` of one.
+ * @param a First operand.
+ * @param b Second operand.
+ * @return Sparse matrix variable holding the sum.
+ */
+template <typename T1, typename T2,
+          require_all_sparse_matrix_t<T1, T2>* = nullptr,
+          require_any_var_sparse_matrix_t<T1, T2>* = nullptr>
+inline auto add(const T1& a, const T2& b) {
+  using sparse_t = Eigen::SparseMatrix<double>;
+  check_matching_dims("add", "a", a, "b", b);
+  auto arena_a = internal::to_arena_sparse(a);
+  auto arena_b = internal::to_arena_sparse(b);
+  var_value<sparse_t> ret(sparse_t(internal::sparse_value_of(arena_a)
+                                   + internal::sparse_value_of(arena_b)));
+  reverse_pass_callback([ret, arena_a, arena_b]() mutable {
+    internal::add_sparse_adjoints_on_pattern(arena_a, ret.adj());
+    internal::add_sparse_adjoints_on_pattern(arena_b, ret.adj());
+  });
+  return ret;
+}
+
 /**
  * Addition operator for matrix variables.
  *
@@ -10,6 +10,7 @@
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
 #include <stan/math/rev/core/dv_vari.hpp>
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/rev/core/operator_addition.hpp>
 #include <stan/math/rev/core/operator_multiplication.hpp>
 #include <stan/math/rev/core/operator_subtraction.hpp>
@@ -88,7 +89,14 @@ class divide_dv_vari final : public op_dv_vari {
  * second.
  */
 inline var operator/(const var& dividend, const var& divisor) {
+#ifdef STAN_OPCODE_TAPE
+  const double quotient = dividend.vi_->val_ / divisor.vi_->val_;
+  return make_op_vari(quotient, dividend.vi_, divisor.vi_,
+                      1.0 / divisor.vi_->val_,
+                      -quotient / divisor.vi_->val_, op_fun::divide);
+#else
   return {new internal::divide_vv_vari(dividend.vi_, divisor.vi_)};
+#endif
 }
 
 /**
@@ -109,7 +117,12 @@ inline var operator/(const var& dividend, Arith divisor) {
   if (divisor == 1.0) {
     return dividend;
   }
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(dividend.vi_->val_ / divisor, dividend.vi_,
+                      1.0 / divisor, op_fun::divide_const, divisor);
+#else
   return {new internal::divide_vd_vari(dividend.vi_, divisor)};
+#endif
 }
 
 /**
@@ -126,7 +139,13 @@ inline var operator/(const var& dividend, Arith divisor) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline var operator/(Arith dividend, const var& divisor) {
+#ifdef STAN_OPCODE_TAPE
+  const double quotient = dividend / divisor.vi_->val_;
+  return make_op_vari(quotient, divisor.vi_, -quotient / divisor.vi_->val_,
+                      op_fun::const_divide, dividend);
+#else
   return {new internal::divide_dv_vari(dividend, divisor.vi_)};
+#endif
 }
 
 inline std::complex<var> operator/(const std::complex<var>& x1,
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_HPP
 
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/prim/meta.hpp>
 
@@ -23,7 +24,13 @@ namespace math {
  * @param b Second variable.
  * @return True if first variable's value is greater than second's.
  */
-inline bool operator>(const var& a, const var& b) { return a.val() > b.val(); }
+inline bool operator>(const var& a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a.val() > b.val(), op_fun::greater, a.vi_, b.vi_);
+#else
+  return a.val() > b.val();
+#endif
+}
 
 /**
  * Greater than operator comparing variable's value and double
@@ -36,7 +43,11 @@ inline bool operator>(const var& a, const var& b) { return a.val() > b.val(); }
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator>(const var& a, Arith b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a.val() > b, op_fun::greater, a.vi_, nullptr, b);
+#else
   return a.val() > b;
+#endif
 }
 
 /**
@@ -50,7 +61,11 @@ inline bool operator>(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator>(Arith a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a > b.val(), op_fun::less, b.vi_, nullptr, a);
+#else
   return a > b.val();
+#endif
 }
 
 }  // namespace math
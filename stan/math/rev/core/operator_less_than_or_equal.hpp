@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_OR_EQUAL_HPP
 #define STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_OR_EQUAL_HPP
 
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/prim/meta.hpp>
 
@@ -25,7 +26,11 @@ namespace math {
  * the second's.
  */
 inline bool operator<=(const var& a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a.val() <= b.val(), op_fun::less_equal, a.vi_, b.vi_);
+#else
   return a.val() <= b.val();
+#endif
 }
 
 /**
@@ -40,7 +45,11 @@ inline bool operator<=(const var& a, const var& b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator<=(const var& a, Arith b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a.val() <= b, op_fun::less_equal, a.vi_, nullptr, b);
+#else
   return a.val() <= b;
+#endif
 }
 
 /**
@@ -55,7 +64,11 @@ inline bool operator<=(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator<=(Arith a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a <= b.val(), op_fun::greater_equal, b.vi_, nullptr, a);
+#else
   return a <= b.val();
+#endif
 }
 
 }  // namespace math
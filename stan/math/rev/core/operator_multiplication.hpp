@@ -5,6 +5,7 @@
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/vv_vari.hpp>
 #include <stan/math/rev/core/vd_vari.hpp>
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_any_nan.hpp>
 #include <stan/math/prim/fun/isinf.hpp>
@@ -69,7 +70,12 @@ class multiply_vd_vari final : public op_vd_vari {
  * @return Variable result of multiplying operands.
  */
 inline var operator*(const var& a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a.vi_->val_ * b.vi_->val_, a.vi_, b.vi_, b.vi_->val_,
+                      a.vi_->val_, op_fun::multiply);
+#else
   return {new internal::multiply_vv_vari(a.vi_, b.vi_)};
+#endif
 }
 
 /**
@@ -89,7 +95,11 @@ inline var operator*(const var& a, Arith b) {
   if (b == 1.0) {
     return a;
   }
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a.vi_->val_ * b, a.vi_, b, op_fun::multiply_const, b);
+#else
   return {new internal::multiply_vd_vari(a.vi_, b)};
+#endif
 }
 
 /**
@@ -109,7 +119,11 @@ inline var operator*(Arith a, const var& b) {
   if (a == 1.0) {
     return b;
   }
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a * b.vi_->val_, b.vi_, a, op_fun::multiply_const, a);
+#else
   return {new internal::multiply_vd_vari(b.vi_, a)};  // by symmetry
+#endif
 }
 
 }  // namespace math
@@ -11,7 +11,7 @@ namespace math {
 template <typename T>
 inline var_value<T>& var_value<T, require_floating_point_t<T>>::operator*=(
     const var_value<T>& b) {
-  vi_ = new internal::multiply_vv_vari(vi_, b.vi_);
+  vi_ = (*this * b).vi_;
   return *this;
 }
 
@@ -21,7 +21,7 @@ inline var_value<T>& var_value<T, require_floating_point_t<T>>::operator*=(
   if (b == 1.0) {
     return *this;
   }
-  vi_ = new internal::multiply_vd_vari(vi_, b);
+  vi_ = (*this * b).vi_;
   return *this;
 }
 
@@ -3,6 +3,7 @@
 
 #include <stan/math/rev/core/std_complex.hpp>
 #include <stan/math/rev/core/operator_equal.hpp>
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/prim/meta.hpp>
 #include <complex>
@@ -28,7 +29,11 @@ namespace math {
  * second's.
  */
 inline bool operator!=(const var& a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a.val() != b.val(), op_fun::not_equal, a.vi_, b.vi_);
+#else
   return a.val() != b.val();
+#endif
 }
 
 /**
@@ -43,7 +48,11 @@ inline bool operator!=(const var& a, const var& b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator!=(const var& a, Arith b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a.val() != b, op_fun::not_equal, a.vi_, nullptr, b);
+#else
   return a.val() != b;
+#endif
 }
 
 /**
@@ -58,7 +67,11 @@ inline bool operator!=(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline bool operator!=(Arith a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_branch(a != b.val(), op_fun::not_equal, b.vi_, nullptr, a);
+#else
   return a != b.val();
+#endif
 }
 
 /**
@@ -5,6 +5,7 @@
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/arena_matrix.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/prim/fun/as_column_vector_or_scalar.hpp>
 #include <stan/math/prim/fun/as_array_or_scalar.hpp>
 #include <stan/math/prim/fun/constants.hpp>
@@ -54,11 +55,16 @@ namespace math {
  * the first.
  */
 inline var operator-(const var& a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a.vi_->val_ - b.vi_->val_, a.vi_, b.vi_, 1.0, -1.0,
+                      op_fun::subtract);
+#else
   return make_callback_vari(a.vi_->val_ - b.vi_->val_,
                             [avi = a.vi_, bvi = b.vi_](const auto& vi) mutable {
                               avi->adj_ += vi.adj_;
                               bvi->adj_ -= vi.adj_;
                             });
+#endif
 }
 
 /**
@@ -79,9 +85,13 @@ inline var operator-(const var& a, Arith b) {
   if (unlikely(b == 0.0)) {
     return a;
   }
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a.vi_->val_ - b, a.vi_, 1.0, op_fun::subtract_const, b);
+#else
   return make_callback_vari(
       a.vi_->val_ - b,
       [avi = a.vi_, b](const auto& vi) mutable { avi->adj_ += vi.adj_; });
+#endif
 }
 
 /**
@@ -99,9 +109,13 @@ inline var operator-(const var& a, Arith b) {
  */
 template <typename Arith, require_arithmetic_t<Arith>* = nullptr>
 inline var operator-(Arith a, const var& b) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(a - b.vi_->val_, b.vi_, -1.0, op_fun::const_subtract, a);
+#else
   return make_callback_vari(
       a - b.vi_->val_,
       [bvi = b.vi_, a](const auto& vi) mutable { bvi->adj_ -= vi.adj_; });
+#endif
 }
 
 /**
@@ -4,6 +4,7 @@
 #include <stan/math/prim/meta.hpp>
 #include <stan/math/rev/core/var.hpp>
 #include <stan/math/rev/core/callback_vari.hpp>
+#include <stan/math/rev/core/make_op_vari.hpp>
 #include <stan/math/prim/fun/constants.hpp>
 #include <stan/math/prim/fun/is_nan.hpp>
 
@@ -35,8 +36,12 @@ namespace math {
  * @return Negation of variable.
  */
 inline var operator-(const var& a) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(-a.vi_->val_, a.vi_, -1.0, op_fun::negate);
+#else
   return make_callback_var(
       -a.val(), [a](const auto& vi) mutable { a.adj() -= vi.adj(); });
+#endif
 }
 
 /**
@@ -0,0 +1,552 @@
+#ifndef STAN_MATH_REV_CORE_PROFILER_HPP
+#define STAN_MATH_REV_CORE_PROFILER_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/reverse_pass_callback.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <stan/math/rev/core/vari_type_name.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Aggregated statistics of one region of a <code>profiler</code>, for one
+ * thread. Regions are identified by their path, the names of the
+ * enclosing regions and the region itself joined with '/'. All
+ * quantities of a region include those of the regions nested in it.
+ */
+struct profile_region_stats {
+  std::string path_;
+  std::thread::id thread_id_;
+  size_t n_fwd_passes_{0};
+  size_t n_rev_passes_{0};
+  double fwd_time_{0};
+  double rev_time_{0};
+  // shortest and longest single pass, zero if there was none
+  double fwd_time_min_{0};
+  double fwd_time_max_{0};
+  double rev_time_min_{0};
+  double rev_time_max_{0};
+  // arena bytes used by the forward passes
+  size_t arena_bytes_{0};
+  size_t chain_stack_used_{0};
+  size_t nochain_stack_used_{0};
+  // number of varis created per dynamic type, if counted
+  std::map<std::string, size_t> vari_counts_;
+};
+
+namespace internal {
+
+/**
+ * Running totals of the forward or the reverse passes of a region.
+ */
+struct profile_pass_totals {
+  size_t n_{0};
+  int64_t total_ns_{0};
+  // time not spent in nested regions
+  int64_t self_ns_{0};
+  int64_t min_ns_{0};
+  int64_t max_ns_{0};
+
+  void add(int64_t ns, int64_t children_ns) {
+    min_ns_ = n_ == 0 ? ns : std::min(min_ns_, ns);
+    max_ns_ = std::max(max_ns_, ns);
+    ++n_;
+    total_ns_ += ns;
+    self_ns_ += ns - children_ns;
+  }
+};
+
+/**
+ * Completed forward or reverse pass of a region, kept for the trace.
+ */
+struct profile_span {
+  int64_t begin_ns_;
+  int64_t end_ns_;
+  size_t arena_bytes_;
+  size_t chain_size_;
+  size_t nochain_size_;
+  uint32_t region_;
+  bool forward_;
+};
+
+/**
+ * Node of the tree of regions seen by one thread, with the totals of its
+ * passes.
+ */
+struct profile_region_node {
+  std::string name_;
+  std::string path_;
+  uint32_t parent_;
+  std::vector<uint32_t> children_;
+  std::unordered_map<std::type_index, size_t> vari_counts_;
+  profile_pass_totals fwd_;
+  profile_pass_totals rev_;
+  size_t arena_bytes_{0};
+  size_t chain_stack_used_{0};
+  size_t nochain_stack_used_{0};
+};
+
+/**
+ * Profile of one thread. Only the owning thread writes to the buffer, so
+ * entering and leaving a region takes no lock.
+ *
+ * Passes are added to the totals of their region when they end, so the
+ * memory used grows with the number of distinct regions only. The most
+ * recent passes are also kept for the trace in a ring buffer of fixed
+ * capacity.
+ */
+struct profile_thread_buffer {
+  struct open_pass {
+    uint32_t region_;
+    int64_t begin_ns_;
+    size_t arena_bytes_;
+    size_t chain_size_;
+    size_t nochain_size_;
+    int64_t children_ns_;
+  };
+
+  std::thread::id thread_id_;
+  size_t thread_index_;
+  std::vector<profile_region_node> regions_;
+  std::vector<open_pass> open_;
+  std::vector<open_pass> rev_open_;
+  size_t span_capacity_;
+  std::vector<profile_span> spans_;
+  // position of the oldest span once the ring buffer is full
+  size_t next_span_{0};
+
+  profile_thread_buffer(std::thread::id thread_id, size_t thread_index,
+                        size_t span_capacity)
+      : thread_id_(thread_id),
+        thread_index_(thread_index),
+        span_capacity_(span_capacity) {
+    clear();
+  }
+
+  /**
+   * Remove all regions and spans.
+   */
+  void clear() {
+    regions_.clear();
+    regions_.push_back({"", "", 0, {}, {}});
+    open_.clear();
+    rev_open_.clear();
+    spans_.clear();
+    next_span_ = 0;
+  }
+
+  /**
+   * Return the index of the child region with the specified name of the
+   * innermost open region, adding it if needed.
+   *
+   * @param name name of the region
+   * @return index of the region
+   */
+  uint32_t child(const std::string& name) {
+    const uint32_t parent = open_.empty() ? 0 : open_.back().region_;
+    for (uint32_t c : regions_[parent].children_) {
+      if (regions_[c].name_ == name) {
+        return c;
+      }
+    }
+    const uint32_t c = regions_.size();
+    std::string path
+        = parent == 0 ? name : regions_[parent].path_ + "/" + name;
+    regions_.push_back({name, std::move(path), parent, {}, {}});
+    regions_[parent].children_.push_back(c);
+    return c;
+  }
+
+  /**
+   * Keep a span for the trace, replacing the oldest one if the ring
+   * buffer is full.
+   *
+   * @param span completed pass
+   */
+  void add_span(const profile_span& span) {
+    if (spans_.size() < span_capacity_) {
+      spans_.push_back(span);
+    } else if (span_capacity_ > 0) {
+      spans_[next_span_] = span;
+      next_span_ = (next_span_ + 1) % span_capacity_;
+    }
+  }
+
+  /**
+   * End the innermost forward pass and add it to the totals of its
+   * region.
+   *
+   * @param end_ns time at the end of the pass
+   * @param arena_bytes arena bytes in use at the end of the pass
+   * @param chain_size size of the var stack at the end of the pass
+   * @param nochain_size size of the nochain var stack at the end of the
+   * pass
+   */
+  void end_forward(int64_t end_ns, size_t arena_bytes, size_t chain_size,
+                   size_t nochain_size) {
+    const open_pass pass = open_.back();
+    open_.pop_back();
+    const int64_t ns = end_ns - pass.begin_ns_;
+    if (!open_.empty()) {
+      open_.back().children_ns_ += ns;
+    }
+    auto& node = regions_[pass.region_];
+    node.fwd_.add(ns, pass.children_ns_);
+    node.arena_bytes_ += arena_bytes - pass.arena_bytes_;
+    node.chain_stack_used_ += chain_size - pass.chain_size_;
+    node.nochain_stack_used_ += nochain_size - pass.nochain_size_;
+    add_span({pass.begin_ns_, end_ns, arena_bytes - pass.arena_bytes_,
+              chain_size - pass.chain_size_,
+              nochain_size - pass.nochain_size_, pass.region_, true});
+  }
+
+  /**
+   * End the innermost reverse pass and add it to the totals of its
+   * region.
+   *
+   * @param end_ns time at the end of the pass
+   */
+  void end_reverse(int64_t end_ns) {
+    if (rev_open_.empty()) {
+      return;
+    }
+    const open_pass pass = rev_open_.back();
+    rev_open_.pop_back();
+    const int64_t ns = end_ns - pass.begin_ns_;
+    if (!rev_open_.empty()) {
+      rev_open_.back().children_ns_ += ns;
+    }
+    regions_[pass.region_].rev_.add(ns, pass.children_ns_);
+    add_span({pass.begin_ns_, end_ns, 0, 0, 0, pass.region_, false});
+  }
+};
+
+/**
+ * Escape a string for use in a JSON string literal.
+ */
+inline std::string json_escape(const std::string& s) {
+  std::string escaped;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+}  // namespace internal
+
+/**
+ * Collector of hierarchical profiles of forward and reverse passes.
+ *
+ * Regions are profiled with <code>profile_region</code> objects. Regions
+ * may be nested, also with the same name, and are identified by their
+ * path in the tree of enclosing regions of the thread that entered them.
+ * For every region the profiler records forward and reverse pass times,
+ * the arena bytes used, the number of varis created and, if enabled,
+ * the number of varis per dynamic vari type.
+ *
+ * Each thread writes into its own buffer, found through a thread local
+ * cache, so entering and leaving a region takes no lock and does no map
+ * lookup. Every pass is added to the totals of its region when it ends,
+ * so the memory used does not grow with the number of passes. The most
+ * recent passes of every thread are kept in a ring buffer of fixed
+ * capacity for the trace. The statistics and traces must not be
+ * requested while regions are being profiled in other threads.
+ *
+ * The kept passes can be written in the Chrome trace event format (load
+ * in chrome://tracing or Perfetto) and the totals as folded stacks for
+ * flame graph tools.
+ */
+class profiler {
+ public:
+  /**
+   * Construct a profiler.
+   *
+   * @param count_vari_types if true, count the varis created in every
+   * region per dynamic type. This scans the varis of a region when it is
+   * left, so it is off by default.
+   * @param trace_capacity number of most recent passes kept per thread
+   * for <code>write_chrome_trace()</code>
+   */
+  explicit profiler(bool count_vari_types = false,
+                    size_t trace_capacity = 65536)
+      : id_(next_id()),
+        count_vari_types_(count_vari_types),
+        trace_capacity_(trace_capacity),
+        start_(std::chrono::steady_clock::now()) {}
+
+  profiler(const profiler&) = delete;
+  profiler& operator=(const profiler&) = delete;
+
+  bool count_vari_types() const noexcept { return count_vari_types_; }
+
+  size_t trace_capacity() const noexcept { return trace_capacity_; }
+
+  /**
+   * Return the buffer of the calling thread.
+   */
+  internal::profile_thread_buffer& thread_buffer() {
+    struct cache_t {
+      size_t profiler_id_{0};
+      internal::profile_thread_buffer* buffer_{nullptr};
+    };
+    static thread_local cache_t cache;
+    if (cache.profiler_id_ == id_) {
+      return *cache.buffer_;
+    }
+    const auto thread_id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(mutex_);
+    internal::profile_thread_buffer* buffer = nullptr;
+    for (auto& b : buffers_) {
+      if (b->thread_id_ == thread_id) {
+        buffer = b.get();
+      }
+    }
+    if (buffer == nullptr) {
+      buffers_.push_back(std::make_unique<internal::profile_thread_buffer>(
+          thread_id, buffers_.size(), trace_capacity_));
+      buffer = buffers_.back().get();
+    }
+    cache.profiler_id_ = id_;
+    cache.buffer_ = buffer;
+    return *buffer;
+  }
+
+  /**
+   * Return the number of nanoseconds since the profiler was constructed.
+   */
+  int64_t now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start_)
+        .count();
+  }
+
+  /**
+   * Remove all recorded passes. Must not be called while regions are
+   * open or while the AD stack holds reverse pass callbacks of profiled
+   * regions.
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& b : buffers_) {
+      b->clear();
+    }
+  }
+
+  /**
+   * Return the statistics of all regions, ordered by thread and path.
+   *
+   * @return statistics per thread and region
+   */
+  std::vector<profile_region_stats> stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<profile_region_stats> result;
+    for (const auto& b : buffers_) {
+      const auto& regions = b->regions_;
+      std::map<std::string, size_t> order;
+      for (size_t i = 1; i < regions.size(); ++i) {
+        order[regions[i].path_] = i;
+      }
+      for (const auto& o : order) {
+        const auto& node = regions[o.second];
+        profile_region_stats r;
+        r.path_ = o.first;
+        r.thread_id_ = b->thread_id_;
+        r.n_fwd_passes_ = node.fwd_.n_;
+        r.n_rev_passes_ = node.rev_.n_;
+        r.fwd_time_ = 1e-9 * node.fwd_.total_ns_;
+        r.rev_time_ = 1e-9 * node.rev_.total_ns_;
+        r.fwd_time_min_ = 1e-9 * node.fwd_.min_ns_;
+        r.fwd_time_max_ = 1e-9 * node.fwd_.max_ns_;
+        r.rev_time_min_ = 1e-9 * node.rev_.min_ns_;
+        r.rev_time_max_ = 1e-9 * node.rev_.max_ns_;
+        r.arena_bytes_ = node.arena_bytes_;
+        r.chain_stack_used_ = node.chain_stack_used_;
+        r.nochain_stack_used_ = node.nochain_stack_used_;
+        for (const auto& count : node.vari_counts_) {
+          r.vari_counts_[internal::vari_type_name(count.first)]
+              += count.second;
+        }
+        result.push_back(std::move(r));
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Write the kept passes as complete events of the Chrome trace event
+   * format. Every thread is shown as a separate track; reverse passes are
+   * labelled with the category "reverse".
+   *
+   * @param o stream to write to
+   */
+  void write_chrome_trace(std::ostream& o) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    o << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& b : buffers_) {
+      // oldest first
+      const size_t n = b->spans_.size();
+      for (size_t k = 0; k < n; ++k) {
+        const auto& span = b->spans_[(b->next_span_ + k) % n];
+        o << (first ? "\n" : ",\n");
+        first = false;
+        o << "{\"name\":\""
+          << internal::json_escape(b->regions_[span.region_].name_)
+          << "\",\"cat\":\"" << (span.forward_ ? "forward" : "reverse")
+          << "\",\"ph\":\"X\",\"ts\":" << 1e-3 * span.begin_ns_
+          << ",\"dur\":" << 1e-3 * (span.end_ns_ - span.begin_ns_)
+          << ",\"pid\":0,\"tid\":" << b->thread_index_;
+        if (span.forward_) {
+          o << ",\"args\":{\"arena_bytes\":" << span.arena_bytes_
+            << ",\"chain_stack\":" << span.chain_size_
+            << ",\"nochain_stack\":" << span.nochain_size_ << "}";
+        }
+        o << "}";
+      }
+    }
+    o << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  }
+
+  /**
+   * Write the self time of every region in microseconds as folded stacks
+   * ("forward;outer;inner 123"), the input format of flame graph tools.
+   * Forward and reverse passes are rooted at "forward" and "reverse";
+   * the times of all threads are added.
+   *
+   * @param o stream to write to
+   */
+  void write_folded_stacks(std::ostream& o) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, double> self_us;
+    for (const auto& b : buffers_) {
+      const auto& regions = b->regions_;
+      for (uint32_t i = 1; i < regions.size(); ++i) {
+        std::string stack;
+        for (uint32_t r = i; r != 0; r = regions[r].parent_) {
+          stack = ";" + regions[r].name_ + stack;
+        }
+        if (regions[i].fwd_.n_ > 0) {
+          self_us["forward" + stack] += 1e-3 * regions[i].fwd_.self_ns_;
+        }
+        if (regions[i].rev_.n_ > 0) {
+          self_us["reverse" + stack] += 1e-3 * regions[i].rev_.self_ns_;
+        }
+      }
+    }
+    for (const auto& s : self_us) {
+      o << s.first << " " << static_cast<int64_t>(s.second + 0.5) << "\n";
+    }
+  }
+
+ private:
+  static size_t next_id() {
+    static std::atomic<size_t> id{0};
+    return ++id;
+  }
+
+  const size_t id_;
+  const bool count_vari_types_;
+  const size_t trace_capacity_;
+  const std::chrono::steady_clock::time_point start_;
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<internal::profile_thread_buffer>> buffers_;
+};
+
+/**
+ * Profiles the C++ lines where the object is in scope as a region of a
+ * <code>profiler</code>, nested in the regions of the same profiler that
+ * are open in this thread.
+ *
+ * When T is var, the reverse pass of the region is profiled as well,
+ * with callbacks placed on the AD tape when the region is entered and
+ * left. Otherwise only the forward pass is profiled.
+ *
+ * @tparam T type of the region. If var, the reverse pass is profiled.
+ */
+template <typename T>
+class profile_region {
+  profiler& profiler_;
+  internal::profile_thread_buffer& buffer_;
+  uint32_t region_;
+
+ public:
+  /**
+   * Enter a region.
+   *
+   * @param name name of the region
+   * @param p profiler collecting the region
+   */
+  profile_region(const std::string& name, profiler& p)
+      : profiler_(p), buffer_(p.thread_buffer()), region_(buffer_.child(name)) {
+    if (!is_constant<T>::value) {
+      // runs last in the reverse pass of the region
+      reverse_pass_callback([p = &profiler_, buffer = &buffer_]() {
+        buffer->end_reverse(p->now());
+      });
+    }
+    const auto& stack = *ChainableStack::instance_;
+    buffer_.open_.push_back({region_, profiler_.now(),
+                             stack.memalloc_.bytes_used(),
+                             stack.var_stack_.size(),
+                             stack.var_nochain_stack_.size(), 0});
+  }
+
+  /**
+   * Leave the region.
+   */
+  ~profile_region() {
+    const auto& stack = *ChainableStack::instance_;
+    const size_t chain_begin = buffer_.open_.back().chain_size_;
+    const size_t nochain_begin = buffer_.open_.back().nochain_size_;
+    buffer_.end_forward(profiler_.now(), stack.memalloc_.bytes_used(),
+                        stack.var_stack_.size(),
+                        stack.var_nochain_stack_.size());
+    if (!is_constant<T>::value) {
+      if (profiler_.count_vari_types()) {
+        auto& counts = buffer_.regions_[region_].vari_counts_;
+        for (size_t i = chain_begin; i < stack.var_stack_.size(); ++i) {
+          counts[typeid(*stack.var_stack_[i])]++;
+        }
+        for (size_t i = nochain_begin; i < stack.var_nochain_stack_.size();
+             ++i) {
+          counts[typeid(*stack.var_nochain_stack_[i])]++;
+        }
+      }
+      // runs first in the reverse pass of the region
+      reverse_pass_callback(
+          [p = &profiler_, buffer = &buffer_, region = region_]() {
+            buffer->rev_open_.push_back({region, p->now(), 0, 0, 0, 0});
+          });
+    }
+  }
+
+  profile_region(const profile_region&) = delete;
+  profile_region& operator=(const profile_region&) = delete;
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
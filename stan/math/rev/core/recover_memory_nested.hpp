@@ -43,6 +43,9 @@ static inline void recover_memory_nested() {
   ChainableStack::instance_->var_alloc_stack_.resize(
       ChainableStack::instance_->nested_var_alloc_stack_starts_.back());
   ChainableStack::instance_->nested_var_alloc_stack_starts_.pop_back();
+  ChainableStack::instance_->op_stack_.resize(
+      ChainableStack::instance_->nested_op_stack_sizes_.back());
+  ChainableStack::instance_->nested_op_stack_sizes_.pop_back();
 
   ChainableStack::instance_->memalloc_.recover_nested();
 }
@@ -20,6 +20,8 @@ static inline void start_nested() {
       ChainableStack::instance_->var_nochain_stack_.size());
   ChainableStack::instance_->nested_var_alloc_stack_starts_.push_back(
       ChainableStack::instance_->var_alloc_stack_.size());
+  ChainableStack::instance_->nested_op_stack_sizes_.push_back(
+      ChainableStack::instance_->op_stack_.size());
   ChainableStack::instance_->memalloc_.start_nested();
 }
 
@@ -0,0 +1,94 @@
+#ifndef STAN_MATH_REV_CORE_TAPE_OP_HPP
+#define STAN_MATH_REV_CORE_TAPE_OP_HPP
+
+#include <cstddef>
+
+namespace stan {
+namespace math {
+
+/**
+ * Operation codes of the records on the op tape.
+ */
+enum class op_code : unsigned int {
+  v,      // one operand with a precomputed partial
+  vv,     // two operands with precomputed partials
+  branch  // outcome of a comparison, no adjoints to propagate
+};
+
+/**
+ * Function computing the value of a record on the op tape from the
+ * values of its operands, so that the tape can be replayed for new
+ * values (see <code>retaped_gradient</code>). <code>c</code> is the
+ * constant operand of the one operand records, kept in
+ * <code>tape_op::db_</code>. The comparisons are the functions of the
+ * <code>op_code::branch</code> records; they compare <code>a</code> with
+ * <code>c</code> if the record has no second operand.
+ */
+enum class op_fun : unsigned char {
+  none,            // no forward function, the record cannot be replayed
+  add,             // a + b
+  add_const,       // a + c
+  subtract,        // a - b
+  subtract_const,  // a - c
+  const_subtract,  // c - a
+  multiply,        // a * b
+  multiply_const,  // a * c
+  divide,          // a / b
+  divide_const,    // a / c
+  const_divide,    // c / a
+  negate,          // -a
+  exp,             // exp(a)
+  log,             // log(a)
+  less,            // a < b
+  less_equal,      // a <= b
+  greater,         // a > b
+  greater_equal,   // a >= b
+  equal,           // a == b
+  not_equal        // a != b
+};
+
+/**
+ * Compact record of a scalar operation on the op tape.
+ *
+ * When Stan Math is compiled with <code>STAN_OPCODE_TAPE</code> defined,
+ * the common scalar operations (arithmetic operators, <code>exp</code>,
+ * <code>log</code>, ...) do not put a vari with a virtual
+ * <code>chain()</code> method on the var stack. Instead they create a
+ * plain result vari, which is not chained, and append one of these
+ * records to the op stack. <code>grad()</code> sweeps the op stack with a
+ * switch over the op code and interleaves it with the var stack using
+ * <code>pos_</code>, so that every other vari still has its
+ * <code>chain()</code> method called in the right order.
+ */
+struct tape_op {
+  double* adj_;    // adjoint of the result, unused for op_code::branch
+  double* a_adj_;  // adjoint of the first operand
+  double* b_adj_;  // adjoint of the second operand, nullptr if it is c
+  double da_;      // partial of the result w.r.t. the first operand
+  double db_;      // partial w.r.t. the second operand, or the constant c
+  size_t pos_;     // size of the var stack when the record was made
+  op_code code_;
+  op_fun fun_;  // forward function, op_fun::none if unknown
+  bool taken_;  // outcome of the comparison of an op_code::branch record
+
+  /**
+   * Propagate the adjoint of the result to the operands.
+   */
+  inline void chain() const {
+    switch (code_) {
+      case op_code::v:
+        *a_adj_ += *adj_ * da_;
+        break;
+      case op_code::vv:
+        *a_adj_ += *adj_ * da_;
+        *b_adj_ += *adj_ * db_;
+        break;
+      case op_code::branch:
+        break;
+    }
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
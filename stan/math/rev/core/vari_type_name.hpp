@@ -0,0 +1,41 @@
+#ifndef STAN_MATH_REV_CORE_VARI_TYPE_NAME_HPP
+#define STAN_MATH_REV_CORE_VARI_TYPE_NAME_HPP
+
+#include <cstdlib>
+#include <string>
+#include <typeindex>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Return the human readable name of a type, used to label vari types in
+ * diagnostic output. With GCC and clang the mangled name from
+ * <code>std::type_index</code> is demangled; otherwise it is returned as
+ * is.
+ *
+ * @param type type, e.g. <code>typeid(*vi)</code>
+ * @return name of the type
+ */
+inline std::string vari_type_name(std::type_index type) {
+#if defined(__GNUG__)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+  if (status == 0 && demangled != nullptr) {
+    std::string name(demangled);
+    std::free(demangled);
+    return name;
+  }
+#endif
+  return type.name();
+}
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
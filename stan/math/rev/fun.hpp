@@ -119,6 +119,7 @@
 #include <stan/math/rev/fun/log_sum_exp.hpp>
 #include <stan/math/rev/fun/logit.hpp>
 #include <stan/math/rev/fun/lub_constrain.hpp>
+#include <stan/math/rev/fun/matrix_exp.hpp>
 #include <stan/math/rev/fun/matrix_exp_multiply.hpp>
 #include <stan/math/rev/fun/matrix_power.hpp>
 #include <stan/math/rev/fun/mdivide_left.hpp>
@@ -175,6 +176,7 @@
 #include <stan/math/rev/fun/trace_gen_quad_form.hpp>
 #include <stan/math/rev/fun/trace_inv_quad_form_ldlt.hpp>
 #include <stan/math/rev/fun/trace_quad_form.hpp>
+#include <stan/math/rev/fun/transpose.hpp>
 #include <stan/math/rev/fun/trigamma.hpp>
 #include <stan/math/rev/fun/trunc.hpp>
 #include <stan/math/rev/fun/unit_vector_constrain.hpp>
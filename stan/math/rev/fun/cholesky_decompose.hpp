@@ -118,6 +118,87 @@ inline auto cholesky_lambda(T1& L_A, T2& L, T3& A) {
     A.adj().template triangularView<Eigen::Lower>() += L_adj;
   };
 }
+
+/**
+ * Reverse pass of the left-looking sparse Cholesky factorization.
+ *
+ * Column j of the factorization computes
+ * \f$c = A_{j:n,j} - \sum_{k < j} L_{j:n,k} L_{jk}\f$ and scales it by
+ * \f$\sqrt{c_j}\f$. Going through the columns from last to first, the
+ * adjoint of \f$c\f$ is the adjoint of column j of \f$A\f$, and it is
+ * pushed back to the columns \f$k < j\f$ with \f$L_{jk} \neq 0\f$. All
+ * updates stay on the sparsity pattern of \f$L\f$, so the cost is about
+ * the cost of the factorization.
+ *
+ * @param L compressed lower triangular Cholesky factor
+ * @param L_adj adjoint of the factor, with the storage of <code>L</code>
+ * @return adjoint of the lower triangle of the factored matrix, with the
+ * sparsity pattern of <code>L</code>
+ */
+inline Eigen::SparseMatrix<double> sparse_cholesky_adjoint(
+    const Eigen::SparseMatrix<double>& L,
+    const Eigen::SparseMatrix<double>& L_adj) {
+  const int n = L.cols();
+  const int nnz = L.nonZeros();
+  const int* outer = L.outerIndexPtr();
+  const int* inner = L.innerIndexPtr();
+  const double* l = L.valuePtr();
+  std::vector<double> l_adj(L_adj.valuePtr(), L_adj.valuePtr() + nnz);
+  Eigen::SparseMatrix<double> A_adj = L;
+  double* a_adj = A_adj.valuePtr();
+
+  // positions and columns of the entries of each row left of the diagonal
+  std::vector<int> row_begin(n + 1, 0);
+  for (int k = 0; k < n; ++k) {
+    for (int p = outer[k] + 1; p < outer[k + 1]; ++p) {
+      ++row_begin[inner[p] + 1];
+    }
+  }
+  for (int j = 0; j < n; ++j) {
+    row_begin[j + 1] += row_begin[j];
+  }
+  std::vector<int> row_pos(nnz - n);
+  std::vector<int> row_col(nnz - n);
+  std::vector<int> row_next(row_begin.begin(), row_begin.end() - 1);
+  for (int k = 0; k < n; ++k) {
+    for (int p = outer[k] + 1; p < outer[k + 1]; ++p) {
+      const int r = row_next[inner[p]]++;
+      row_pos[r] = p;
+      row_col[r] = k;
+    }
+  }
+
+  Eigen::VectorXd c_adj = Eigen::VectorXd::Zero(n);
+  for (int j = n - 1; j >= 0; --j) {
+    const int p_begin = outer[j];
+    const int p_end = outer[j + 1];
+    const double l_jj = l[p_begin];
+    double diag_adj = l_adj[p_begin];
+    for (int p = p_begin + 1; p < p_end; ++p) {
+      c_adj(inner[p]) = l_adj[p] / l_jj;
+      diag_adj -= l_adj[p] * l[p] / l_jj;
+    }
+    c_adj(j) = 0.5 * diag_adj / l_jj;
+    for (int p = p_begin; p < p_end; ++p) {
+      a_adj[p] = c_adj(inner[p]);
+    }
+    for (int r = row_begin[j]; r < row_begin[j + 1]; ++r) {
+      const int q = row_pos[r];
+      const int k = row_col[r];
+      const double l_jk = l[q];
+      double dot = 0;
+      for (int t = q; t < outer[k + 1]; ++t) {
+        dot += c_adj(inner[t]) * l[t];
+        l_adj[t] -= c_adj(inner[t]) * l_jk;
+      }
+      l_adj[q] -= dot;
+    }
+    for (int p = p_begin; p < p_end; ++p) {
+      c_adj(inner[p]) = 0;
+    }
+  }
+  return A_adj;
+}
 }  // namespace internal
 
 /**
@@ -167,7 +248,8 @@ inline auto cholesky_decompose(const EigMat& A) {
  * @param A A square positive definite matrix with no nan values.
  * @return L Cholesky factor of A
  */
-template <typename T, require_var_matrix_t<T>* = nullptr>
+template <typename T, require_var_matrix_t<T>* = nullptr,
+          require_not_var_sparse_matrix_t<T>* = nullptr>
 inline auto cholesky_decompose(const T& A) {
   check_symmetric("cholesky_decompose", "A", A.val());
   plain_type_t<T> L = cholesky_decompose(A.val());
@@ -179,6 +261,29 @@ inline auto cholesky_decompose(const T& A) {
   return L;
 }
 
+/**
+ * Reverse mode specialization of the Cholesky decomposition of a sparse
+ * matrix. As for dense matrices, the adjoint is propagated to the lower
+ * triangle of the matrix only.
+ *
+ * @tparam T A `var_value` holding a sparse matrix
+ * @param A A sparse, symmetric, positive definite matrix with no nan values.
+ * @return L Sparse Cholesky factor of A
+ */
+template <typename T, require_var_sparse_matrix_t<T>* = nullptr>
+inline var_value<Eigen::SparseMatrix<double>> cholesky_decompose(const T& A) {
+  var_value<Eigen::SparseMatrix<double>> L = cholesky_decompose(A.val());
+  reverse_pass_callback([A, L]() mutable {
+    const Eigen::SparseMatrix<double> A_adj
+        = internal::sparse_cholesky_adjoint(L.val(), L.adj());
+    internal::add_sparse_adjoints(
+        A, [&A_adj](Eigen::Index i, Eigen::Index j, double /* a_ij */) {
+          return i >= j ? A_adj.coeff(i, j) : 0.0;
+        });
+  });
+  return L;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
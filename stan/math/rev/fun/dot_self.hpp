@@ -44,7 +44,8 @@ inline var dot_self(const T& v) {
  * @param[in] v Vector.
  * @return Dot product of the vector with itself.
  */
-template <typename T, require_var_matrix_t<T>* = nullptr>
+template <typename T, require_var_matrix_t<T>* = nullptr,
+          require_not_var_sparse_matrix_t<T>* = nullptr>
 inline var dot_self(const T& v) {
   var res = v.val().dot(v.val());
   reverse_pass_callback(
@@ -53,6 +54,27 @@ inline var dot_self(const T& v) {
   return res;
 }
 
+/**
+ * Returns the sum of the squares of the nonzeros of a sparse matrix
+ * variable, the squared Frobenius norm of the matrix.
+ *
+ * @tparam T `var_value` of a sparse matrix
+ * @param[in] v sparse matrix
+ * @return Sum of the squared coefficients of the matrix.
+ */
+template <typename T, require_var_sparse_matrix_t<T>* = nullptr>
+inline var dot_self(const T& v) {
+  var res = v.val().squaredNorm();
+  reverse_pass_callback([res, v]() mutable {
+    const double two_res_adj = 2.0 * res.adj();
+    internal::add_sparse_adjoints(
+        v, [two_res_adj](Eigen::Index /* i */, Eigen::Index /* j */,
+                         double v_ij) { return two_res_adj * v_ij; });
+  });
+
+  return res;
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
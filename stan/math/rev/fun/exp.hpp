@@ -39,9 +39,14 @@ namespace math {
  * @return Exponentiated variable.
  */
 inline var exp(const var& a) {
+#ifdef STAN_OPCODE_TAPE
+  const double exp_a = std::exp(a.val());
+  return make_op_vari(exp_a, a.vi_, exp_a, op_fun::exp);
+#else
   return make_callback_var(std::exp(a.val()), [a](auto& vi) mutable {
     a.adj() += vi.adj() * vi.val();
   });
+#endif
 }
 
 /**
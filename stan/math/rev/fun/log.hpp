@@ -45,9 +45,13 @@ namespace math {
  * @return Natural log of variable.
  */
 inline var log(const var& a) {
+#ifdef STAN_OPCODE_TAPE
+  return make_op_vari(std::log(a.val()), a.vi_, 1.0 / a.val(), op_fun::log);
+#else
   return make_callback_var(std::log(a.val()), [a](auto& vi) mutable {
     a.adj() += vi.adj() / a.val();
   });
+#endif
 }
 
 /**
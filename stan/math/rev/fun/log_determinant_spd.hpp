@@ -7,6 +7,7 @@
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
 #include <stan/math/prim/fun/log.hpp>
+#include <stan/math/prim/fun/sparse_cholesky_factor.hpp>
 #include <stan/math/prim/fun/sum.hpp>
 #include <stan/math/prim/fun/typedefs.hpp>
 
@@ -70,7 +71,8 @@ inline var log_determinant_spd(const EigMat& m) {
  * @param m a symmetric, positive-definite matrix
  * @return The log determinant of the specified matrix
  */
-template <typename T, require_var_matrix_t<T>* = nullptr>
+template <typename T, require_var_matrix_t<T>* = nullptr,
+          require_not_var_sparse_matrix_t<T>* = nullptr>
 inline var log_determinant_spd(const T& m) {
   check_square("log_determinant_spd", "m", m);
 
@@ -103,6 +105,32 @@ inline var log_determinant_spd(const T& m) {
                            });
 }
 
+/**
+ * Returns the log det of a sparse, symmetric, positive-definite matrix.
+ *
+ * The gradient \f$A^{-1}\f$ is only needed on the nonzeros of the
+ * matrix, which the Takahashi recurrence computes from the sparse Cholesky
+ * factor at about the cost of the factorization.
+ *
+ * @tparam T A `var_value` holding a sparse matrix
+ * @param m a sparse, symmetric, positive-definite matrix
+ * @return The log determinant of the specified matrix
+ */
+template <typename T, require_var_sparse_matrix_t<T>* = nullptr>
+inline var log_determinant_spd(const T& m) {
+  check_square("log_determinant_spd", "m", m);
+  if (m.size() == 0) {
+    return var(0.0);
+  }
+  sparse_cholesky_factor factor("log_determinant_spd", "m", m.val());
+  auto* m_inv = make_chainable_ptr(factor.inverse_on_pattern(m.val()));
+  return make_callback_var(factor.log_determinant(),
+                           [m, m_inv](const auto& res) mutable {
+                             internal::add_sparse_adjoints_on_pattern(
+                                 m, res.adj() * *m_inv);
+                           });
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -0,0 +1,86 @@
+#ifndef STAN_MATH_REV_FUN_MATRIX_EXP_HPP
+#define STAN_MATH_REV_FUN_MATRIX_EXP_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/fun/value_of.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/matrix_exp.hpp>
+#include <stan/math/prim/fun/matrix_exp_pade.hpp>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Return the Fréchet derivative of the matrix exponential at
+ * <code>A</code> in the direction <code>E</code>, the upper right block of
+ * the exponential of the block triangular matrix [A, E; 0, A].
+ *
+ * The direction is scaled to the norm of <code>A</code> before taking the
+ * exponential so that the scaling and squaring of the Padé approximation
+ * is driven by <code>A</code> and not by the magnitude of
+ * <code>E</code>; the derivative is linear in <code>E</code>.
+ *
+ * @param A square matrix
+ * @param E direction, same size as A
+ * @return Fréchet derivative L(A, E)
+ */
+inline Eigen::MatrixXd matrix_exp_frechet(const Eigen::MatrixXd& A,
+                                          const Eigen::MatrixXd& E) {
+  const Eigen::Index n = A.rows();
+  const double E_norm = E.cwiseAbs().colwise().sum().maxCoeff();
+  if (E_norm == 0) {
+    return Eigen::MatrixXd::Zero(n, n);
+  }
+  const double A_norm = A.cwiseAbs().colwise().sum().maxCoeff();
+  const double scale = A_norm > 0 ? A_norm / E_norm : 1.0 / E_norm;
+  Eigen::MatrixXd X(2 * n, 2 * n);
+  X.topLeftCorner(n, n) = A;
+  X.topRightCorner(n, n) = scale * E;
+  X.bottomLeftCorner(n, n).setZero();
+  X.bottomRightCorner(n, n) = A;
+  return matrix_exp_pade(X).topRightCorner(n, n) / scale;
+}
+
+}  // namespace internal
+
+/**
+ * Return the matrix exponential of a matrix of vars.
+ *
+ * The value is computed in double precision and a single callback
+ * propagates the adjoint, which is the Fréchet derivative of the matrix
+ * exponential at the transposed argument applied to the adjoint of the
+ * result, adj(A) += L(A^T, adj(exp(A))).
+ *
+ * @tparam T type of the matrix, a `Matrix<var>` or `var_value<Matrix>`
+ * @param[in] A Matrix to exponentiate.
+ * @return Matrix exponential.
+ * @throw <code>std::invalid_argument</code> if the input matrix
+ * is not square.
+ */
+template <typename T, require_rev_matrix_t<T>* = nullptr>
+inline auto matrix_exp(const T& A) {
+  check_square("matrix_exp", "input matrix", A);
+
+  using ret_type = return_var_matrix_t<T>;
+  if (unlikely(A.size() == 0)) {
+    return ret_type(A);
+  }
+
+  arena_t<T> arena_A = A;
+  arena_t<ret_type> res = matrix_exp(arena_A.val().eval());
+
+  reverse_pass_callback([arena_A, res]() mutable {
+    arena_A.adj() += internal::matrix_exp_frechet(
+        arena_A.val().transpose(), res.adj());
+  });
+
+  return ret_type(res);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -6,6 +6,7 @@
 #include <stan/math/rev/core/typedefs.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/sparse_cholesky_factor.hpp>
 #include <stan/math/prim/fun/to_ref.hpp>
 #include <stan/math/prim/fun/typedefs.hpp>
 #include <vector>
@@ -257,6 +258,7 @@ mdivide_left_spd(const EigMat1 &A, const EigMat2 &b) {
  * as many rows as A has columns.
  */
 template <typename T1, typename T2, require_all_matrix_t<T1, T2> * = nullptr,
+          require_not_sparse_matrix_t<T1> * = nullptr,
           require_any_var_matrix_t<T1, T2> * = nullptr>
 inline auto mdivide_left_spd(const T1 &A, const T2 &B) {
   using ret_val_type = plain_type_t<decltype(value_of(A) * value_of(B))>;
@@ -349,6 +351,57 @@ inline auto mdivide_left_spd(const T1 &A, const T2 &B) {
   }
 }
 
+/**
+ * Returns the solution of the system Ax=B where A is a sparse, symmetric
+ * positive definite matrix and at least one of A and B is an autodiff
+ * type.
+ *
+ * The sparse Cholesky factor is kept for the reverse pass, which solves
+ * one more system and only propagates adjoints into the nonzeros of A.
+ *
+ * @tparam T1 type of the sparse matrix, a sparse matrix of doubles or a
+ * `var_value` of one
+ * @tparam T2 type of the right-hand side matrix or vector
+ *
+ * @param A Sparse matrix.
+ * @param B Right hand side matrix or vector.
+ * @return x = A^-1 B, solution of the linear system.
+ * @throws std::domain_error if A is not square or B does not have
+ * as many rows as A has columns.
+ */
+template <typename T1, typename T2, require_sparse_matrix_t<T1> * = nullptr,
+          require_matrix_t<T2> * = nullptr,
+          require_not_sparse_matrix_t<T2> * = nullptr,
+          require_return_type_t<is_var, T1, T2> * = nullptr>
+inline auto mdivide_left_spd(const T1 &A, const T2 &B) {
+  using ret_val_type = plain_type_t<decltype(value_of(B))>;
+  using ret_type = return_var_matrix_t<ret_val_type, T1, T2>;
+
+  check_multiplicable("mdivide_left_spd", "A", A, "B", B);
+  if (A.size() == 0) {
+    return ret_type(ret_val_type(0, B.cols()));
+  }
+
+  auto arena_A = internal::to_arena_sparse(A);
+  arena_t<T2> arena_B = B;
+  auto *factor = make_chainable_ptr(
+      sparse_cholesky_factor("mdivide_left_spd", "A", value_of(arena_A)));
+  arena_t<ret_type> res = factor->solve(value_of(arena_B));
+
+  reverse_pass_callback([arena_A, arena_B, factor, res]() mutable {
+    const ret_val_type adjB = factor->solve(res.adj());
+    const ret_val_type x = res.val();
+    internal::add_sparse_adjoints(
+        arena_A, [&adjB, &x](Eigen::Index i, Eigen::Index j,
+                             double /* a_ij */) {
+          return -adjB.row(i).dot(x.row(j));
+        });
+    internal::add_dense_adjoints(arena_B, adjB);
+  });
+
+  return ret_type(res);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
@@ -24,6 +24,7 @@ namespace math {
  * @return A * B
  */
 template <typename T1, typename T2, require_all_matrix_t<T1, T2>* = nullptr,
+          require_all_not_sparse_matrix_t<T1, T2>* = nullptr,
           require_return_type_t<is_var, T1, T2>* = nullptr,
           require_not_row_and_col_vector_t<T1, T2>* = nullptr>
 inline auto multiply(const T1& A, const T2& B) {
@@ -74,6 +75,122 @@ inline auto multiply(const T1& A, const T2& B) {
   }
 }
 
+/**
+ * Return the product of a sparse matrix and a dense matrix, where at
+ * least one of them is an autodiff type.
+ *
+ * The sparsity pattern of the sparse matrix is kept in the arena for the
+ * reverse pass, which only propagates adjoints into its nonzeros.
+ *
+ * @tparam T1 type of the sparse matrix, a sparse matrix of doubles or a
+ * `var_value` of one
+ * @tparam T2 type of the dense matrix
+ *
+ * @param[in] A sparse matrix
+ * @param[in] B dense matrix
+ * @return A * B
+ */
+template <typename T1, typename T2, require_sparse_matrix_t<T1>* = nullptr,
+          require_matrix_t<T2>* = nullptr,
+          require_not_sparse_matrix_t<T2>* = nullptr,
+          require_return_type_t<is_var, T1, T2>* = nullptr>
+inline auto multiply(const T1& A, const T2& B) {
+  check_multiplicable("multiply", "A", A, "B", B);
+  auto arena_A = internal::to_arena_sparse(A);
+  arena_t<T2> arena_B = B;
+  arena_t<promote_scalar_t<double, T2>> arena_B_val = value_of(arena_B);
+  using return_t
+      = return_var_matrix_t<decltype((value_of(arena_A) * arena_B_val).eval()),
+                            T1, T2>;
+  arena_t<return_t> res = value_of(arena_A) * arena_B_val;
+  reverse_pass_callback([arena_A, arena_B, arena_B_val, res]() mutable {
+    const auto res_adj = res.adj().eval();
+    internal::add_sparse_adjoints(
+        arena_A, [&res_adj, &arena_B_val](Eigen::Index i, Eigen::Index j,
+                                         double /* a_ij */) {
+          return res_adj.row(i).dot(arena_B_val.row(j));
+        });
+    internal::add_dense_adjoints(arena_B,
+                                 value_of(arena_A).transpose() * res_adj);
+  });
+  return return_t(res);
+}
+
+/**
+ * Return the product of a dense matrix and a sparse matrix, where at
+ * least one of them is an autodiff type.
+ *
+ * The sparsity pattern of the sparse matrix is kept in the arena for the
+ * reverse pass, which only propagates adjoints into its nonzeros.
+ *
+ * @tparam T1 type of the dense matrix
+ * @tparam T2 type of the sparse matrix, a sparse matrix of doubles or a
+ * `var_value` of one
+ *
+ * @param[in] A dense matrix
+ * @param[in] B sparse matrix
+ * @return A * B
+ */
+template <typename T1, typename T2, require_matrix_t<T1>* = nullptr,
+          require_not_sparse_matrix_t<T1>* = nullptr,
+          require_sparse_matrix_t<T2>* = nullptr,
+          require_return_type_t<is_var, T1, T2>* = nullptr>
+inline auto multiply(const T1& A, const T2& B) {
+  check_multiplicable("multiply", "A", A, "B", B);
+  arena_t<T1> arena_A = A;
+  arena_t<promote_scalar_t<double, T1>> arena_A_val = value_of(arena_A);
+  auto arena_B = internal::to_arena_sparse(B);
+  using return_t
+      = return_var_matrix_t<decltype((arena_A_val * value_of(arena_B)).eval()),
+                            T1, T2>;
+  arena_t<return_t> res = arena_A_val * value_of(arena_B);
+  reverse_pass_callback([arena_A, arena_A_val, arena_B, res]() mutable {
+    const auto res_adj = res.adj().eval();
+    internal::add_dense_adjoints(arena_A,
+                                 res_adj * value_of(arena_B).transpose());
+    internal::add_sparse_adjoints(
+        arena_B, [&res_adj, &arena_A_val](Eigen::Index i, Eigen::Index j,
+                                         double /* b_ij */) {
+          return arena_A_val.col(i).dot(res_adj.col(j));
+        });
+  });
+  return return_t(res);
+}
+
+/**
+ * Return the product of two sparse matrices, where at least one of them
+ * is a `var_value`, as a sparse matrix variable.
+ *
+ * @tparam T1 type of the first sparse matrix
+ * @tparam T2 type of the second sparse matrix
+ *
+ * @param[in] A first sparse matrix
+ * @param[in] B second sparse matrix
+ * @return A * B
+ */
+template <typename T1, typename T2,
+          require_all_sparse_matrix_t<T1, T2>* = nullptr,
+          require_any_var_sparse_matrix_t<T1, T2>* = nullptr>
+inline var_value<Eigen::SparseMatrix<double>> multiply(const T1& A,
+                                                       const T2& B) {
+  using sparse_t = Eigen::SparseMatrix<double>;
+  check_multiplicable("multiply", "A", A, "B", B);
+  auto arena_A = internal::to_arena_sparse(A);
+  auto arena_B = internal::to_arena_sparse(B);
+  var_value<sparse_t> res(sparse_t(value_of(arena_A) * value_of(arena_B)));
+  reverse_pass_callback([arena_A, arena_B, res]() mutable {
+    if (is_var<T1>::value) {
+      internal::add_sparse_adjoints_on_pattern(
+          arena_A, sparse_t(res.adj() * value_of(arena_B).transpose()));
+    }
+    if (is_var<T2>::value) {
+      internal::add_sparse_adjoints_on_pattern(
+          arena_B, sparse_t(value_of(arena_A).transpose() * res.adj()));
+    }
+  });
+  return res;
+}
+
 /**
  * Return the product of a row vector times a column vector as a scalar
  *
@@ -219,6 +219,67 @@ inline auto quad_form_impl(const Mat1& A, const Mat2& B, bool symmetric) {
     return res;
   }
 }
+
+/**
+ * Return the quadratic form \f$ B^T A B \f$ of a sparse matrix and a dense
+ * matrix.
+ *
+ * The sparsity pattern of A is kept in the arena for the reverse pass,
+ * which only propagates adjoints into its nonzeros.
+ *
+ * @tparam Mat1 type of the sparse matrix, a sparse matrix of doubles or a
+ * `var_value` of one
+ * @tparam Mat2 type of the dense matrix
+ *
+ * @param A square sparse matrix
+ * @param B dense matrix
+ * @param symmetric indicates whether the output should be made symmetric
+ * @return The quadratic form
+ * @throws std::invalid_argument if A is not square, or if A cannot be
+ * multiplied by B
+ */
+template <typename Mat1, typename Mat2,
+          require_sparse_matrix_t<Mat1>* = nullptr>
+inline auto quad_form_sparse_impl(const Mat1& A, const Mat2& B,
+                                  bool symmetric) {
+  check_square("quad_form", "A", A);
+  check_multiplicable("quad_form", "A", A, "B", B);
+
+  auto arena_A = to_arena_sparse(A);
+  arena_t<Mat2> arena_B = B;
+  arena_t<promote_scalar_t<double, Mat2>> arena_B_val = value_of(arena_B);
+  check_not_nan("quad_form", "B", arena_B_val);
+
+  using return_t
+      = return_var_matrix_t<decltype((arena_B_val.transpose() * arena_B_val)
+                                         .eval()),
+                            Mat1, Mat2>;
+  arena_t<Eigen::MatrixXd> arena_AB = value_of(arena_A) * arena_B_val;
+  Eigen::MatrixXd res_val = arena_B_val.transpose() * arena_AB;
+  if (symmetric) {
+    res_val = (0.5 * (res_val + res_val.transpose())).eval();
+  }
+  arena_t<return_t> res = res_val;
+
+  reverse_pass_callback(
+      [arena_A, arena_B, arena_B_val, arena_AB, res, symmetric]() mutable {
+        Eigen::MatrixXd res_adj = res.adj();
+        if (symmetric) {
+          res_adj = (0.5 * (res_adj + res_adj.transpose())).eval();
+        }
+        const Eigen::MatrixXd B_res_adj = arena_B_val * res_adj;
+        add_sparse_adjoints(arena_A, [&B_res_adj, &arena_B_val](
+                                         Eigen::Index i, Eigen::Index j,
+                                         double /* a_ij */) {
+          return B_res_adj.row(i).dot(arena_B_val.row(j));
+        });
+        add_dense_adjoints(arena_B,
+                           arena_AB * res_adj.transpose()
+                               + value_of(arena_A).transpose() * B_res_adj);
+      });
+
+  return res;
+}
 }  // namespace internal
 
 /**
@@ -239,6 +300,7 @@ inline auto quad_form_impl(const Mat1& A, const Mat2& B, bool symmetric) {
  */
 template <typename EigMat1, typename EigMat2,
           require_all_eigen_t<EigMat1, EigMat2>* = nullptr,
+          require_not_sparse_matrix_t<EigMat1>* = nullptr,
           require_not_eigen_col_vector_t<EigMat2>* = nullptr,
           require_any_vt_var<EigMat1, EigMat2>* = nullptr>
 inline promote_scalar_t<var, EigMat2> quad_form(const EigMat1& A,
@@ -269,6 +331,7 @@ inline promote_scalar_t<var, EigMat2> quad_form(const EigMat1& A,
  * multiplied by B
  */
 template <typename EigMat, typename ColVec, require_eigen_t<EigMat>* = nullptr,
+          require_not_sparse_matrix_t<EigMat>* = nullptr,
           require_eigen_col_vector_t<ColVec>* = nullptr,
           require_any_vt_var<EigMat, ColVec>* = nullptr>
 inline var quad_form(const EigMat& A, const ColVec& B, bool symmetric = false) {
@@ -306,6 +369,7 @@ inline var quad_form(const EigMat& A, const ColVec& B, bool symmetric = false) {
  */
 template <typename Mat1, typename Mat2,
           require_all_matrix_t<Mat1, Mat2>* = nullptr,
+          require_not_sparse_matrix_t<Mat1>* = nullptr,
           require_not_col_vector_t<Mat2>* = nullptr,
           require_any_var_matrix_t<Mat1, Mat2>* = nullptr>
 inline auto quad_form(const Mat1& A, const Mat2& B, bool symmetric = false) {
@@ -331,12 +395,62 @@ inline auto quad_form(const Mat1& A, const Mat2& B, bool symmetric = false) {
  * multiplied by B
  */
 template <typename Mat, typename Vec, require_matrix_t<Mat>* = nullptr,
+          require_not_sparse_matrix_t<Mat>* = nullptr,
           require_col_vector_t<Vec>* = nullptr,
           require_any_var_matrix_t<Mat, Vec>* = nullptr>
 inline var quad_form(const Mat& A, const Vec& B, bool symmetric = false) {
   return internal::quad_form_impl(A, B, symmetric)(0, 0);
 }
 
+/**
+ * Return the quadratic form \f$ B^T A B \f$ of a sparse matrix and a dense
+ * matrix, where at least one of them is an autodiff type.
+ *
+ * @tparam Mat1 type of the sparse matrix, a sparse matrix of doubles or a
+ * `var_value` of one
+ * @tparam Mat2 type of the dense matrix
+ *
+ * @param A square sparse matrix
+ * @param B dense matrix
+ * @param symmetric indicates whether the output should be made symmetric
+ * @return The quadratic form
+ * @throws std::invalid_argument if A is not square, or if A cannot be
+ * multiplied by B
+ */
+template <typename Mat1, typename Mat2,
+          require_sparse_matrix_t<Mat1>* = nullptr,
+          require_matrix_t<Mat2>* = nullptr,
+          require_not_sparse_matrix_t<Mat2>* = nullptr,
+          require_not_col_vector_t<Mat2>* = nullptr,
+          require_return_type_t<is_var, Mat1, Mat2>* = nullptr>
+inline auto quad_form(const Mat1& A, const Mat2& B, bool symmetric = false) {
+  using return_t = return_var_matrix_t<
+      decltype((value_of(B).transpose() * value_of(B)).eval()), Mat1, Mat2>;
+  return return_t(internal::quad_form_sparse_impl(A, B, symmetric));
+}
+
+/**
+ * Return the quadratic form \f$ B^T A B \f$ of a sparse matrix and a dense
+ * vector, where at least one of them is an autodiff type.
+ *
+ * @tparam Mat type of the sparse matrix, a sparse matrix of doubles or a
+ * `var_value` of one
+ * @tparam Vec type of the vector
+ *
+ * @param A square sparse matrix
+ * @param B vector
+ * @param symmetric indicates whether the output should be made symmetric
+ * @return The quadratic form (a scalar).
+ * @throws std::invalid_argument if A is not square, or if A cannot be
+ * multiplied by B
+ */
+template <typename Mat, typename Vec, require_sparse_matrix_t<Mat>* = nullptr,
+          require_col_vector_t<Vec>* = nullptr,
+          require_return_type_t<is_var, Mat, Vec>* = nullptr>
+inline var quad_form(const Mat& A, const Vec& B, bool symmetric = false) {
+  return internal::quad_form_sparse_impl(A, B, symmetric)(0, 0);
+}
+
 }  // namespace math
 }  // namespace stan
 #endif
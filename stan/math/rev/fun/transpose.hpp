@@ -0,0 +1,32 @@
+#ifndef STAN_MATH_REV_FUN_TRANSPOSE_HPP
+#define STAN_MATH_REV_FUN_TRANSPOSE_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+
+namespace stan {
+namespace math {
+
+/**
+ * Transposes a sparse matrix variable. The adjoint of the result is
+ * transposed back into the sparsity pattern of the argument.
+ *
+ * @tparam T `var_value` of a sparse matrix
+ * @param m sparse matrix
+ * @return transposed sparse matrix
+ */
+template <typename T, require_var_sparse_matrix_t<T>* = nullptr>
+inline var_value<Eigen::SparseMatrix<double>> transpose(const T& m) {
+  using sparse_t = Eigen::SparseMatrix<double>;
+  var_value<sparse_t> res(sparse_t(m.val().transpose()));
+  reverse_pass_callback([m, res]() mutable {
+    internal::add_sparse_adjoints_on_pattern(m,
+                                             sparse_t(res.adj().transpose()));
+  });
+  return res;
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
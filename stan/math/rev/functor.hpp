@@ -5,12 +5,16 @@
 #include <stan/math/rev/functor/algebra_solver_powell.hpp>
 #include <stan/math/rev/functor/algebra_solver_newton.hpp>
 #include <stan/math/rev/functor/algebra_system.hpp>
+#include <stan/math/rev/functor/analytic_jacobian.hpp>
 #include <stan/math/rev/functor/apply_scalar_unary.hpp>
 #include <stan/math/rev/functor/apply_vector_unary.hpp>
 #include <stan/math/rev/functor/coupled_ode_system.hpp>
+#include <stan/math/rev/functor/cvodes_adjoint_workspace.hpp>
 #include <stan/math/rev/functor/cvodes_integrator.hpp>
 #include <stan/math/rev/functor/cvodes_utils.hpp>
+#include <stan/math/rev/functor/cvodes_workspace.hpp>
 #include <stan/math/rev/functor/gradient.hpp>
+#include <stan/math/rev/functor/independent_sum.hpp>
 #include <stan/math/rev/functor/integrate_1d.hpp>
 #include <stan/math/rev/functor/integrate_dae.hpp>
 #include <stan/math/rev/functor/integrate_ode_adams.hpp>
@@ -18,6 +22,7 @@
 #include <stan/math/rev/functor/ode_adams.hpp>
 #include <stan/math/rev/functor/ode_bdf.hpp>
 #include <stan/math/rev/functor/ode_adjoint.hpp>
+#include <stan/math/rev/functor/ode_batch.hpp>
 #include <stan/math/rev/functor/ode_store_sensitivities.hpp>
 #include <stan/math/rev/functor/jacobian.hpp>
 #include <stan/math/rev/functor/kinsol_data.hpp>
@@ -26,6 +31,9 @@
 #include <stan/math/rev/functor/map_rect_reduce.hpp>
 #include <stan/math/rev/functor/operands_and_partials.hpp>
 #include <stan/math/rev/functor/reduce_sum.hpp>
+#include <stan/math/rev/functor/retaped_gradient.hpp>
+#include <stan/math/rev/functor/sundials_jacobian.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
 #include <stan/math/rev/functor/finite_diff_hessian_auto.hpp>
 
 #endif
@@ -0,0 +1,141 @@
+#ifndef STAN_MATH_REV_FUNCTOR_ANALYTIC_JACOBIAN_HPP
+#define STAN_MATH_REV_FUNCTOR_ANALYTIC_JACOBIAN_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/functor/sundials_jacobian.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+/**
+ * Wrapper of an ODE right hand side or a DAE residual functor together
+ * with a functor returning its Jacobian with respect to the states. Calls
+ * are forwarded to the wrapped functor unchanged.
+ *
+ * @tparam F ODE right hand side or DAE residual functor
+ * @tparam J Jacobian functor
+ */
+template <typename F, typename J>
+struct analytic_jacobian_functor {
+  F f_;
+  J jacobian_;
+
+  template <typename... T_args>
+  auto operator()(const T_args&... args) const {
+    return f_(args...);
+  }
+};
+
+/**
+ * Return the ODE right hand side or DAE residual functor wrapped so that
+ * the stiff solvers (<code>ode_bdf</code>, <code>ode_adams</code>,
+ * <code>ode_adjoint_tol_ctl</code> and <code>integrate_dae</code>) take the
+ * Jacobian of their Newton iterations from <code>jacobian</code> instead
+ * of one nested reverse sweep per state.
+ *
+ * For an ODE the Jacobian functor is called with the arguments of the
+ * right hand side with double values,
+ * <code>jacobian(t, y, msgs, args...)</code>, and returns
+ * \f$\partial f / \partial y\f$. For a DAE it is called as
+ * <code>jacobian(t, yy, yp, cj, theta, x_r, x_i, msgs)</code> and returns
+ * \f$\partial F / \partial y + c_j \partial F / \partial y'\f$. Either way
+ * the Jacobian is a square Eigen matrix or sparse matrix of doubles; a
+ * sparse Jacobian is stored at a cost linear in its number of nonzeros.
+ * Its entries outside of the band or the pattern of the linear solver are
+ * dropped.
+ *
+ * @tparam F ODE right hand side or DAE residual functor
+ * @tparam J Jacobian functor
+ * @param f ODE right hand side or DAE residual functor
+ * @param jacobian Jacobian functor
+ * @return wrapped functor, to be passed to the solvers in place of
+ * <code>f</code>
+ */
+template <typename F, typename J>
+inline analytic_jacobian_functor<F, J> analytic_jacobian(const F& f,
+                                                         const J& jacobian) {
+  return analytic_jacobian_functor<F, J>{f, jacobian};
+}
+
+namespace internal {
+
+/**
+ * Store a Jacobian returned by a Jacobian functor after checking its size.
+ *
+ * @tparam T type of the dense or sparse Jacobian
+ * @param function name of the calling function
+ * @param jacobian Jacobian
+ * @param N number of states
+ * @param linear_solver linear solver owning the matrix
+ * @param J Jacobian matrix of the linear solver
+ * @param transpose whether to store the transpose of the Jacobian
+ * @param scale factor applied to the Jacobian
+ */
+template <typename T>
+inline void store_analytic_jacobian(const char* function, const T& jacobian,
+                                    size_t N,
+                                    const sundials_linear_solver& linear_solver,
+                                    SUNMatrix J, bool transpose,
+                                    double scale) {
+  check_size_match(function, "rows of the Jacobian", jacobian.rows(),
+                   "states", N);
+  check_size_match(function, "columns of the Jacobian", jacobian.cols(),
+                   "states", N);
+  if (transpose) {
+    linear_solver.set_jacobian(J, jacobian.transpose(), scale);
+  } else {
+    linear_solver.set_jacobian(J, jacobian, scale);
+  }
+}
+
+/**
+ * Jacobian of an ODE right hand side which supplies it.
+ */
+template <typename F, typename JF>
+struct sundials_ode_jacobian<analytic_jacobian_functor<F, JF>> {
+  template <typename... Args>
+  static void store(const char* function,
+                    const analytic_jacobian_functor<F, JF>& f, double t,
+                    const Eigen::VectorXd& y, std::ostream* msgs,
+                    const std::tuple<Args...>& args_tuple,
+                    const sundials_linear_solver& linear_solver, SUNMatrix J,
+                    bool transpose, double scale) {
+    const auto jacobian = apply(
+        [&](auto&&... args) { return f.jacobian_(t, y, msgs, args...); },
+        args_tuple);
+    store_analytic_jacobian(function, jacobian, y.size(), linear_solver, J,
+                            transpose, scale);
+  }
+};
+
+/**
+ * Jacobian of a DAE residual which supplies it.
+ */
+template <typename F, typename JF>
+struct sundials_dae_jacobian<analytic_jacobian_functor<F, JF>> {
+  static constexpr bool supplied = true;
+
+  static void store(const analytic_jacobian_functor<F, JF>& f, double t,
+                    double cj, const std::vector<double>& yy,
+                    const std::vector<double>& yp,
+                    const std::vector<double>& theta,
+                    const std::vector<double>& x_r,
+                    const std::vector<int>& x_i, std::ostream* msgs,
+                    const sundials_linear_solver& linear_solver, SUNMatrix J) {
+    const auto jacobian = f.jacobian_(t, yy, yp, cj, theta, x_r, x_i, msgs);
+    store_analytic_jacobian("idas_integrator", jacobian, yy.size(),
+                            linear_solver, J, false, 1.0);
+  }
+};
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -58,6 +58,12 @@ namespace math {
  * parameter vector part of the nochain autodiff tape and is therefore
  * set to zero separately.
  *
+ * <p>Each call records the base ODE RHS once and takes one reverse sweep
+ * per state to form the Jacobians with respect to the states and the
+ * parameters, after which the sensitivity RHS is a pair of matrix
+ * products. Systems with few sensitivities relative to their states can
+ * instead wrap the functor with <code>ode_forward_sensitivity</code>.
+ *
  * @tparam F base ode system functor. Must provide
  *   <code>
  *     template<typename T_y, typename... T_args>
@@ -73,8 +79,10 @@ struct coupled_ode_system_impl<false, F, T_y0, Args...> {
   const size_t num_y0_vars_;
   const size_t num_args_vars;
   const size_t N_;
-  Eigen::VectorXd args_adjoints_;
-  Eigen::VectorXd y_adjoints_;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      jacobian_y_;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      jacobian_args_;
   std::ostream* msgs_;
 
   /**
@@ -96,8 +104,8 @@ struct coupled_ode_system_impl<false, F, T_y0, Args...> {
         num_y0_vars_(count_vars(y0_)),
         num_args_vars(count_vars(args...)),
         N_(y0.size()),
-        args_adjoints_(num_args_vars),
-        y_adjoints_(N_),
+        jacobian_y_(N_, N_),
+        jacobian_args_(N_, num_args_vars),
         msgs_(msgs) {}
 
   /**
@@ -132,23 +140,23 @@ struct coupled_ode_system_impl<false, F, T_y0, Args...> {
     check_size_match("coupled_ode_system", "dy_dt", f_y_t_vars.size(), "states",
                      N_);
 
+    // One reverse sweep per state fills row i of the Jacobians of the RHS
+    // with respect to the states and the parameters
     for (size_t i = 0; i < N_; ++i) {
       dz_dt[i] = f_y_t_vars.coeffRef(i).val();
       f_y_t_vars.coeffRef(i).grad();
 
-      y_adjoints_ = y_vars.adj();
+      jacobian_y_.row(i) = y_vars.adj();
 
-      if (args_adjoints_.size() > 0) {
-        memset(args_adjoints_.data(), 0,
-               sizeof(double) * args_adjoints_.size());
+      if (num_args_vars > 0) {
+        jacobian_args_.row(i).setZero();
+        apply(
+            [&](auto&&... args) {
+              accumulate_adjoints(jacobian_args_.row(i).data(), args...);
+            },
+            local_args_tuple_);
       }
 
-      apply(
-          [&](auto&&... args) {
-            accumulate_adjoints(args_adjoints_.data(), args...);
-          },
-          local_args_tuple_);
-
       // The vars here do not live on the nested stack so must be zero'd
       // separately
       stan::math::for_each([](auto&& arg) { zero_adjoints(arg); },
@@ -158,30 +166,23 @@ struct coupled_ode_system_impl<false, F, T_y0, Args...> {
       if (i + 1 < N_) {
         nested.set_zero_all_adjoints();
       }
-
-      // Compute the right hand side for the sensitivities with respect to the
-      // initial conditions
-      for (size_t j = 0; j < num_y0_vars_; ++j) {
-        double temp_deriv = 0.0;
-        for (size_t k = 0; k < N_; ++k) {
-          temp_deriv += z[N_ + N_ * j + k] * y_adjoints_.coeffRef(k);
-        }
-
-        dz_dt[N_ + N_ * j + i] = temp_deriv;
-      }
-
-      // Compute the right hand size for the sensitivities with respect to the
-      // parameters
-      for (size_t j = 0; j < num_args_vars; ++j) {
-        double temp_deriv = args_adjoints_.coeffRef(j);
-        for (size_t k = 0; k < N_; ++k) {
-          temp_deriv += z[N_ + N_ * num_y0_vars_ + N_ * j + k]
-                        * y_adjoints_.coeffRef(k);
-        }
-
-        dz_dt[N_ + N_ * num_y0_vars_ + N_ * j + i] = temp_deriv;
-      }
     }
+
+    // The sensitivities with respect to each initial condition and each
+    // parameter are stored as consecutive columns of length N, so the right
+    // hand side of the sensitivities is J_y * S for the initial conditions
+    // and J_y * S + J_args for the parameters
+    Eigen::Map<const Eigen::MatrixXd> S_y0(z.data() + N_, N_, num_y0_vars_);
+    Eigen::Map<Eigen::MatrixXd> dS_y0(dz_dt.data() + N_, N_, num_y0_vars_);
+    dS_y0.noalias() = jacobian_y_ * S_y0;
+
+    const size_t args_offset = N_ + N_ * num_y0_vars_;
+    Eigen::Map<const Eigen::MatrixXd> S_args(z.data() + args_offset, N_,
+                                             num_args_vars);
+    Eigen::Map<Eigen::MatrixXd> dS_args(dz_dt.data() + args_offset, N_,
+                                        num_args_vars);
+    dS_args = jacobian_args_;
+    dS_args.noalias() += jacobian_y_ * S_args;
   }
 
   /**
@@ -0,0 +1,380 @@
+#ifndef STAN_MATH_REV_FUNCTOR_CVODES_ADJOINT_WORKSPACE_HPP
+#define STAN_MATH_REV_FUNCTOR_CVODES_ADJOINT_WORKSPACE_HPP
+
+#include <stan/math/rev/functor/cvodes_utils.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
+#include <cvodes/cvodes.h>
+#include <nvector/nvector_serial.h>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+namespace stan {
+namespace math {
+
+/**
+ * CVODES memory, vectors, Jacobian matrices and linear solvers of the
+ * forward and backward problems of <code>ode_adjoint_tol_ctl</code>,
+ * together with an approximate budget for the memory of the checkpoints
+ * and counters of the work done by the solves.
+ *
+ * A workspace passed to several solves keeps the CVODES memory between
+ * them as long as consecutive problems have the same right hand side type,
+ * methods, interpolation, checkpoint spacing, size and linear solver, so
+ * that repeated solves only reinitialize CVODES.
+ *
+ * The checkpoints of the last forward solve are kept in the workspace. A
+ * reverse pass that finds them replaced by a later solve recomputes them,
+ * one output interval at a time, from the states at the output times. With
+ * a checkpoint memory budget the forward solve stores no checkpoints at
+ * all and every reverse pass recomputes them in segments short enough for
+ * their checkpoints and interpolation data to fit the budget, at the cost
+ * of integrating the forward problem at most twice more. CVODES does not
+ * report the memory it holds, so the budget is converted to a number of
+ * checkpoints from an estimate of their size, see
+ * <code>max_checkpoints()</code>, and is not a hard limit.
+ *
+ * Solves share the ownership of their workspace until the memory of their
+ * reverse pass is recovered. A workspace must only be used by one thread
+ * at a time.
+ */
+class cvodes_adjoint_workspace {
+ public:
+  /**
+   * Construct a workspace.
+   *
+   * @param max_checkpoint_memory approximate bound on the bytes of
+   * checkpoints and interpolation data held by CVODES at any time, or zero
+   * to keep all the checkpoints of the forward solve
+   */
+  explicit cvodes_adjoint_workspace(size_t max_checkpoint_memory = 0)
+      : max_checkpoint_memory_(max_checkpoint_memory) {}
+  cvodes_adjoint_workspace(const cvodes_adjoint_workspace&) = delete;
+  cvodes_adjoint_workspace& operator=(const cvodes_adjoint_workspace&)
+      = delete;
+
+  ~cvodes_adjoint_workspace() { clear(); }
+
+  /**
+   * Prepare the workspace for a problem, keeping the current CVODES memory
+   * if it was set up for a problem of the same kind and creating new memory
+   * otherwise. Any checkpoints held by the workspace are invalidated.
+   *
+   * @param rhs right hand side callback of the forward problem
+   * @param solver_forward multistep method of the forward problem
+   * @param solver_backward multistep method of the backward problem
+   * @param interpolation_polynomial interpolation between checkpoints
+   * @param num_steps_between_checkpoints steps between checkpoints
+   * @param N number of states
+   * @param num_args_vars number of parameters of the quadrature
+   * @param linear_solver linear solver of the forward problem
+   * @return true if the CVODES memory is reused and only needs to be
+   * reinitialized, false if it was created and needs to be set up
+   */
+  bool prepare(CVRhsFn rhs, int solver_forward, int solver_backward,
+               int interpolation_polynomial,
+               long int num_steps_between_checkpoints,  // NOLINT
+               size_t N, size_t num_args_vars,
+               const sundials_linear_solver& linear_solver) {
+    ++checkpoints_id_;
+    if (mem_ != nullptr && rhs == rhs_ && solver_forward == solver_forward_
+        && solver_backward == solver_backward_
+        && interpolation_polynomial == interpolation_polynomial_
+        && num_steps_between_checkpoints == num_steps_between_checkpoints_
+        && N == N_ && num_args_vars == num_args_vars_
+        && linear_solver == linear_solver_forward_) {
+      return true;
+    }
+    clear();
+    rhs_ = rhs;
+    solver_forward_ = solver_forward;
+    solver_backward_ = solver_backward;
+    interpolation_polynomial_ = interpolation_polynomial;
+    num_steps_between_checkpoints_ = num_steps_between_checkpoints;
+    N_ = N;
+    num_args_vars_ = num_args_vars;
+    linear_solver_forward_ = linear_solver;
+    linear_solver_backward_ = linear_solver.transpose();
+    mem_ = CVodeCreate(solver_forward);
+    if (mem_ == nullptr) {
+      throw std::runtime_error("CVodeCreate failed to allocate memory");
+    }
+    nv_state_forward_ = N_VNewEmpty_Serial(N);
+    nv_state_backward_ = N_VNewEmpty_Serial(N);
+    nv_quad_ = N_VNewEmpty_Serial(num_args_vars);
+    nv_absolute_tolerance_forward_ = N_VNewEmpty_Serial(N);
+    nv_absolute_tolerance_backward_ = N_VNewEmpty_Serial(N);
+    A_forward_ = linear_solver_forward_.make_matrix(N);
+    A_backward_ = linear_solver_backward_.make_matrix(N);
+    LS_forward_ = linear_solver_forward_.make_solver(nv_state_forward_,
+                                                     A_forward_);
+    LS_backward_ = linear_solver_backward_.make_solver(nv_state_backward_,
+                                                       A_backward_);
+    ++num_allocations_;
+    return false;
+  }
+
+  /**
+   * Point the vectors to the memory of a solve.
+   *
+   * @param state_forward state of the forward problem, of size N
+   * @param state_backward state of the backward problem, of size N
+   * @param quad quadrature of the backward problem, of size num_args_vars
+   * @param absolute_tolerance_forward absolute tolerances of the forward
+   * problem, of size N
+   * @param absolute_tolerance_backward absolute tolerances of the backward
+   * problem, of size N
+   */
+  void set_data(double* state_forward, double* state_backward, double* quad,
+                double* absolute_tolerance_forward,
+                double* absolute_tolerance_backward) {
+    NV_DATA_S(nv_state_forward_) = state_forward;
+    NV_DATA_S(nv_state_backward_) = state_backward;
+    NV_DATA_S(nv_quad_) = quad;
+    NV_DATA_S(nv_absolute_tolerance_forward_) = absolute_tolerance_forward;
+    NV_DATA_S(nv_absolute_tolerance_backward_) = absolute_tolerance_backward;
+  }
+
+  /**
+   * Return the approximate number of checkpoints that fit the memory budget
+   * besides the interpolation data between two checkpoints. The size of a
+   * checkpoint is estimated from the largest Nordsieck history of the
+   * forward method and that of the interpolation data from the values
+   * stored per step, without the bookkeeping of CVODES, so the memory held
+   * may exceed the budget by a small fraction.
+   *
+   * @return number of checkpoints, the largest int without a budget
+   */
+  int max_checkpoints() const {
+    if (max_checkpoint_memory_ == 0) {
+      return std::numeric_limits<int>::max();
+    }
+    const size_t max_order = solver_forward_ == CV_ADAMS ? 12 : 5;
+    const size_t checkpoint_bytes = (max_order + 2) * N_ * sizeof(double);
+    const size_t point_bytes
+        = (interpolation_polynomial_ == CV_HERMITE ? 2 : 1) * N_
+          * sizeof(double);
+    const size_t interpolation_bytes
+        = (num_steps_between_checkpoints_ + 1) * point_bytes;
+    if (max_checkpoint_memory_ <= interpolation_bytes) {
+      return 0;
+    }
+    const size_t num_checkpoints
+        = (max_checkpoint_memory_ - interpolation_bytes) / checkpoint_bytes;
+    return num_checkpoints
+                   > static_cast<size_t>(std::numeric_limits<int>::max())
+               ? std::numeric_limits<int>::max()
+               : static_cast<int>(num_checkpoints);
+  }
+
+  /**
+   * Take over the checkpoints for a forward solve, invalidating those of
+   * earlier solves.
+   *
+   * @return identifier of the checkpoints
+   */
+  size_t claim_checkpoints() { return ++checkpoints_id_; }
+
+  /**
+   * Return true if the checkpoints with the given identifier are still
+   * held by the workspace.
+   */
+  bool holds_checkpoints(size_t id) const { return id == checkpoints_id_; }
+
+  /**
+   * Add the steps and Jacobian evaluations of the forward problem since it
+   * was last initialized to the counters.
+   */
+  void count_forward() {
+    long int num_steps = 0;      // NOLINT(runtime/int)
+    long int num_jac_evals = 0;  // NOLINT(runtime/int)
+    check_flag_sundials(CVodeGetNumSteps(mem_, &num_steps),
+                        "CVodeGetNumSteps");
+    check_flag_sundials(CVodeGetNumJacEvals(mem_, &num_jac_evals),
+                        "CVodeGetNumJacEvals");
+    num_forward_steps_ += num_steps;
+    num_jacobian_evaluations_ += num_jac_evals;
+  }
+
+  /**
+   * Add the steps and Jacobian evaluations of the backward problem since it
+   * was last initialized to the counters.
+   */
+  void count_backward() {
+    void* mem_backward = CVodeGetAdjCVodeBmem(mem_, index_backward_);
+    long int num_steps = 0;      // NOLINT(runtime/int)
+    long int num_jac_evals = 0;  // NOLINT(runtime/int)
+    check_flag_sundials(CVodeGetNumSteps(mem_backward, &num_steps),
+                        "CVodeGetNumSteps");
+    check_flag_sundials(CVodeGetNumJacEvals(mem_backward, &num_jac_evals),
+                        "CVodeGetNumJacEvals");
+    num_backward_steps_ += num_steps;
+    num_jacobian_evaluations_ += num_jac_evals;
+  }
+
+  /**
+   * Add checkpoints stored by a forward solve to the counter.
+   *
+   * @param num_checkpoints number of checkpoints
+   */
+  void count_checkpoints(int num_checkpoints) {
+    num_checkpoints_ += num_checkpoints;
+  }
+
+  /**
+   * Count a solve using the workspace. A solve may prepare the workspace
+   * more than once, again before its reverse pass if another solve has
+   * used the workspace since.
+   */
+  void count_solve() { ++num_solves_; }
+
+  /**
+   * Count a forward segment recomputed by a reverse pass.
+   */
+  void count_recomputation() { ++num_recomputations_; }
+
+  /**
+   * Free the CVODES memory, vectors and linear solvers.
+   */
+  void clear() {
+    if (mem_ == nullptr) {
+      return;
+    }
+    CVodeFree(&mem_);
+    SUNLinSolFree(LS_forward_);
+    SUNLinSolFree(LS_backward_);
+    if (A_forward_ != nullptr) {
+      SUNMatDestroy(A_forward_);
+      SUNMatDestroy(A_backward_);
+    }
+    N_VDestroy_Serial(nv_state_forward_);
+    N_VDestroy_Serial(nv_state_backward_);
+    N_VDestroy_Serial(nv_quad_);
+    N_VDestroy_Serial(nv_absolute_tolerance_forward_);
+    N_VDestroy_Serial(nv_absolute_tolerance_backward_);
+    mem_ = nullptr;
+    A_forward_ = nullptr;
+    A_backward_ = nullptr;
+    LS_forward_ = nullptr;
+    LS_backward_ = nullptr;
+    index_backward_ = -1;
+    adjoint_initialized_ = false;
+  }
+
+  void* memory() { return mem_; }
+  N_Vector state_forward() { return nv_state_forward_; }
+  N_Vector state_backward() { return nv_state_backward_; }
+  N_Vector quad() { return nv_quad_; }
+  N_Vector absolute_tolerance_forward() {
+    return nv_absolute_tolerance_forward_;
+  }
+  N_Vector absolute_tolerance_backward() {
+    return nv_absolute_tolerance_backward_;
+  }
+  SUNMatrix matrix_forward() { return A_forward_; }
+  SUNMatrix matrix_backward() { return A_backward_; }
+  SUNLinearSolver linear_solver_forward() { return LS_forward_; }
+  SUNLinearSolver linear_solver_backward() { return LS_backward_; }
+  const sundials_linear_solver& linear_solver_forward_type() const {
+    return linear_solver_forward_;
+  }
+  const sundials_linear_solver& linear_solver_backward_type() const {
+    return linear_solver_backward_;
+  }
+
+  /**
+   * Return true if the backward problem has been created.
+   */
+  bool has_backward() const { return index_backward_ >= 0; }
+
+  /**
+   * Return the CVODES index of the backward problem.
+   */
+  int& index_backward() { return index_backward_; }
+
+  /**
+   * Return true if the adjoint module of CVODES has been initialized.
+   */
+  bool& adjoint_initialized() { return adjoint_initialized_; }
+
+  /**
+   * Return the approximate bound on the bytes of checkpoint memory, zero if
+   * there is none.
+   */
+  size_t max_checkpoint_memory() const { return max_checkpoint_memory_; }
+
+  /**
+   * Return the number of solves that used the workspace.
+   */
+  size_t num_solves() const { return num_solves_; }
+
+  /**
+   * Return the number of times CVODES memory was created.
+   */
+  size_t num_allocations() const { return num_allocations_; }
+
+  /**
+   * Return the number of steps taken by the forward problem, including
+   * the steps of recomputed segments.
+   */
+  size_t num_forward_steps() const { return num_forward_steps_; }
+
+  /**
+   * Return the number of steps taken by the backward problem.
+   */
+  size_t num_backward_steps() const { return num_backward_steps_; }
+
+  /**
+   * Return the number of checkpoints stored by the forward problem.
+   */
+  size_t num_checkpoints() const { return num_checkpoints_; }
+
+  /**
+   * Return the number of Jacobian evaluations of the forward and backward
+   * problems.
+   */
+  size_t num_jacobian_evaluations() const {
+    return num_jacobian_evaluations_;
+  }
+
+  /**
+   * Return the number of forward segments recomputed by reverse passes.
+   */
+  size_t num_recomputations() const { return num_recomputations_; }
+
+ private:
+  size_t max_checkpoint_memory_;
+  void* mem_{nullptr};
+  N_Vector nv_state_forward_{nullptr};
+  N_Vector nv_state_backward_{nullptr};
+  N_Vector nv_quad_{nullptr};
+  N_Vector nv_absolute_tolerance_forward_{nullptr};
+  N_Vector nv_absolute_tolerance_backward_{nullptr};
+  SUNMatrix A_forward_{nullptr};
+  SUNMatrix A_backward_{nullptr};
+  SUNLinearSolver LS_forward_{nullptr};
+  SUNLinearSolver LS_backward_{nullptr};
+  sundials_linear_solver linear_solver_forward_;
+  sundials_linear_solver linear_solver_backward_;
+  CVRhsFn rhs_{nullptr};
+  int solver_forward_{0};
+  int solver_backward_{0};
+  int interpolation_polynomial_{0};
+  long int num_steps_between_checkpoints_{0};  // NOLINT(runtime/int)
+  size_t N_{0};
+  size_t num_args_vars_{0};
+  int index_backward_{-1};
+  bool adjoint_initialized_{false};
+  size_t checkpoints_id_{0};
+  size_t num_solves_{0};
+  size_t num_allocations_{0};
+  size_t num_forward_steps_{0};
+  size_t num_backward_steps_{0};
+  size_t num_checkpoints_{0};
+  size_t num_jacobian_evaluations_{0};
+  size_t num_recomputations_{0};
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
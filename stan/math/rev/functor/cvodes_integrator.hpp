@@ -4,12 +4,15 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/functor/cvodes_utils.hpp>
 #include <stan/math/rev/functor/coupled_ode_system.hpp>
+#include <stan/math/rev/functor/cvodes_workspace.hpp>
 #include <stan/math/rev/functor/ode_store_sensitivities.hpp>
+#include <stan/math/rev/functor/sundials_jacobian.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
 #include <cvodes/cvodes.h>
+#include <cvodes/cvodes_bandpre.h>
 #include <nvector/nvector_serial.h>
-#include <sunlinsol/sunlinsol_dense.h>
 #include <algorithm>
 #include <ostream>
 #include <vector>
@@ -47,6 +50,7 @@ class cvodes_integrator {
   double relative_tolerance_;
   double absolute_tolerance_;
   long int max_num_steps_;  // NOLINT(runtime/int)
+  const sundials_linear_solver linear_solver_;
 
   const size_t num_y0_vars_;
   const size_t num_args_vars_;
@@ -54,10 +58,6 @@ class cvodes_integrator {
   coupled_ode_system<F, T_y0_t0, T_Args...> coupled_ode_;
 
   std::vector<double> coupled_state_;
-  N_Vector nv_state_;
-  N_Vector* nv_state_sens_;
-  SUNMatrix A_;
-  SUNLinearSolver LS_;
 
   /**
    * Implements the function of type CVRhsFn which is the user-defined
@@ -117,21 +117,9 @@ class cvodes_integrator {
    * given time-point t and state y.
    */
   inline void jacobian_states(double t, const double y[], SUNMatrix J) const {
-    Eigen::VectorXd fy;
-    Eigen::MatrixXd Jfy;
-
-    auto f_wrapped = [&](const Eigen::Matrix<var, Eigen::Dynamic, 1>& y) {
-      return apply([&](auto&&... args) { return f_(t, y, msgs_, args...); },
-                   value_of_args_tuple_);
-    };
-
-    jacobian(f_wrapped, Eigen::Map<const Eigen::VectorXd>(y, N_), fy, Jfy);
-
-    for (size_t j = 0; j < Jfy.cols(); ++j) {
-      for (size_t i = 0; i < Jfy.rows(); ++i) {
-        SM_ELEMENT_D(J, i, j) = Jfy(i, j);
-      }
-    }
+    internal::sundials_ode_jacobian<F>::store(
+        "cvodes_integrator", f_, t, Eigen::Map<const Eigen::VectorXd>(y, N_),
+        msgs_, value_of_args_tuple_, linear_solver_, J, false, 1.0);
   }
 
   /**
@@ -171,6 +159,7 @@ class cvodes_integrator {
    * @param absolute_tolerance Absolute tolerance passed to CVODES
    * @param max_num_steps Upper limit on the number of integration steps to
    *   take between each output (error if exceeded)
+   * @param linear_solver Linear solver for the Newton iterations
    * @param[in, out] msgs the print stream for warning messages
    * @param args Extra arguments passed unmodified through to ODE right hand
    * side function
@@ -188,6 +177,7 @@ class cvodes_integrator {
                     const T_t0& t0, const std::vector<T_ts>& ts,
                     double relative_tolerance, double absolute_tolerance,
                     long int max_num_steps,  // NOLINT(runtime/int)
+                    const sundials_linear_solver& linear_solver,
                     std::ostream* msgs, const T_Args&... args)
       : function_name_(function_name),
         f_(f),
@@ -201,6 +191,7 @@ class cvodes_integrator {
         relative_tolerance_(relative_tolerance),
         absolute_tolerance_(absolute_tolerance),
         max_num_steps_(max_num_steps),
+        linear_solver_(linear_solver),
         num_y0_vars_(count_vars(y0_)),
         num_args_vars_(count_vars(args...)),
         coupled_ode_(f, y0_, msgs, args...),
@@ -228,29 +219,7 @@ class cvodes_integrator {
     check_positive_finite(function_name, "absolute_tolerance",
                           absolute_tolerance_);
     check_positive(function_name, "max_num_steps", max_num_steps_);
-
-    nv_state_ = N_VMake_Serial(N_, &coupled_state_[0]);
-    nv_state_sens_ = nullptr;
-    A_ = SUNDenseMatrix(N_, N_);
-    LS_ = SUNDenseLinearSolver(nv_state_, A_);
-
-    if (num_y0_vars_ + num_args_vars_ > 0) {
-      nv_state_sens_ = N_VCloneVectorArrayEmpty_Serial(
-          num_y0_vars_ + num_args_vars_, nv_state_);
-      for (std::size_t i = 0; i < num_y0_vars_ + num_args_vars_; i++) {
-        NV_DATA_S(nv_state_sens_[i]) = &coupled_state_[N_] + i * N_;
-      }
-    }
-  }
-
-  ~cvodes_integrator() {
-    SUNLinSolFree(LS_);
-    SUNMatDestroy(A_);
-    N_VDestroy_Serial(nv_state_);
-    if (num_y0_vars_ + num_args_vars_ > 0) {
-      N_VDestroyVectorArray_Serial(nv_state_sens_,
-                                   num_y0_vars_ + num_args_vars_);
-    }
+    linear_solver_.check(function_name, N_);
   }
 
   /**
@@ -262,17 +231,40 @@ class cvodes_integrator {
    *   solution time (excluding the initial state)
    */
   std::vector<Eigen::Matrix<T_Return, Eigen::Dynamic, 1>> operator()() {
+    cvodes_workspace workspace;
+    return (*this)(workspace);
+  }
+
+  /**
+   * Solve the ODE initial value problem with the CVODES memory, vectors and
+   * linear solver of a workspace, which are reused if they were set up by
+   * a previous solve of a system of the same kind.
+   *
+   * @param[in, out] workspace CVODES workspace
+   * @return std::vector of Eigen::Matrix of the states of the ODE, one for each
+   *   solution time (excluding the initial state)
+   */
+  std::vector<Eigen::Matrix<T_Return, Eigen::Dynamic, 1>> operator()(
+      cvodes_workspace& workspace) {
     std::vector<Eigen::Matrix<T_Return, Eigen::Dynamic, 1>> y;
+    const size_t num_sens = num_y0_vars_ + num_args_vars_;
 
-    void* cvodes_mem = CVodeCreate(Lmm);
-    if (cvodes_mem == nullptr) {
-      throw std::runtime_error("CVodeCreate failed to allocate memory");
-    }
+    const bool reuse = workspace.prepare(&cvodes_integrator::cv_rhs, Lmm, N_,
+                                         num_sens, linear_solver_);
+    workspace.set_state(coupled_state_.data());
+    void* cvodes_mem = workspace.memory();
+    N_Vector nv_state = workspace.state();
+    N_Vector* nv_state_sens = workspace.state_sensitivities();
 
     try {
-      check_flag_sundials(CVodeInit(cvodes_mem, &cvodes_integrator::cv_rhs,
-                                    value_of(t0_), nv_state_),
-                          "CVodeInit");
+      if (reuse) {
+        check_flag_sundials(CVodeReInit(cvodes_mem, value_of(t0_), nv_state),
+                            "CVodeReInit");
+      } else {
+        check_flag_sundials(CVodeInit(cvodes_mem, &cvodes_integrator::cv_rhs,
+                                      value_of(t0_), nv_state),
+                            "CVodeInit");
+      }
 
       // Assign pointer to this as user data
       check_flag_sundials(
@@ -285,19 +277,36 @@ class cvodes_integrator {
                                             absolute_tolerance_),
                           "CVodeSStolerances");
 
-      check_flag_sundials(CVodeSetLinearSolver(cvodes_mem, LS_, A_),
-                          "CVodeSetLinearSolver");
-      check_flag_sundials(
-          CVodeSetJacFn(cvodes_mem, &cvodes_integrator::cv_jacobian_states),
-          "CVodeSetJacFn");
+      if (!reuse) {
+        check_flag_sundials(
+            CVodeSetLinearSolver(cvodes_mem, workspace.linear_solver(),
+                                 workspace.matrix()),
+            "CVodeSetLinearSolver");
+        if (linear_solver_.has_matrix()) {
+          check_flag_sundials(
+              CVodeSetJacFn(cvodes_mem, &cvodes_integrator::cv_jacobian_states),
+              "CVodeSetJacFn");
+        } else if (linear_solver_.has_band_preconditioner()) {
+          check_flag_sundials(
+              CVBandPrecInit(cvodes_mem, N_, linear_solver_.upper_bandwidth(),
+                             linear_solver_.lower_bandwidth()),
+              "CVBandPrecInit");
+        }
+      }
 
       // initialize forward sensitivity system of CVODES as needed
-      if (num_y0_vars_ + num_args_vars_ > 0) {
-        check_flag_sundials(
-            CVodeSensInit(
-                cvodes_mem, static_cast<int>(num_y0_vars_ + num_args_vars_),
-                CV_STAGGERED, &cvodes_integrator::cv_rhs_sens, nv_state_sens_),
-            "CVodeSensInit");
+      if (num_sens > 0) {
+        if (reuse) {
+          check_flag_sundials(
+              CVodeSensReInit(cvodes_mem, CV_STAGGERED, nv_state_sens),
+              "CVodeSensReInit");
+        } else {
+          check_flag_sundials(
+              CVodeSensInit(cvodes_mem, static_cast<int>(num_sens),
+                            CV_STAGGERED, &cvodes_integrator::cv_rhs_sens,
+                            nv_state_sens),
+              "CVodeSensInit");
+        }
 
         check_flag_sundials(CVodeSetSensErrCon(cvodes_mem, SUNTRUE),
                             "CVodeSetSensErrCon");
@@ -312,7 +321,7 @@ class cvodes_integrator {
 
         if (t_final != t_init) {
           int error_code
-              = CVode(cvodes_mem, t_final, nv_state_, &t_init, CV_NORMAL);
+              = CVode(cvodes_mem, t_final, nv_state, &t_init, CV_NORMAL);
 
           if (error_code == CV_TOO_MUCH_WORK) {
             throw_domain_error(function_name_, "", t_final,
@@ -322,9 +331,9 @@ class cvodes_integrator {
             check_flag_sundials(error_code, "CVode");
           }
 
-          if (num_y0_vars_ + num_args_vars_ > 0) {
+          if (num_sens > 0) {
             check_flag_sundials(
-                CVodeGetSens(cvodes_mem, &t_init, nv_state_sens_),
+                CVodeGetSens(cvodes_mem, &t_init, nv_state_sens),
                 "CVodeGetSens");
           }
         }
@@ -339,12 +348,11 @@ class cvodes_integrator {
         t_init = t_final;
       }
     } catch (const std::exception& e) {
-      CVodeFree(&cvodes_mem);
+      // the state of CVODES after a failure is not reused
+      workspace.clear();
       throw;
     }
 
-    CVodeFree(&cvodes_mem);
-
     return y;
   }
 };  // cvodes integrator
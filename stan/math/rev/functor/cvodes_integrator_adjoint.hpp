@@ -3,16 +3,19 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/core/save_varis.hpp>
+#include <stan/math/rev/functor/cvodes_adjoint_workspace.hpp>
 #include <stan/math/rev/functor/cvodes_utils.hpp>
 #include <stan/math/rev/functor/ode_store_sensitivities.hpp>
+#include <stan/math/rev/functor/sundials_jacobian.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
 #include <stan/math/prim/functor/for_each.hpp>
 #include <cvodes/cvodes.h>
+#include <cvodes/cvodes_bandpre.h>
 #include <nvector/nvector_serial.h>
-#include <sunmatrix/sunmatrix_dense.h>
-#include <sunlinsol/sunlinsol_dense.h>
 #include <algorithm>
+#include <memory>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -69,84 +72,45 @@ class cvodes_integrator_adjoint_vari : public vari_base {
   int interpolation_polynomial_;
   int solver_forward_;
   int solver_backward_;
-  int index_backward_;
-  bool backward_is_initialized_{false};
+  int max_checkpoints_;
+  size_t checkpoints_id_{0};
 
   /**
    * Since the CVODES solver manages memory with malloc calls, these resources
    * must be freed using a destructor call (which is not being called for the
-   * vari class).
+   * vari class). The CVODES memory is held by a workspace, shared with the
+   * caller or else of the solver's own, which lives as long as the solver.
    */
   struct cvodes_solver : public chainable_alloc {
     const std::string function_name_str_;
     const std::decay_t<F> f_;
     const size_t N_;
-    N_Vector nv_state_forward_;
-    N_Vector nv_state_backward_;
-    N_Vector nv_quad_;
-    N_Vector nv_absolute_tolerance_forward_;
-    N_Vector nv_absolute_tolerance_backward_;
-    SUNMatrix A_forward_;
-    SUNLinearSolver LS_forward_;
-    SUNMatrix A_backward_;
-    SUNLinearSolver LS_backward_;
-    void* cvodes_mem_;
+    const sundials_linear_solver linear_solver_;
+    std::shared_ptr<cvodes_adjoint_workspace> workspace_;
     std::vector<Eigen::Matrix<T_Return, Eigen::Dynamic, 1>> y_return_;
     std::tuple<T_Args...> local_args_tuple_;
     const std::tuple<
         promote_scalar_t<partials_type_t<scalar_type_t<T_Args>>, T_Args>...>
         value_of_args_tuple_;
 
-    template <typename FF, typename StateFwd, typename StateBwd, typename Quad,
-              typename AbsTolFwd, typename AbsTolBwd>
-    cvodes_solver(const char* function_name, FF&& f, size_t N,
-                  size_t num_args_vars, size_t ts_size, int solver_forward,
-                  StateFwd& state_forward, StateBwd& state_backward, Quad& quad,
-                  AbsTolFwd& absolute_tolerance_forward,
-                  AbsTolBwd& absolute_tolerance_backward, const T_Args&... args)
+    template <typename FF>
+    cvodes_solver(const char* function_name, FF&& f, size_t N, size_t ts_size,
+                  const sundials_linear_solver& linear_solver,
+                  std::shared_ptr<cvodes_adjoint_workspace> workspace,
+                  const T_Args&... args)
         : chainable_alloc(),
           f_(std::forward<FF>(f)),
           function_name_str_(function_name),
-          y_return_(ts_size),
-          nv_state_forward_(N_VMake_Serial(N, state_forward.data())),
-          nv_state_backward_(N_VMake_Serial(N, state_backward.data())),
-          nv_quad_(N_VMake_Serial(num_args_vars, quad.data())),
-          nv_absolute_tolerance_forward_(
-              N_VMake_Serial(N, absolute_tolerance_forward.data())),
-          nv_absolute_tolerance_backward_(
-              N_VMake_Serial(N, absolute_tolerance_backward.data())),
-          A_forward_(SUNDenseMatrix(N, N)),
-          A_backward_(SUNDenseMatrix(N, N)),
-          LS_forward_(
-              N == 0 ? nullptr
-                     : SUNDenseLinearSolver(nv_state_forward_, A_forward_)),
-          LS_backward_(
-              N == 0 ? nullptr
-                     : SUNDenseLinearSolver(nv_state_backward_, A_backward_)),
           N_(N),
-          cvodes_mem_(CVodeCreate(solver_forward)),
+          linear_solver_(linear_solver),
+          workspace_(workspace == nullptr
+                         ? std::make_shared<cvodes_adjoint_workspace>()
+                         : std::move(workspace)),
+          y_return_(ts_size),
           local_args_tuple_(deep_copy_vars(args)...),
-          value_of_args_tuple_(value_of(args)...) {
-      if (cvodes_mem_ == nullptr) {
-        throw std::runtime_error("CVodeCreate failed to allocate memory");
-      }
-    }
+          value_of_args_tuple_(value_of(args)...) {}
 
-    virtual ~cvodes_solver() {
-      SUNMatDestroy(A_forward_);
-      SUNMatDestroy(A_backward_);
-      if (N_ > 0) {
-        SUNLinSolFree(LS_forward_);
-        SUNLinSolFree(LS_backward_);
-      }
-      N_VDestroy_Serial(nv_state_forward_);
-      N_VDestroy_Serial(nv_state_backward_);
-      N_VDestroy_Serial(nv_quad_);
-      N_VDestroy_Serial(nv_absolute_tolerance_forward_);
-      N_VDestroy_Serial(nv_absolute_tolerance_backward_);
-
-      CVodeFree(&cvodes_mem_);
-    }
+    virtual ~cvodes_solver() {}
   };
   cvodes_solver* solver_{nullptr};
 
@@ -182,7 +146,11 @@ class cvodes_integrator_adjoint_vari : public vari_base {
    * @param interpolation_polynomial type of polynomial used for interpolation
    * @param solver_forward solver used for forward pass
    * @param solver_backward solver used for backward pass
-   *   take between each output (error if exceeded)
+   * @param linear_solver Linear solver for the Newton iterations of the
+   * forward problem; the backward problem uses its transpose
+   * @param shared_workspace Workspace holding the CVODES memory and
+   * counting the work of the solve, shared with the solver until its memory
+   * is recovered, or nullptr for a workspace of the solve's own
    * @param[in, out] msgs the print stream for warning messages
    * @param args Extra arguments passed unmodified through to ODE right hand
    * side function
@@ -202,6 +170,8 @@ class cvodes_integrator_adjoint_vari : public vari_base {
       long int max_num_steps,                  // NOLINT(runtime/int)
       long int num_steps_between_checkpoints,  // NOLINT(runtime/int)
       int interpolation_polynomial, int solver_forward, int solver_backward,
+      const sundials_linear_solver& linear_solver,
+      std::shared_ptr<cvodes_adjoint_workspace> shared_workspace,
       std::ostream* msgs, const T_Args&... args)
       : vari_base(),
         y_(ts.size()),
@@ -232,7 +202,7 @@ class cvodes_integrator_adjoint_vari : public vari_base {
         interpolation_polynomial_(interpolation_polynomial),
         solver_forward_(solver_forward),
         solver_backward_(solver_backward),
-        backward_is_initialized_(false),
+        max_checkpoints_(0),
         solver_(nullptr) {
     check_finite(function_name, "initial state", y0);
     check_finite(function_name, "initial time", t0);
@@ -261,6 +231,7 @@ class cvodes_integrator_adjoint_vari : public vari_base {
     check_positive(function_name, "max_num_steps", max_num_steps_);
     check_positive(function_name, "num_steps_between_checkpoints",
                    num_steps_between_checkpoints_);
+    linear_solver.check(function_name, N_);
     // for polynomial: 1=CV_HERMITE / 2=CV_POLYNOMIAL
     if (interpolation_polynomial_ != 1 && interpolation_polynomial_ != 2)
       invalid_argument(function_name, "interpolation_polynomial",
@@ -275,10 +246,9 @@ class cvodes_integrator_adjoint_vari : public vari_base {
       invalid_argument(function_name, "solver_backward", solver_backward_, "",
                        ", must be 1 for Adams or 2 for BDF backward solver");
 
-    solver_ = new cvodes_solver(
-        function_name, f, N_, num_args_vars_, ts_.size(), solver_forward_,
-        state_forward_, state_backward_, quad_, absolute_tolerance_forward_,
-        absolute_tolerance_backward_, args...);
+    solver_ = new cvodes_solver(function_name, f, N_, ts_.size(),
+                                linear_solver, std::move(shared_workspace),
+                                args...);
 
     stan::math::for_each(
         [func_name = function_name](auto&& arg) {
@@ -286,39 +256,33 @@ class cvodes_integrator_adjoint_vari : public vari_base {
         },
         solver_->local_args_tuple_);
 
-    check_flag_sundials(
-        CVodeInit(solver_->cvodes_mem_, &cvodes_integrator_adjoint_vari::cv_rhs,
-                  value_of(t0_), solver_->nv_state_forward_),
-        "CVodeInit");
-
-    // Assign pointer to this as user data
-    check_flag_sundials(
-        CVodeSetUserData(solver_->cvodes_mem_, reinterpret_cast<void*>(this)),
-        "CVodeSetUserData");
-
-    cvodes_set_options(solver_->cvodes_mem_, max_num_steps_);
-
-    check_flag_sundials(
-        CVodeSVtolerances(solver_->cvodes_mem_, relative_tolerance_forward_,
-                          solver_->nv_absolute_tolerance_forward_),
-        "CVodeSVtolerances");
-
-    check_flag_sundials(
-        CVodeSetLinearSolver(solver_->cvodes_mem_, solver_->LS_forward_,
-                             solver_->A_forward_),
-        "CVodeSetLinearSolver");
-
-    check_flag_sundials(
-        CVodeSetJacFn(solver_->cvodes_mem_,
-                      &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_states),
-        "CVodeSetJacFn");
-
-    // initialize backward sensitivity system of CVODES as needed
-    if (is_var_return_ && !is_var_only_ts_) {
-      check_flag_sundials(
-          CVodeAdjInit(solver_->cvodes_mem_, num_steps_between_checkpoints_,
-                       interpolation_polynomial_),
-          "CVodeAdjInit");
+    workspace().count_solve();
+    prepare_forward();
+    set_forward_options();
+    void* cvodes_mem = workspace().memory();
+
+    // initialize backward sensitivity system of CVODES as needed. Without
+    // a checkpoint memory budget the forward solve stores the checkpoints,
+    // otherwise the reverse pass recomputes them
+    const bool is_adjoint = is_var_return_ && !is_var_only_ts_;
+    const bool is_checkpointed
+        = is_adjoint && workspace().max_checkpoint_memory() == 0;
+    if (is_adjoint) {
+      max_checkpoints_ = workspace().max_checkpoints();
+      if (max_checkpoints_ < 2) {
+        invalid_argument(function_name, "max_checkpoint_memory",
+                         workspace().max_checkpoint_memory(), "",
+                         ", must hold at least two checkpoints and the "
+                         "interpolation data between them");
+      }
+      if (!workspace().adjoint_initialized()) {
+        init_adjoint();
+      } else if (is_checkpointed) {
+        check_flag_sundials(CVodeAdjReInit(cvodes_mem), "CVodeAdjReInit");
+      }
+      if (is_checkpointed) {
+        checkpoints_id_ = workspace().claim_checkpoints();
+      }
     }
 
     /**
@@ -327,16 +291,15 @@ class cvodes_integrator_adjoint_vari : public vari_base {
      */
     const auto ts_dbl = value_of(ts_);
 
+    int ncheck = 0;
     double t_init = value_of(t0_);
     for (size_t n = 0; n < ts_dbl.size(); ++n) {
       double t_final = ts_dbl[n];
       if (t_final != t_init) {
-        if (is_var_return_ && !is_var_only_ts_) {
-          int ncheck;
-
+        if (is_checkpointed) {
           int error_code
-              = CVodeF(solver_->cvodes_mem_, t_final,
-                       solver_->nv_state_forward_, &t_init, CV_NORMAL, &ncheck);
+              = CVodeF(cvodes_mem, t_final, workspace().state_forward(),
+                       &t_init, CV_NORMAL, &ncheck);
 
           if (unlikely(error_code == CV_TOO_MUCH_WORK)) {
             throw_domain_error(solver_->function_name_str_.c_str(), "", t_final,
@@ -347,7 +310,7 @@ class cvodes_integrator_adjoint_vari : public vari_base {
           }
         } else {
           int error_code
-              = CVode(solver_->cvodes_mem_, t_final, solver_->nv_state_forward_,
+              = CVode(cvodes_mem, t_final, workspace().state_forward(),
                       &t_init, CV_NORMAL);
 
           if (unlikely(error_code == CV_TOO_MUCH_WORK)) {
@@ -363,6 +326,10 @@ class cvodes_integrator_adjoint_vari : public vari_base {
 
       t_init = t_final;
     }
+    workspace().count_forward();
+    if (is_checkpointed) {
+      workspace().count_checkpoints(ncheck + 1);
+    }
     ChainableStack::instance_->var_stack_.push_back(this);
   }
 
@@ -431,6 +398,22 @@ class cvodes_integrator_adjoint_vari : public vari_base {
     state_backward_.setZero();
     quad_.setZero();
 
+    // the workspace may have been used by other solves since the forward
+    // pass, in which case the checkpoints are recomputed from the states at
+    // the output times. Those solves may have set up the CVODES memory for
+    // another problem, so it is prepared for this one again
+    const bool is_checkpointed = workspace().holds_checkpoints(checkpoints_id_);
+    if (is_checkpointed) {
+      set_workspace_data();
+    } else {
+      prepare_forward();
+      workspace().claim_checkpoints();
+      set_forward_options();
+      if (!workspace().adjoint_initialized()) {
+        init_adjoint();
+      }
+    }
+
     // At every time step, collect the adjoints from the output
     // variables and re-initialize the solver
     double t_init = value_of(ts_.back());
@@ -444,105 +427,13 @@ class cvodes_integrator_adjoint_vari : public vari_base {
 
       double t_final = value_of((i > 0) ? ts_[i - 1] : t0_);
       if (t_final != t_init) {
-        if (unlikely(!backward_is_initialized_)) {
-          check_flag_sundials(CVodeCreateB(solver_->cvodes_mem_,
-                                           solver_backward_, &index_backward_),
-                              "CVodeCreateB");
-
-          check_flag_sundials(
-              CVodeSetUserDataB(solver_->cvodes_mem_, index_backward_,
-                                reinterpret_cast<void*>(this)),
-              "CVodeSetUserDataB");
-
-          // initialize CVODES backward machinery.
-          // the states of the backward problem *are* the adjoints
-          // of the ode states
-          check_flag_sundials(
-              CVodeInitB(solver_->cvodes_mem_, index_backward_,
-                         &cvodes_integrator_adjoint_vari::cv_rhs_adj, t_init,
-                         solver_->nv_state_backward_),
-              "CVodeInitB");
-
-          check_flag_sundials(
-              CVodeSVtolerancesB(solver_->cvodes_mem_, index_backward_,
-                                 relative_tolerance_backward_,
-                                 solver_->nv_absolute_tolerance_backward_),
-              "CVodeSVtolerancesB");
-
-          check_flag_sundials(
-              CVodeSetMaxNumStepsB(solver_->cvodes_mem_, index_backward_,
-                                   max_num_steps_),
-              "CVodeSetMaxNumStepsB");
-
-          check_flag_sundials(CVodeSetLinearSolverB(
-                                  solver_->cvodes_mem_, index_backward_,
-                                  solver_->LS_backward_, solver_->A_backward_),
-                              "CVodeSetLinearSolverB");
-
-          check_flag_sundials(
-              CVodeSetJacFnB(
-                  solver_->cvodes_mem_, index_backward_,
-                  &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_adj_states),
-              "CVodeSetJacFnB");
-
-          // Allocate space for backwards quadrature needed when
-          // parameters vary.
-          if (is_any_var_args_) {
-            check_flag_sundials(
-                CVodeQuadInitB(solver_->cvodes_mem_, index_backward_,
-                               &cvodes_integrator_adjoint_vari::cv_quad_rhs_adj,
-                               solver_->nv_quad_),
-                "CVodeQuadInitB");
-
-            check_flag_sundials(
-                CVodeQuadSStolerancesB(solver_->cvodes_mem_, index_backward_,
-                                       relative_tolerance_quadrature_,
-                                       absolute_tolerance_quadrature_),
-                "CVodeQuadSStolerancesB");
-
-            check_flag_sundials(CVodeSetQuadErrConB(solver_->cvodes_mem_,
-                                                    index_backward_, SUNTRUE),
-                                "CVodeSetQuadErrConB");
-          }
-
-          backward_is_initialized_ = true;
+        if (is_checkpointed) {
+          integrate_backward(t_init, t_final);
         } else {
-          // just re-initialize the solver
-          check_flag_sundials(
-              CVodeReInitB(solver_->cvodes_mem_, index_backward_, t_init,
-                           solver_->nv_state_backward_),
-              "CVodeReInitB");
-
-          if (is_any_var_args_) {
-            check_flag_sundials(
-                CVodeQuadReInitB(solver_->cvodes_mem_, index_backward_,
-                                 solver_->nv_quad_),
-                "CVodeQuadReInitB");
-          }
-        }
-
-        int error_code = CVodeB(solver_->cvodes_mem_, t_final, CV_NORMAL);
-
-        if (unlikely(error_code == CV_TOO_MUCH_WORK)) {
-          throw_domain_error(solver_->function_name_str_.c_str(), "", t_final,
-                             "Failed to integrate backward to output time (",
-                             ") in less than max_num_steps steps");
-        } else {
-          check_flag_sundials(error_code, "CVodeB");
-        }
-
-        // obtain adjoint states and update t_init to time point
-        // reached of t_final
-        check_flag_sundials(CVodeGetB(solver_->cvodes_mem_, index_backward_,
-                                      &t_init, solver_->nv_state_backward_),
-                            "CVodeGetB");
-
-        if (is_any_var_args_) {
-          check_flag_sundials(
-              CVodeGetQuadB(solver_->cvodes_mem_, index_backward_, &t_init,
-                            solver_->nv_quad_),
-              "CVodeGetQuadB");
+          recompute_backward(t_final, i > 0 ? y_[i - 1] : value_of(y0_),
+                             t_init);
         }
+        t_init = t_final;
       }
     }
 
@@ -568,6 +459,272 @@ class cvodes_integrator_adjoint_vari : public vari_base {
   }
 
  private:
+  /**
+   * Return the workspace of the solve.
+   */
+  cvodes_adjoint_workspace& workspace() const { return *solver_->workspace_; }
+
+  /**
+   * Point the vectors of the workspace to the memory of this solve.
+   */
+  void set_workspace_data() {
+    workspace().set_data(state_forward_.data(), state_backward_.data(),
+                         quad_.data(), absolute_tolerance_forward_.data(),
+                         absolute_tolerance_backward_.data());
+  }
+
+  /**
+   * Prepare the workspace for the forward problem of this solve and point
+   * its vectors to the memory of the solve. CVODES memory kept from a
+   * problem of the same kind is reinitialized at the initial state,
+   * otherwise the new memory is initialized and its linear solver set up.
+   */
+  void prepare_forward() {
+    const bool reuse = workspace().prepare(
+        &cvodes_integrator_adjoint_vari::cv_rhs, solver_forward_,
+        solver_backward_, interpolation_polynomial_,
+        num_steps_between_checkpoints_, N_, num_args_vars_,
+        solver_->linear_solver_);
+    set_workspace_data();
+    void* cvodes_mem = workspace().memory();
+
+    if (reuse) {
+      check_flag_sundials(CVodeReInit(cvodes_mem, value_of(t0_),
+                                      workspace().state_forward()),
+                          "CVodeReInit");
+      return;
+    }
+    check_flag_sundials(
+        CVodeInit(cvodes_mem, &cvodes_integrator_adjoint_vari::cv_rhs,
+                  value_of(t0_), workspace().state_forward()),
+        "CVodeInit");
+
+    check_flag_sundials(
+        CVodeSetLinearSolver(cvodes_mem, workspace().linear_solver_forward(),
+                             workspace().matrix_forward()),
+        "CVodeSetLinearSolver");
+
+    const sundials_linear_solver& linear_solver_forward
+        = workspace().linear_solver_forward_type();
+    if (linear_solver_forward.has_matrix()) {
+      check_flag_sundials(
+          CVodeSetJacFn(
+              cvodes_mem,
+              &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_states),
+          "CVodeSetJacFn");
+    } else if (linear_solver_forward.has_band_preconditioner()) {
+      check_flag_sundials(
+          CVBandPrecInit(cvodes_mem, N_,
+                         linear_solver_forward.upper_bandwidth(),
+                         linear_solver_forward.lower_bandwidth()),
+          "CVBandPrecInit");
+    }
+  }
+
+  /**
+   * Initialize the adjoint machinery of the CVODES memory.
+   */
+  void init_adjoint() {
+    check_flag_sundials(
+        CVodeAdjInit(workspace().memory(), num_steps_between_checkpoints_,
+                     interpolation_polynomial_),
+        "CVodeAdjInit");
+    workspace().adjoint_initialized() = true;
+  }
+
+  /**
+   * Set the user data and the options of the forward problem.
+   */
+  void set_forward_options() {
+    void* cvodes_mem = workspace().memory();
+    check_flag_sundials(
+        CVodeSetUserData(cvodes_mem, reinterpret_cast<void*>(this)),
+        "CVodeSetUserData");
+
+    cvodes_set_options(cvodes_mem, max_num_steps_);
+
+    check_flag_sundials(
+        CVodeSVtolerances(cvodes_mem, relative_tolerance_forward_,
+                          workspace().absolute_tolerance_forward()),
+        "CVodeSVtolerances");
+  }
+
+  /**
+   * Integrate the backward problem from its state at t_from to t_to, which
+   * must lie within the last forward solve with checkpoints, and the
+   * quadrature along with it.
+   *
+   * @param t_from initial time of the backward problem
+   * @param t_to final time of the backward problem
+   */
+  void integrate_backward(double t_from, double t_to) {
+    void* cvodes_mem = workspace().memory();
+    int& index_backward = workspace().index_backward();
+    if (unlikely(!workspace().has_backward())) {
+      check_flag_sundials(
+          CVodeCreateB(cvodes_mem, solver_backward_, &index_backward),
+          "CVodeCreateB");
+
+      // initialize CVODES backward machinery.
+      // the states of the backward problem *are* the adjoints
+      // of the ode states
+      check_flag_sundials(
+          CVodeInitB(cvodes_mem, index_backward,
+                     &cvodes_integrator_adjoint_vari::cv_rhs_adj, t_from,
+                     workspace().state_backward()),
+          "CVodeInitB");
+
+      check_flag_sundials(
+          CVodeSetLinearSolverB(cvodes_mem, index_backward,
+                                workspace().linear_solver_backward(),
+                                workspace().matrix_backward()),
+          "CVodeSetLinearSolverB");
+
+      const sundials_linear_solver& linear_solver_backward
+          = workspace().linear_solver_backward_type();
+      if (linear_solver_backward.has_matrix()) {
+        check_flag_sundials(
+            CVodeSetJacFnB(
+                cvodes_mem, index_backward,
+                &cvodes_integrator_adjoint_vari::cv_jacobian_rhs_adj_states),
+            "CVodeSetJacFnB");
+      } else if (linear_solver_backward.has_band_preconditioner()) {
+        check_flag_sundials(
+            CVBandPrecInitB(cvodes_mem, index_backward, N_,
+                            linear_solver_backward.upper_bandwidth(),
+                            linear_solver_backward.lower_bandwidth()),
+            "CVBandPrecInitB");
+      }
+
+      // Allocate space for backwards quadrature needed when
+      // parameters vary.
+      if (is_any_var_args_) {
+        check_flag_sundials(
+            CVodeQuadInitB(cvodes_mem, index_backward,
+                           &cvodes_integrator_adjoint_vari::cv_quad_rhs_adj,
+                           workspace().quad()),
+            "CVodeQuadInitB");
+
+        check_flag_sundials(
+            CVodeSetQuadErrConB(cvodes_mem, index_backward, SUNTRUE),
+            "CVodeSetQuadErrConB");
+      }
+    } else {
+      // just re-initialize the solver
+      check_flag_sundials(CVodeReInitB(cvodes_mem, index_backward, t_from,
+                                       workspace().state_backward()),
+                          "CVodeReInitB");
+
+      if (is_any_var_args_) {
+        check_flag_sundials(
+            CVodeQuadReInitB(cvodes_mem, index_backward, workspace().quad()),
+            "CVodeQuadReInitB");
+      }
+    }
+
+    check_flag_sundials(CVodeSetUserDataB(cvodes_mem, index_backward,
+                                          reinterpret_cast<void*>(this)),
+                        "CVodeSetUserDataB");
+
+    check_flag_sundials(
+        CVodeSVtolerancesB(cvodes_mem, index_backward,
+                           relative_tolerance_backward_,
+                           workspace().absolute_tolerance_backward()),
+        "CVodeSVtolerancesB");
+
+    check_flag_sundials(
+        CVodeSetMaxNumStepsB(cvodes_mem, index_backward, max_num_steps_),
+        "CVodeSetMaxNumStepsB");
+
+    if (is_any_var_args_) {
+      check_flag_sundials(
+          CVodeQuadSStolerancesB(cvodes_mem, index_backward,
+                                 relative_tolerance_quadrature_,
+                                 absolute_tolerance_quadrature_),
+          "CVodeQuadSStolerancesB");
+    }
+
+    int error_code = CVodeB(cvodes_mem, t_to, CV_NORMAL);
+
+    if (unlikely(error_code == CV_TOO_MUCH_WORK)) {
+      throw_domain_error(solver_->function_name_str_.c_str(), "", t_to,
+                         "Failed to integrate backward to output time (",
+                         ") in less than max_num_steps steps");
+    } else {
+      check_flag_sundials(error_code, "CVodeB");
+    }
+
+    // obtain adjoint states
+    double t_reached;
+    check_flag_sundials(CVodeGetB(cvodes_mem, index_backward, &t_reached,
+                                  workspace().state_backward()),
+                        "CVodeGetB");
+
+    if (is_any_var_args_) {
+      check_flag_sundials(CVodeGetQuadB(cvodes_mem, index_backward,
+                                        &t_reached, workspace().quad()),
+                          "CVodeGetQuadB");
+    }
+    workspace().count_backward();
+  }
+
+  /**
+   * Integrate the backward problem from its state at t_to back to t_from
+   * after recomputing the checkpoints of the forward problem from its state
+   * y_from at t_from.
+   *
+   * Whenever the checkpoints of a segment reach the budget of the workspace
+   * before t_to, the forward state at that point is kept and the rest of the
+   * segment is solved first, so that at most the budgeted checkpoints are
+   * held at any time. Each segment restarts from the state kept at its
+   * start, never from t_from, so the forward problem is integrated at most
+   * twice: once to find the segments and once more for each segment but
+   * the last one.
+   *
+   * @param t_from time of the known forward state
+   * @param y_from forward state at t_from
+   * @param t_to initial time of the backward problem
+   */
+  void recompute_backward(double t_from, const Eigen::VectorXd& y_from,
+                          double t_to) {
+    void* cvodes_mem = workspace().memory();
+    std::vector<std::pair<double, Eigen::VectorXd>> segment_starts{
+        {t_from, y_from}};
+    while (!segment_starts.empty()) {
+      const double t_start = segment_starts.back().first;
+      state_forward_.noalias() = segment_starts.back().second;
+      check_flag_sundials(
+          CVodeReInit(cvodes_mem, t_start, workspace().state_forward()),
+          "CVodeReInit");
+      check_flag_sundials(CVodeAdjReInit(cvodes_mem), "CVodeAdjReInit");
+      workspace().count_recomputation();
+
+      int ncheck = 0;
+      double t = t_start;
+      bool is_split = false;
+      while (t < t_to) {
+        check_flag_sundials(
+            CVodeF(cvodes_mem, t_to, workspace().state_forward(), &t,
+                   CV_ONE_STEP, &ncheck),
+            "CVodeF");
+        if (ncheck + 1 >= max_checkpoints_ && t < t_to) {
+          is_split = true;
+          break;
+        }
+      }
+      workspace().count_forward();
+      workspace().count_checkpoints(ncheck + 1);
+
+      if (is_split) {
+        segment_starts.emplace_back(t, state_forward_);
+      } else {
+        integrate_backward(t_to, t_start);
+        segment_starts.pop_back();
+        t_to = t_start;
+      }
+    }
+  }
+
   /**
    * Call the ODE RHS with given tuple.
    */
@@ -670,6 +827,9 @@ class cvodes_integrator_adjoint_vari : public vari_base {
                      f_y_t_vars.size(), "states", N_);
     f_y_t_vars.adj() = -Eigen::Map<Eigen::VectorXd>(NV_DATA_S(yB), N_);
     grad();
+    // qBdot is a CVODES work vector holding earlier values (or uninitialized
+    // memory on the first call), while the adjoints are added into it
+    N_VConst(0.0, qBdot);
     apply(
         [&qBdot](auto&&... args) {
           accumulate_adjoints(NV_DATA_S(qBdot), args...);
@@ -678,6 +838,7 @@ class cvodes_integrator_adjoint_vari : public vari_base {
     return 0;
   }
 
+ public:
   /**
    * Implements the function of type CVQuadRhsFnB which is the
    * RHS of the backward ODE system's quadrature.
@@ -687,31 +848,18 @@ class cvodes_integrator_adjoint_vari : public vari_base {
     return cast_to_self(user_data)->quad_rhs_adj(t, y, yB, qBdot);
   }
 
+ private:
+
   /**
    * Calculates the jacobian of the ODE RHS wrt to its states y at the
    * given time-point t and state y.
    */
   inline int jacobian_rhs_states(double t, N_Vector y, SUNMatrix J) const {
-    Eigen::Map<Eigen::MatrixXd> Jfy(SM_DATA_D(J), N_, N_);
-
-    nested_rev_autodiff nested;
-
-    Eigen::Matrix<var, Eigen::Dynamic, 1> y_var(
-        Eigen::Map<const Eigen::VectorXd>(NV_DATA_S(y), N_));
-    Eigen::Matrix<var, Eigen::Dynamic, 1> fy_var
-        = rhs(t, y_var, solver_->value_of_args_tuple_);
-
-    check_size_match(solver_->function_name_str_.c_str(), "dy_dt",
-                     fy_var.size(), "states", N_);
-
-    grad(fy_var.coeffRef(0).vi_);
-    Jfy.col(0) = y_var.adj();
-    for (int i = 1; i < fy_var.size(); ++i) {
-      nested.set_zero_all_adjoints();
-      grad(fy_var.coeffRef(i).vi_);
-      Jfy.col(i) = y_var.adj();
-    }
-    Jfy.transposeInPlace();
+    internal::sundials_ode_jacobian<std::decay_t<F>>::store(
+        solver_->function_name_str_.c_str(), solver_->f_, t,
+        Eigen::Map<const Eigen::VectorXd>(NV_DATA_S(y), N_), msgs_,
+        solver_->value_of_args_tuple_, workspace().linear_solver_forward_type(),
+        J, false, 1.0);
     return 0;
   }
 
@@ -738,12 +886,12 @@ class cvodes_integrator_adjoint_vari : public vari_base {
    */
   inline int jacobian_rhs_adj_states(double t, N_Vector y, SUNMatrix J) const {
     // J_adj_y = -1 * transpose(J_y)
-    int error_code = jacobian_rhs_states(t, y, J);
-
-    Eigen::Map<Eigen::MatrixXd> J_adj_y(SM_DATA_D(J), N_, N_);
-    J_adj_y.transposeInPlace();
-    J_adj_y.array() *= -1.0;
-    return error_code;
+    internal::sundials_ode_jacobian<std::decay_t<F>>::store(
+        solver_->function_name_str_.c_str(), solver_->f_, t,
+        Eigen::Map<const Eigen::VectorXd>(NV_DATA_S(y), N_), msgs_,
+        solver_->value_of_args_tuple_,
+        workspace().linear_solver_backward_type(), J, true, -1.0);
+    return 0;
   }
 
   /**
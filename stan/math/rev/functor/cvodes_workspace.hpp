@@ -0,0 +1,142 @@
+#ifndef STAN_MATH_REV_FUNCTOR_CVODES_WORKSPACE_HPP
+#define STAN_MATH_REV_FUNCTOR_CVODES_WORKSPACE_HPP
+
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
+#include <cvodes/cvodes.h>
+#include <nvector/nvector_serial.h>
+#include <cstddef>
+#include <stdexcept>
+
+namespace stan {
+namespace math {
+
+/**
+ * CVODES memory, state vectors, Jacobian matrix and linear solver used by
+ * <code>cvodes_integrator</code>.
+ *
+ * A workspace passed to several integrators keeps these between their
+ * solves, as long as consecutive systems have the same right hand side
+ * type, multistep method, size, number of sensitivities and linear solver.
+ * The next solve then only reinitializes CVODES instead of allocating and
+ * setting everything up again, which dominates the cost of many small
+ * solves such as the per subject solves of population models. A workspace
+ * must only be used by one thread at a time.
+ */
+class cvodes_workspace {
+ public:
+  cvodes_workspace() = default;
+  cvodes_workspace(const cvodes_workspace&) = delete;
+  cvodes_workspace& operator=(const cvodes_workspace&) = delete;
+
+  ~cvodes_workspace() { clear(); }
+
+  /**
+   * Prepare the workspace for a system, keeping the current CVODES memory
+   * if it was set up for a system of the same kind and creating new memory
+   * otherwise.
+   *
+   * @param rhs right hand side callback of the integrator
+   * @param lmm multistep method (CV_ADAMS or CV_BDF)
+   * @param N number of states
+   * @param num_sens number of sensitivities
+   * @param linear_solver linear solver for the Newton iterations
+   * @return true if the CVODES memory is reused and only needs to be
+   * reinitialized, false if it was created and needs to be set up
+   */
+  bool prepare(CVRhsFn rhs, int lmm, size_t N, size_t num_sens,
+               const sundials_linear_solver& linear_solver) {
+    ++num_solves_;
+    if (mem_ != nullptr && rhs == rhs_ && lmm == lmm_ && N == N_
+        && num_sens == num_sens_ && linear_solver == linear_solver_) {
+      return true;
+    }
+    clear();
+    rhs_ = rhs;
+    lmm_ = lmm;
+    N_ = N;
+    num_sens_ = num_sens;
+    linear_solver_ = linear_solver;
+    mem_ = CVodeCreate(lmm);
+    if (mem_ == nullptr) {
+      throw std::runtime_error("CVodeCreate failed to allocate memory");
+    }
+    nv_state_ = N_VNewEmpty_Serial(N);
+    if (num_sens > 0) {
+      nv_state_sens_ = N_VCloneVectorArrayEmpty_Serial(num_sens, nv_state_);
+    }
+    A_ = linear_solver.make_matrix(N);
+    LS_ = linear_solver.make_solver(nv_state_, A_);
+    ++num_allocations_;
+    return false;
+  }
+
+  /**
+   * Point the state vectors to the coupled state of an integrator, the N
+   * states followed by the N sensitivities of each parameter.
+   *
+   * @param coupled_state coupled state, of size N * (num_sens + 1)
+   */
+  void set_state(double* coupled_state) {
+    NV_DATA_S(nv_state_) = coupled_state;
+    for (size_t i = 0; i < num_sens_; ++i) {
+      NV_DATA_S(nv_state_sens_[i]) = coupled_state + (i + 1) * N_;
+    }
+  }
+
+  /**
+   * Free the CVODES memory, vectors and linear solver.
+   */
+  void clear() {
+    if (mem_ == nullptr) {
+      return;
+    }
+    CVodeFree(&mem_);
+    SUNLinSolFree(LS_);
+    if (A_ != nullptr) {
+      SUNMatDestroy(A_);
+    }
+    if (num_sens_ > 0) {
+      N_VDestroyVectorArray_Serial(nv_state_sens_, num_sens_);
+    }
+    N_VDestroy_Serial(nv_state_);
+    mem_ = nullptr;
+    nv_state_ = nullptr;
+    nv_state_sens_ = nullptr;
+    A_ = nullptr;
+    LS_ = nullptr;
+  }
+
+  void* memory() { return mem_; }
+  N_Vector state() { return nv_state_; }
+  N_Vector* state_sensitivities() { return nv_state_sens_; }
+  SUNMatrix matrix() { return A_; }
+  SUNLinearSolver linear_solver() { return LS_; }
+
+  /**
+   * Return the number of solves the workspace was prepared for.
+   */
+  size_t num_solves() const { return num_solves_; }
+
+  /**
+   * Return the number of times CVODES memory was created.
+   */
+  size_t num_allocations() const { return num_allocations_; }
+
+ private:
+  void* mem_{nullptr};
+  N_Vector nv_state_{nullptr};
+  N_Vector* nv_state_sens_{nullptr};
+  SUNMatrix A_{nullptr};
+  SUNLinearSolver LS_{nullptr};
+  CVRhsFn rhs_{nullptr};
+  int lmm_{0};
+  size_t N_{0};
+  size_t num_sens_{0};
+  sundials_linear_solver linear_solver_;
+  size_t num_solves_{0};
+  size_t num_allocations_{0};
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -3,10 +3,10 @@
 
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/rev/functor/idas_forward_system.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
 #include <stan/math/prim/err.hpp>
 #include <idas/idas.h>
-#include <sunmatrix/sunmatrix_dense.h>
-#include <sunlinsol/sunlinsol_dense.h>
+#include <idas/idas_bbdpre.h>
 #include <nvector/nvector_serial.h>
 #include <ostream>
 #include <vector>
@@ -24,6 +24,7 @@ class idas_integrator {
   const double rtol_;
   const double atol_;
   const int64_t max_num_steps_;
+  const sundials_linear_solver linear_solver_;
   /**
    * Forward decl
    */
@@ -77,10 +78,16 @@ class idas_integrator {
    * @param[in] rtol relative tolerance
    * @param[in] atol absolute tolerance
    * @param[in] max_num_steps max nb. of times steps
+   * @param[in] linear_solver linear solver for the Newton iterations
    */
-  idas_integrator(const double rtol, const double atol,
-                  const int64_t max_num_steps = IDAS_MAX_STEPS)
-      : rtol_(rtol), atol_(atol), max_num_steps_(max_num_steps) {
+  idas_integrator(
+      const double rtol, const double atol,
+      const int64_t max_num_steps = IDAS_MAX_STEPS,
+      const sundials_linear_solver& linear_solver = sundials_linear_solver())
+      : rtol_(rtol),
+        atol_(atol),
+        max_num_steps_(max_num_steps),
+        linear_solver_(linear_solver) {
     if (rtol_ <= 0) {
       invalid_argument("idas_integrator", "relative tolerance,", rtol_, "",
                        ", must be greater than 0");
@@ -137,14 +144,31 @@ class idas_integrator {
     typename Dae::return_type res_yy(
         ts.size(), std::vector<typename Dae::scalar_type>(n, 0));
 
-    auto A = SUNDenseMatrix(n, n);
-    auto LS = SUNDenseLinearSolver(yy, A);
+    linear_solver_.check(caller, n);
+    dae.set_linear_solver(linear_solver_);
+    auto A = linear_solver_.make_matrix(n);
+    auto LS = linear_solver_.make_solver(yy, A);
 
     try {
       CHECK_IDAS_CALL(IDASetUserData(mem, dae.to_user_data()));
 
       CHECK_IDAS_CALL(IDAInit(mem, dae.residual(), t0, yy, yp));
       CHECK_IDAS_CALL(IDASetLinearSolver(mem, LS, A));
+      // dense and banded Jacobians are approximated by IDAS with difference
+      // quotients unless the residual supplies its Jacobian, sparse ones
+      // have no such approximation
+      using solver_type = sundials_linear_solver::solver_type;
+      if (linear_solver_.type() == solver_type::sparse
+          || (linear_solver_.has_matrix() && Dae::is_jacobian_supplied)) {
+        CHECK_IDAS_CALL(IDASetJacFn(mem, dae.jacobian()));
+      } else if (linear_solver_.has_band_preconditioner()) {
+        const int64_t mu = std::min<int64_t>(linear_solver_.upper_bandwidth(),
+                                             n - 1);
+        const int64_t ml = std::min<int64_t>(linear_solver_.lower_bandwidth(),
+                                             n - 1);
+        CHECK_IDAS_CALL(IDABBDPrecInit(mem, n, mu, ml, mu, ml, 0.0,
+                                       dae.preconditioner_residual(), NULL));
+      }
       CHECK_IDAS_CALL(IDASStolerances(mem, rtol_, atol_));
       CHECK_IDAS_CALL(IDASetMaxNumSteps(mem, max_num_steps_));
 
@@ -153,12 +177,16 @@ class idas_integrator {
       solve(dae, t0, ts, res_yy);
     } catch (const std::exception& e) {
       SUNLinSolFree(LS);
-      SUNMatDestroy(A);
+      if (A != nullptr) {
+        SUNMatDestroy(A);
+      }
       throw;
     }
 
     SUNLinSolFree(LS);
-    SUNMatDestroy(A);
+    if (A != nullptr) {
+      SUNMatDestroy(A);
+    }
 
     return res_yy;
   }
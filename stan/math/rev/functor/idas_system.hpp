@@ -2,12 +2,15 @@
 #define STAN_MATH_REV_FUNCTOR_IDAS_RESIDUAL_HPP
 
 #include <stan/math/rev/meta.hpp>
-#include <stan/math/rev/core/typedefs.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/sundials_jacobian.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
 #include <stan/math/prim/err.hpp>
 #include <stan/math/prim/fun/dot_self.hpp>
 #include <stan/math/prim/fun/typedefs.hpp>
 #include <stan/math/prim/fun/value_of.hpp>
 #include <idas/idas.h>
+#include <idas/idas_bbdpre.h>
 #include <nvector/nvector_serial.h>
 #include <ostream>
 #include <vector>
@@ -105,12 +108,15 @@ class idas_system {
   N_Vector id_;
   void* mem_;
   std::ostream* msgs_;
+  sundials_linear_solver linear_solver_;
 
  public:
   static constexpr bool is_var_yy0 = stan::is_var<Tyy>::value;
   static constexpr bool is_var_yp0 = stan::is_var<Typ>::value;
   static constexpr bool is_var_par = stan::is_var<Tpar>::value;
   static constexpr bool need_sens = is_var_yy0 || is_var_yp0 || is_var_par;
+  static constexpr bool is_jacobian_supplied
+      = internal::sundials_dae_jacobian<F>::supplied;
 
   using scalar_type = return_type_t<Tyy, Typ, Tpar>;
   using return_type = std::vector<std::vector<scalar_type> >;
@@ -314,30 +320,92 @@ class idas_system {
    */
   const F& f() { return f_; }
 
+  /**
+   * Set the linear solver whose Jacobian storage is filled by
+   * <code>jacobian()</code>.
+   *
+   * @param[in] linear_solver linear solver of the integrator
+   */
+  void set_linear_solver(const sundials_linear_solver& linear_solver) {
+    linear_solver_ = linear_solver;
+  }
+
+  /**
+   * Return the linear solver of the integrator
+   */
+  const sundials_linear_solver& linear_solver() const { return linear_solver_; }
+
   /**
    * Return a closure for IDAS residual callback
    */
   IDAResFn residual() {  // a non-capture lambda
     return [](double t, N_Vector yy, N_Vector yp, N_Vector rr,
               void* user_data) -> int {
+      return idas_system<F, Tyy, Typ, Tpar>::residual_impl(t, yy, yp, rr,
+                                                           user_data);
+    };
+  }
+
+  /**
+   * Return a closure for the IDAS Jacobian callback, which fills the
+   * Jacobian \f$\partial F / \partial y + c_j \partial F / \partial y'\f$
+   * of the residual, by default by rows with one reverse sweep per
+   * equation.
+   */
+  IDALsJacFn jacobian() {  // a non-capture lambda
+    return [](double t, double cj, N_Vector yy, N_Vector yp, N_Vector rr,
+              SUNMatrix J, void* user_data, N_Vector tmp1, N_Vector tmp2,
+              N_Vector tmp3) -> int {
       using DAE = idas_system<F, Tyy, Typ, Tpar>;
       DAE* dae = static_cast<DAE*>(user_data);
 
-      size_t N = NV_LENGTH_S(yy);
+      const size_t N = NV_LENGTH_S(yy);
       auto yy_val = N_VGetArrayPointer(yy);
-      std::vector<double> yy_vec(yy_val, yy_val + N);
       auto yp_val = N_VGetArrayPointer(yp);
-      std::vector<double> yp_vec(yp_val, yp_val + N);
-      auto res = dae->f_(t, yy_vec, yp_vec, dae->theta_, dae->x_r_, dae->x_i_,
-                         dae->msgs_);
-      for (size_t i = 0; i < N; ++i) {
-        NV_Ith_S(rr, i) = value_of(res[i]);
-      }
-
+      internal::sundials_dae_jacobian<F>::store(
+          dae->f_, t, cj, std::vector<double>(yy_val, yy_val + N),
+          std::vector<double>(yp_val, yp_val + N), value_of(dae->theta_),
+          dae->x_r_, dae->x_i_, dae->msgs_, dae->linear_solver_, J);
       return 0;
     };
   }
 
+  /**
+   * Return a closure for the residual callback of the IDAS band-block-diagonal
+   * preconditioner, which approximates the Jacobian of the residual by
+   * difference quotients.
+   */
+  IDABBDLocalFn preconditioner_residual() {  // a non-capture lambda
+    return [](sunindextype N, double t, N_Vector yy, N_Vector yp, N_Vector gval,
+              void* user_data) -> int {
+      return idas_system<F, Tyy, Typ, Tpar>::residual_impl(t, yy, yp, gval,
+                                                           user_data);
+    };
+  }
+
+  /**
+   * Evaluate the residual of the DAE system whose address is
+   * <code>user_data</code>.
+   */
+  static int residual_impl(double t, N_Vector yy, N_Vector yp, N_Vector rr,
+                           void* user_data) {
+    using DAE = idas_system<F, Tyy, Typ, Tpar>;
+    DAE* dae = static_cast<DAE*>(user_data);
+
+    size_t N = NV_LENGTH_S(yy);
+    auto yy_val = N_VGetArrayPointer(yy);
+    std::vector<double> yy_vec(yy_val, yy_val + N);
+    auto yp_val = N_VGetArrayPointer(yp);
+    std::vector<double> yp_vec(yp_val, yp_val + N);
+    auto res = dae->f_(t, yy_vec, yp_vec, dae->theta_, dae->x_r_, dae->x_i_,
+                       dae->msgs_);
+    for (size_t i = 0; i < N; ++i) {
+      NV_Ith_S(rr, i) = value_of(res[i]);
+    }
+
+    return 0;
+  }
+
   void check_ic_consistency(const double& t0, const double& tol) {
     const std::vector<double> theta_d(value_of(theta_));
     const std::vector<double> yy_d(value_of(yy_));
@@ -0,0 +1,210 @@
+#ifndef STAN_MATH_REV_FUNCTOR_INDEPENDENT_SUM_HPP
+#define STAN_MATH_REV_FUNCTOR_INDEPENDENT_SUM_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+
+#include <algorithm>
+#include <memory>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * A segment of a sum of independent terms. The terms are recorded on an
+ * AD stack of their own, on which the shared arguments are deep copied,
+ * so that the reverse pass of one segment neither reads nor writes any
+ * vari of another segment or of the main AD stack.
+ */
+struct independent_sum_segment {
+  ScopedChainableStack stack_;
+  vari* result_{nullptr};
+  // deep copies of the shared arguments on stack_
+  std::vector<vari*> local_operands_;
+
+  /**
+   * Run the reverse pass of the segment with the adjoint of the result
+   * set to 1 and add the adjoints of the local copies of the shared
+   * arguments to <code>operands_adj</code>.
+   *
+   * @param[in, out] operands_adj adjoints of the shared arguments
+   */
+  inline void chain(Eigen::VectorXd& operands_adj) {
+    stack_.execute([&]() {
+      set_zero_all_adjoints();
+      grad(result_);
+    });
+    for (size_t i = 0; i < local_operands_.size(); ++i) {
+      operands_adj.coeffRef(i) += local_operands_[i]->adj_;
+    }
+  }
+};
+
+/**
+ * Owner of the segments of an <code>independent_sum()</code>. The
+ * segments live as long as the memory of the AD stack on which the sum
+ * was created.
+ */
+class independent_sum_segments : public chainable_alloc {
+ public:
+  std::vector<std::unique_ptr<independent_sum_segment>> segments_;
+
+  ~independent_sum_segments() {
+    for (auto& segment : segments_) {
+      segment->stack_.execute([]() { recover_memory(); });
+    }
+  }
+};
+
+/**
+ * The vari of an <code>independent_sum()</code>. Its <code>chain()</code>
+ * method runs the reverse passes of the segments in parallel and then
+ * adds the adjoints accumulated on the deep copies of the shared
+ * arguments to the shared arguments.
+ */
+class independent_sum_vari : public vari {
+  independent_sum_segments* segments_;
+  vari** operands_;
+  size_t num_operands_;
+
+ public:
+  independent_sum_vari(double val, independent_sum_segments* segments,
+                       vari** operands, size_t num_operands)
+      : vari(val),
+        segments_(segments),
+        operands_(operands),
+        num_operands_(num_operands) {}
+
+  void chain() {
+    auto& segments = segments_->segments_;
+    // one adjoint buffer per thread, summed after the parallel sweep
+    tbb::enumerable_thread_specific<Eigen::VectorXd> operands_adj(
+        Eigen::VectorXd::Zero(num_operands_));
+#ifdef STAN_THREADS
+    // the thread local AD stack of this thread is left alone while the
+    // segments are chained, see reduce_sum for the need of isolation
+    tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, segments.size()),
+                        [&](const tbb::blocked_range<size_t>& r) {
+                          auto& local_adj = operands_adj.local();
+                          for (size_t s = r.begin(); s < r.end(); ++s) {
+                            segments[s]->chain(local_adj);
+                          }
+                        });
+    });
+#else
+    // without STAN_THREADS the AD stack pointer is shared by all threads
+    auto& local_adj = operands_adj.local();
+    for (auto& segment : segments) {
+      segment->chain(local_adj);
+    }
+#endif
+    Eigen::VectorXd total_adj = Eigen::VectorXd::Zero(num_operands_);
+    for (const auto& local_adj : operands_adj) {
+      total_adj += local_adj;
+    }
+    for (size_t i = 0; i < num_operands_; ++i) {
+      operands_[i]->adj_ += adj_ * total_adj.coeff(i);
+    }
+  }
+};
+
+}  // namespace internal
+
+/**
+ * Return the sum of <code>num_terms</code> terms that do not depend on
+ * each other, with a reverse pass that chains groups of terms in
+ * parallel.
+ *
+ * The terms are split into consecutive segments of at most
+ * <code>grainsize</code> terms. The segments are evaluated one after the
+ * other in the calling thread, each on an AD stack of its own (a
+ * <code>ScopedChainableStack</code>) holding deep copies of the shared
+ * arguments, and the result is a single vari on the AD stack of the
+ * caller. When the reverse pass reaches that vari, the segments are
+ * chained as independent tasks on the TBB threadpool (see
+ * <code>init_threadpool_tbb()</code>). The adjoints of the copies of the
+ * shared arguments are summed in one buffer per thread, so no
+ * synchronization is needed while chaining, and the buffers are added to
+ * the shared arguments once all segments are done.
+ *
+ * Unlike <code>reduce_sum()</code>, the forward pass is sequential and
+ * the reverse pass of the terms is deferred to <code>grad()</code>,
+ * which makes this suited for wide sums whose reverse pass dominates, or
+ * which are differentiated more than once (e.g. by <code>jacobian()</code>).
+ *
+ * The segments are only chained in parallel if <code>STAN_THREADS</code>
+ * is defined, as otherwise all threads share one AD stack pointer.
+ *
+ * F must define an operator() with the same signature as:
+ *   var f(int start, int end, std::ostream* msgs, Args&&... args)
+ * returning the sum of the terms start through end (inclusive).
+ *
+ * @tparam F type of function
+ * @tparam Args types of shared arguments
+ * @param f function computing a segment of the sum
+ * @param num_terms number of terms
+ * @param grainsize maximum number of terms per segment
+ * @param[in, out] msgs print stream for warning messages
+ * @param args shared arguments used in every term
+ * @return sum of the terms
+ * @throw std::domain_error if num_terms is negative or grainsize is not
+ * positive
+ */
+template <typename F, typename... Args>
+inline var independent_sum(const F& f, int num_terms, int grainsize,
+                           std::ostream* msgs, const Args&... args) {
+  static const char* function = "independent_sum";
+  check_nonnegative(function, "num_terms", num_terms);
+  check_positive(function, "grainsize", grainsize);
+  if (num_terms == 0) {
+    return var(0.0);
+  }
+
+  const size_t num_operands = count_vars(args...);
+  vari** operands
+      = ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_operands);
+  save_varis(operands, args...);
+
+  auto* segments = new internal::independent_sum_segments();
+  double sum = 0;
+  for (int start = 0; start < num_terms; start += grainsize) {
+    const int end = std::min(start + grainsize, num_terms) - 1;
+    segments->segments_.emplace_back(
+        std::make_unique<internal::independent_sum_segment>());
+    auto& segment = *segments->segments_.back();
+    segment.stack_.execute([&]() {
+      auto local_args = std::make_tuple(deep_copy_vars(args)...);
+      segment.local_operands_.resize(num_operands);
+      apply(
+          [&](auto&&... local) {
+            save_varis(segment.local_operands_.data(), local...);
+          },
+          local_args);
+      var result = apply(
+          [&](auto&&... local) { return f(start, end, msgs, local...); },
+          local_args);
+      segment.result_ = result.vi_;
+      sum += result.val();
+    });
+  }
+
+  return var(new internal::independent_sum_vari(sum, segments, operands,
+                                                num_operands));
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -27,7 +27,8 @@ integrate_ode_bdf(const F& f, const std::vector<T_y0>& y0, const T_t0& t0,
   internal::integrate_ode_std_vector_interface_adapter<F> f_adapted(f);
   auto y = ode_bdf_tol_impl("integrate_ode_bdf", f_adapted, to_vector(y0), t0,
                             ts, relative_tolerance, absolute_tolerance,
-                            max_num_steps, msgs, theta, x, x_int);
+                            max_num_steps, sundials_linear_solver(), msgs,
+                            theta, x, x_int);
 
   std::vector<std::vector<return_type_t<T_y0, T_param, T_t0, T_ts>>>
       y_converted;
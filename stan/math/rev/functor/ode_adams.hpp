@@ -40,6 +40,7 @@ namespace math {
  * @param absolute_tolerance Absolute tolerance passed to CVODES
  * @param max_num_steps Upper limit on the number of integration steps to
  *   take between each output (error if exceeded)
+ * @param linear_solver Linear solver for the Newton iterations
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to ODE right hand side
  * @return Solution to ODE at times \p ts
@@ -52,13 +53,15 @@ ode_adams_tol_impl(const char* function_name, const F& f, const T_y0& y0,
                    const T_t0& t0, const std::vector<T_ts>& ts,
                    double relative_tolerance, double absolute_tolerance,
                    long int max_num_steps,  // NOLINT(runtime/int)
+                   const sundials_linear_solver& linear_solver,
                    std::ostream* msgs, const T_Args&... args) {
   const auto& args_ref_tuple = std::make_tuple(to_ref(args)...);
   return apply(
       [&](const auto&... args_refs) {
         cvodes_integrator<CV_ADAMS, F, T_y0, T_t0, T_ts, ref_type_t<T_Args>...>
         integrator(function_name, f, y0, t0, ts, relative_tolerance,
-                   absolute_tolerance, max_num_steps, msgs, args_refs...);
+                   absolute_tolerance, max_num_steps, linear_solver, msgs,
+                   args_refs...);
 
         return integrator();
       },
@@ -108,7 +111,57 @@ ode_adams_tol(const F& f, const T_y0& y0, const T_t0& t0,
               long int max_num_steps,  // NOLINT(runtime/int)
               std::ostream* msgs, const T_Args&... args) {
   return ode_adams_tol_impl("ode_adams_tol", f, y0, t0, ts, relative_tolerance,
-                            absolute_tolerance, max_num_steps, msgs, args...);
+                            absolute_tolerance, max_num_steps,
+                            sundials_linear_solver(), msgs, args...);
+}
+
+/**
+ * Solve the ODE initial value problem y' = f(t, y), y(t0) = y0 at a set of
+ * times, { t1, t2, t3, ... } using the non-stiff Adams-Moulton
+ * solver from CVODES, with the given linear solver for the Newton iterations.
+ * Banded, sparse and matrix-free linear solvers avoid the dense
+ * factorizations of the Jacobian for large systems with few couplings
+ * between states.
+ *
+ * \p f must define an operator() with the signature as:
+ *   template<typename T_t, typename T_y, typename... T_Args>
+ *   Eigen::Matrix<stan::return_type_t<T_t, T_y, T_Args...>, Eigen::Dynamic, 1>
+ *     operator()(const T_t& t, const Eigen::Matrix<T_y, Eigen::Dynamic, 1>& y,
+ *     std::ostream* msgs, const T_Args&... args);
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial state
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Times at which to solve the ODE at. All values must be sorted and
+ *   not less than t0.
+ * @param relative_tolerance Relative tolerance passed to CVODES
+ * @param absolute_tolerance Absolute tolerance passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param linear_solver Linear solver for the Newton iterations
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ * @return Solution to ODE at times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<Eigen::Matrix<stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>,
+                          Eigen::Dynamic, 1>>
+ode_adams_tol(const F& f, const T_y0& y0, const T_t0& t0,
+              const std::vector<T_ts>& ts, double relative_tolerance,
+              double absolute_tolerance,
+              long int max_num_steps,  // NOLINT(runtime/int)
+              const sundials_linear_solver& linear_solver,
+              std::ostream* msgs, const T_Args&... args) {
+  return ode_adams_tol_impl("ode_adams_tol", f, y0, t0, ts, relative_tolerance,
+                            absolute_tolerance, max_num_steps, linear_solver,
+                            msgs, args...);
 }
 
 /**
@@ -153,7 +206,8 @@ ode_adams(const F& f, const T_y0& y0, const T_t0& t0,
   long int max_num_steps = 1e8;  // NOLINT(runtime/int)
 
   return ode_adams_tol_impl("ode_adams", f, y0, t0, ts, relative_tolerance,
-                            absolute_tolerance, max_num_steps, msgs, args...);
+                            absolute_tolerance, max_num_steps,
+                            sundials_linear_solver(), msgs, args...);
 }
 
 }  // namespace math
@@ -4,6 +4,7 @@
 #include <stan/math/rev/meta.hpp>
 #include <stan/math/prim/fun/eval.hpp>
 #include <stan/math/rev/functor/cvodes_integrator_adjoint.hpp>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -57,6 +58,10 @@ namespace math {
  * @param interpolation_polynomial type of polynomial used for interpolation
  * @param solver_forward solver used for forward pass
  * @param solver_backward solver used for backward pass
+ * @param linear_solver Linear solver for the Newton iterations of the
+ * forward problem; the backward problem uses its transpose
+ * @param workspace Workspace holding the CVODES memory, or nullptr for one of
+ * the solve's own
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to ODE right hand side
  * @return An `std::vector` of Eigen column vectors with scalars equal to
@@ -78,7 +83,9 @@ auto ode_adjoint_impl(
     long int max_num_steps,                  // NOLINT(runtime/int)
     long int num_steps_between_checkpoints,  // NOLINT(runtime/int)
     int interpolation_polynomial, int solver_forward, int solver_backward,
-    std::ostream* msgs, const T_Args&... args) {
+    const sundials_linear_solver& linear_solver,
+    std::shared_ptr<cvodes_adjoint_workspace> workspace, std::ostream* msgs,
+    const T_Args&... args) {
   using integrator_vari
       = cvodes_integrator_adjoint_vari<F, plain_type_t<T_y0>, T_t0, T_ts,
                                        plain_type_t<T_Args>...>;
@@ -88,7 +95,7 @@ auto ode_adjoint_impl(
       absolute_tolerance_backward, relative_tolerance_quadrature,
       absolute_tolerance_quadrature, max_num_steps,
       num_steps_between_checkpoints, interpolation_polynomial, solver_forward,
-      solver_backward, msgs, args...);
+      solver_backward, linear_solver, std::move(workspace), msgs, args...);
   return integrator->solution();
 }
 
@@ -141,6 +148,10 @@ auto ode_adjoint_impl(
  * @param interpolation_polynomial type of polynomial used for interpolation
  * @param solver_forward solver used for forward pass
  * @param solver_backward solver used for backward pass
+ * @param linear_solver Linear solver for the Newton iterations of the
+ * forward problem; the backward problem uses its transpose
+ * @param workspace Workspace holding the CVODES memory, or nullptr for one of
+ * the solve's own
  * @param[in, out] msgs the print stream for warning messages
  * @param args Extra arguments passed unmodified through to ODE right hand side
  * @return An `std::vector` of Eigen column vectors with scalars equal to
@@ -162,7 +173,9 @@ std::vector<Eigen::VectorXd> ode_adjoint_impl(
     long int max_num_steps,                  // NOLINT(runtime/int)
     long int num_steps_between_checkpoints,  // NOLINT(runtime/int)
     int interpolation_polynomial, int solver_forward, int solver_backward,
-    std::ostream* msgs, const T_Args&... args) {
+    const sundials_linear_solver& linear_solver,
+    std::shared_ptr<cvodes_adjoint_workspace> workspace, std::ostream* msgs,
+    const T_Args&... args) {
   std::vector<Eigen::VectorXd> ode_solution;
   {
     nested_rev_autodiff nested;
@@ -177,7 +190,8 @@ std::vector<Eigen::VectorXd> ode_adjoint_impl(
         relative_tolerance_backward, absolute_tolerance_backward,
         relative_tolerance_quadrature, absolute_tolerance_quadrature,
         max_num_steps, num_steps_between_checkpoints, interpolation_polynomial,
-        solver_forward, solver_backward, msgs, args...);
+        solver_forward, solver_backward, linear_solver, std::move(workspace),
+        msgs, args...);
 
     ode_solution = integrator->solution();
   }
@@ -257,7 +271,166 @@ auto ode_adjoint_tol_ctl(
       relative_tolerance_backward, absolute_tolerance_backward,
       relative_tolerance_quadrature, absolute_tolerance_quadrature,
       max_num_steps, num_steps_between_checkpoints, interpolation_polynomial,
-      solver_forward, solver_backward, msgs, args...);
+      solver_forward, solver_backward, sundials_linear_solver(), nullptr,
+      msgs, args...);
+}
+
+/**
+ * Solve the ODE initial value problem y' = f(t, y), y(t0) = y0 at a set of
+ * times, { t1, t2, t3, ... } using the stiff backward differentiation formula
+ * BDF solver or the non-stiff Adams solver from CVODES, with the given
+ * linear solver for the Newton iterations. The ODE system is integrated
+ * using the adjoint sensitivity approach of CVODES, and the backward
+ * problem uses the transpose of the linear solver, so that banded, sparse
+ * and matrix-free linear solvers apply to both passes.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial state
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Times at which to solve the ODE at. All values must be sorted and
+ *   not less than t0.
+ * @param relative_tolerance_forward Relative tolerance for forward problem
+ * passed to CVODES
+ * @param absolute_tolerance_forward Absolute tolerance per ODE state for
+ * forward problem passed to CVODES
+ * @param relative_tolerance_backward Relative tolerance for backward problem
+ * passed to CVODES
+ * @param absolute_tolerance_backward Absolute tolerance per ODE state for
+ * backward problem passed to CVODES
+ * @param relative_tolerance_quadrature Relative tolerance for quadrature
+ * problem passed to CVODES
+ * @param absolute_tolerance_quadrature Absolute tolerance for quadrature
+ * problem passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param num_steps_between_checkpoints Number of integrator steps after which a
+ * checkpoint is stored for the backward pass
+ * @param interpolation_polynomial type of polynomial used for interpolation
+ * @param solver_forward solver used for forward pass
+ * @param solver_backward solver used for backward pass
+ * @param linear_solver Linear solver for the Newton iterations of the
+ * forward problem
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ * @return An `std::vector` of Eigen column vectors with scalars equal to
+ *  the least upper bound of `T_y0`, `T_t0`, `T_ts`, and the lambda's arguments.
+ *  This represents the solution to ODE at times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename T_abs_tol_fwd, typename T_abs_tol_bwd, typename... T_Args,
+          require_all_eigen_col_vector_t<T_y0, T_abs_tol_fwd,
+                                         T_abs_tol_bwd>* = nullptr>
+auto ode_adjoint_tol_ctl(
+    F&& f, const T_y0& y0, const T_t0& t0, const std::vector<T_ts>& ts,
+    double relative_tolerance_forward,
+    const T_abs_tol_fwd& absolute_tolerance_forward,
+    double relative_tolerance_backward,
+    const T_abs_tol_bwd& absolute_tolerance_backward,
+    double relative_tolerance_quadrature, double absolute_tolerance_quadrature,
+    long int max_num_steps,                  // NOLINT(runtime/int)
+    long int num_steps_between_checkpoints,  // NOLINT(runtime/int)
+    int interpolation_polynomial, int solver_forward, int solver_backward,
+    const sundials_linear_solver& linear_solver, std::ostream* msgs,
+    const T_Args&... args) {
+  return ode_adjoint_impl(
+      "ode_adjoint_tol_ctl", std::forward<F>(f), y0, t0, ts,
+      relative_tolerance_forward, absolute_tolerance_forward,
+      relative_tolerance_backward, absolute_tolerance_backward,
+      relative_tolerance_quadrature, absolute_tolerance_quadrature,
+      max_num_steps, num_steps_between_checkpoints, interpolation_polynomial,
+      solver_forward, solver_backward, linear_solver, nullptr, msgs, args...);
+}
+
+/**
+ * Solve the ODE initial value problem y' = f(t, y), y(t0) = y0 at a set of
+ * times, { t1, t2, t3, ... } using the stiff backward differentiation formula
+ * BDF solver or the non-stiff Adams solver from CVODES, with the given
+ * linear solver and the CVODES memory of a workspace. The ODE system is
+ * integrated using the adjoint sensitivity approach of CVODES.
+ *
+ * Repeated solves of problems of the same size and kind with the same
+ * workspace reuse its CVODES memory. The checkpoints for the backward
+ * problem are bounded by the approximate checkpoint memory budget of the
+ * workspace, and are recomputed in segments during the reverse pass if the
+ * budget is set or a later solve used the workspace. The workspace counts
+ * the steps, checkpoints and Jacobian evaluations of the solves, which
+ * share its ownership until the memory of their reverse pass is recovered.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial state
+ * @tparam T_t0 Type of initial time
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of pass-through parameters
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state
+ * @param t0 Initial time
+ * @param ts Times at which to solve the ODE at. All values must be sorted and
+ *   not less than t0.
+ * @param relative_tolerance_forward Relative tolerance for forward problem
+ * passed to CVODES
+ * @param absolute_tolerance_forward Absolute tolerance per ODE state for
+ * forward problem passed to CVODES
+ * @param relative_tolerance_backward Relative tolerance for backward problem
+ * passed to CVODES
+ * @param absolute_tolerance_backward Absolute tolerance per ODE state for
+ * backward problem passed to CVODES
+ * @param relative_tolerance_quadrature Relative tolerance for quadrature
+ * problem passed to CVODES
+ * @param absolute_tolerance_quadrature Absolute tolerance for quadrature
+ * problem passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param num_steps_between_checkpoints Number of integrator steps after which a
+ * checkpoint is stored for the backward pass
+ * @param interpolation_polynomial type of polynomial used for interpolation
+ * @param solver_forward solver used for forward pass
+ * @param solver_backward solver used for backward pass
+ * @param linear_solver Linear solver for the Newton iterations of the
+ * forward problem
+ * @param[in, out] workspace Workspace holding the CVODES memory and the
+ * counters of the solves, shared with the reverse pass of the solve
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments passed unmodified through to ODE right hand side
+ * @return An `std::vector` of Eigen column vectors with scalars equal to
+ *  the least upper bound of `T_y0`, `T_t0`, `T_ts`, and the lambda's arguments.
+ *  This represents the solution to ODE at times \p ts
+ * @throw std::invalid_argument if the checkpoint memory budget of the
+ * workspace cannot hold two checkpoints and the interpolation data between
+ * them
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename T_abs_tol_fwd, typename T_abs_tol_bwd, typename... T_Args,
+          require_all_eigen_col_vector_t<T_y0, T_abs_tol_fwd,
+                                         T_abs_tol_bwd>* = nullptr>
+auto ode_adjoint_tol_ctl(
+    F&& f, const T_y0& y0, const T_t0& t0, const std::vector<T_ts>& ts,
+    double relative_tolerance_forward,
+    const T_abs_tol_fwd& absolute_tolerance_forward,
+    double relative_tolerance_backward,
+    const T_abs_tol_bwd& absolute_tolerance_backward,
+    double relative_tolerance_quadrature, double absolute_tolerance_quadrature,
+    long int max_num_steps,                  // NOLINT(runtime/int)
+    long int num_steps_between_checkpoints,  // NOLINT(runtime/int)
+    int interpolation_polynomial, int solver_forward, int solver_backward,
+    const sundials_linear_solver& linear_solver,
+    const std::shared_ptr<cvodes_adjoint_workspace>& workspace,
+    std::ostream* msgs,
+    const T_Args&... args) {
+  return ode_adjoint_impl(
+      "ode_adjoint_tol_ctl", std::forward<F>(f), y0, t0, ts,
+      relative_tolerance_forward, absolute_tolerance_forward,
+      relative_tolerance_backward, absolute_tolerance_backward,
+      relative_tolerance_quadrature, absolute_tolerance_quadrature,
+      max_num_steps, num_steps_between_checkpoints, interpolation_polynomial,
+      solver_forward, solver_backward, linear_solver, workspace, msgs,
+      args...);
 }
 
 }  // namespace math
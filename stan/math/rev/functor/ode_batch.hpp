@@ -0,0 +1,517 @@
+#ifndef STAN_MATH_REV_FUNCTOR_ODE_BATCH_HPP
+#define STAN_MATH_REV_FUNCTOR_ODE_BATCH_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/cvodes_integrator.hpp>
+#include <stan/math/rev/functor/cvodes_workspace.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <stan/math/prim/functor/ode_rk45.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Call <code>solve(i, workspace)</code> for every subject i, on the TBB
+ * threadpool if <code>STAN_THREADS</code> is defined. Each thread keeps
+ * one CVODES workspace for all the subjects it solves.
+ *
+ * @tparam Solve type of the functor solving one subject
+ * @param num_subjects number of subjects
+ * @param solve functor solving one subject
+ */
+template <typename Solve>
+inline void ode_batch_for_each(size_t num_subjects, const Solve& solve) {
+  tbb::enumerable_thread_specific<cvodes_workspace> workspaces;
+#ifdef STAN_THREADS
+  // see reduce_sum for the need of isolation
+  tbb::this_task_arena::isolate([&] {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_subjects),
+                      [&](const tbb::blocked_range<size_t>& r) {
+                        cvodes_workspace& workspace = workspaces.local();
+                        for (size_t i = r.begin(); i < r.end(); ++i) {
+                          solve(i, workspace);
+                        }
+                      });
+  });
+#else
+  // without STAN_THREADS the AD stack pointer is shared by all threads
+  cvodes_workspace& workspace = workspaces.local();
+  for (size_t i = 0; i < num_subjects; ++i) {
+    solve(i, workspace);
+  }
+#endif
+}
+
+/**
+ * Solver of one subject of a batch with a multistep method of CVODES,
+ * reusing the CVODES workspace of the thread.
+ *
+ * @tparam Lmm CVODES multistep method, CV_BDF or CV_ADAMS
+ */
+template <int Lmm>
+struct ode_batch_cvodes_solver {
+  template <typename F, typename T_y0, typename T_t0, typename T_ts,
+            typename... T_Args>
+  static auto solve(const char* function_name, const F& f, const T_y0& y0,
+                    const T_t0& t0, const std::vector<T_ts>& ts,
+                    double relative_tolerance, double absolute_tolerance,
+                    long int max_num_steps,  // NOLINT(runtime/int)
+                    std::ostream* msgs, cvodes_workspace& workspace,
+                    const T_Args&... args) {
+    cvodes_integrator<Lmm, F, T_y0, T_t0, T_ts, T_Args...> integrator(
+        function_name, f, y0, t0, ts, relative_tolerance, absolute_tolerance,
+        max_num_steps, sundials_linear_solver(), msgs, args...);
+    return integrator(workspace);
+  }
+};
+
+/**
+ * Solver of one subject of a batch with the Runge-Kutta 45 solver of
+ * Boost, which keeps no memory between solves and does not use the
+ * CVODES workspace of the thread.
+ */
+struct ode_batch_rk45_solver {
+  template <typename F, typename T_y0, typename T_t0, typename T_ts,
+            typename... T_Args>
+  static auto solve(const char* function_name, const F& f, const T_y0& y0,
+                    const T_t0& t0, const std::vector<T_ts>& ts,
+                    double relative_tolerance, double absolute_tolerance,
+                    long int max_num_steps,  // NOLINT(runtime/int)
+                    std::ostream* msgs, cvodes_workspace&,
+                    const T_Args&... args) {
+    return ode_rk45_tol_impl(function_name, f, y0, t0, ts, relative_tolerance,
+                             absolute_tolerance, max_num_steps, msgs,
+                             args...);
+  }
+};
+
+/**
+ * Solve the ODEs of all subjects when no argument is an autodiff type.
+ */
+template <typename Solver, typename F, typename T_y0, typename T_t0,
+          typename T_ts, typename... T_Args>
+inline std::vector<std::vector<Eigen::VectorXd>> ode_batch_impl(
+    std::false_type, const char* function_name, const F& f,
+    const std::vector<T_y0>& y0, const std::vector<T_t0>& t0,
+    const std::vector<std::vector<T_ts>>& ts, double relative_tolerance,
+    double absolute_tolerance,
+    long int max_num_steps,  // NOLINT(runtime/int)
+    std::vector<std::stringstream>& subject_msgs, bool print,
+    const std::vector<T_Args>&... args) {
+  std::vector<std::vector<Eigen::VectorXd>> ys(y0.size());
+  ode_batch_for_each(y0.size(), [&](size_t i, cvodes_workspace& workspace) {
+    ys[i] = Solver::solve(function_name, f, y0[i], t0[i], ts[i],
+                          relative_tolerance, absolute_tolerance,
+                          max_num_steps, print ? &subject_msgs[i] : nullptr,
+                          workspace, args[i]...);
+  });
+  return ys;
+}
+
+/**
+ * Solve the ODEs of all subjects when some arguments are autodiff types.
+ *
+ * Each subject is solved with nested autodiff on the AD stack of the thread
+ * solving it, from copies of its arguments, and the Jacobian of its
+ * solution with respect to its arguments is stored on the AD stack of the
+ * caller. The reverse pass of each subject is then a single product of the
+ * transposed Jacobian with the adjoints of the solution.
+ */
+template <typename Solver, typename F, typename T_y0, typename T_t0,
+          typename T_ts, typename... T_Args>
+inline std::vector<std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>>>
+ode_batch_impl(std::true_type, const char* function_name, const F& f,
+               const std::vector<T_y0>& y0, const std::vector<T_t0>& t0,
+               const std::vector<std::vector<T_ts>>& ts,
+               double relative_tolerance, double absolute_tolerance,
+               long int max_num_steps,  // NOLINT(runtime/int)
+               std::vector<std::stringstream>& subject_msgs, bool print,
+               const std::vector<T_Args>&... args) {
+  const size_t num_subjects = y0.size();
+
+  // the Jacobians are allocated by the caller, as the worker threads may
+  // have AD stacks of their own
+  std::vector<arena_matrix<Eigen::MatrixXd>> jacobians;
+  std::vector<Eigen::VectorXd> values(num_subjects);
+  jacobians.reserve(num_subjects);
+  for (size_t i = 0; i < num_subjects; ++i) {
+    const size_t num_vars = count_vars(y0[i], t0[i], ts[i], args[i]...);
+    jacobians.emplace_back(num_vars, y0[i].size() * ts[i].size());
+  }
+
+  ode_batch_for_each(num_subjects, [&](size_t i, cvodes_workspace& workspace) {
+    nested_rev_autodiff nested;
+
+    auto y0_local = deep_copy_vars(y0[i]);
+    auto t0_local = deep_copy_vars(t0[i]);
+    auto ts_local = deep_copy_vars(ts[i]);
+    std::tuple<decltype(deep_copy_vars(args[i]))...> args_local(
+        deep_copy_vars(args[i])...);
+
+    std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> ys = apply(
+        [&](const auto&... args_refs) {
+          return Solver::solve(function_name, f, y0_local, t0_local,
+                               ts_local, relative_tolerance,
+                               absolute_tolerance, max_num_steps,
+                               print ? &subject_msgs[i] : nullptr, workspace,
+                               args_refs...);
+        },
+        args_local);
+
+    const size_t N = y0_local.size();
+    Eigen::VectorXd& value = values[i];
+    arena_matrix<Eigen::MatrixXd>& jacobian = jacobians[i];
+    value.resize(N * ys.size());
+    jacobian.setZero();
+    for (size_t n = 0; n < ys.size(); ++n) {
+      for (size_t k = 0; k < N; ++k) {
+        const size_t output = n * N + k;
+        value.coeffRef(output) = ys[n].coeff(k).val();
+        if (output > 0) {
+          nested.set_zero_all_adjoints();
+        }
+        ys[n].coeffRef(k).grad();
+        apply(
+            [&](const auto&... args_refs) {
+              accumulate_adjoints(jacobian.col(output).data(), y0_local,
+                                  t0_local, ts_local, args_refs...);
+            },
+            args_local);
+      }
+    }
+  });
+
+  std::vector<std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>>> ys(
+      num_subjects);
+  for (size_t i = 0; i < num_subjects; ++i) {
+    const size_t num_vars = jacobians[i].rows();
+    vari** operands
+        = ChainableStack::instance_->memalloc_.alloc_array<vari*>(num_vars);
+    save_varis(operands, y0[i], t0[i], ts[i], args[i]...);
+    arena_t<Eigen::Matrix<var, Eigen::Dynamic, 1>> solution = values[i];
+    reverse_pass_callback(
+        [solution, jacobian = jacobians[i], operands, num_vars]() mutable {
+          const Eigen::VectorXd solution_adj = solution.adj();
+          const Eigen::VectorXd operands_adj = jacobian * solution_adj;
+          for (size_t j = 0; j < num_vars; ++j) {
+            operands[j]->adj_ += operands_adj.coeff(j);
+          }
+        });
+    const size_t N = y0[i].size();
+    ys[i].reserve(ts[i].size());
+    for (size_t n = 0; n < ts[i].size(); ++n) {
+      ys[i].emplace_back(solution.segment(n * N, N));
+    }
+  }
+  return ys;
+}
+
+/**
+ * Check the sizes of the arguments of a batch of ODE solves, solve them
+ * and print the messages of the subjects in order.
+ */
+template <typename Solver, typename F, typename T_y0, typename T_t0,
+          typename T_ts, typename... T_Args>
+inline auto ode_batch_tol_impl(const char* function_name, const F& f,
+                               const std::vector<T_y0>& y0,
+                               const std::vector<T_t0>& t0,
+                               const std::vector<std::vector<T_ts>>& ts,
+                               double relative_tolerance,
+                               double absolute_tolerance,
+                               long int max_num_steps,  // NOLINT(runtime/int)
+                               std::ostream* msgs,
+                               const std::vector<T_Args>&... args) {
+  const size_t num_subjects = y0.size();
+  check_size_match(function_name, "initial times", t0.size(), "subjects",
+                   num_subjects);
+  check_size_match(function_name, "output times", ts.size(), "subjects",
+                   num_subjects);
+  std::vector<int> unused_temp{
+      0, (check_size_match(function_name, "ode parameters and data",
+                           args.size(), "subjects", num_subjects),
+          0)...};
+
+  using is_var_return
+      = std::integral_constant<bool, is_var<return_type_t<
+                                         T_y0, T_t0, T_ts, T_Args...>>::value>;
+  std::vector<std::stringstream> subject_msgs(num_subjects);
+  auto ys = ode_batch_impl<Solver>(
+      is_var_return(), function_name, f, y0, t0, ts, relative_tolerance,
+      absolute_tolerance, max_num_steps, subject_msgs, msgs != nullptr,
+      args...);
+  if (msgs != nullptr) {
+    for (const auto& subject_msg : subject_msgs) {
+      *msgs << subject_msg.str();
+    }
+  }
+  return ys;
+}
+
+}  // namespace internal
+
+/**
+ * Solve a batch of independent ODE initial value problems
+ * y_i' = f(t, y_i, args_i), y_i(t0_i) = y0_i, such as the per subject
+ * systems of a population model, with the stiff backward differentiation
+ * formula BDF solver from CVODES.
+ *
+ * The subjects are solved in parallel on the TBB threadpool if
+ * <code>STAN_THREADS</code> is defined. Each thread reuses its CVODES
+ * memory, vectors and linear solver for all the subjects it solves as long
+ * as their systems have the same size, and the sensitivities of each
+ * subject enter the AD stack of the caller as a single Jacobian.
+ *
+ * \p f must define an operator() as for <code>ode_bdf</code>. Every
+ * argument after \p msgs is a std::vector with the argument of \p f for
+ * each subject.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial times
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of the pass-through parameters of each subject
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of each subject
+ * @param t0 Initial time of each subject
+ * @param ts Times at which to solve the ODE of each subject. The times of
+ *   each subject must be sorted and greater than its initial time.
+ * @param relative_tolerance Relative tolerance passed to CVODES
+ * @param absolute_tolerance Absolute tolerance passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of each subject passed unmodified through to
+ *   the ODE right hand side
+ * @return Solution of the ODE of each subject at its times \p ts
+ * @throw std::invalid_argument if the arguments do not have one entry per
+ *   subject, or for the errors of <code>ode_bdf_tol</code>
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_bdf_batch_tol(const F& f, const std::vector<T_y0>& y0,
+                  const std::vector<T_t0>& t0,
+                  const std::vector<std::vector<T_ts>>& ts,
+                  double relative_tolerance, double absolute_tolerance,
+                  long int max_num_steps,  // NOLINT(runtime/int)
+                  std::ostream* msgs, const std::vector<T_Args>&... args) {
+  using solver = internal::ode_batch_cvodes_solver<CV_BDF>;
+  return internal::ode_batch_tol_impl<solver>(
+      "ode_bdf_batch_tol", f, y0, t0, ts, relative_tolerance,
+      absolute_tolerance, max_num_steps, msgs, args...);
+}
+
+/**
+ * Solve a batch of independent ODE initial value problems with the stiff
+ * BDF solver from CVODES and the default tolerances of
+ * <code>ode_bdf</code>. See <code>ode_bdf_batch_tol</code>.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial times
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of the pass-through parameters of each subject
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of each subject
+ * @param t0 Initial time of each subject
+ * @param ts Times at which to solve the ODE of each subject
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of each subject passed unmodified through to
+ *   the ODE right hand side
+ * @return Solution of the ODE of each subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_bdf_batch(const F& f, const std::vector<T_y0>& y0,
+              const std::vector<T_t0>& t0,
+              const std::vector<std::vector<T_ts>>& ts, std::ostream* msgs,
+              const std::vector<T_Args>&... args) {
+  double relative_tolerance = 1e-10;
+  double absolute_tolerance = 1e-10;
+  long int max_num_steps = 1e8;  // NOLINT(runtime/int)
+
+  using solver = internal::ode_batch_cvodes_solver<CV_BDF>;
+  return internal::ode_batch_tol_impl<solver>(
+      "ode_bdf_batch", f, y0, t0, ts, relative_tolerance, absolute_tolerance,
+      max_num_steps, msgs, args...);
+}
+
+/**
+ * Solve a batch of independent ODE initial value problems with the
+ * non-stiff Adams solver from CVODES. See <code>ode_bdf_batch_tol</code>.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial times
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of the pass-through parameters of each subject
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of each subject
+ * @param t0 Initial time of each subject
+ * @param ts Times at which to solve the ODE of each subject
+ * @param relative_tolerance Relative tolerance passed to CVODES
+ * @param absolute_tolerance Absolute tolerance passed to CVODES
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of each subject passed unmodified through to
+ *   the ODE right hand side
+ * @return Solution of the ODE of each subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_adams_batch_tol(const F& f, const std::vector<T_y0>& y0,
+                    const std::vector<T_t0>& t0,
+                    const std::vector<std::vector<T_ts>>& ts,
+                    double relative_tolerance, double absolute_tolerance,
+                    long int max_num_steps,  // NOLINT(runtime/int)
+                    std::ostream* msgs, const std::vector<T_Args>&... args) {
+  using solver = internal::ode_batch_cvodes_solver<CV_ADAMS>;
+  return internal::ode_batch_tol_impl<solver>(
+      "ode_adams_batch_tol", f, y0, t0, ts, relative_tolerance,
+      absolute_tolerance, max_num_steps, msgs, args...);
+}
+
+/**
+ * Solve a batch of independent ODE initial value problems with the
+ * non-stiff Adams solver from CVODES and the default tolerances of
+ * <code>ode_adams</code>. See <code>ode_bdf_batch_tol</code>.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial times
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of the pass-through parameters of each subject
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of each subject
+ * @param t0 Initial time of each subject
+ * @param ts Times at which to solve the ODE of each subject
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of each subject passed unmodified through to
+ *   the ODE right hand side
+ * @return Solution of the ODE of each subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_adams_batch(const F& f, const std::vector<T_y0>& y0,
+                const std::vector<T_t0>& t0,
+                const std::vector<std::vector<T_ts>>& ts, std::ostream* msgs,
+                const std::vector<T_Args>&... args) {
+  double relative_tolerance = 1e-10;
+  double absolute_tolerance = 1e-10;
+  long int max_num_steps = 1e8;  // NOLINT(runtime/int)
+
+  using solver = internal::ode_batch_cvodes_solver<CV_ADAMS>;
+  return internal::ode_batch_tol_impl<solver>(
+      "ode_adams_batch", f, y0, t0, ts, relative_tolerance,
+      absolute_tolerance, max_num_steps, msgs, args...);
+}
+
+/**
+ * Solve a batch of independent ODE initial value problems with the
+ * non-stiff Runge-Kutta 45 solver from Boost. See
+ * <code>ode_bdf_batch_tol</code>.
+ *
+ * The subjects are solved in parallel as for the CVODES solvers and their
+ * sensitivities enter the AD stack of the caller as a single Jacobian per
+ * subject, but the solver has no memory to reuse between subjects.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial times
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of the pass-through parameters of each subject
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of each subject
+ * @param t0 Initial time of each subject
+ * @param ts Times at which to solve the ODE of each subject
+ * @param relative_tolerance Relative tolerance passed to Boost
+ * @param absolute_tolerance Absolute tolerance passed to Boost
+ * @param max_num_steps Upper limit on the number of integration steps to
+ *   take between each output (error if exceeded)
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of each subject passed unmodified through to
+ *   the ODE right hand side
+ * @return Solution of the ODE of each subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_rk45_batch_tol(const F& f, const std::vector<T_y0>& y0,
+                   const std::vector<T_t0>& t0,
+                   const std::vector<std::vector<T_ts>>& ts,
+                   double relative_tolerance, double absolute_tolerance,
+                   long int max_num_steps,  // NOLINT(runtime/int)
+                   std::ostream* msgs, const std::vector<T_Args>&... args) {
+  return internal::ode_batch_tol_impl<internal::ode_batch_rk45_solver>(
+      "ode_rk45_batch_tol", f, y0, t0, ts, relative_tolerance,
+      absolute_tolerance, max_num_steps, msgs, args...);
+}
+
+/**
+ * Solve a batch of independent ODE initial value problems with the
+ * non-stiff Runge-Kutta 45 solver from Boost and the default tolerances of
+ * <code>ode_rk45</code>. See <code>ode_rk45_batch_tol</code>.
+ *
+ * @tparam F Type of ODE right hand side
+ * @tparam T_y0 Type of initial states
+ * @tparam T_t0 Type of initial times
+ * @tparam T_ts Type of output times
+ * @tparam T_Args Types of the pass-through parameters of each subject
+ *
+ * @param f Right hand side of the ODE
+ * @param y0 Initial state of each subject
+ * @param t0 Initial time of each subject
+ * @param ts Times at which to solve the ODE of each subject
+ * @param[in, out] msgs the print stream for warning messages
+ * @param args Extra arguments of each subject passed unmodified through to
+ *   the ODE right hand side
+ * @return Solution of the ODE of each subject at its times \p ts
+ */
+template <typename F, typename T_y0, typename T_t0, typename T_ts,
+          typename... T_Args, require_eigen_col_vector_t<T_y0>* = nullptr>
+std::vector<std::vector<Eigen::Matrix<
+    stan::return_type_t<T_y0, T_t0, T_ts, T_Args...>, Eigen::Dynamic, 1>>>
+ode_rk45_batch(const F& f, const std::vector<T_y0>& y0,
+               const std::vector<T_t0>& t0,
+               const std::vector<std::vector<T_ts>>& ts, std::ostream* msgs,
+               const std::vector<T_Args>&... args) {
+  double relative_tolerance = 1e-6;
+  double absolute_tolerance = 1e-6;
+  long int max_num_steps = 1e6;  // NOLINT(runtime/int)
+
+  return internal::ode_batch_tol_impl<internal::ode_batch_rk45_solver>(
+      "ode_rk45_batch", f, y0, t0, ts, relative_tolerance, absolute_tolerance,
+      max_num_steps, msgs, args...);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -8,9 +8,11 @@
 #include <tbb/task_arena.h>
 #include <tbb/parallel_reduce.h>
 #include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 
 #include <tuple>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -18,6 +20,53 @@ namespace stan {
 namespace math {
 namespace internal {
 
+/**
+ * Pool of AD stacks holding the copies of the shared arguments of
+ * reduce_sum. A stack is taken from the pool by a worker thread the
+ * first time it runs a chunk of a call and returned, with its memory
+ * recovered but its arena blocks kept, at the end of the call. Later
+ * calls thus make their copies without allocating memory.
+ */
+class scoped_stack_pool {
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ScopedChainableStack>> stacks_;
+
+ public:
+  /**
+   * Return a stack from the pool or a new one if the pool is empty.
+   */
+  std::unique_ptr<ScopedChainableStack> acquire() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!stacks_.empty()) {
+        auto stack = std::move(stacks_.back());
+        stacks_.pop_back();
+        return stack;
+      }
+    }
+    return std::make_unique<ScopedChainableStack>();
+  }
+
+  /**
+   * Recover the memory of a stack and return it to the pool.
+   *
+   * @param stack stack to return
+   */
+  void release(std::unique_ptr<ScopedChainableStack> stack) {
+    stack->execute([] { recover_memory(); });
+    std::lock_guard<std::mutex> lock(mutex_);
+    stacks_.push_back(std::move(stack));
+  }
+
+  /**
+   * Return the pool shared by all calls of reduce_sum.
+   */
+  static scoped_stack_pool& instance() {
+    static scoped_stack_pool pool;
+    return pool;
+  }
+};
+
 /**
  * Var specialization of reduce_sum_impl
  *
@@ -30,15 +79,67 @@ template <typename ReduceFunction, typename ReturnType, typename Vec,
           typename... Args>
 struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
                        Vec, Args...> {
+  /**
+   * Deep copies of the shared arguments, made on a stack from the
+   * scoped_stack_pool the first time they are needed. The adjoints of the
+   * copies are not zeroed between chunks, so the adjoints of all chunks
+   * using the copies accumulate in place and are read only once. Shared
+   * arguments a chunk does not depend on cost nothing in that chunk.
+   */
   struct scoped_args_tuple {
-    ScopedChainableStack stack_;
     using args_tuple_t
         = std::tuple<decltype(deep_copy_vars(std::declval<Args>()))...>;
+    std::unique_ptr<ScopedChainableStack> stack_;
     std::unique_ptr<args_tuple_t> args_tuple_holder_;
 
-    scoped_args_tuple() : stack_(), args_tuple_holder_(nullptr) {}
+    scoped_args_tuple() = default;
+    scoped_args_tuple(const scoped_args_tuple&) = delete;
+    scoped_args_tuple& operator=(const scoped_args_tuple&) = delete;
+
+    ~scoped_args_tuple() {
+      if (stack_) {
+        args_tuple_holder_.reset();
+        scoped_stack_pool::instance().release(std::move(stack_));
+      }
+    }
+
+    /**
+     * Return the copies of the shared arguments, copying them on first
+     * use.
+     *
+     * @param args_tuple shared arguments
+     * @return deep copies of the shared arguments
+     */
+    inline args_tuple_t& get(const std::tuple<Args...>& args_tuple) {
+      if (!args_tuple_holder_) {
+        stack_ = scoped_stack_pool::instance().acquire();
+        stack_->execute([&]() {
+          apply(
+              [&](auto&&... args) {
+                args_tuple_holder_
+                    = std::make_unique<args_tuple_t>(deep_copy_vars(args)...);
+              },
+              args_tuple);
+        });
+      }
+      return *args_tuple_holder_;
+    }
+
+    /**
+     * Add the adjoints of the copies, if any were made, to dest.
+     *
+     * @param dest adjoints of the shared arguments
+     */
+    inline void accumulate(double* dest) const {
+      if (args_tuple_holder_) {
+        apply([&](auto&&... args) { accumulate_adjoints(dest, args...); },
+              *args_tuple_holder_);
+      }
+    }
   };
 
+  using thread_args_t = tbb::enumerable_thread_specific<scoped_args_tuple>;
+
   /**
    * This struct is used by the TBB to accumulate partial
    *  sums over consecutive ranges of the input. To distribute the workload,
@@ -55,19 +156,29 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
     Vec vmapped_;
     std::stringstream msgs_;
     std::tuple<Args...> args_tuple_;
+    // copies of the shared arguments per worker thread, or nullptr if
+    // every reducer keeps its own copies
+    thread_args_t* thread_args_;
     scoped_args_tuple local_args_tuple_scope_;
     double sum_{0.0};
+    // adjoints of the shared arguments collected from joined reducers
     Eigen::VectorXd args_adjoints_{0};
+    grainsize_tuner* tuner_;
+    grainsize_tuner::chunk_stats stats_;
 
     template <typename VecT, typename... ArgsT>
     recursive_reducer(size_t num_vars_per_term, size_t num_vars_shared_terms,
-                      double* sliced_partials, VecT&& vmapped, ArgsT&&... args)
+                      double* sliced_partials, grainsize_tuner* tuner,
+                      thread_args_t* thread_args, VecT&& vmapped,
+                      ArgsT&&... args)
         : num_vars_per_term_(num_vars_per_term),
           num_vars_shared_terms_(num_vars_shared_terms),
           sliced_partials_(sliced_partials),
           vmapped_(std::forward<VecT>(vmapped)),
+          args_tuple_(std::forward<ArgsT>(args)...),
+          thread_args_(thread_args),
           local_args_tuple_scope_(),
-          args_tuple_(std::forward<ArgsT>(args)...) {}
+          tuner_(tuner) {}
 
     /*
      * This is the copy operator as required for tbb::parallel_reduce
@@ -80,8 +191,10 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
           num_vars_shared_terms_(other.num_vars_shared_terms_),
           sliced_partials_(other.sliced_partials_),
           vmapped_(other.vmapped_),
+          args_tuple_(other.args_tuple_),
+          thread_args_(other.thread_args_),
           local_args_tuple_scope_(),
-          args_tuple_(other.args_tuple_) {}
+          tuner_(other.tuner_) {}
 
     /**
      * Compute, using nested autodiff, the value and Jacobian of
@@ -93,6 +206,8 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
      *  different thread other than the current thread of execution. This
      * function may be called multiple times per object instantiation (so the
      * sum_ and args_adjoints_ must be accumulated, not just assigned).
+     * If a grainsize tuner is set, the time spent in the terms and in
+     * copying arguments and collecting adjoints is accumulated in stats_.
      *
      * @param r Range over which to compute reduce_sum
      */
@@ -101,33 +216,18 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
         return;
       }
 
-      if (args_adjoints_.size() == 0) {
-        args_adjoints_ = Eigen::VectorXd::Zero(num_vars_shared_terms_);
+      grainsize_tuner::clock::time_point start;
+      if (tuner_) {
+        start = grainsize_tuner::clock::now();
       }
 
       // Obtain reference to a local copy of all shared arguments that do
-      // not point
-      //   back to main autodiff stack
-
-      if (!local_args_tuple_scope_.args_tuple_holder_) {
-        // shared arguments need to be copied to reducer-specific
-        // scope. In this case no need for zeroing adjoints, since the
-        // fresh copy has all adjoints set to zero.
-        local_args_tuple_scope_.stack_.execute([&]() {
-          apply(
-              [&](auto&&... args) {
-                local_args_tuple_scope_.args_tuple_holder_ = std::make_unique<
-                    typename scoped_args_tuple::args_tuple_t>(
-                    deep_copy_vars(args)...);
-              },
-              args_tuple_);
-        });
-      } else {
-        // set adjoints of shared arguments to zero
-        local_args_tuple_scope_.stack_.execute([] { set_zero_all_adjoints(); });
-      }
-
-      auto& args_tuple_local = *(local_args_tuple_scope_.args_tuple_holder_);
+      //   not point back to main autodiff stack. The copies are shared by
+      //   all chunks run by this worker thread (or by this reducer) and
+      //   the adjoints of the chunks accumulate in them.
+      scoped_args_tuple& local_args
+          = thread_args_ ? thread_args_->local() : local_args_tuple_scope_;
+      auto& args_tuple_local = local_args.get(args_tuple_);
 
       // Initialize nested autodiff stack
       const nested_rev_autodiff begin_nest;
@@ -140,6 +240,11 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
         local_sub_slice.emplace_back(deep_copy_vars(vmapped_[i]));
       }
 
+      grainsize_tuner::clock::time_point copied;
+      if (tuner_) {
+        copied = grainsize_tuner::clock::now();
+      }
+
       // Perform calculation
       var sub_sum_v = apply(
           [&](auto&&... args) {
@@ -151,6 +256,11 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
       // Compute Jacobian
       sub_sum_v.grad();
 
+      grainsize_tuner::clock::time_point evaluated;
+      if (tuner_) {
+        evaluated = grainsize_tuner::clock::now();
+      }
+
       // Accumulate value of reduce_sum
       sum_ += sub_sum_v.val();
 
@@ -158,31 +268,54 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
       accumulate_adjoints(sliced_partials_ + r.begin() * num_vars_per_term_,
                           std::move(local_sub_slice));
 
-      // Accumulate adjoints of shared_arguments
-      apply(
-          [&](auto&&... args) {
-            accumulate_adjoints(args_adjoints_.data(), args...);
-          },
-          args_tuple_local);
+      if (tuner_) {
+        stats_.num_chunks_ += 1;
+        stats_.num_terms_ += r.size();
+        stats_.term_seconds_ += grainsize_tuner::seconds(copied, evaluated);
+        stats_.overhead_seconds_
+            += grainsize_tuner::seconds(start, copied)
+               + grainsize_tuner::seconds(evaluated,
+                                          grainsize_tuner::clock::now());
+      }
     }
 
     /**
-     * Join reducers. Accumuluate the value (sum_) and Jacobian (arg_adoints_)
-     *   of the other reducer.
+     * Join reducers. Accumuluate the value (sum_) and, if the reducers
+     *   keep their own copies of the shared arguments, the Jacobian
+     *   (args_adjoints_ and the adjoints of the copies) of the other
+     *   reducer.
      *
      * @param rhs Another partial sum
      */
     inline void join(const recursive_reducer& rhs) {
       sum_ += rhs.sum_;
-      if (args_adjoints_.size() != 0 && rhs.args_adjoints_.size() != 0) {
-        args_adjoints_ += rhs.args_adjoints_;
-      } else if (args_adjoints_.size() == 0 && rhs.args_adjoints_.size() != 0) {
-        args_adjoints_ = rhs.args_adjoints_;
+      if (rhs.args_adjoints_.size() != 0
+          || rhs.local_args_tuple_scope_.args_tuple_holder_) {
+        if (args_adjoints_.size() == 0) {
+          args_adjoints_ = Eigen::VectorXd::Zero(num_vars_shared_terms_);
+        }
+        if (rhs.args_adjoints_.size() != 0) {
+          args_adjoints_ += rhs.args_adjoints_;
+        }
+        rhs.local_args_tuple_scope_.accumulate(args_adjoints_.data());
       }
       msgs_ << rhs.msgs_.str();
+      stats_.add(rhs.stats_);
     }
   };
 
+  grainsize_tuner* tuner_{nullptr};
+
+  reduce_sum_impl() = default;
+
+  /**
+   * Construct an implementation which measures the cost of the terms and
+   * reports it to the tuner after every call.
+   *
+   * @param tuner grainsize tuner
+   */
+  explicit reduce_sum_impl(grainsize_tuner* tuner) : tuner_(tuner) {}
+
   /**
    * Call an instance of the function `ReduceFunction` on every element
    *   of an input sequence and sum these terms.
@@ -216,6 +349,12 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
    *  than or equal to grainsize and accumulate all the partial sums
    *  in the same order. This still may not achieve bitwise reproducibility.
    *
+   * The shared arguments are deep copied once per worker thread with auto
+   *  partitioning and once per reducer otherwise, on stacks reused across
+   *  calls. The adjoints of the shared arguments accumulate in place in
+   *  the copies over all chunks using them and are summed once at the end
+   *  of the call (or when reducers are joined).
+   *
    * @param vmapped Vector containing one element per term of sum
    * @param auto_partitioning Work partitioning style
    * @param grainsize Suggested grainsize for tbb
@@ -242,11 +381,14 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
     save_varis(varis, vmapped);
     save_varis(varis + num_vars_sliced_terms, args...);
 
-    for (size_t i = 0; i < num_vars_sliced_terms; ++i) {
+    for (size_t i = 0; i < num_vars_sliced_terms + num_vars_shared_terms;
+         ++i) {
       partials[i] = 0.0;
     }
 
+    thread_args_t thread_args;
     recursive_reducer worker(num_vars_per_term, num_vars_shared_terms, partials,
+                             tuner_, auto_partitioning ? &thread_args : nullptr,
                              std::forward<Vec>(vmapped),
                              std::forward<Args>(args)...);
 
@@ -268,13 +410,23 @@ struct reduce_sum_impl<ReduceFunction, require_var_t<ReturnType>, ReturnType,
       }
     });
 
-    for (size_t i = 0; i < num_vars_shared_terms; ++i) {
-      partials[num_vars_sliced_terms + i] = worker.args_adjoints_.coeff(i);
+    double* shared_partials = partials + num_vars_sliced_terms;
+    for (const auto& local_args : thread_args) {
+      local_args.accumulate(shared_partials);
+    }
+    worker.local_args_tuple_scope_.accumulate(shared_partials);
+    if (worker.args_adjoints_.size() != 0) {
+      for (size_t i = 0; i < num_vars_shared_terms; ++i) {
+        shared_partials[i] += worker.args_adjoints_.coeff(i);
+      }
     }
 
     if (msgs) {
       *msgs << worker.msgs_.str();
     }
+    if (tuner_) {
+      tuner_->update(worker.stats_);
+    }
 
     return var(new precomputed_gradients_vari(
         worker.sum_, num_vars_sliced_terms + num_vars_shared_terms, varis,
@@ -0,0 +1,461 @@
+#ifndef STAN_MATH_REV_FUNCTOR_RETAPED_GRADIENT_HPP
+#define STAN_MATH_REV_FUNCTOR_RETAPED_GRADIENT_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Operation of a replay program: a record of the op tape with its
+ * operands and result resolved to slots of the value and adjoint arrays
+ * of the program.
+ */
+struct replay_op {
+  op_fun fun_;
+  size_t res_;
+  size_t a_;
+  size_t b_;  // res_ for one operand functions
+  double c_;  // constant operand of one operand functions
+  double da_{0};
+  double db_{0};
+
+  /**
+   * Compute the value of the result and the partials from the values
+   * of the operands.
+   *
+   * @param[in, out] values values of the slots
+   */
+  inline void forward(std::vector<double>& values) {
+    const double a = values[a_];
+    double& res = values[res_];
+    switch (fun_) {
+      case op_fun::add:
+        res = a + values[b_];
+        da_ = 1.0;
+        db_ = 1.0;
+        break;
+      case op_fun::add_const:
+        res = a + c_;
+        da_ = 1.0;
+        break;
+      case op_fun::subtract:
+        res = a - values[b_];
+        da_ = 1.0;
+        db_ = -1.0;
+        break;
+      case op_fun::subtract_const:
+        res = a - c_;
+        da_ = 1.0;
+        break;
+      case op_fun::const_subtract:
+        res = c_ - a;
+        da_ = -1.0;
+        break;
+      case op_fun::multiply: {
+        const double b = values[b_];
+        res = a * b;
+        da_ = b;
+        db_ = a;
+        break;
+      }
+      case op_fun::multiply_const:
+        res = a * c_;
+        da_ = c_;
+        break;
+      case op_fun::divide: {
+        const double b = values[b_];
+        res = a / b;
+        da_ = 1.0 / b;
+        db_ = -res / b;
+        break;
+      }
+      case op_fun::divide_const:
+        res = a / c_;
+        da_ = 1.0 / c_;
+        break;
+      case op_fun::const_divide:
+        res = c_ / a;
+        da_ = -res / a;
+        break;
+      case op_fun::negate:
+        res = -a;
+        da_ = -1.0;
+        break;
+      case op_fun::exp:
+        res = std::exp(a);
+        da_ = res;
+        break;
+      case op_fun::log:
+        res = std::log(a);
+        da_ = 1.0 / a;
+        break;
+      default:
+        break;
+    }
+  }
+};
+
+/**
+ * Comparison of a replay program with the outcome it had when the
+ * function was recorded.
+ */
+struct replay_branch {
+  op_fun fun_;
+  size_t a_;
+  size_t b_;
+  bool taken_;
+
+  /**
+   * Return true if the comparison has the recorded outcome for the
+   * current values.
+   *
+   * @param values values of the slots
+   */
+  inline bool holds(const std::vector<double>& values) const {
+    const double a = values[a_];
+    const double b = values[b_];
+    switch (fun_) {
+      case op_fun::less:
+        return (a < b) == taken_;
+      case op_fun::less_equal:
+        return (a <= b) == taken_;
+      case op_fun::greater:
+        return (a > b) == taken_;
+      case op_fun::greater_equal:
+        return (a >= b) == taken_;
+      case op_fun::equal:
+        return (a == b) == taken_;
+      case op_fun::not_equal:
+        return (a != b) == taken_;
+      default:
+        return false;
+    }
+  }
+};
+
+}  // namespace internal
+
+/**
+ * Gradient functor for repeated evaluation of a function whose tape has
+ * the same structure for every input, i.e. functions without data
+ * dependent control flow.
+ *
+ * The first evaluation runs the function on an AD stack owned by this
+ * object (a <code>ScopedChainableStack</code>), separate from the AD
+ * stack of the calling thread, and compiles the op tape it leaves (see
+ * <code>tape_op</code>) into a replay program: the values of the varis
+ * become slots of an array and every op record an operation on those
+ * slots. Later evaluations write the arguments into their slots, replay
+ * the operations forward to recompute the values and the partials and
+ * sweep them backwards for the gradient. The function is not called,
+ * nothing is allocated and the <code>check_*</code> calls of the function
+ * do not run.
+ *
+ * A tape can only be replayed if Stan Math is compiled with
+ * <code>STAN_OPCODE_TAPE</code> defined and every operation of the
+ * function is recorded on the op tape with its forward function (the
+ * arithmetic operators, <code>exp</code> and <code>log</code>). Otherwise
+ * <code>replayable()</code> is false and every evaluation runs the
+ * function and a normal reverse pass on the owned stack. Vars created
+ * from doubles in the function are constants of the replay, so the
+ * function must not compute them from the values of its arguments.
+ *
+ * While recording, the comparisons of vars in the function are recorded
+ * as well. A replay in which a comparison has another outcome than in
+ * the recording means that the control flow of the function diverged:
+ * the evaluation falls back to running the function and a normal
+ * reverse pass, which records the new path, and the divergence is
+ * counted in <code>num_divergences()</code>; in strict mode a
+ * <code>std::domain_error</code> is thrown instead. Control flow on the
+ * values of the arguments taken with <code>value_of()</code> or
+ * <code>val()</code> is not seen. A replay producing a value or gradient
+ * which is not finite also falls back to running the function, so that
+ * its argument checks throw as they would for <code>gradient()</code>.
+ *
+ * <code>invalidate()</code> drops the recording and returns the memory
+ * of the tape to the system.
+ *
+ * The functor must be callable with an
+ * <code>Eigen::Matrix<var, Eigen::Dynamic, 1></code> and return a
+ * <code>var</code>, as for <code>gradient()</code>.
+ *
+ * @tparam F type of function
+ */
+template <typename F>
+class retaped_gradient {
+ public:
+  /**
+   * Construct the gradient functor.
+   *
+   * @param f function to differentiate
+   * @param strict if true, throw when the control flow of a replay
+   * diverges from the recording instead of recording the new path
+   */
+  explicit retaped_gradient(const F& f, bool strict = false)
+      : f_(f), strict_(strict) {}
+
+  /**
+   * Calculate the value and the gradient of the function at the
+   * specified argument.
+   *
+   * @param[in] x argument to function
+   * @param[out] fx function applied to argument
+   * @param[out] grad_fx gradient of function at argument
+   * @throw std::domain_error in strict mode if the control flow diverges
+   * from the recording
+   */
+  void operator()(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  double& fx,
+                  Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+    if (replayable_ && static_cast<size_t>(x.size()) == inputs_.size()
+        && replay(x, fx, grad_fx)) {
+      return;
+    }
+    evaluate(x, fx, grad_fx);
+  }
+
+  /**
+   * Drop the recording and return the memory held by the tape to the
+   * system. The next evaluation records the function again.
+   */
+  void invalidate() {
+    recorded_ = false;
+    replayable_ = false;
+    clear_program();
+    values_.shrink_to_fit();
+    adjoints_.shrink_to_fit();
+    ops_.shrink_to_fit();
+    branches_.shrink_to_fit();
+    inputs_.shrink_to_fit();
+    tape_.execute([]() {
+      auto& stack = *ChainableStack::instance_;
+      stack.var_stack_.clear();
+      stack.var_stack_.shrink_to_fit();
+      stack.var_nochain_stack_.clear();
+      stack.var_nochain_stack_.shrink_to_fit();
+      stack.op_stack_.clear();
+      stack.op_stack_.shrink_to_fit();
+      stack.memalloc_.free_all();
+    });
+    x_var_.resize(0);
+  }
+
+  /**
+   * Return true if the function has been recorded.
+   *
+   * @return true if recorded
+   */
+  bool recorded() const { return recorded_; }
+
+  /**
+   * Return true if the recording is replayed, false if the evaluations
+   * run the function and a normal reverse pass.
+   *
+   * @return true if replayable
+   */
+  bool replayable() const { return replayable_; }
+
+  /**
+   * Return the number of replays whose control flow diverged from the
+   * recording.
+   *
+   * @return number of divergences
+   */
+  size_t num_divergences() const { return num_divergences_; }
+
+ private:
+  F f_;
+  bool strict_;
+  bool recorded_{false};
+  bool replayable_{false};
+  size_t num_divergences_{0};
+  ScopedChainableStack tape_;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_var_;
+
+  // replay program
+  std::vector<double> values_;
+  std::vector<double> adjoints_;
+  std::vector<internal::replay_op> ops_;
+  std::vector<internal::replay_branch> branches_;
+  std::vector<size_t> inputs_;
+  size_t output_{0};
+
+  void clear_program() {
+    values_.clear();
+    adjoints_.clear();
+    ops_.clear();
+    branches_.clear();
+    inputs_.clear();
+  }
+
+  /**
+   * Replay the recording at the specified argument.
+   *
+   * @return false if the evaluation has to run the function instead
+   * @throw std::domain_error in strict mode if the control flow diverges
+   */
+  bool replay(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x, double& fx,
+              Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      values_[inputs_[i]] = x.coeff(i);
+    }
+    for (auto& op : ops_) {
+      op.forward(values_);
+    }
+    for (const auto& branch : branches_) {
+      if (!branch.holds(values_)) {
+        ++num_divergences_;
+        if (strict_) {
+          throw std::domain_error(
+              "retaped_gradient: a comparison in the function has another "
+              "outcome than in the recording; the control flow of the "
+              "function depends on its arguments");
+        }
+        return false;
+      }
+    }
+
+    std::fill(adjoints_.begin(), adjoints_.end(), 0.0);
+    adjoints_[output_] = 1.0;
+    for (auto op = ops_.rbegin(); op != ops_.rend(); ++op) {
+      const double adj = adjoints_[op->res_];
+      adjoints_[op->a_] += adj * op->da_;
+      if (op->b_ != op->res_) {
+        adjoints_[op->b_] += adj * op->db_;
+      }
+    }
+    fx = values_[output_];
+    grad_fx.resize(inputs_.size());
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+      grad_fx.coeffRef(i) = adjoints_[inputs_[i]];
+    }
+    return std::isfinite(fx) && grad_fx.allFinite();
+  }
+
+  /**
+   * Run the function and a normal reverse pass on the owned stack,
+   * recording the function if there is no recording or the recording is
+   * replayable.
+   */
+  void evaluate(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                double& fx, Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+    const bool record = !recorded_ || replayable_;
+    tape_.execute([&]() {
+      auto& stack = *ChainableStack::instance_;
+      try {
+        stack.record_branches_ = record;
+        x_var_ = x.template cast<var>();
+        var fx_var = f_(x_var_);
+        stack.record_branches_ = false;
+        if (record) {
+          replayable_ = compile(fx_var);
+          recorded_ = true;
+        }
+        fx = fx_var.val();
+        grad(fx_var.vi_);
+        grad_fx = x_var_.adj();
+      } catch (...) {
+        stack.record_branches_ = false;
+        recover_memory();
+        throw;
+      }
+      recover_memory();
+    });
+  }
+
+  /**
+   * Compile the tape of the owned stack into the replay program.
+   *
+   * @param fx_var result of the function
+   * @return false if the tape holds operations which cannot be replayed
+   */
+  bool compile(const var& fx_var) {
+    clear_program();
+    auto& stack = *ChainableStack::instance_;
+    if (!stack.var_alloc_stack_.empty()) {
+      return false;
+    }
+    // every scalar vari of the tape gets a slot; the varis on the var
+    // stack must not have a chain() method, those which are not operands
+    // or results of op records are constants
+    std::unordered_map<const double*, size_t> slots;
+    auto add_slots = [&](const std::vector<vari_base*>& varis) {
+      for (vari_base* vi : varis) {
+        if (typeid(*vi) != typeid(vari)) {
+          return false;
+        }
+        vari* scalar_vi = static_cast<vari*>(vi);
+        slots.emplace(&scalar_vi->adj_, values_.size());
+        values_.push_back(scalar_vi->val_);
+      }
+      return true;
+    };
+    if (!add_slots(stack.var_stack_) || !add_slots(stack.var_nochain_stack_)) {
+      return false;
+    }
+    auto slot = [&](const double* adj, size_t& s) {
+      auto found = slots.find(adj);
+      if (found == slots.end()) {
+        return false;
+      }
+      s = found->second;
+      return true;
+    };
+    for (Eigen::Index i = 0; i < x_var_.size(); ++i) {
+      inputs_.push_back(0);
+      if (!slot(&x_var_.coeff(i).vi_->adj_, inputs_.back())) {
+        return false;
+      }
+    }
+    if (!slot(&fx_var.vi_->adj_, output_)) {
+      return false;
+    }
+    for (const tape_op& op : stack.op_stack_) {
+      size_t a;
+      if (op.fun_ == op_fun::none || !slot(op.a_adj_, a)) {
+        return false;
+      }
+      if (op.code_ == op_code::branch) {
+        size_t b;
+        if (op.b_adj_ == nullptr) {
+          // comparison with a constant
+          b = values_.size();
+          values_.push_back(op.db_);
+        } else if (!slot(op.b_adj_, b)) {
+          return false;
+        }
+        branches_.push_back({op.fun_, a, b, op.taken_});
+        continue;
+      }
+      // one operand operations point the second operand at the result,
+      // which the reverse sweep skips
+      size_t res;
+      if (!slot(op.adj_, res)) {
+        return false;
+      }
+      size_t b = res;
+      if (op.code_ == op_code::vv && !slot(op.b_adj_, b)) {
+        return false;
+      }
+      ops_.push_back({op.fun_, res, a, b, op.db_});
+    }
+    adjoints_.resize(values_.size());
+    return true;
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
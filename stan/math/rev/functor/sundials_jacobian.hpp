@@ -0,0 +1,142 @@
+#ifndef STAN_MATH_REV_FUNCTOR_SUNDIALS_JACOBIAN_HPP
+#define STAN_MATH_REV_FUNCTOR_SUNDIALS_JACOBIAN_HPP
+
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/functor/sundials_linear_solver.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/functor/apply.hpp>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+namespace stan {
+namespace math {
+namespace internal {
+
+/**
+ * Jacobian of an ODE right hand side with respect to the states, as needed
+ * by the Newton iterations of the CVODES integrators.
+ *
+ * The general case records the right hand side once with nested reverse
+ * mode autodiff and takes one reverse sweep per state. Right hand sides
+ * wrapped with <code>analytic_jacobian</code> or
+ * <code>colored_jacobian</code> specialize this template.
+ *
+ * @tparam F ODE right hand side functor
+ */
+template <typename F>
+struct sundials_ode_jacobian {
+  /**
+   * Store the Jacobian, or its transpose, scaled by <code>scale</code> in
+   * the matrix of a linear solver.
+   *
+   * @tparam Args types of the arguments, which contain no vars
+   * @param function name of the calling function
+   * @param f ODE right hand side
+   * @param t time
+   * @param y state
+   * @param msgs stream for messages of the right hand side
+   * @param args_tuple arguments of the right hand side
+   * @param linear_solver linear solver owning the matrix
+   * @param J Jacobian matrix of the linear solver
+   * @param transpose whether to store the transpose of the Jacobian
+   * @param scale factor applied to the Jacobian
+   */
+  template <typename... Args>
+  static void store(const char* function, const F& f, double t,
+                    const Eigen::VectorXd& y, std::ostream* msgs,
+                    const std::tuple<Args...>& args_tuple,
+                    const sundials_linear_solver& linear_solver, SUNMatrix J,
+                    bool transpose, double scale) {
+    nested_rev_autodiff nested;
+
+    Eigen::Matrix<var, Eigen::Dynamic, 1> y_vars(y);
+    Eigen::Matrix<var, Eigen::Dynamic, 1> fy_vars = apply(
+        [&](auto&&... args) { return f(t, y_vars, msgs, args...); },
+        args_tuple);
+
+    check_size_match(function, "dy_dt", fy_vars.size(), "states", y.size());
+
+    linear_solver.begin_jacobian(J);
+    for (Eigen::Index i = 0; i < fy_vars.size(); ++i) {
+      if (i > 0) {
+        nested.set_zero_all_adjoints();
+      }
+      grad(fy_vars.coeffRef(i).vi_);
+      if (transpose) {
+        linear_solver.set_jacobian_column(J, i, y_vars.adj(), scale);
+      } else {
+        linear_solver.set_jacobian_row(J, i, y_vars.adj(), scale);
+      }
+    }
+  }
+};
+
+/**
+ * Jacobian \f$\partial F / \partial y + c_j \partial F / \partial y'\f$ of
+ * a DAE residual, as needed by the Newton iterations of IDAS.
+ *
+ * The general case records the residual once with nested reverse mode
+ * autodiff and takes one reverse sweep per equation. It is only used with
+ * sparse linear solvers, since IDAS approximates dense and banded
+ * Jacobians with difference quotients unless the residual supplies its
+ * Jacobian, which is indicated by <code>supplied</code>.
+ *
+ * @tparam F DAE residual functor
+ */
+template <typename F>
+struct sundials_dae_jacobian {
+  static constexpr bool supplied = false;
+
+  /**
+   * Store the Jacobian in the matrix of a linear solver.
+   *
+   * @param f DAE residual
+   * @param t time
+   * @param cj scaling of the derivative part of the Jacobian
+   * @param yy state
+   * @param yp derivative of the state
+   * @param theta parameters
+   * @param x_r real data
+   * @param x_i integer data
+   * @param msgs stream for messages of the residual
+   * @param linear_solver linear solver owning the matrix
+   * @param J Jacobian matrix of the linear solver
+   */
+  static void store(const F& f, double t, double cj,
+                    const std::vector<double>& yy,
+                    const std::vector<double>& yp,
+                    const std::vector<double>& theta,
+                    const std::vector<double>& x_r,
+                    const std::vector<int>& x_i, std::ostream* msgs,
+                    const sundials_linear_solver& linear_solver, SUNMatrix J) {
+    const size_t N = yy.size();
+
+    nested_rev_autodiff nested;
+    std::vector<var> yy_vars(yy.begin(), yy.end());
+    std::vector<var> yp_vars(yp.begin(), yp.end());
+    std::vector<var> res = f(t, yy_vars, yp_vars, theta, x_r, x_i, msgs);
+
+    check_size_match("idas_integrator", "residual", res.size(), "states", N);
+
+    Eigen::VectorXd row(N);
+    linear_solver.begin_jacobian(J);
+    for (size_t i = 0; i < N; ++i) {
+      if (i > 0) {
+        nested.set_zero_all_adjoints();
+      }
+      grad(res[i].vi_);
+      for (size_t j = 0; j < N; ++j) {
+        row.coeffRef(j) = yy_vars[j].adj() + cj * yp_vars[j].adj();
+      }
+      linear_solver.set_jacobian_row(J, i, row);
+    }
+  }
+};
+
+}  // namespace internal
+}  // namespace math
+}  // namespace stan
+#endif
@@ -0,0 +1,505 @@
+#ifndef STAN_MATH_REV_FUNCTOR_SUNDIALS_LINEAR_SOLVER_HPP
+#define STAN_MATH_REV_FUNCTOR_SUNDIALS_LINEAR_SOLVER_HPP
+
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_linearsolver.h>
+#include <sunmatrix/sunmatrix_band.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#include <sunlinsol/sunlinsol_band.h>
+#include <sunlinsol/sunlinsol_dense.h>
+#include <sunlinsol/sunlinsol_spgmr.h>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Content of the SUNDIALS linear solver which factors sparse CSC matrices
+ * with the supernodal LU decomposition of Eigen, so that sparse Jacobians
+ * can be used without KLU or SuperLU.
+ */
+struct sundials_sparse_lu_content {
+  using sparse_t = Eigen::SparseMatrix<double, Eigen::ColMajor, sunindextype>;
+  Eigen::SparseLU<sparse_t> lu_;
+  sunindextype analyzed_nnz_{-1};
+};
+
+inline SUNLinearSolver_Type sundials_sparse_lu_gettype(SUNLinearSolver S) {
+  return SUNLINEARSOLVER_DIRECT;
+}
+
+inline SUNLinearSolver_ID sundials_sparse_lu_getid(SUNLinearSolver S) {
+  return SUNLINEARSOLVER_CUSTOM;
+}
+
+inline int sundials_sparse_lu_initialize(SUNLinearSolver S) {
+  return SUNLS_SUCCESS;
+}
+
+/**
+ * Factor the sparse matrix. The fill-reducing ordering is computed for
+ * the first matrix and reused as long as the number of nonzeros stays the
+ * same, which is the case for the Newton matrices of the integrators.
+ */
+inline int sundials_sparse_lu_setup(SUNLinearSolver S, SUNMatrix A) {
+  auto* content = static_cast<sundials_sparse_lu_content*>(S->content);
+  const sunindextype n = SM_COLUMNS_S(A);
+  const sunindextype nnz = SM_INDEXPTRS_S(A)[n];
+  const sundials_sparse_lu_content::sparse_t a
+      = Eigen::Map<const sundials_sparse_lu_content::sparse_t>(
+          SM_ROWS_S(A), n, nnz, SM_INDEXPTRS_S(A), SM_INDEXVALS_S(A),
+          SM_DATA_S(A));
+  if (content->analyzed_nnz_ != nnz) {
+    content->lu_.analyzePattern(a);
+    content->analyzed_nnz_ = nnz;
+  }
+  content->lu_.factorize(a);
+  return content->lu_.info() == Eigen::Success ? SUNLS_SUCCESS
+                                               : SUNLS_LUFACT_FAIL;
+}
+
+inline int sundials_sparse_lu_solve(SUNLinearSolver S, SUNMatrix A,
+                                    N_Vector x, N_Vector b, realtype tol) {
+  auto* content = static_cast<sundials_sparse_lu_content*>(S->content);
+  const sunindextype n = NV_LENGTH_S(b);
+  Eigen::Map<Eigen::VectorXd>(NV_DATA_S(x), n)
+      = content->lu_.solve(Eigen::Map<const Eigen::VectorXd>(NV_DATA_S(b), n));
+  return SUNLS_SUCCESS;
+}
+
+inline int sundials_sparse_lu_free(SUNLinearSolver S) {
+  if (S == nullptr) {
+    return SUNLS_SUCCESS;
+  }
+  delete static_cast<sundials_sparse_lu_content*>(S->content);
+  S->content = nullptr;
+  SUNLinSolFreeEmpty(S);
+  return SUNLS_SUCCESS;
+}
+
+/**
+ * Return a SUNDIALS direct linear solver for sparse CSC matrices.
+ */
+inline SUNLinearSolver sundials_sparse_lu() {
+  SUNLinearSolver S = SUNLinSolNewEmpty();
+  if (S == nullptr) {
+    throw std::runtime_error("SUNLinSolNewEmpty failed to allocate memory");
+  }
+  S->ops->gettype = sundials_sparse_lu_gettype;
+  S->ops->getid = sundials_sparse_lu_getid;
+  S->ops->initialize = sundials_sparse_lu_initialize;
+  S->ops->setup = sundials_sparse_lu_setup;
+  S->ops->solve = sundials_sparse_lu_solve;
+  S->ops->free = sundials_sparse_lu_free;
+  S->content = new sundials_sparse_lu_content();
+  return S;
+}
+
+}  // namespace internal
+
+/**
+ * Linear solver used by the Newton iterations of the CVODES and IDAS
+ * integrators, together with the storage of the Jacobian.
+ *
+ * <ul>
+ * <li><code>dense()</code>: dense LU of the full Jacobian (the default).
+ * <li><code>band(lower, upper)</code>: banded LU of a Jacobian with the given
+ * half-bandwidths, at O(N * lower * upper) cost per factorization.
+ * <li><code>sparse(pattern)</code>: sparse LU of a Jacobian in compressed
+ * sparse column format with the sparsity pattern of the nonzeros of
+ * <code>pattern</code>, using SUNDIALS' sparse matrix and Eigen's
+ * SparseLU, so that neither KLU nor SuperLU is needed.
+ * <li><code>spgmr(max_krylov, lower, upper)</code>: matrix-free GMRES with
+ * difference quotient Jacobian-vector products, optionally preconditioned
+ * with a banded difference quotient approximation of the Jacobian.
+ * </ul>
+ *
+ * The Jacobian entries outside of the band or the pattern are dropped, so
+ * they must be structural zeros of the system for the integration to keep
+ * its accuracy.
+ */
+class sundials_linear_solver {
+ public:
+  enum class solver_type { dense, band, sparse, spgmr };
+
+  /**
+   * Construct the dense linear solver.
+   */
+  sundials_linear_solver() = default;
+
+  /**
+   * Return the dense linear solver.
+   */
+  static sundials_linear_solver dense() { return sundials_linear_solver(); }
+
+  /**
+   * Return the banded linear solver.
+   *
+   * @param lower number of nonzero diagonals below the main diagonal
+   * @param upper number of nonzero diagonals above the main diagonal
+   * @throw std::domain_error if a bandwidth is negative
+   */
+  static sundials_linear_solver band(int lower, int upper) {
+    check_nonnegative("sundials_linear_solver", "lower bandwidth", lower);
+    check_nonnegative("sundials_linear_solver", "upper bandwidth", upper);
+    sundials_linear_solver solver;
+    solver.type_ = solver_type::band;
+    solver.lower_ = lower;
+    solver.upper_ = upper;
+    return solver;
+  }
+
+  /**
+   * Return the sparse linear solver for Jacobians with the sparsity pattern
+   * of the given matrix. The diagonal is always part of the pattern.
+   *
+   * @tparam T type of the sparse matrix
+   * @param pattern square sparse matrix whose nonzeros give the pattern
+   * @throw std::invalid_argument if the matrix is not square
+   */
+  template <typename T, require_eigen_sparse_base_t<T>* = nullptr>
+  static sundials_linear_solver sparse(const T& pattern) {
+    check_square("sundials_linear_solver", "Jacobian pattern", pattern);
+    const Eigen::Index n = pattern.rows();
+    Eigen::SparseMatrix<double> p = pattern;
+    p.makeCompressed();
+    p.coeffs().setOnes();
+    Eigen::SparseMatrix<double> identity(n, n);
+    identity.setIdentity();
+    p += identity;
+    p.makeCompressed();
+
+    sundials_linear_solver solver;
+    solver.type_ = solver_type::sparse;
+    solver.col_ptr_.assign(p.outerIndexPtr(), p.outerIndexPtr() + n + 1);
+    solver.row_idx_.assign(p.innerIndexPtr(), p.innerIndexPtr() + p.nonZeros());
+    solver.index_rows();
+    return solver;
+  }
+
+  /**
+   * Return the matrix-free GMRES linear solver.
+   *
+   * @param max_krylov maximum dimension of the Krylov subspace, or zero for
+   * the SUNDIALS default of 5
+   * @param lower lower half-bandwidth of the banded preconditioner, or a
+   * negative number for no preconditioner
+   * @param upper upper half-bandwidth of the banded preconditioner
+   */
+  static sundials_linear_solver spgmr(int max_krylov = 0, int lower = -1,
+                                      int upper = -1) {
+    check_nonnegative("sundials_linear_solver", "max_krylov", max_krylov);
+    sundials_linear_solver solver;
+    solver.type_ = solver_type::spgmr;
+    solver.max_krylov_ = max_krylov;
+    if (lower >= 0) {
+      check_nonnegative("sundials_linear_solver", "upper bandwidth", upper);
+      solver.lower_ = lower;
+      solver.upper_ = upper;
+    }
+    return solver;
+  }
+
+  solver_type type() const { return type_; }
+  int lower_bandwidth() const { return lower_; }
+  int upper_bandwidth() const { return upper_; }
+
+  /**
+   * Return true if the solver stores the Jacobian in a SUNMatrix.
+   */
+  bool has_matrix() const { return type_ != solver_type::spgmr; }
+
+  /**
+   * Return true if the matrix-free solver is preconditioned with a banded
+   * approximation of the Jacobian.
+   */
+  bool has_band_preconditioner() const {
+    return type_ == solver_type::spgmr && lower_ >= 0;
+  }
+
+  /**
+   * Return true if both solvers are of the same type with the same
+   * bandwidths, Krylov dimension and sparsity pattern.
+   */
+  bool operator==(const sundials_linear_solver& other) const {
+    return type_ == other.type_ && lower_ == other.lower_
+           && upper_ == other.upper_ && max_krylov_ == other.max_krylov_
+           && col_ptr_ == other.col_ptr_ && row_idx_ == other.row_idx_;
+  }
+
+  bool operator!=(const sundials_linear_solver& other) const {
+    return !(*this == other);
+  }
+
+  /**
+   * Return the solver for the transpose of the Jacobian, as needed by the
+   * backward problem of adjoint sensitivities.
+   */
+  sundials_linear_solver transpose() const {
+    sundials_linear_solver solver = *this;
+    std::swap(solver.lower_, solver.upper_);
+    if (type_ == solver_type::sparse) {
+      // the pattern by rows is the pattern of the transpose by columns
+      solver.col_ptr_ = row_ptr_;
+      solver.row_idx_ = row_col_;
+      solver.index_rows();
+    }
+    return solver;
+  }
+
+  /**
+   * Check that the solver fits a system of the given size.
+   *
+   * @param function name of the calling function
+   * @param N number of states
+   * @throw std::invalid_argument if the pattern does not match the size
+   */
+  void check(const char* function, size_t N) const {
+    if (type_ == solver_type::sparse) {
+      check_size_match(function, "rows of the Jacobian pattern",
+                       col_ptr_.size() - 1, "states", N);
+    }
+  }
+
+  /**
+   * Return a new SUNMatrix for the Jacobian of a system with N states, or
+   * <code>nullptr</code> for the matrix-free solver.
+   */
+  SUNMatrix make_matrix(size_t N) const {
+    switch (type_) {
+      case solver_type::band:
+        return SUNBandMatrix(N, std::min<sunindextype>(upper_, N - 1),
+                             std::min<sunindextype>(lower_, N - 1));
+      case solver_type::sparse:
+        return SUNSparseMatrix(N, N, row_idx_.size(), CSC_MAT);
+      case solver_type::spgmr:
+        return nullptr;
+      default:
+        return SUNDenseMatrix(N, N);
+    }
+  }
+
+  /**
+   * Return a new SUNLinearSolver for the matrix returned by
+   * <code>make_matrix()</code>.
+   *
+   * @param y template vector of the states
+   * @param A Jacobian matrix
+   */
+  SUNLinearSolver make_solver(N_Vector y, SUNMatrix A) const {
+    switch (type_) {
+      case solver_type::band:
+        return SUNLinSol_Band(y, A);
+      case solver_type::sparse:
+        return internal::sundials_sparse_lu();
+      case solver_type::spgmr:
+        return SUNLinSol_SPGMR(y, has_band_preconditioner() ? PREC_LEFT
+                                                            : PREC_NONE,
+                               max_krylov_);
+      default:
+        return SUNDenseLinearSolver(y, A);
+    }
+  }
+
+  /**
+   * Prepare a Jacobian matrix to be filled by rows or columns. SUNDIALS
+   * zeros sparse matrices including their structure, which is restored
+   * here. Filling all rows or all columns then sets every stored entry.
+   *
+   * @param J Jacobian matrix returned by <code>make_matrix()</code>
+   */
+  void begin_jacobian(SUNMatrix J) const {
+    if (type_ == solver_type::sparse) {
+      std::copy(col_ptr_.begin(), col_ptr_.end(), SM_INDEXPTRS_S(J));
+      std::copy(row_idx_.begin(), row_idx_.end(), SM_INDEXVALS_S(J));
+    }
+  }
+
+  /**
+   * Store row <code>i</code> of the Jacobian, scaled by <code>scale</code>.
+   * Entries outside of the band or the sparsity pattern are dropped.
+   *
+   * @tparam Vec type of the dense row
+   * @param J Jacobian matrix prepared with <code>begin_jacobian()</code>
+   * @param i row index
+   * @param row dense row of the Jacobian
+   * @param scale factor applied to the row
+   */
+  template <typename Vec>
+  void set_jacobian_row(SUNMatrix J, sunindextype i, const Vec& row,
+                        double scale = 1.0) const {
+    const sunindextype n = row.size();
+    switch (type_) {
+      case solver_type::band: {
+        const sunindextype j_begin = std::max<sunindextype>(0, i - lower_);
+        const sunindextype j_end = std::min<sunindextype>(n, i + upper_ + 1);
+        for (sunindextype j = j_begin; j < j_end; ++j) {
+          SM_ELEMENT_B(J, i, j) = scale * row.coeff(j);
+        }
+        break;
+      }
+      case solver_type::sparse: {
+        realtype* data = SM_DATA_S(J);
+        for (sunindextype p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+          data[row_pos_[p]] = scale * row.coeff(row_col_[p]);
+        }
+        break;
+      }
+      default:
+        for (sunindextype j = 0; j < n; ++j) {
+          SM_ELEMENT_D(J, i, j) = scale * row.coeff(j);
+        }
+    }
+  }
+
+  /**
+   * Store column <code>j</code> of the Jacobian, scaled by
+   * <code>scale</code>. Entries outside of the band or the sparsity pattern
+   * are dropped.
+   *
+   * @tparam Vec type of the dense column
+   * @param J Jacobian matrix prepared with <code>begin_jacobian()</code>
+   * @param j column index
+   * @param col dense column of the Jacobian
+   * @param scale factor applied to the column
+   */
+  template <typename Vec>
+  void set_jacobian_column(SUNMatrix J, sunindextype j, const Vec& col,
+                           double scale = 1.0) const {
+    const sunindextype n = col.size();
+    switch (type_) {
+      case solver_type::band: {
+        const sunindextype i_begin = std::max<sunindextype>(0, j - upper_);
+        const sunindextype i_end = std::min<sunindextype>(n, j + lower_ + 1);
+        for (sunindextype i = i_begin; i < i_end; ++i) {
+          SM_ELEMENT_B(J, i, j) = scale * col.coeff(i);
+        }
+        break;
+      }
+      case solver_type::sparse: {
+        realtype* data = SM_DATA_S(J);
+        for (sunindextype p = col_ptr_[j]; p < col_ptr_[j + 1]; ++p) {
+          data[p] = scale * col.coeff(row_idx_[p]);
+        }
+        break;
+      }
+      default:
+        for (sunindextype i = 0; i < n; ++i) {
+          SM_ELEMENT_D(J, i, j) = scale * col.coeff(i);
+        }
+    }
+  }
+
+  /**
+   * Store a whole dense Jacobian, scaled by <code>scale</code>. Entries
+   * outside of the band or the sparsity pattern are dropped.
+   *
+   * @tparam EigMat type of the dense Jacobian
+   * @param J Jacobian matrix returned by <code>make_matrix()</code>
+   * @param jacobian square Jacobian of the size of the system
+   * @param scale factor applied to the Jacobian
+   */
+  template <typename EigMat, require_eigen_dense_base_t<EigMat>* = nullptr>
+  void set_jacobian(SUNMatrix J, const EigMat& jacobian,
+                    double scale = 1.0) const {
+    const auto& jacobian_ref = to_ref(jacobian);
+    begin_jacobian(J);
+    for (Eigen::Index j = 0; j < jacobian_ref.cols(); ++j) {
+      set_jacobian_column(J, j, jacobian_ref.col(j), scale);
+    }
+  }
+
+  /**
+   * Store a whole sparse Jacobian, scaled by <code>scale</code>, at a cost
+   * linear in its number of nonzeros. Entries outside of the band or the
+   * sparsity pattern are dropped. SUNDIALS zeros dense and banded matrices
+   * before asking for the Jacobian, so only the nonzeros are stored.
+   *
+   * @tparam T type of the sparse Jacobian
+   * @param J Jacobian matrix returned by <code>make_matrix()</code>
+   * @param jacobian square Jacobian of the size of the system
+   * @param scale factor applied to the Jacobian
+   */
+  template <typename T, require_eigen_sparse_base_t<T>* = nullptr>
+  void set_jacobian(SUNMatrix J, const T& jacobian, double scale = 1.0) const {
+    const Eigen::SparseMatrix<double> jacobian_csc = jacobian;
+    begin_jacobian(J);
+    if (type_ == solver_type::sparse) {
+      std::fill(SM_DATA_S(J), SM_DATA_S(J) + row_idx_.size(), 0.0);
+    }
+    for (Eigen::Index j = 0; j < jacobian_csc.outerSize(); ++j) {
+      auto p_begin = row_idx_.begin();
+      if (type_ == solver_type::sparse) {
+        p_begin += col_ptr_[j];
+      }
+      for (Eigen::SparseMatrix<double>::InnerIterator it(jacobian_csc, j); it;
+           ++it) {
+        const sunindextype i = it.row();
+        switch (type_) {
+          case solver_type::band:
+            if (i >= j - upper_ && i <= j + lower_) {
+              SM_ELEMENT_B(J, i, j) = scale * it.value();
+            }
+            break;
+          case solver_type::sparse: {
+            // the rows of a column are sorted in both matrices
+            const auto p_end = row_idx_.begin() + col_ptr_[j + 1];
+            p_begin = std::lower_bound(p_begin, p_end, i);
+            if (p_begin != p_end && *p_begin == i) {
+              SM_DATA_S(J)[p_begin - row_idx_.begin()] = scale * it.value();
+            }
+            break;
+          }
+          default:
+            SM_ELEMENT_D(J, i, j) = scale * it.value();
+        }
+      }
+    }
+  }
+
+ private:
+  solver_type type_{solver_type::dense};
+  int lower_{-1};
+  int upper_{-1};
+  int max_krylov_{0};
+  // sparsity pattern in compressed sparse column format
+  std::vector<sunindextype> col_ptr_;
+  std::vector<sunindextype> row_idx_;
+  // the same pattern by rows, with the positions of the entries in the
+  // column format
+  std::vector<sunindextype> row_ptr_;
+  std::vector<sunindextype> row_col_;
+  std::vector<sunindextype> row_pos_;
+
+  void index_rows() {
+    const sunindextype n = col_ptr_.size() - 1;
+    row_ptr_.assign(n + 1, 0);
+    for (sunindextype i : row_idx_) {
+      ++row_ptr_[i + 1];
+    }
+    for (sunindextype i = 0; i < n; ++i) {
+      row_ptr_[i + 1] += row_ptr_[i];
+    }
+    row_col_.resize(row_idx_.size());
+    row_pos_.resize(row_idx_.size());
+    std::vector<sunindextype> next(row_ptr_.begin(), row_ptr_.end() - 1);
+    for (sunindextype j = 0; j < n; ++j) {
+      for (sunindextype p = col_ptr_[j]; p < col_ptr_[j + 1]; ++p) {
+        const sunindextype q = next[row_idx_[p]]++;
+        row_col_[q] = j;
+        row_pos_[q] = p;
+      }
+    }
+  }
+};
+
+}  // namespace math
+}  // namespace stan
+#endif
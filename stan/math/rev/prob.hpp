@@ -0,0 +1,7 @@
+#ifndef STAN_MATH_REV_PROB_HPP
+#define STAN_MATH_REV_PROB_HPP
+
+#include <stan/math/rev/prob/gaussian_dlm_obs_lpdf.hpp>
+#include <stan/math/rev/prob/hmm_marginal.hpp>
+
+#endif
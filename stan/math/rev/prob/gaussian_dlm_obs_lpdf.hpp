@@ -0,0 +1,260 @@
+#ifndef STAN_MATH_REV_PROB_GAUSSIAN_DLM_OBS_LPDF_HPP
+#define STAN_MATH_REV_PROB_GAUSSIAN_DLM_OBS_LPDF_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/fun/value_of.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/constants.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/prob/gaussian_dlm_obs_lpdf.hpp>
+#include <cmath>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Predict step of the Kalman filter in double precision,
+ * m <- G m and C <- G C G' + W.
+ */
+inline void gaussian_dlm_obs_predict(const Eigen::MatrixXd& G,
+                                     const Eigen::MatrixXd& W,
+                                     Eigen::VectorXd& m, Eigen::MatrixXd& C) {
+  m = G * m;
+  Eigen::MatrixXd GCGt = G * C * G.transpose();
+  C = 0.5 * (GCGt + GCGt.transpose()) + W;
+}
+
+/**
+ * Sequential update step of the Kalman filter in double precision for
+ * one observation with design vector Fj and variance Vj.
+ *
+ * @return log density of the observation without the normalizing
+ * constant
+ */
+inline double gaussian_dlm_obs_update(const Eigen::VectorXd& Fj, double yj,
+                                      double Vj, Eigen::VectorXd& m,
+                                      Eigen::MatrixXd& C) {
+  const Eigen::VectorXd c = C * Fj;
+  const double Q = Fj.dot(c) + Vj;
+  const double e = yj - Fj.dot(m);
+  m += c * (e / Q);
+  C -= c * c.transpose() / Q;
+  C = 0.5 * (C + C.transpose()).eval();
+  return -0.5 * (std::log(Q) + e * e / Q);
+}
+
+}  // namespace internal
+
+/** \ingroup multivar_dists
+ * The log of a Gaussian dynamic linear model (GDLM) with
+ * uncorrelated observation disturbances for reverse mode autodiff.
+ *
+ * The Kalman filter is run in double precision and only the filtered
+ * means and covariances at the start of each time point are kept in the
+ * arena. The reverse pass walks the time points backwards, recomputes
+ * the predict and sequential update steps of each time point from the
+ * stored state and propagates the adjoints of the filtered state through
+ * them. Nothing else is put on the autodiff stack, so the memory is
+ * O(T n^2) instead of a vari per scalar operation of the filter.
+ *
+ * See the <code>prim</code> overload for the arguments.
+ *
+ * @throw std::domain_error if a matrix in the Kalman filter is
+ * not positive semi-definite.
+ */
+template <
+    bool propto, typename T_y, typename T_F, typename T_G, typename T_V,
+    typename T_W, typename T_m0, typename T_C0,
+    require_all_eigen_matrix_dynamic_t<T_y, T_F, T_G, T_W, T_C0>* = nullptr,
+    require_all_eigen_col_vector_t<T_V, T_m0>* = nullptr,
+    require_any_vt_var<T_y, T_F, T_G, T_V, T_W, T_m0, T_C0>* = nullptr>
+inline var gaussian_dlm_obs_lpdf(const T_y& y, const T_F& F, const T_G& G,
+                                 const T_V& V, const T_W& W, const T_m0& m0,
+                                 const T_C0& C0) {
+  static const char* function = "gaussian_dlm_obs_lpdf";
+  check_size_match(function, "columns of F", F.cols(), "rows of y", y.rows());
+  check_size_match(function, "rows of F", F.rows(), "rows of G", G.rows());
+  check_size_match(function, "rows of G", G.rows(), "columns of G", G.cols());
+  check_size_match(function, "size of V", V.size(), "rows of y", y.rows());
+  check_size_match(function, "rows of W", W.rows(), "rows of G", G.rows());
+  check_size_match(function, "size of m0", m0.size(), "rows of G", G.rows());
+  check_size_match(function, "rows of C0", C0.rows(), "rows of G", G.rows());
+
+  arena_t<T_y> arena_y = y;
+  arena_t<T_F> arena_F = F;
+  arena_t<T_G> arena_G = G;
+  arena_t<T_V> arena_V = V;
+  arena_t<T_W> arena_W = W;
+  arena_t<T_m0> arena_m0 = m0;
+  arena_t<T_C0> arena_C0 = C0;
+
+  const Eigen::MatrixXd y_val = value_of(arena_y);
+  const Eigen::MatrixXd F_val = value_of(arena_F);
+  const Eigen::MatrixXd G_val = value_of(arena_G);
+  const Eigen::VectorXd V_val = value_of(arena_V);
+  const Eigen::MatrixXd W_val = value_of(arena_W);
+  const Eigen::VectorXd m0_val = value_of(arena_m0);
+  const Eigen::MatrixXd C0_val = value_of(arena_C0);
+
+  check_finite(function, "y", y_val);
+  check_finite(function, "F", F_val);
+  check_finite(function, "G", G_val);
+  check_nonnegative(function, "V", V_val);
+  // TODO(anyone): support infinite V
+  check_finite(function, "V", V_val);
+  check_pos_semidefinite(function, "W", W_val);
+  // TODO(anyone): support infinite W
+  check_finite(function, "W", W_val);
+  check_finite(function, "m0", m0_val);
+  check_pos_semidefinite(function, "C0", C0_val);
+  check_finite(function, "C0", C0_val);
+
+  if (y.cols() == 0 || y.rows() == 0) {
+    return 0;
+  }
+
+  const int r = y.rows();  // number of variables
+  const int n = G.rows();  // number of states
+  const int T = y.cols();  // number of time points
+
+  double lp = 0;
+  if (include_summand<propto>::value) {
+    lp -= HALF_LOG_TWO_PI * r * T;
+  }
+
+  // filtered state at the start of each time point
+  arena_t<Eigen::MatrixXd> ms(n, T);
+  arena_t<Eigen::MatrixXd> Cs(n, n * T);
+  Eigen::VectorXd m = m0_val;
+  Eigen::MatrixXd C = C0_val;
+  for (int i = 0; i < T; ++i) {
+    ms.col(i) = m;
+    Cs.middleCols(i * n, n) = C;
+    internal::gaussian_dlm_obs_predict(G_val, W_val, m, C);
+    for (int j = 0; j < r; ++j) {
+      if (i == 0) {
+        check_positive(function, "Q0",
+                       F_val.col(j).dot(C * F_val.col(j)) + V_val.coeff(j));
+      }
+      lp += internal::gaussian_dlm_obs_update(F_val.col(j), y_val.coeff(j, i),
+                                              V_val.coeff(j), m, C);
+    }
+  }
+
+  return make_callback_var(lp, [arena_y, arena_F, arena_G, arena_V, arena_W,
+                                arena_m0, arena_C0, ms,
+                                Cs](auto& vi) mutable {
+    const double lp_adj = vi.adj();
+    const int r = arena_y.rows();
+    const int n = arena_G.rows();
+    const int T = arena_y.cols();
+    const Eigen::MatrixXd y_val = value_of(arena_y);
+    const Eigen::MatrixXd F_val = value_of(arena_F);
+    const Eigen::MatrixXd G_val = value_of(arena_G);
+    const Eigen::VectorXd V_val = value_of(arena_V);
+    const Eigen::MatrixXd W_val = value_of(arena_W);
+
+    Eigen::MatrixXd y_adj = Eigen::MatrixXd::Zero(r, T);
+    Eigen::MatrixXd F_adj = Eigen::MatrixXd::Zero(n, r);
+    Eigen::MatrixXd G_adj = Eigen::MatrixXd::Zero(n, n);
+    Eigen::VectorXd V_adj = Eigen::VectorXd::Zero(r);
+    Eigen::MatrixXd W_adj = Eigen::MatrixXd::Zero(n, n);
+    // adjoints of the filtered state
+    Eigen::VectorXd m_adj = Eigen::VectorXd::Zero(n);
+    Eigen::MatrixXd C_adj = Eigen::MatrixXd::Zero(n, n);
+
+    // state before each sequential update of a time point
+    Eigen::MatrixXd m_pre(n, r);
+    Eigen::MatrixXd C_pre(n, n * r);
+    Eigen::VectorXd m(n);
+    Eigen::MatrixXd C(n, n);
+    for (int i = T - 1; i >= 0; --i) {
+      m = ms.col(i);
+      C = Cs.middleCols(i * n, n);
+      internal::gaussian_dlm_obs_predict(G_val, W_val, m, C);
+      for (int j = 0; j < r; ++j) {
+        m_pre.col(j) = m;
+        C_pre.middleCols(j * n, n) = C;
+        internal::gaussian_dlm_obs_update(F_val.col(j), y_val.coeff(j, i),
+                                          V_val.coeff(j), m, C);
+      }
+
+      for (int j = r - 1; j >= 0; --j) {
+        const auto& Fj = F_val.col(j);
+        const auto& mj = m_pre.col(j);
+        const auto& Cj = C_pre.middleCols(j * n, n);
+        const Eigen::VectorXd c = Cj * Fj;
+        const double Q = Fj.dot(c) + V_val.coeff(j);
+        const double e = y_val.coeff(j, i) - Fj.dot(mj);
+        const Eigen::VectorXd k = c / Q;
+
+        // C <- sym(C - c c' / Q)
+        const Eigen::MatrixXd D = 0.5 * (C_adj + C_adj.transpose());
+        const Eigen::VectorXd Dc = D * c;
+        double Q_adj = c.dot(Dc) / (Q * Q)
+                       - 0.5 * lp_adj * (1.0 / Q - e * e / (Q * Q));
+        Eigen::VectorXd c_adj = -2.0 / Q * Dc;
+        // m <- m + k e, k = c / Q
+        const double e_adj = k.dot(m_adj) - lp_adj * e / Q;
+        c_adj += m_adj * (e / Q);
+        Q_adj -= e * k.dot(m_adj) / Q;
+        // e = y - F' m, Q = F' C F + V, c = C F
+        y_adj.coeffRef(j, i) += e_adj;
+        c_adj += Q_adj * Fj;
+        F_adj.col(j) += -e_adj * mj + Q_adj * c + Cj.transpose() * c_adj;
+        V_adj.coeffRef(j) += Q_adj;
+        m_adj -= e_adj * Fj;
+        C_adj = D + c_adj * Fj.transpose();
+      }
+
+      // m <- G m, C <- sym(G C G') + W
+      const auto& m_prev = ms.col(i);
+      const auto& C_prev = Cs.middleCols(i * n, n);
+      G_adj += m_adj * m_prev.transpose();
+      m_adj = G_val.transpose() * m_adj;
+      W_adj += C_adj;
+      const Eigen::MatrixXd P = 0.5 * (C_adj + C_adj.transpose());
+      const Eigen::MatrixXd PG = P * G_val;
+      G_adj += PG * (C_prev + C_prev.transpose());
+      C_adj = G_val.transpose() * PG;
+    }
+
+    using T_y_var = arena_t<promote_scalar_t<var, T_y>>;
+    using T_F_var = arena_t<promote_scalar_t<var, T_F>>;
+    using T_G_var = arena_t<promote_scalar_t<var, T_G>>;
+    using T_V_var = arena_t<promote_scalar_t<var, T_V>>;
+    using T_W_var = arena_t<promote_scalar_t<var, T_W>>;
+    using T_m0_var = arena_t<promote_scalar_t<var, T_m0>>;
+    using T_C0_var = arena_t<promote_scalar_t<var, T_C0>>;
+    if (!is_constant<T_y>::value) {
+      forward_as<T_y_var>(arena_y).adj() += y_adj;
+    }
+    if (!is_constant<T_F>::value) {
+      forward_as<T_F_var>(arena_F).adj() += F_adj;
+    }
+    if (!is_constant<T_G>::value) {
+      forward_as<T_G_var>(arena_G).adj() += G_adj;
+    }
+    if (!is_constant<T_V>::value) {
+      forward_as<T_V_var>(arena_V).adj() += V_adj;
+    }
+    if (!is_constant<T_W>::value) {
+      forward_as<T_W_var>(arena_W).adj() += W_adj;
+    }
+    if (!is_constant<T_m0>::value) {
+      forward_as<T_m0_var>(arena_m0).adj() += m_adj;
+    }
+    if (!is_constant<T_C0>::value) {
+      forward_as<T_C0_var>(arena_C0).adj() += C_adj;
+    }
+  });
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
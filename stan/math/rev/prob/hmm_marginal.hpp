@@ -0,0 +1,375 @@
+#ifndef STAN_MATH_REV_PROB_HMM_MARGINAL_HPP
+#define STAN_MATH_REV_PROB_HMM_MARGINAL_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/fun/value_of.hpp>
+#include <stan/math/prim/err.hpp>
+#include <stan/math/prim/err/hmm_check.hpp>
+#include <stan/math/prim/fun/Eigen.hpp>
+#include <stan/math/prim/fun/to_ref.hpp>
+#include <stan/math/prim/fun/value_of.hpp>
+#include <stan/math/prim/prob/hmm_marginal.hpp>
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace stan {
+namespace math {
+
+namespace internal {
+
+/**
+ * Work space of <code>hmm_marginal_adjoint()</code>. It is resized for
+ * the longest sequence and reused for the following ones.
+ */
+struct hmm_marginal_workspace {
+  Eigen::MatrixXd omegas_;
+  Eigen::MatrixXd alphas_;
+  Eigen::VectorXd alpha_log_norms_;
+  Eigen::MatrixXd kappas_;
+  Eigen::VectorXd kappa_log_norms_;
+  Eigen::VectorXd grad_corr_;
+};
+
+/**
+ * Return the log marginal density of one sequence of a hidden Markov
+ * model computed in double precision with the forward algorithm, and
+ * compute its gradient with the adjoint method of the prim
+ * <code>hmm_marginal()</code>.
+ *
+ * The gradient with respect to the log densities is written to
+ * <code>log_omegas_grad</code>; the gradients with respect to the
+ * transition matrix and the initial state are added to
+ * <code>Gamma_grad</code> and <code>rho_grad</code>. A gradient is
+ * skipped if its output has size zero.
+ *
+ * @tparam EigMat type of the log likelihood matrix, an expression of
+ * doubles
+ * @param[in] log_omegas log matrix of observational densities
+ * @param[in] Gamma transition matrix
+ * @param[in] rho initial state
+ * @param[in, out] ws work space
+ * @param[out] log_omegas_grad gradient with respect to log_omegas
+ * @param[in, out] Gamma_grad gradient with respect to Gamma
+ * @param[in, out] rho_grad gradient with respect to rho
+ * @return log marginal density
+ */
+template <typename EigMat>
+inline double hmm_marginal_adjoint(
+    const EigMat& log_omegas, const Eigen::MatrixXd& Gamma,
+    const Eigen::VectorXd& rho, hmm_marginal_workspace& ws,
+    Eigen::Ref<Eigen::MatrixXd> log_omegas_grad,
+    Eigen::MatrixXd& Gamma_grad, Eigen::VectorXd& rho_grad) {
+  const int n_states = log_omegas.rows();
+  const int n_transitions = log_omegas.cols() - 1;
+
+  ws.omegas_ = log_omegas.array().exp();
+  ws.alphas_.resize(n_states, n_transitions + 1);
+  ws.alpha_log_norms_.resize(n_transitions + 1);
+  double norm_norm;
+  const double log_marginal_density
+      = hmm_marginal_val(ws.omegas_, Gamma, rho, ws.alphas_,
+                         ws.alpha_log_norms_, norm_norm);
+  const auto& omegas = ws.omegas_;
+  const auto& alphas = ws.alphas_;
+  const double unnormed_marginal = alphas.col(n_transitions).sum();
+
+  if (n_transitions == 0) {
+    const double marginal = std::exp(log_marginal_density);
+    if (log_omegas_grad.size() > 0) {
+      log_omegas_grad = omegas.cwiseProduct(rho) / marginal;
+    }
+    if (rho_grad.size() > 0) {
+      rho_grad += omegas.col(0) / marginal;
+    }
+    return log_marginal_density;
+  }
+
+  auto& kappas = ws.kappas_;
+  auto& kappa_log_norms = ws.kappa_log_norms_;
+  auto& grad_corr = ws.grad_corr_;
+  kappas.resize(n_states, n_transitions);
+  kappa_log_norms.resize(n_transitions);
+  grad_corr.resize(n_transitions);
+  kappas.col(n_transitions - 1).setOnes();
+  kappa_log_norms(n_transitions - 1) = 0;
+  grad_corr(n_transitions - 1)
+      = std::exp(ws.alpha_log_norms_(n_transitions - 1) - norm_norm);
+  for (int n = n_transitions - 1; n-- > 0;) {
+    kappas.col(n) = Gamma * omegas.col(n + 2).cwiseProduct(kappas.col(n + 1));
+    const double norm = kappas.col(n).maxCoeff();
+    kappas.col(n) /= norm;
+    kappa_log_norms(n) = std::log(norm) + kappa_log_norms(n + 1);
+    grad_corr(n) = std::exp(ws.alpha_log_norms_(n) + kappa_log_norms(n)
+                            - norm_norm);
+  }
+
+  if (Gamma_grad.size() > 0) {
+    for (int n = n_transitions - 1; n >= 0; --n) {
+      Gamma_grad.noalias()
+          += (grad_corr(n) / unnormed_marginal) * alphas.col(n)
+             * kappas.col(n).cwiseProduct(omegas.col(n + 1)).transpose();
+    }
+  }
+
+  const double grad_corr_boundary = std::exp(kappa_log_norms(0) - norm_norm);
+  if (log_omegas_grad.size() > 0 || rho_grad.size() > 0) {
+    const Eigen::VectorXd C
+        = Gamma * omegas.col(1).cwiseProduct(kappas.col(0));
+    if (log_omegas_grad.size() > 0) {
+      for (int n = n_transitions - 1; n >= 0; --n) {
+        log_omegas_grad.col(n + 1)
+            = grad_corr(n)
+              * kappas.col(n).cwiseProduct(Gamma.transpose() * alphas.col(n));
+      }
+      log_omegas_grad.col(0) = grad_corr_boundary * C.cwiseProduct(rho);
+      log_omegas_grad.array() *= omegas.array() / unnormed_marginal;
+    }
+    if (rho_grad.size() > 0) {
+      rho_grad += grad_corr_boundary * C.cwiseProduct(omegas.col(0))
+                  / unnormed_marginal;
+    }
+  }
+  return log_marginal_density;
+}
+
+/**
+ * Reducer of the batched <code>hmm_marginal()</code>: sums the log
+ * marginal densities and the gradients of a range of sequences.
+ */
+template <typename T_omega>
+struct hmm_marginal_reducer {
+  const std::vector<const T_omega*>& log_omegas_;
+  const std::vector<size_t>& offsets_;
+  const Eigen::MatrixXd& Gamma_;
+  const Eigen::VectorXd& rho_;
+  Eigen::Map<Eigen::MatrixXd> log_omegas_grad_;
+  bool compute_Gamma_grad_;
+  bool compute_rho_grad_;
+
+  double log_marginal_density_{0};
+  Eigen::MatrixXd Gamma_grad_;
+  Eigen::VectorXd rho_grad_;
+  hmm_marginal_workspace ws_;
+
+  hmm_marginal_reducer(const std::vector<const T_omega*>& log_omegas,
+                       const std::vector<size_t>& offsets,
+                       const Eigen::MatrixXd& Gamma,
+                       const Eigen::VectorXd& rho,
+                       const Eigen::Map<Eigen::MatrixXd>& log_omegas_grad,
+                       bool compute_Gamma_grad, bool compute_rho_grad)
+      : log_omegas_(log_omegas),
+        offsets_(offsets),
+        Gamma_(Gamma),
+        rho_(rho),
+        log_omegas_grad_(log_omegas_grad),
+        compute_Gamma_grad_(compute_Gamma_grad),
+        compute_rho_grad_(compute_rho_grad),
+        Gamma_grad_(Eigen::MatrixXd::Zero(
+            compute_Gamma_grad ? Gamma.rows() : 0, Gamma.cols())),
+        rho_grad_(Eigen::VectorXd::Zero(compute_rho_grad ? rho.size() : 0)) {}
+
+  hmm_marginal_reducer(hmm_marginal_reducer& other, tbb::split)
+      : hmm_marginal_reducer(other.log_omegas_, other.offsets_, other.Gamma_,
+                             other.rho_, other.log_omegas_grad_,
+                             other.compute_Gamma_grad_,
+                             other.compute_rho_grad_) {}
+
+  inline void operator()(const tbb::blocked_range<size_t>& r) {
+    Eigen::MatrixXd no_grad(0, 0);
+    for (size_t i = r.begin(); i < r.end(); ++i) {
+      const Eigen::Index cols = log_omegas_[i]->cols();
+      if (cols == 0) {
+        continue;
+      }
+      const auto& log_omegas_val = value_of(*log_omegas_[i]);
+      if (log_omegas_grad_.size() > 0) {
+        log_marginal_density_ += hmm_marginal_adjoint(
+            log_omegas_val, Gamma_, rho_, ws_,
+            log_omegas_grad_.middleCols(offsets_[i], cols), Gamma_grad_,
+            rho_grad_);
+      } else {
+        log_marginal_density_ += hmm_marginal_adjoint(
+            log_omegas_val, Gamma_, rho_, ws_, no_grad, Gamma_grad_,
+            rho_grad_);
+      }
+    }
+  }
+
+  inline void join(const hmm_marginal_reducer& rhs) {
+    log_marginal_density_ += rhs.log_marginal_density_;
+    if (compute_Gamma_grad_) {
+      Gamma_grad_ += rhs.Gamma_grad_;
+    }
+    if (compute_rho_grad_) {
+      rho_grad_ += rhs.rho_grad_;
+    }
+  }
+};
+
+/**
+ * Return the sum of the log marginal densities of the sequences pointed
+ * to, see the batched <code>hmm_marginal()</code>.
+ *
+ * @tparam T_omega type of the log likelihood matrices, not an expression
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial guess vector
+ * @param[in] log_omegas pointers to the log matrices of observational
+ *            densities, one per sequence.
+ * @param[in] Gamma transition density between hidden states.
+ * @param[in] rho initial state
+ * @return sum of the log marginal densities.
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho>
+inline var hmm_marginal_batch(const std::vector<const T_omega*>& log_omegas,
+                              const T_Gamma& Gamma, const T_rho& rho) {
+  static const char* function = "hmm_marginal";
+  const size_t n_sequences = log_omegas.size();
+  arena_t<T_Gamma> arena_Gamma = Gamma;
+  arena_t<T_rho> arena_rho = rho;
+  const Eigen::MatrixXd Gamma_val = value_of(arena_Gamma);
+  const Eigen::VectorXd rho_val = value_of(arena_rho);
+  if (n_sequences == 0) {
+    return 0;
+  }
+
+  std::vector<size_t> offsets(n_sequences);
+  size_t total_cols = 0;
+  for (size_t i = 0; i < n_sequences; ++i) {
+    hmm_check(*log_omegas[i], Gamma_val, rho_val, function);
+    offsets[i] = total_cols;
+    total_cols += log_omegas[i]->cols();
+  }
+  // sequences without observations have marginal density one
+  if (total_cols == 0) {
+    return 0;
+  }
+
+  const int n_states = rho_val.size();
+  arena_matrix<Eigen::MatrixXd> log_omegas_grad(
+      n_states, is_constant<T_omega>::value ? 0 : total_cols);
+  internal::hmm_marginal_reducer<T_omega> reducer(
+      log_omegas, offsets, Gamma_val, rho_val, log_omegas_grad,
+      !is_constant<T_Gamma>::value, !is_constant<T_rho>::value);
+#ifdef STAN_THREADS
+  // chunks of roughly 1024 time points, independent of the number of
+  // threads such that the result is reproducible
+  const size_t grainsize
+      = std::max(static_cast<size_t>(1), 1024 * n_sequences / total_cols);
+  tbb::parallel_deterministic_reduce(
+      tbb::blocked_range<size_t>(0, n_sequences, grainsize), reducer);
+#else
+  reducer(tbb::blocked_range<size_t>(0, n_sequences));
+#endif
+
+  arena_t<Eigen::MatrixXd> Gamma_grad = reducer.Gamma_grad_;
+  arena_t<Eigen::VectorXd> rho_grad = reducer.rho_grad_;
+  // the log densities of all sequences side by side
+  arena_t<Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic>> arena_log_omegas(
+      n_states, is_constant<T_omega>::value ? 0 : total_cols);
+  if (!is_constant<T_omega>::value) {
+    for (size_t i = 0; i < n_sequences; ++i) {
+      arena_log_omegas.middleCols(offsets[i], log_omegas[i]->cols())
+          = *log_omegas[i];
+    }
+  }
+  return make_callback_var(
+      reducer.log_marginal_density_,
+      [arena_log_omegas, log_omegas_grad, arena_Gamma, Gamma_grad, arena_rho,
+       rho_grad](auto& vi) mutable {
+        using T_Gamma_var = arena_t<promote_scalar_t<var, T_Gamma>>;
+        using T_rho_var = arena_t<promote_scalar_t<var, T_rho>>;
+        const double adj = vi.adj();
+        if (!is_constant<T_omega>::value) {
+          arena_log_omegas.adj() += adj * log_omegas_grad;
+        }
+        if (!is_constant<T_Gamma>::value) {
+          forward_as<T_Gamma_var>(arena_Gamma).adj() += adj * Gamma_grad;
+        }
+        if (!is_constant<T_rho>::value) {
+          forward_as<T_rho_var>(arena_rho).adj() += adj * rho_grad;
+        }
+      });
+}
+
+}  // namespace internal
+
+/**
+ * Return the log marginal density of a hidden Markov model for
+ * reverse mode autodiff. The density and its gradient are computed in
+ * double precision with the adjoint method of the prim
+ * <code>hmm_marginal()</code> and a single callback propagates the
+ * gradient in the reverse pass.
+ *
+ * @tparam T_omega type of the log likelihood matrix
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial guess vector
+ * @param[in] log_omegas log matrix of observational densities.
+ * @param[in] Gamma transition density between hidden states.
+ * @param[in] rho initial state
+ * @return log marginal density.
+ * @throw `std::invalid_argument` if Gamma is not square, when we have
+ *         at least one transition, or if the size of rho is not the
+ *         number of rows of log_omegas.
+ * @throw `std::domain_error` if rho is not a simplex and of the rows
+ *         of Gamma are not a simplex (when there is at least one transition).
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho,
+          require_all_eigen_t<T_omega, T_Gamma>* = nullptr,
+          require_eigen_col_vector_t<T_rho>* = nullptr,
+          require_any_vt_var<T_omega, T_Gamma, T_rho>* = nullptr>
+inline var hmm_marginal(const T_omega& log_omegas, const T_Gamma& Gamma,
+                        const T_rho& rho) {
+  const auto& log_omegas_ref = to_ref(log_omegas);
+  using T_omega_ref = std::decay_t<decltype(log_omegas_ref)>;
+  return internal::hmm_marginal_batch(
+      std::vector<const T_omega_ref*>{&log_omegas_ref}, Gamma, rho);
+}
+
+/**
+ * Return the sum of the log marginal densities of independent sequences
+ * of a hidden Markov model that share the transition matrix and the
+ * initial state, for reverse mode autodiff.
+ *
+ * The sequences are processed in parallel on the TBB thread pool if
+ * Stan Math is compiled with <code>STAN_THREADS</code>. The density and
+ * the gradient of each sequence are computed in double precision with
+ * a work space that is reused across sequences; the gradients with
+ * respect to Gamma and rho are summed over the sequences before they
+ * are stored. All gradients with respect to the log densities are
+ * stored in one arena allocation and a single callback propagates the
+ * gradients in the reverse pass.
+ *
+ * @tparam T_omega type of the log likelihood matrices
+ * @tparam T_Gamma type of the transition matrix
+ * @tparam T_rho type of the initial guess vector
+ * @param[in] log_omegas log matrices of observational densities, one
+ *            per sequence.
+ * @param[in] Gamma transition density between hidden states.
+ * @param[in] rho initial state
+ * @return sum of the log marginal densities.
+ * @throw `std::invalid_argument` if Gamma is not square, when we have
+ *         at least one transition, or if the size of rho is not the
+ *         number of rows of each log_omegas.
+ * @throw `std::domain_error` if rho is not a simplex and of the rows
+ *         of Gamma are not a simplex (when there is at least one transition).
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho,
+          require_all_eigen_t<T_omega, T_Gamma>* = nullptr,
+          require_eigen_col_vector_t<T_rho>* = nullptr,
+          require_any_vt_var<T_omega, T_Gamma, T_rho>* = nullptr>
+inline var hmm_marginal(const std::vector<T_omega>& log_omegas,
+                        const T_Gamma& Gamma, const T_rho& rho) {
+  std::vector<const T_omega*> log_omegas_ptrs(log_omegas.size());
+  for (size_t i = 0; i < log_omegas.size(); ++i) {
+    log_omegas_ptrs[i] = &log_omegas[i];
+  }
+  return internal::hmm_marginal_batch(log_omegas_ptrs, Gamma, rho);
+}
+
+}  // namespace math
+}  // namespace stan
+#endif
@@ -119,3 +119,178 @@ TEST(stack_alloc, in_stack_second_block) {
   EXPECT_FALSE(allocator.in_stack(x));
   EXPECT_FALSE(allocator.in_stack(y));
 }
+
+TEST(stack_alloc, parse_block_source) {
+  using stan::math::block_source_t;
+  using stan::math::internal::parse_block_source;
+  EXPECT_EQ(block_source_t::malloc, parse_block_source("malloc"));
+  EXPECT_EQ(block_source_t::transparent_huge_pages, parse_block_source("thp"));
+  EXPECT_EQ(block_source_t::hugetlb, parse_block_source("hugetlb"));
+  EXPECT_EQ(block_source_t::numa_first_touch, parse_block_source("numa"));
+  EXPECT_THROW(parse_block_source("jumbo"), std::invalid_argument);
+}
+
+TEST(stack_alloc, block_sources) {
+  using stan::math::block_source_t;
+  for (auto source :
+       {block_source_t::malloc, block_source_t::transparent_huge_pages,
+        block_source_t::hugetlb, block_source_t::numa_first_touch}) {
+    stan::math::stack_alloc allocator(
+        stan::math::internal::DEFAULT_INITIAL_NBYTES, source);
+    EXPECT_EQ(source, allocator.block_source());
+    EXPECT_LE(stan::math::internal::DEFAULT_INITIAL_NBYTES,
+              allocator.bytes_allocated());
+    std::vector<double*> xs;
+    for (int n = 0; n < 20; ++n) {
+      double* x = allocator.alloc_array<double>(1 << n);
+      EXPECT_TRUE(stan::math::is_aligned(x, 8U));
+      x[0] = n;
+      x[(1 << n) - 1] = n;
+      xs.push_back(x);
+    }
+    for (int n = 0; n < 20; ++n) {
+      EXPECT_TRUE(allocator.in_stack(xs[n]));
+      EXPECT_FLOAT_EQ(n, xs[n][0]);
+      EXPECT_FLOAT_EQ(n, xs[n][(1 << n) - 1]);
+    }
+    allocator.free_all();
+    double* y = allocator.alloc_array<double>(10U);
+    y[9] = 1.0;
+    EXPECT_TRUE(allocator.in_stack(y));
+  }
+}
+
+TEST(stack_alloc, policy_growth) {
+  using stan::math::internal::DEFAULT_INITIAL_NBYTES;
+  stan::math::stack_alloc allocator(DEFAULT_INITIAL_NBYTES,
+                                    stan::math::block_source_t::malloc);
+  stan::math::stack_alloc_policy policy;
+  policy.growth_factor = 1.5;
+  policy.max_block_nbytes = 2 * DEFAULT_INITIAL_NBYTES;
+  allocator.set_policy(policy);
+  EXPECT_FLOAT_EQ(1.5, allocator.policy().growth_factor);
+
+  allocator.alloc(DEFAULT_INITIAL_NBYTES);
+  allocator.alloc(1);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 5 / 2, allocator.bytes_reserved());
+  allocator.alloc(DEFAULT_INITIAL_NBYTES * 3 / 2);
+  allocator.alloc(1);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 9 / 2, allocator.bytes_reserved());
+  allocator.alloc(DEFAULT_INITIAL_NBYTES * 2 - 8);
+  allocator.alloc(1);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 13 / 2, allocator.bytes_reserved());
+  // a single request larger than the maximum block size still fits
+  allocator.alloc(DEFAULT_INITIAL_NBYTES * 3);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 19 / 2, allocator.bytes_reserved());
+
+  policy.growth_factor = 0.5;
+  EXPECT_THROW(allocator.set_policy(policy), std::invalid_argument);
+  policy.growth_factor = 2;
+  policy.keep_blocks = 0;
+  EXPECT_THROW(allocator.set_policy(policy), std::invalid_argument);
+}
+
+TEST(stack_alloc, policy_trim_after) {
+  using stan::math::internal::DEFAULT_INITIAL_NBYTES;
+  stan::math::stack_alloc allocator(DEFAULT_INITIAL_NBYTES,
+                                    stan::math::block_source_t::malloc);
+  stan::math::stack_alloc_policy policy;
+  policy.trim_after = 3;
+  allocator.set_policy(policy);
+
+  // outlier tape reaching four blocks
+  for (int i = 0; i < 4; ++i) {
+    allocator.alloc((DEFAULT_INITIAL_NBYTES << i) - 8);
+  }
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 15, allocator.bytes_reserved());
+  allocator.recover_all();
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 15, allocator.bytes_reserved());
+  // two smaller tapes complete the window, the outlier is in it
+  for (int n = 0; n < 2; ++n) {
+    allocator.alloc(DEFAULT_INITIAL_NBYTES / 2);
+    allocator.alloc(DEFAULT_INITIAL_NBYTES);
+    allocator.recover_all();
+  }
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 15, allocator.bytes_reserved());
+  // three smaller tapes reaching only the second block trim the rest
+  for (int n = 0; n < 3; ++n) {
+    allocator.alloc(DEFAULT_INITIAL_NBYTES / 2);
+    allocator.alloc(DEFAULT_INITIAL_NBYTES);
+    EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 15, allocator.bytes_reserved());
+    allocator.recover_all();
+  }
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 3, allocator.bytes_reserved());
+  EXPECT_EQ(4, allocator.stats().blocks_allocated);
+  EXPECT_EQ(2, allocator.stats().blocks_freed);
+
+  double* x = allocator.alloc_array<double>(10);
+  x[9] = 1;
+  EXPECT_TRUE(allocator.in_stack(x));
+}
+
+TEST(stack_alloc, policy_keep_blocks) {
+  using stan::math::internal::DEFAULT_INITIAL_NBYTES;
+  stan::math::stack_alloc allocator(DEFAULT_INITIAL_NBYTES,
+                                    stan::math::block_source_t::malloc);
+  stan::math::stack_alloc_policy policy;
+  policy.keep_blocks = 2;
+  allocator.set_policy(policy);
+  for (int i = 0; i < 4; ++i) {
+    allocator.alloc((DEFAULT_INITIAL_NBYTES << i) - 8);
+  }
+  allocator.free_all();
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 12, allocator.bytes_reserved());
+  EXPECT_EQ(0, allocator.bytes_used());
+
+  // both kept blocks are reused before growing
+  char* x = allocator.alloc_array<char>(DEFAULT_INITIAL_NBYTES * 3);
+  char* y = allocator.alloc_array<char>(DEFAULT_INITIAL_NBYTES * 6);
+  EXPECT_TRUE(allocator.in_stack(x));
+  EXPECT_TRUE(allocator.in_stack(y));
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 12, allocator.bytes_reserved());
+  allocator.alloc(DEFAULT_INITIAL_NBYTES * 2);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 28, allocator.bytes_reserved());
+}
+
+TEST(stack_alloc, stats) {
+  using stan::math::internal::DEFAULT_INITIAL_NBYTES;
+  stan::math::stack_alloc allocator(DEFAULT_INITIAL_NBYTES,
+                                    stan::math::block_source_t::malloc);
+  stan::math::stack_alloc_stats stats = allocator.stats();
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES, stats.bytes_reserved);
+  EXPECT_EQ(0, stats.bytes_used);
+  EXPECT_EQ(0, stats.peak_bytes_used);
+  EXPECT_EQ(1, stats.blocks_allocated);
+  EXPECT_EQ(0, stats.blocks_freed);
+
+  allocator.alloc(1000);
+  allocator.alloc(DEFAULT_INITIAL_NBYTES);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 2, allocator.bytes_used());
+  allocator.recover_all();
+  allocator.alloc(10);
+  stats = allocator.stats();
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 3, stats.bytes_reserved);
+  EXPECT_EQ(10, stats.bytes_used);
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES * 2, stats.peak_bytes_used);
+  EXPECT_EQ(2, stats.blocks_allocated);
+
+  allocator.free_all();
+  stats = allocator.stats();
+  EXPECT_EQ(DEFAULT_INITIAL_NBYTES, stats.bytes_reserved);
+  EXPECT_EQ(1, stats.blocks_freed);
+}
+
+TEST(stack_alloc, alloc_aligned) {
+  stan::math::stack_alloc allocator;
+  EXPECT_TRUE(stan::math::is_aligned(allocator.alloc(1), 64U));
+  for (size_t n = 1; n <= 10000; ++n) {
+    allocator.alloc(n % 7);
+    void* x = allocator.alloc_aligned<64>(n);
+    EXPECT_TRUE(stan::math::is_aligned(x, 64U));
+    EXPECT_TRUE(allocator.in_stack(x));
+    double* y = allocator.alloc_array<double, 32>(n);
+    EXPECT_TRUE(stan::math::is_aligned(y, 32U));
+    y[n - 1] = n;
+    EXPECT_FLOAT_EQ(n, y[n - 1]);
+  }
+}
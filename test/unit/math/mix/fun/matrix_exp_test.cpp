@@ -6,16 +6,19 @@ TEST(MathMixMatFun, matrixExp) {
 
   Eigen::MatrixXd m00(0, 0);
   stan::test::expect_ad(f, m00);
+  stan::test::expect_ad_matvar(f, m00);
 
   Eigen::MatrixXd a1(1, 1);
   a1 << 1;
   stan::test::expect_ad(f, a1);
+  stan::test::expect_ad_matvar(f, a1);
 
   double a = -1;
   double b = -17;
   Eigen::MatrixXd d(2, 2);
   d << -2 * a + 3 * b, 1.5 * a - 1.5 * b, -4 * a + 4 * b, 3 * a - 2 * b;
   stan::test::expect_ad(f, d);
+  stan::test::expect_ad_matvar(f, d);
 
   stan::test::ad_tolerances tols;
   tols.hessian_hessian_ = relative_tolerance(5e-4, 1e-3);
@@ -29,6 +32,7 @@ TEST(MathMixMatFun, matrixExp) {
       5 * a - 8 * b + 3 * c, 20 * b - 20 * c, -15 * b + 16 * c, -4 * b + 4 * c,
       -120 * a + 120 * b, 90 * a - 90 * b, 25 * a - 24 * b;
   stan::test::expect_ad(tols, f, e);
+  stan::test::expect_ad_matvar(f, e);
 
   stan::test::ad_tolerances tols2;
   tols2.hessian_hessian_ = 1e-2;
@@ -38,6 +42,7 @@ TEST(MathMixMatFun, matrixExp) {
   // replace original random tests
   for (const auto& x : stan::test::ar_test_cov_matrices(1, 3, 0.0)) {
     stan::test::expect_ad(tols2, f, x);
+    stan::test::expect_ad_matvar(f, x);
   }
   for (const auto& x : stan::test::ar_test_cov_matrices(1, 3, 0.9)) {
     stan::test::expect_ad(tols2, f, x);
@@ -47,4 +52,16 @@ TEST(MathMixMatFun, matrixExp) {
   Eigen::MatrixXd mm(2, 2);
   mm << -0.999984, 0.511211, -0.736924, -0.0826997;
   stan::test::expect_ad(tols2, f, mm);
+  stan::test::expect_ad_matvar(f, mm);
+
+  // non-normal matrix, where the adjoint needs the transposed argument
+  Eigen::MatrixXd nn(3, 3);
+  nn << 0.5, 2.0, -1.0, 0.0, -0.3, 1.5, 0.2, 0.0, 0.1;
+  stan::test::expect_ad(f, nn);
+  stan::test::expect_ad_matvar(f, nn);
+
+  Eigen::MatrixXd ns(2, 3);
+  ns << 1, 2, 3, 4, 5, 6;
+  stan::test::expect_ad(f, ns);
+  stan::test::expect_ad_matvar(f, ns);
 }
@@ -0,0 +1,173 @@
+#include <stan/math/mix.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/prim/functor/harmonic_oscillator.hpp>
+#include <vector>
+
+namespace {
+// right hand side taking a std::vector, an Eigen vector, a scalar and data
+struct mixed_args_ode {
+  template <typename T0, typename T1, typename T2, typename T3, typename T4>
+  Eigen::Matrix<stan::return_type_t<T1, T2, T3, T4>, Eigen::Dynamic, 1>
+  operator()(const T0& t, const Eigen::Matrix<T1, Eigen::Dynamic, 1>& y,
+             std::ostream* msgs, const std::vector<T2>& k,
+             const Eigen::Matrix<T3, Eigen::Dynamic, 1>& c, const T4& s,
+             const std::vector<int>& shift) const {
+    const int N = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2, T3, T4>, Eigen::Dynamic, 1> dy(
+        N);
+    for (int i = 0; i < N; ++i) {
+      dy(i) = -k[i] * y(i) + c(i) * s * stan::math::sin(t);
+      if (i > 0) {
+        dy(i) += k[i - 1] * y(i - 1) * y((i + shift[0]) % N);
+      }
+    }
+    return dy;
+  }
+};
+
+template <typename F, typename T_y0, typename... Args>
+std::vector<double> coupled_rhs(const F& f, const T_y0& y0,
+                                const std::vector<double>& z, double t,
+                                const Args&... args) {
+  stan::math::coupled_ode_system<F, stan::scalar_type_t<T_y0>, Args...> system(
+      f, y0, nullptr, args...);
+  std::vector<double> dz_dt;
+  system(z, dz_dt, t);
+  return dz_dt;
+}
+}  // namespace
+
+TEST(OdeForwardSensitivity, coupled_rhs_matches_reverse_mode) {
+  using stan::math::var;
+  const int N = 4;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> y0(N);
+  y0 << 1.0, 0.5, -0.2, 0.3;
+  std::vector<var> k{0.3, 0.9, 1.4, 0.6};
+  Eigen::Matrix<var, Eigen::Dynamic, 1> c(N);
+  c << 0.1, -0.4, 0.7, 0.2;
+  var s = 1.3;
+  std::vector<int> shift{2};
+
+  mixed_args_ode f;
+  auto f_fwd = stan::math::ode_forward_sensitivity(f);
+  stan::math::coupled_ode_system<decltype(f_fwd), var, std::vector<var>,
+                                 Eigen::Matrix<var, Eigen::Dynamic, 1>, var,
+                                 std::vector<int>>
+      system(f_fwd, y0, nullptr, k, c, s, shift);
+  ASSERT_EQ(N + N * (N + N + N + 1), system.size());
+
+  std::vector<double> z = system.initial_state();
+  for (size_t i = 0; i < z.size(); ++i) {
+    z[i] += 0.01 * ((i * 7) % 11) - 0.05;
+  }
+
+  std::size_t stack_size = stan::math::ChainableStack::instance_->var_stack_
+                               .size();
+  std::vector<double> dz_fwd;
+  system(z, dz_fwd, 0.7);
+  EXPECT_EQ(stack_size,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+
+  std::vector<double> dz_rev = coupled_rhs(f, y0, z, 0.7, k, c, s, shift);
+  ASSERT_EQ(dz_rev.size(), dz_fwd.size());
+  for (size_t i = 0; i < dz_rev.size(); ++i) {
+    EXPECT_NEAR(dz_rev[i], dz_fwd[i], 1e-12) << "coupled state " << i;
+  }
+
+  // repeated calls leave the parameter tangents at zero
+  std::vector<double> dz_again;
+  system(z, dz_again, 0.7);
+  for (size_t i = 0; i < dz_fwd.size(); ++i) {
+    EXPECT_FLOAT_EQ(dz_fwd[i], dz_again[i]);
+  }
+
+  // data initial conditions
+  Eigen::VectorXd y0_d = stan::math::value_of(y0);
+  std::vector<double> z_d(z.begin(), z.begin() + N + N * (N + N + 1));
+  std::vector<double> dz_rev_d = coupled_rhs(f, y0_d, z_d, 0.2, k, c, s, shift);
+  std::vector<double> dz_fwd_d
+      = coupled_rhs(f_fwd, y0_d, z_d, 0.2, k, c, s, shift);
+  ASSERT_EQ(dz_rev_d.size(), dz_fwd_d.size());
+  for (size_t i = 0; i < dz_rev_d.size(); ++i) {
+    EXPECT_NEAR(dz_rev_d[i], dz_fwd_d[i], 1e-12) << "coupled state " << i;
+  }
+  stan::math::recover_memory();
+}
+
+TEST(OdeForwardSensitivity, coupled_rhs_without_directions) {
+  using stan::math::var;
+  const int N = 3;
+  Eigen::VectorXd y0(N);
+  y0 << 1.0, 0.5, -0.2;
+  std::vector<double> k{0.3, 0.9, 1.4};
+  Eigen::VectorXd c(N);
+  c << 0.1, -0.4, 0.7;
+  std::vector<var> s_empty;
+  std::vector<int> shift{1};
+
+  // the only autodiff argument is empty, so there are no sensitivities
+  auto f = [](const auto& t, const auto& y, std::ostream* msgs,
+              const auto& k, const auto& c, const auto& s_empty,
+              const auto& shift) {
+    return mixed_args_ode()(t, y, msgs, k, c, 2.0, shift);
+  };
+  auto f_fwd = stan::math::ode_forward_sensitivity(f);
+  std::vector<double> z{0.8, 0.4, 0.1};
+  std::vector<double> dz_fwd
+      = coupled_rhs(f_fwd, y0, z, 0.3, k, c, s_empty, shift);
+  ASSERT_EQ(N, dz_fwd.size());
+
+  Eigen::VectorXd y(N);
+  y << z[0], z[1], z[2];
+  Eigen::VectorXd dy_dt = mixed_args_ode()(0.3, y, nullptr, k, c, 2.0, shift);
+  for (int i = 0; i < N; ++i) {
+    EXPECT_FLOAT_EQ(dy_dt(i), dz_fwd[i]) << "state " << i;
+  }
+
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1>> ys = stan::math::ode_rk45(
+      f_fwd, y0, 0.0, std::vector<double>{0.5}, nullptr, k, c, s_empty, shift);
+  std::vector<Eigen::VectorXd> ys_d = stan::math::ode_rk45(
+      f, y0, 0.0, std::vector<double>{0.5}, nullptr, k, c, 2.0, shift);
+  for (int i = 0; i < N; ++i) {
+    EXPECT_NEAR(ys_d[0](i), ys[0](i).val(), 1e-8);
+  }
+  stan::math::recover_memory();
+}
+
+TEST(OdeForwardSensitivity, solvers_match_reverse_mode) {
+  using stan::math::var;
+  harm_osc_ode_fun_eigen harm_osc;
+  std::vector<double> ts{0.5, 1.0, 2.0};
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  auto gradients = [&](auto&& f, auto&& solver) {
+    Eigen::Matrix<var, Eigen::Dynamic, 1> y0(2);
+    y0 << 1.0, 0.5;
+    std::vector<var> theta{0.15};
+    auto ys = solver(f, y0, 0.0, ts, nullptr, theta, x, x_int);
+    var lp = 0;
+    for (const auto& y : ys) {
+      lp += y(0) + 2 * y(1);
+    }
+    lp.grad();
+    std::vector<double> g{lp.val(), y0(0).adj(), y0(1).adj(), theta[0].adj()};
+    stan::math::recover_memory();
+    return g;
+  };
+  auto rk45 = [](auto&&... args) { return stan::math::ode_rk45(args...); };
+  auto bdf = [](auto&&... args) { return stan::math::ode_bdf(args...); };
+  auto f_fwd = stan::math::ode_forward_sensitivity(harm_osc);
+
+  std::vector<double> g_rev = gradients(harm_osc, rk45);
+  std::vector<double> g_fwd = gradients(f_fwd, rk45);
+  for (size_t i = 0; i < g_rev.size(); ++i) {
+    EXPECT_NEAR(g_rev[i], g_fwd[i], 1e-8);
+  }
+
+  g_rev = gradients(harm_osc, bdf);
+  g_fwd = gradients(f_fwd, bdf);
+  for (size_t i = 0; i < g_rev.size(); ++i) {
+    EXPECT_NEAR(g_rev[i], g_fwd[i], 1e-6);
+  }
+}
@@ -0,0 +1,257 @@
+#include <stan/math/mix.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// method of lines discretization of an advection-diffusion-reaction
+// equation with diffusion theta[0], upwind advection 0.5 * theta[0] and
+// quadratic decay theta[1], whose Jacobian is tridiagonal and not
+// symmetric
+struct advection_diffusion_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int n = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(n);
+    for (int i = 0; i < n; ++i) {
+      const auto left = i > 0 ? y(i - 1) : y(i);
+      const auto right = i + 1 < n ? y(i + 1) : y(i);
+      dy(i) = theta[0] * (left - 2.0 * y(i) + right)
+              + 0.5 * theta[0] * (left - y(i)) - theta[1] * y(i) * y(i);
+    }
+    return dy;
+  }
+};
+
+// chemical kinetics DAE of the IDAS examples
+struct chemical_kinetics_dae {
+  template <typename T0, typename TYY, typename TYP, typename TPAR>
+  std::vector<stan::return_type_t<TYY, TYP, TPAR>> operator()(
+      const T0& t, const std::vector<TYY>& yy, const std::vector<TYP>& yp,
+      const std::vector<TPAR>& theta, const std::vector<double>& x_r,
+      const std::vector<int>& x_i, std::ostream* msgs) const {
+    std::vector<stan::return_type_t<TYY, TYP, TPAR>> res(3);
+    res[0] = yp[0] + theta[0] * yy[0] - theta[1] * yy[1] * yy[2];
+    res[1] = yp[1] - theta[0] * yy[0] + theta[1] * yy[1] * yy[2]
+             + theta[2] * yy[1] * yy[1];
+    res[2] = yy[0] + yy[1] + yy[2] - 1.0;
+    return res;
+  }
+};
+
+Eigen::SparseMatrix<double> banded_pattern(int n, int lower, int upper) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - lower); j < std::min(n, i + upper + 1);
+         ++j) {
+      triplets.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(n, n);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  return pattern;
+}
+
+// solve with the given functor and return the values of the states at the
+// last time followed by the gradient of their sum
+template <typename Solve>
+std::vector<double> solve_grad(const Solve& solve) {
+  using stan::math::var;
+  const int n = 20;
+  Eigen::Matrix<var, -1, 1> y0
+      = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5).cast<var>();
+  std::vector<var> theta{50.0, 2.0};
+  std::vector<Eigen::Matrix<var, -1, 1>> ys = solve(y0, theta);
+  const Eigen::VectorXd y_last = stan::math::value_of(ys.back());
+  std::vector<double> result(y_last.data(), y_last.data() + n);
+  stan::math::sum(ys.back()).grad();
+  for (int i = 0; i < n; ++i) {
+    result.push_back(y0(i).adj());
+  }
+  result.push_back(theta[0].adj());
+  result.push_back(theta[1].adj());
+  stan::math::recover_memory();
+  return result;
+}
+
+void expect_near_rel(const std::vector<double>& expected,
+                     const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i],
+                1e-5 * std::max(1.0, std::abs(expected[i])))
+        << "index " << i;
+  }
+}
+
+// product of a vector with the Jacobian of f stored in the matrix of a
+// linear solver, possibly transposed and scaled
+template <typename F>
+Eigen::VectorXd stored_jacobian_times(
+    const F& f, const stan::math::sundials_linear_solver& linear_solver,
+    bool transpose, double scale, const Eigen::VectorXd& x) {
+  const int n = x.size();
+  const Eigen::VectorXd y = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5);
+  SUNMatrix J = linear_solver.make_matrix(n);
+  SUNMatZero(J);
+  stan::math::internal::sundials_ode_jacobian<F>::store(
+      "test", f, 0.0, y, nullptr, std::make_tuple(std::vector<double>{50, 2}),
+      linear_solver, J, transpose, scale);
+  Eigen::VectorXd x_copy = x;
+  Eigen::VectorXd b(n);
+  N_Vector nv_x = N_VMake_Serial(n, x_copy.data());
+  N_Vector nv_b = N_VMake_Serial(n, b.data());
+  SUNMatMatvec(J, nv_x, nv_b);
+  N_VDestroy_Serial(nv_x);
+  N_VDestroy_Serial(nv_b);
+  SUNMatDestroy(J);
+  return b;
+}
+
+}  // namespace
+
+TEST(colored_jacobian, coloring) {
+  const advection_diffusion_rhs f;
+  EXPECT_EQ(3, stan::math::colored_jacobian(f, banded_pattern(20, 1, 1))
+                   .num_colors());
+  EXPECT_EQ(1, stan::math::colored_jacobian(f, banded_pattern(20, 0, 0))
+                   .num_colors());
+
+  // columns of a color have no row in common and every column has a color
+  Eigen::SparseMatrix<double> pattern = banded_pattern(30, 2, 1);
+  for (int i = 0; i + 7 < 30; i += 3) {
+    pattern.coeffRef(i, i + 7) = 1.0;
+  }
+  const auto f_colored = stan::math::colored_jacobian(f, pattern);
+  std::vector<int> num_colored(30, 0);
+  for (const auto& columns : f_colored.groups_) {
+    std::vector<int> rows_used(30, 0);
+    for (int j : columns) {
+      ++num_colored[j];
+      for (Eigen::SparseMatrix<double>::InnerIterator it(pattern, j); it;
+           ++it) {
+        EXPECT_EQ(0, rows_used[it.row()]++) << "column " << j;
+      }
+    }
+  }
+  for (int j = 0; j < 30; ++j) {
+    EXPECT_EQ(1, num_colored[j]) << "column " << j;
+  }
+}
+
+TEST(colored_jacobian, stored_jacobian) {
+  using stan::math::sundials_linear_solver;
+  const int n = 20;
+  const advection_diffusion_rhs f;
+  const auto f_colored
+      = stan::math::colored_jacobian(f, banded_pattern(n, 1, 1));
+  const Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(n, -1.0, 2.0);
+
+  for (const auto& linear_solver :
+       {sundials_linear_solver(), sundials_linear_solver::band(1, 1),
+        sundials_linear_solver::sparse(banded_pattern(n, 1, 1))}) {
+    for (bool transpose : {false, true}) {
+      const auto solver
+          = transpose ? linear_solver.transpose() : linear_solver;
+      const double scale = transpose ? -1.0 : 1.0;
+      const Eigen::VectorXd expected
+          = stored_jacobian_times(f, solver, transpose, scale, x);
+      const Eigen::VectorXd b
+          = stored_jacobian_times(f_colored, solver, transpose, scale, x);
+      for (int i = 0; i < n; ++i) {
+        EXPECT_NEAR(expected(i), b(i), 1e-10) << "row " << i;
+      }
+    }
+  }
+}
+
+TEST(colored_jacobian, ode_solvers) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(20, 1e-10);
+  const sundials_linear_solver sparse
+      = sundials_linear_solver::sparse(banded_pattern(20, 1, 1));
+  const advection_diffusion_rhs f;
+  const auto f_colored
+      = stan::math::colored_jacobian(f, banded_pattern(20, 1, 1));
+
+  auto bdf = [&](const auto& f) {
+    return [&](const auto& y0, const auto& theta) {
+      return stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 100000,
+                                     sparse, nullptr, theta);
+    };
+  };
+  auto adams = [&](const auto& f) {
+    return [&](const auto& y0, const auto& theta) {
+      return stan::math::ode_adams_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 100000,
+                                       sparse, nullptr, theta);
+    };
+  };
+  auto adjoint = [&](const auto& f) {
+    return [&](const auto& y0, const auto& theta) {
+      return stan::math::ode_adjoint_tol_ctl(
+          f, y0, 0.0, ts, 1e-10, atol, 1e-10, atol, 1e-10, 1e-10, 100000, 150,
+          CV_HERMITE, CV_BDF, CV_BDF, sparse, nullptr, theta);
+    };
+  };
+  expect_near_rel(solve_grad(bdf(f)), solve_grad(bdf(f_colored)));
+  expect_near_rel(solve_grad(adams(f)), solve_grad(adams(f_colored)));
+  expect_near_rel(solve_grad(adjoint(f)), solve_grad(adjoint(f_colored)));
+}
+
+TEST(colored_jacobian, integrate_dae) {
+  using stan::math::sundials_linear_solver;
+  using stan::math::var;
+  const std::vector<double> yy0{1.0, 0.0, 0.0};
+  const std::vector<double> yp0{-0.04, 0.04, 0.0};
+  const std::vector<double> ts{0.4, 4.0, 40.0};
+  const std::vector<double> x_r;
+  const std::vector<int> x_i;
+
+  auto solve_dae = [&](const auto& f) {
+    std::vector<var> theta{0.040, 1.0e4, 3.0e7};
+    auto yy = stan::math::integrate_dae(f, yy0, yp0, 0.0, ts, theta, x_r, x_i,
+                                        1e-8, 1e-10, 10000,
+                                        sundials_linear_solver());
+    std::vector<double> result;
+    for (size_t i = 0; i < 3; ++i) {
+      result.push_back(yy.back()[i].val());
+      stan::math::set_zero_all_adjoints();
+      yy.back()[i].grad();
+      for (const auto& p : theta) {
+        result.push_back(p.adj());
+      }
+    }
+    stan::math::recover_memory();
+    return result;
+  };
+
+  const chemical_kinetics_dae f;
+  const std::vector<double> expected = solve_dae(f);
+  const std::vector<double> result
+      = solve_dae(stan::math::colored_jacobian(f, banded_pattern(3, 2, 2)));
+  ASSERT_EQ(expected.size(), result.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], result[i],
+                1e-4 * std::max(1e-6, std::abs(expected[i])))
+        << "index " << i;
+  }
+}
+
+TEST(colored_jacobian, errors) {
+  const advection_diffusion_rhs f;
+  EXPECT_THROW(
+      stan::math::colored_jacobian(f, Eigen::SparseMatrix<double>(3, 4)),
+      std::invalid_argument);
+
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  Eigen::VectorXd y0 = Eigen::VectorXd::Ones(20);
+  const std::vector<double> theta{50.0, 2.0};
+  EXPECT_THROW(
+      stan::math::ode_bdf(
+          stan::math::colored_jacobian(f, banded_pattern(19, 1, 1)), y0, 0.0,
+          ts, nullptr, theta),
+      std::invalid_argument);
+}
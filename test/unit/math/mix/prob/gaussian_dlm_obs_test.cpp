@@ -204,3 +204,171 @@ TEST(ProbDistributionsGaussianDLM, LoglikeMM_fvar_fvar_var) {
   EXPECT_NEAR(ll_expected, lp_ref.val_.val_.val(), 1e-4);
   EXPECT_NEAR(18.89044287309947, lp_ref.d_.val_.val(), 1e-4);
 }
+
+namespace gaussian_dlm_obs_test {
+
+/**
+ * Check the reverse mode gradient of f(x) against directional derivatives
+ * computed in forward mode. If symmetric, x is a symmetric matrix and
+ * only symmetric perturbations are compared.
+ */
+template <typename F, typename EigMat>
+void expect_grad_fwd_rev(const std::string& name, const F& f, const EigMat& x,
+                         bool symmetric = false) {
+  using stan::math::fvar;
+  using stan::math::var;
+  using x_var_t = Eigen::Matrix<var, EigMat::RowsAtCompileTime,
+                                EigMat::ColsAtCompileTime>;
+  using x_fvar_t = Eigen::Matrix<fvar<double>, EigMat::RowsAtCompileTime,
+                                 EigMat::ColsAtCompileTime>;
+  x_var_t x_v = x.template cast<var>();
+  var lp = f(x_v);
+  EXPECT_FLOAT_EQ(f(x), lp.val());
+  lp.grad();
+  for (int j = 0; j < x.cols(); ++j) {
+    for (int i = 0; i < x.rows(); ++i) {
+      if (symmetric && i < j) {
+        continue;
+      }
+      x_fvar_t x_f = x.template cast<fvar<double>>();
+      x_f(i, j).d_ = 1;
+      double adj = x_v(i, j).adj();
+      if (symmetric && i != j) {
+        x_f(j, i).d_ = 1;
+        adj += x_v(j, i).adj();
+      }
+      const double d = f(x_f).d_;
+      EXPECT_NEAR(d, adj, 1e-8 * std::max(1.0, std::fabs(d)))
+          << name << "(" << i << ", " << j << ")";
+    }
+  }
+  stan::math::recover_memory();
+}
+
+struct dlm_data {
+  Eigen::MatrixXd F{2, 3};
+  Eigen::MatrixXd G{2, 2};
+  Eigen::VectorXd V_vec{3};
+  Eigen::MatrixXd V{3, 3};
+  Eigen::MatrixXd W{2, 2};
+  Eigen::VectorXd m0{2};
+  Eigen::MatrixXd C0{2, 2};
+  Eigen::MatrixXd y{3, 10};
+
+  dlm_data() {
+    F << 0.585528817843856, 0.709466017509524, -0.109303314681054,
+        -0.453497173462763, 0.605887455840394, -1.81795596770373;
+    G << 0.520216457554957, 0.816899839520583, -0.750531994502331,
+        -0.886357521243213;
+    V_vec << 7.19105866377728, 3.27048576782842, 5.86564522448303;
+    V << 7.19105866377728, -0.311731853764732, 4.87333111936296,
+        -0.311731853764732, 3.27048576782842, 0.457616661474554,
+        4.87333111936296, 0.457616661474554, 5.86564522448303;
+    W << 2.24277594357501, -1.65863136283477, -1.65863136283477,
+        6.69010664813895;
+    m0 << -0.892071328367409, 3.74785137677115;
+    C0 << 82.1224673418328, 0, 0, 56.0195157304406;
+    y << 4.6192929816929, 2.26894555443421, 3.61335021783362,
+        -4.51389305654121, 3.08033023711521, -4.82109003178482,
+        -2.54481105697422, 1.18754549447415, -1.42836336886182,
+        3.63685652388162, 0.595814660705009, 3.54442019268414,
+        3.1049183858329, -0.333667025669854, -4.51083833189994,
+        -2.16199020343709, 2.0276722565752, 7.50025078627574,
+        -4.62619641974711, -5.06870294715032, -0.305820649788242,
+        -0.395878816467899, -1.10528492007673, -2.51313807448059,
+        -1.44699002950331, -2.43925609241825, 0.902652349582918,
+        -5.82732638176514, 0.861614157026216, 2.56883513585703;
+  }
+};
+
+template <typename T_V>
+void expect_dlm_gradients(const dlm_data& d, const T_V& V, bool V_symmetric) {
+  using stan::math::gaussian_dlm_obs_lpdf;
+  expect_grad_fwd_rev(
+      "y",
+      [&](const auto& y) {
+        return gaussian_dlm_obs_lpdf(y, d.F, d.G, V, d.W, d.m0, d.C0);
+      },
+      d.y);
+  expect_grad_fwd_rev(
+      "F",
+      [&](const auto& F) {
+        return gaussian_dlm_obs_lpdf(d.y, F, d.G, V, d.W, d.m0, d.C0);
+      },
+      d.F);
+  expect_grad_fwd_rev(
+      "G",
+      [&](const auto& G) {
+        return gaussian_dlm_obs_lpdf(d.y, d.F, G, V, d.W, d.m0, d.C0);
+      },
+      d.G);
+  expect_grad_fwd_rev(
+      "V",
+      [&](const auto& V) {
+        return gaussian_dlm_obs_lpdf(d.y, d.F, d.G, V, d.W, d.m0, d.C0);
+      },
+      V, V_symmetric);
+  expect_grad_fwd_rev(
+      "W",
+      [&](const auto& W) {
+        return gaussian_dlm_obs_lpdf(d.y, d.F, d.G, V, W, d.m0, d.C0);
+      },
+      d.W);
+  expect_grad_fwd_rev(
+      "m0",
+      [&](const auto& m0) {
+        return gaussian_dlm_obs_lpdf(d.y, d.F, d.G, V, d.W, m0, d.C0);
+      },
+      d.m0);
+  expect_grad_fwd_rev(
+      "C0",
+      [&](const auto& C0) {
+        return gaussian_dlm_obs_lpdf(d.y, d.F, d.G, V, d.W, d.m0, C0);
+      },
+      d.C0);
+}
+
+}  // namespace gaussian_dlm_obs_test
+
+TEST(ProbDistributionsGaussianDLM, gradient_vector_V) {
+  gaussian_dlm_obs_test::dlm_data d;
+  gaussian_dlm_obs_test::expect_dlm_gradients(d, d.V_vec, false);
+}
+
+TEST(ProbDistributionsGaussianDLM, gradient_matrix_V) {
+  gaussian_dlm_obs_test::dlm_data d;
+  gaussian_dlm_obs_test::expect_dlm_gradients(d, d.V, true);
+}
+
+TEST(ProbDistributionsGaussianDLM, gradient_propto) {
+  using stan::math::gaussian_dlm_obs_lpdf;
+  using stan::math::var;
+  gaussian_dlm_obs_test::dlm_data d;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> G = d.G;
+  var lp = gaussian_dlm_obs_lpdf<false>(d.y, d.F, G, d.V_vec, d.W, d.m0, d.C0);
+  var lp_propto
+      = gaussian_dlm_obs_lpdf<true>(d.y, d.F, G, d.V_vec, d.W, d.m0, d.C0);
+  EXPECT_FLOAT_EQ(lp.val() + stan::math::HALF_LOG_TWO_PI * 3 * 10,
+                  lp_propto.val());
+  stan::math::recover_memory();
+}
+
+TEST(ProbDistributionsGaussianDLM, check_varis_on_stack) {
+  using stan::math::gaussian_dlm_obs_lpdf;
+  using stan::math::var;
+  gaussian_dlm_obs_test::dlm_data d;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> y = d.y;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> F = d.F;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> G = d.G;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> V = d.V_vec;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> W = d.W;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> m0 = d.m0;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> C0 = d.C0;
+  const size_t stack_size
+      = stan::math::ChainableStack::instance_->var_stack_.size();
+  gaussian_dlm_obs_lpdf(y, F, G, V, W, m0, C0);
+  // the whole filter is a single vari
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  stan::math::recover_memory();
+}
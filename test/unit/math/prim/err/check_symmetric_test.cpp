@@ -64,3 +64,26 @@ TEST(ErrorHandlingMatrix, checkSymmetric_non_square) {
   EXPECT_THROW(stan::math::check_symmetric("checkSymmetric", "y", y),
                std::invalid_argument);
 }
+
+TEST(ErrorHandlingMatrix, checkSymmetric_sparse) {
+  Eigen::SparseMatrix<double> y(3, 3);
+  y.insert(0, 0) = std::numeric_limits<double>::quiet_NaN();
+  y.insert(1, 0) = 2;
+  y.insert(0, 1) = 2;
+  y.insert(2, 2) = 1;
+  EXPECT_NO_THROW(stan::math::check_symmetric("checkSymmetric", "y", y));
+
+  y.insert(2, 1) = 3;
+  std::string message;
+  try {
+    stan::math::check_symmetric("checkSymmetric", "y", y);
+    FAIL() << "should have thrown";
+  } catch (const std::domain_error& e) {
+    message = e.what();
+  }
+  EXPECT_NE(std::string::npos, message.find("[3,2]")) << message;
+
+  EXPECT_THROW(stan::math::check_symmetric("checkSymmetric", "y",
+                                           Eigen::SparseMatrix<double>(2, 3)),
+               std::invalid_argument);
+}
@@ -86,3 +86,52 @@ TEST(MathMatrixPrimMat, accumulateCollection) {
   a.add(vvx);
   test_sum(a, pos - 1);
 }
+
+TEST(MathMatrixPrimMat, accumulateCompensated) {
+  using stan::math::accumulator;
+
+  accumulator<double> a;
+  a.add(1e16);
+  for (int i = 0; i < 1000; ++i)
+    a.add(1.0);
+  a.add(-1e16);
+  EXPECT_EQ(1000.0, a.sum());
+
+  accumulator<double> b;
+  Eigen::VectorXd x = Eigen::VectorXd::Constant(1000, 0.1);
+  b.add(x.array() * 2.0);
+  EXPECT_EQ(200.0, b.sum());
+}
+
+TEST(MathMatrixPrimMat, accumulateNonFinite) {
+  using stan::math::accumulator;
+
+  accumulator<double> a;
+  a.add(1.0);
+  a.add(stan::math::NEGATIVE_INFTY);
+  a.add(2.0);
+  EXPECT_EQ(stan::math::NEGATIVE_INFTY, a.sum());
+  a.add(stan::math::INFTY);
+  EXPECT_TRUE(std::isnan(a.sum()));
+
+  accumulator<double> b;
+  b.add(stan::math::NOT_A_NUMBER);
+  b.add(1.0);
+  EXPECT_TRUE(std::isnan(b.sum()));
+}
+
+TEST(MathMatrixPrimMat, accumulateMerge) {
+  using stan::math::accumulator;
+
+  accumulator<double> a;
+  accumulator<double> b;
+  a.add(1e16);
+  for (int i = 0; i < 100; ++i) {
+    a.add(1.0);
+    b.add(1.0);
+  }
+  b.add(-1e16);
+  a.add(b);
+  EXPECT_EQ(200.0, a.sum());
+  EXPECT_EQ(-1e16 + 100, b.sum());
+}
@@ -0,0 +1,94 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+TEST(MathPrimFun, prepared_data_statistics) {
+  Eigen::VectorXd y(4);
+  y << 1.5, -2.0, 3.25, 0.5;
+  auto y_prep = stan::math::prepare_data(y);
+
+  EXPECT_EQ(4, y_prep.size());
+  EXPECT_FALSE(y_prep.has_nan());
+  EXPECT_FLOAT_EQ(-2.0, y_prep.min());
+  EXPECT_FLOAT_EQ(3.25, y_prep.max());
+  EXPECT_FLOAT_EQ(y.sum(), y_prep.sum());
+  EXPECT_FLOAT_EQ(y.mean(), y_prep.mean());
+  EXPECT_FLOAT_EQ((y.array() - y.mean()).square().sum(),
+                  y_prep.sum_sq_dev());
+}
+
+TEST(MathPrimFun, prepared_data_integer_statistics) {
+  std::vector<int> n{0, 3, 1, 7};
+  auto n_prep = stan::math::prepare_data(n);
+
+  EXPECT_EQ(4, n_prep.size());
+  EXPECT_FLOAT_EQ(0, n_prep.min());
+  EXPECT_FLOAT_EQ(7, n_prep.max());
+  EXPECT_FLOAT_EQ(11, n_prep.sum());
+  double sum_lgamma = 0;
+  for (int n_i : n) {
+    sum_lgamma += stan::math::lgamma(n_i + 1.0);
+  }
+  EXPECT_FLOAT_EQ(sum_lgamma, n_prep.sum_lgamma_plus_one());
+}
+
+TEST(MathPrimFun, prepared_data_real_poisson) {
+  using stan::math::poisson_log_lpmf;
+  using stan::math::poisson_lpmf;
+  std::vector<int> n{0, 3, 1, 7};
+  std::vector<double> x(n.begin(), n.end());
+  auto x_prep = stan::math::prepare_data(x);
+  Eigen::VectorXd alpha(4);
+  alpha << 0.9, -0.5, 0.0, 1.9;
+
+  EXPECT_FLOAT_EQ(stan::math::prepare_data(n).sum_lgamma_plus_one(),
+                  x_prep.sum_lgamma_plus_one());
+  EXPECT_FLOAT_EQ(poisson_lpmf(n, 2.5), poisson_lpmf(x_prep, 2.5));
+  EXPECT_FLOAT_EQ(poisson_log_lpmf(n, 0.7), poisson_log_lpmf(x_prep, 0.7));
+  EXPECT_FLOAT_EQ(poisson_log_lpmf(n, alpha), poisson_log_lpmf(x_prep, alpha));
+}
+
+TEST(MathPrimFun, prepared_data_copies_data) {
+  std::vector<double> y{1, 2, 3};
+  auto y_prep = stan::math::prepare_data(y);
+  y[0] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(y_prep.has_nan());
+  EXPECT_FLOAT_EQ(1, y_prep.data()[0]);
+}
+
+TEST(MathPrimFun, prepared_data_lpdf_values) {
+  using stan::math::normal_lpdf;
+  using stan::math::poisson_log_lpmf;
+  using stan::math::poisson_lpmf;
+  Eigen::VectorXd y(3);
+  y << 1.5, -2.0, 3.25;
+  std::vector<int> n{0, 3, 1};
+  Eigen::VectorXd mu(3);
+  mu << 0.1, -0.5, 1.0;
+  auto y_prep = stan::math::prepare_data(y);
+  auto n_prep = stan::math::prepare_data(n);
+
+  EXPECT_FLOAT_EQ(normal_lpdf(y, 0.3, 1.7), normal_lpdf(y_prep, 0.3, 1.7));
+  EXPECT_FLOAT_EQ(poisson_lpmf(n, 2.5), poisson_lpmf(n_prep, 2.5));
+  EXPECT_FLOAT_EQ(poisson_lpmf(n, mu.array() + 1),
+                  poisson_lpmf(n_prep, mu.array() + 1));
+  EXPECT_FLOAT_EQ(poisson_log_lpmf(n, 0.7), poisson_log_lpmf(n_prep, 0.7));
+  EXPECT_FLOAT_EQ(poisson_log_lpmf(n, mu), poisson_log_lpmf(n_prep, mu));
+  EXPECT_FLOAT_EQ(0, normal_lpdf<true>(y_prep, 0.3, 1.7));
+  EXPECT_FLOAT_EQ(stan::math::LOG_ZERO, poisson_lpmf(n_prep, 0));
+}
+
+TEST(MathPrimFun, prepared_data_lpdf_errors) {
+  using stan::math::normal_lpdf;
+  using stan::math::poisson_lpmf;
+  std::vector<double> y{1.5, std::numeric_limits<double>::quiet_NaN()};
+  std::vector<int> n{0, -3, 1};
+
+  EXPECT_THROW(normal_lpdf(stan::math::prepare_data(y), 0, 1),
+               std::domain_error);
+  EXPECT_THROW(normal_lpdf(stan::math::prepare_data(n), 0, -1),
+               std::domain_error);
+  EXPECT_THROW(poisson_lpmf(stan::math::prepare_data(n), 2.0),
+               std::domain_error);
+}
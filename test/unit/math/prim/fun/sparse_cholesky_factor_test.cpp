@@ -0,0 +1,117 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// precision matrix of a Gaussian Markov random field on an n x n grid
+Eigen::SparseMatrix<double> grid_precision(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  auto index = [n](int i, int j) { return i * n + j; };
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      triplets.emplace_back(index(i, j), index(i, j), 4.5 + 0.1 * j);
+      if (i + 1 < n) {
+        triplets.emplace_back(index(i, j), index(i + 1, j), -1.0);
+        triplets.emplace_back(index(i + 1, j), index(i, j), -1.0);
+      }
+      if (j + 1 < n) {
+        triplets.emplace_back(index(i, j), index(i, j + 1), -0.5);
+        triplets.emplace_back(index(i, j + 1), index(i, j), -0.5);
+      }
+    }
+  }
+  Eigen::SparseMatrix<double> Q(n * n, n * n);
+  Q.setFromTriplets(triplets.begin(), triplets.end());
+  return Q;
+}
+}  // namespace
+
+TEST(MathMatrixPrim, sparse_cholesky_factor) {
+  Eigen::SparseMatrix<double> Q = grid_precision(6);
+  Eigen::MatrixXd Q_d(Q);
+  stan::math::sparse_cholesky_factor factor("f", "Q", Q);
+
+  Eigen::SparseMatrix<double> L = factor.matrixL();
+  Eigen::MatrixXd LLt = Eigen::MatrixXd(L * L.transpose());
+  Eigen::MatrixXd PQPt = factor.permutationP() * Q_d
+                         * factor.permutationP().transpose();
+  EXPECT_TRUE(PQPt.isApprox(LLt, 1e-12));
+
+  EXPECT_NEAR(std::log(Q_d.determinant()), factor.log_determinant(), 1e-10);
+
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(36, 3);
+  EXPECT_TRUE(Q_d.llt().solve(b).isApprox(factor.solve(b), 1e-12));
+
+  // selected inverse of the permuted matrix on the pattern of L
+  Eigen::MatrixXd PQPt_inv = PQPt.inverse();
+  Eigen::SparseMatrix<double> sigma = factor.selected_inverse();
+  EXPECT_EQ(L.nonZeros(), sigma.nonZeros());
+  for (int k = 0; k < sigma.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(sigma, k); it; ++it) {
+      EXPECT_NEAR(PQPt_inv(it.row(), it.col()), it.value(), 1e-12);
+    }
+  }
+
+  // inverse on the pattern of Q, in the original ordering
+  Eigen::MatrixXd Q_inv = Q_d.inverse();
+  Eigen::SparseMatrix<double> Q_inv_sparse = factor.inverse_on_pattern(Q);
+  EXPECT_EQ(Q.nonZeros(), Q_inv_sparse.nonZeros());
+  for (int k = 0; k < Q_inv_sparse.outerSize(); ++k) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(Q_inv_sparse, k); it;
+         ++it) {
+      EXPECT_NEAR(Q_inv(it.row(), it.col()), it.value(), 1e-12);
+    }
+  }
+}
+
+TEST(MathMatrixPrim, sparse_cholesky_factor_errors) {
+  Eigen::SparseMatrix<double> Q = grid_precision(3);
+  EXPECT_THROW(stan::math::sparse_cholesky_factor("f", "Q",
+                                                  Eigen::SparseMatrix<double>(
+                                                      2, 3)),
+               std::invalid_argument);
+
+  Eigen::SparseMatrix<double> asymmetric = Q;
+  asymmetric.coeffRef(1, 0) = 2;
+  EXPECT_THROW(stan::math::sparse_cholesky_factor("f", "Q", asymmetric),
+               std::domain_error);
+
+  Eigen::SparseMatrix<double> indefinite = -Q;
+  EXPECT_THROW(stan::math::sparse_cholesky_factor("f", "Q", indefinite),
+               std::domain_error);
+
+  Eigen::SparseMatrix<double> with_nan = Q;
+  with_nan.coeffRef(0, 0) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::sparse_cholesky_factor("f", "Q", with_nan),
+               std::domain_error);
+}
+
+TEST(MathMatrixPrim, cholesky_decompose_sparse) {
+  Eigen::SparseMatrix<double> Q = grid_precision(5);
+  Eigen::SparseMatrix<double> L = stan::math::cholesky_decompose(Q);
+  Eigen::MatrixXd L_dense = stan::math::cholesky_decompose(Eigen::MatrixXd(Q));
+  EXPECT_TRUE(L_dense.isApprox(Eigen::MatrixXd(L), 1e-12));
+
+  EXPECT_THROW(stan::math::cholesky_decompose(Eigen::SparseMatrix<double>(-Q)),
+               std::domain_error);
+}
+
+TEST(MathMatrixPrim, log_determinant_spd_sparse) {
+  Eigen::SparseMatrix<double> Q = grid_precision(5);
+  EXPECT_NEAR(stan::math::log_determinant_spd(Eigen::MatrixXd(Q)),
+              stan::math::log_determinant_spd(Q), 1e-10);
+  EXPECT_EQ(0, stan::math::log_determinant_spd(Eigen::SparseMatrix<double>()));
+}
+
+TEST(MathMatrixPrim, mdivide_left_spd_sparse) {
+  Eigen::SparseMatrix<double> Q = grid_precision(5);
+  Eigen::VectorXd b = Eigen::VectorXd::Random(25);
+  Eigen::VectorXd x = stan::math::mdivide_left_spd(Q, b);
+  EXPECT_TRUE(stan::math::mdivide_left_spd(Eigen::MatrixXd(Q), b)
+                  .isApprox(x, 1e-12));
+
+  Eigen::MatrixXd B = Eigen::MatrixXd::Random(25, 0);
+  EXPECT_EQ(0, stan::math::mdivide_left_spd(Q, B).cols());
+  EXPECT_THROW(stan::math::mdivide_left_spd(Q, Eigen::VectorXd(3)),
+               std::invalid_argument);
+}
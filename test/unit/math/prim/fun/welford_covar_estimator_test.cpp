@@ -73,3 +73,66 @@ TEST(ProbWelfordCovarEstimator, sample_covariance) {
     for (int j = 0; j < n; ++j)
       EXPECT_EQ(55.0 / 6.0, covar(i, j));
 }
+
+TEST(ProbWelfordCovarEstimator, add_samples) {
+  const int n = 7;
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(n, 50);
+
+  stan::math::welford_covar_estimator sequential(n);
+  for (int i = 0; i < qs.cols(); ++i)
+    sequential.add_sample(qs.col(i));
+
+  stan::math::welford_covar_estimator batched(n);
+  batched.add_sample(qs.col(0));
+  batched.add_samples(qs.middleCols(1, 20));
+  batched.add_samples(qs.rightCols(29));
+
+  EXPECT_EQ(sequential.num_samples(), batched.num_samples());
+  Eigen::VectorXd mean_seq, mean_bat;
+  Eigen::MatrixXd covar_seq, covar_bat;
+  sequential.sample_mean(mean_seq);
+  batched.sample_mean(mean_bat);
+  sequential.sample_covariance(covar_seq);
+  batched.sample_covariance(covar_bat);
+  EXPECT_TRUE(mean_seq.isApprox(mean_bat, 1e-12));
+  EXPECT_TRUE(covar_seq.isApprox(covar_bat, 1e-12));
+
+  EXPECT_THROW(batched.add_samples(Eigen::MatrixXd::Zero(n + 1, 3)),
+               std::invalid_argument);
+}
+
+TEST(ProbWelfordCovarEstimator, merge) {
+  const int n = 5;
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(n, 40);
+  qs.rightCols(15).array() += 3.0;
+
+  stan::math::welford_covar_estimator all(n);
+  stan::math::welford_covar_estimator first(n);
+  stan::math::welford_covar_estimator second(n);
+  stan::math::welford_covar_estimator empty(n);
+  for (int i = 0; i < qs.cols(); ++i) {
+    all.add_sample(qs.col(i));
+    if (i < 25)
+      first.add_sample(qs.col(i));
+    else
+      second.add_sample(qs.col(i));
+  }
+  empty.merge(first);
+  empty.merge(second);
+  first.merge(second);
+
+  for (auto* merged : {&first, &empty}) {
+    EXPECT_EQ(40, merged->num_samples());
+    Eigen::VectorXd mean_all, mean_merged;
+    Eigen::MatrixXd covar_all, covar_merged;
+    all.sample_mean(mean_all);
+    merged->sample_mean(mean_merged);
+    all.sample_covariance(covar_all);
+    merged->sample_covariance(covar_merged);
+    EXPECT_TRUE(mean_all.isApprox(mean_merged, 1e-12));
+    EXPECT_TRUE(covar_all.isApprox(covar_merged, 1e-12));
+  }
+
+  stan::math::welford_covar_estimator other(n + 1);
+  EXPECT_THROW(first.merge(other), std::invalid_argument);
+}
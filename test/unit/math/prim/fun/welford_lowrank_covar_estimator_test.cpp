@@ -0,0 +1,118 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+// samples with a covariance of rank k plus a mean offset
+Eigen::MatrixXd low_rank_samples(int n, int k, int n_samples) {
+  Eigen::MatrixXd A = Eigen::MatrixXd::Random(n, k);
+  Eigen::MatrixXd qs = A * Eigen::MatrixXd::Random(k, n_samples);
+  qs.colwise() += Eigen::VectorXd::LinSpaced(n, -1.0, 1.0);
+  return qs;
+}
+
+Eigen::MatrixXd dense_covariance(const Eigen::MatrixXd& qs) {
+  stan::math::welford_covar_estimator estimator(qs.rows());
+  estimator.add_samples(qs);
+  Eigen::MatrixXd covar;
+  estimator.sample_covariance(covar);
+  return covar;
+}
+
+Eigen::MatrixXd lowrank_covariance(
+    stan::math::welford_lowrank_covar_estimator& estimator) {
+  Eigen::VectorXd diag;
+  Eigen::MatrixXd factor;
+  estimator.sample_covariance(diag, factor);
+  Eigen::MatrixXd covar = factor * factor.transpose();
+  covar.diagonal() += diag;
+  return covar;
+}
+}  // namespace
+
+TEST(ProbWelfordLowrankCovarEstimator, restart) {
+  const int n = 10;
+  stan::math::welford_lowrank_covar_estimator estimator(n, 2);
+  for (int i = 0; i < 10; ++i)
+    estimator.add_sample(Eigen::VectorXd::Random(n));
+
+  estimator.restart();
+
+  EXPECT_EQ(0, estimator.num_samples());
+  Eigen::VectorXd mean(n);
+  estimator.sample_mean(mean);
+  for (int i = 0; i < n; ++i)
+    EXPECT_EQ(0, mean(i));
+
+  EXPECT_THROW(stan::math::welford_lowrank_covar_estimator(n, 0),
+               std::domain_error);
+  EXPECT_THROW(stan::math::welford_lowrank_covar_estimator(n, -1),
+               std::domain_error);
+  EXPECT_THROW(stan::math::welford_lowrank_covar_estimator(-1, 2),
+               std::domain_error);
+}
+
+TEST(ProbWelfordLowrankCovarEstimator, exact_for_low_rank) {
+  const int n = 20;
+  const int k = 3;
+  Eigen::MatrixXd qs = low_rank_samples(n, k, 200);
+  Eigen::MatrixXd covar = dense_covariance(qs);
+
+  stan::math::welford_lowrank_covar_estimator sequential(n, k);
+  for (int i = 0; i < qs.cols(); ++i)
+    sequential.add_sample(qs.col(i));
+  EXPECT_EQ(200, sequential.num_samples());
+  EXPECT_TRUE(covar.isApprox(lowrank_covariance(sequential), 1e-8));
+
+  stan::math::welford_lowrank_covar_estimator batched(n, k);
+  batched.add_samples(qs.leftCols(73));
+  batched.add_samples(qs.rightCols(127));
+  EXPECT_TRUE(covar.isApprox(lowrank_covariance(batched), 1e-8));
+
+  Eigen::VectorXd mean_seq, mean_bat, mean;
+  sequential.sample_mean(mean_seq);
+  batched.sample_mean(mean_bat);
+  mean = qs.rowwise().mean();
+  EXPECT_TRUE(mean.isApprox(mean_seq, 1e-12));
+  EXPECT_TRUE(mean.isApprox(mean_bat, 1e-12));
+}
+
+TEST(ProbWelfordLowrankCovarEstimator, diagonal_is_exact) {
+  const int n = 15;
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(n, 100);
+  Eigen::MatrixXd covar = dense_covariance(qs);
+
+  stan::math::welford_lowrank_covar_estimator estimator(n, 2);
+  estimator.add_samples(qs);
+  Eigen::VectorXd var;
+  estimator.sample_variance(var);
+  EXPECT_TRUE(covar.diagonal().isApprox(var, 1e-12));
+
+  // the low-rank part never exceeds the variances
+  Eigen::VectorXd diag;
+  Eigen::MatrixXd factor;
+  estimator.sample_covariance(diag, factor);
+  EXPECT_EQ(n, factor.rows());
+  EXPECT_EQ(2, factor.cols());
+  EXPECT_TRUE((diag.array() >= 0).all());
+  EXPECT_TRUE(
+      lowrank_covariance(estimator).diagonal().isApprox(covar.diagonal()));
+}
+
+TEST(ProbWelfordLowrankCovarEstimator, merge) {
+  const int n = 12;
+  const int k = 2;
+  Eigen::MatrixXd qs = low_rank_samples(n, k, 90);
+  Eigen::MatrixXd covar = dense_covariance(qs);
+
+  stan::math::welford_lowrank_covar_estimator first(n, k);
+  stan::math::welford_lowrank_covar_estimator second(n, k);
+  first.add_samples(qs.leftCols(40));
+  second.add_samples(qs.rightCols(50));
+  first.merge(second);
+
+  EXPECT_EQ(90, first.num_samples());
+  EXPECT_TRUE(covar.isApprox(lowrank_covariance(first), 1e-8));
+
+  stan::math::welford_lowrank_covar_estimator other_rank(n, k + 1);
+  EXPECT_THROW(first.merge(other_rank), std::invalid_argument);
+}
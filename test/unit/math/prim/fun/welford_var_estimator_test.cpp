@@ -70,3 +70,58 @@ TEST(ProbWelfordVarEstimator, sample_variance) {
   for (int i = 0; i < n; ++i)
     EXPECT_EQ(55.0 / 6.0, var(i));
 }
+
+TEST(ProbWelfordVarEstimator, add_samples) {
+  const int n = 7;
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(n, 50);
+
+  stan::math::welford_var_estimator sequential(n);
+  for (int i = 0; i < qs.cols(); ++i)
+    sequential.add_sample(qs.col(i));
+
+  stan::math::welford_var_estimator batched(n);
+  batched.add_samples(qs.leftCols(21));
+  batched.add_samples(qs.rightCols(29));
+
+  EXPECT_EQ(sequential.num_samples(), batched.num_samples());
+  Eigen::VectorXd mean_seq, mean_bat, var_seq, var_bat;
+  sequential.sample_mean(mean_seq);
+  batched.sample_mean(mean_bat);
+  sequential.sample_variance(var_seq);
+  batched.sample_variance(var_bat);
+  EXPECT_TRUE(mean_seq.isApprox(mean_bat, 1e-12));
+  EXPECT_TRUE(var_seq.isApprox(var_bat, 1e-12));
+
+  EXPECT_THROW(batched.add_samples(Eigen::MatrixXd::Zero(n + 1, 3)),
+               std::invalid_argument);
+}
+
+TEST(ProbWelfordVarEstimator, merge) {
+  const int n = 5;
+  Eigen::MatrixXd qs = Eigen::MatrixXd::Random(n, 40);
+  qs.rightCols(15).array() += 3.0;
+
+  stan::math::welford_var_estimator all(n);
+  stan::math::welford_var_estimator first(n);
+  stan::math::welford_var_estimator second(n);
+  for (int i = 0; i < qs.cols(); ++i) {
+    all.add_sample(qs.col(i));
+    if (i < 25)
+      first.add_sample(qs.col(i));
+    else
+      second.add_sample(qs.col(i));
+  }
+  first.merge(second);
+
+  EXPECT_EQ(40, first.num_samples());
+  Eigen::VectorXd mean_all, mean_merged, var_all, var_merged;
+  all.sample_mean(mean_all);
+  first.sample_mean(mean_merged);
+  all.sample_variance(var_all);
+  first.sample_variance(var_merged);
+  EXPECT_TRUE(mean_all.isApprox(mean_merged, 1e-12));
+  EXPECT_TRUE(var_all.isApprox(var_merged, 1e-12));
+
+  stan::math::welford_var_estimator other(n + 1);
+  EXPECT_THROW(first.merge(other), std::invalid_argument);
+}
@@ -0,0 +1,49 @@
+#include <stan/math/prim/functor.hpp>
+#include <gtest/gtest.h>
+
+using stan::math::internal::grainsize_tuner;
+
+TEST(MathFunctions, grainsize_tuner_initial) {
+  grainsize_tuner tuner;
+  EXPECT_EQ(0, tuner.num_updates());
+  // 8 chunks per thread
+  EXPECT_EQ(125, tuner.grainsize(4000, 4));
+  EXPECT_EQ(1, tuner.grainsize(10, 4));
+  EXPECT_EQ(1, tuner.grainsize(0, 4));
+  EXPECT_EQ(500, tuner.grainsize(4000, 0));
+}
+
+TEST(MathFunctions, grainsize_tuner_update) {
+  grainsize_tuner tuner;
+  grainsize_tuner::chunk_stats stats;
+  // 1us per term, 1ms overhead per chunk
+  stats.num_chunks_ = 10;
+  stats.num_terms_ = 1000;
+  stats.term_seconds_ = 1e-3;
+  stats.overhead_seconds_ = 1e-2;
+  tuner.update(stats);
+  EXPECT_EQ(1, tuner.num_updates());
+  EXPECT_FLOAT_EQ(1e-6, tuner.cost_per_term());
+  EXPECT_FLOAT_EQ(1e-3, tuner.overhead_per_chunk());
+  // overhead at most 10% of the chunk needs 10000 terms
+  EXPECT_NEAR(10000, tuner.grainsize(1000000, 4), 1);
+  // but every thread gets work
+  EXPECT_EQ(2500, tuner.grainsize(10000, 4));
+
+  // no overhead, chunks of at least 10us
+  stats.overhead_seconds_ = 0;
+  tuner.reset();
+  tuner.update(stats);
+  EXPECT_NEAR(10, tuner.grainsize(1000000, 4), 1);
+
+  // running average
+  stats.term_seconds_ = 3e-3;
+  tuner.update(stats);
+  EXPECT_EQ(2, tuner.num_updates());
+  EXPECT_FLOAT_EQ(2e-6, tuner.cost_per_term());
+  EXPECT_NEAR(5, tuner.grainsize(1000000, 4), 1);
+
+  // calls without chunks are ignored
+  tuner.update(grainsize_tuner::chunk_stats());
+  EXPECT_EQ(2, tuner.num_updates());
+}
@@ -25,10 +25,46 @@ TEST(StanMathPrim_reduce_sum, value) {
       = stan::math::reduce_sum_static<count_lpdf<double>>(
           data, 5, get_new_msg(), vlambda_d, idata);
 
+  double poisson_auto_lpdf = stan::math::reduce_sum_auto<count_lpdf<double>>(
+      data, get_new_msg(), vlambda_d, idata);
+
   double poisson_lpdf_ref = stan::math::poisson_lpmf(data, lambda_d);
   // NOTE:(Steve) This fails with EXPECT_DOUBLE_EQ at about 10e-7
   EXPECT_FLOAT_EQ(poisson_lpdf, poisson_lpdf_ref);
   EXPECT_FLOAT_EQ(poisson_static_lpdf, poisson_lpdf_ref);
+  EXPECT_FLOAT_EQ(poisson_auto_lpdf, poisson_lpdf_ref);
+}
+
+TEST(StanMathPrim_reduce_sum, auto_grainsize) {
+  using stan::math::test::count_lpdf;
+  using stan::math::test::get_new_msg;
+  std::vector<int> data(10000);
+  for (std::size_t i = 0; i != data.size(); ++i)
+    data[i] = i % 20;
+  std::vector<int> idata;
+  std::vector<double> vlambda_d(1, 10.0);
+
+  auto& tuner = stan::math::internal::reduce_sum_tuner<count_lpdf<double>>();
+  tuner.reset();
+  const double poisson_lpdf_ref = stan::math::poisson_lpmf(data, 10.0);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(stan::math::reduce_sum_auto<count_lpdf<double>>(
+                        data, get_new_msg(), vlambda_d, idata),
+                    poisson_lpdf_ref);
+  }
+  std::vector<int> empty;
+  EXPECT_FLOAT_EQ(stan::math::reduce_sum_auto<count_lpdf<double>>(
+                      empty, get_new_msg(), vlambda_d, idata),
+                  0.0);
+#ifdef STAN_THREADS
+  EXPECT_EQ(3, tuner.num_updates());
+  EXPECT_GT(tuner.cost_per_term(), 0.0);
+  const int grainsize = tuner.grainsize(data.size(), 4);
+  EXPECT_GE(grainsize, 1);
+  EXPECT_LE(grainsize, 2500);
+#else
+  EXPECT_EQ(0, tuner.num_updates());
+#endif
 }
 
 TEST(StanMathPrim_reduce_sum, grainsize) {
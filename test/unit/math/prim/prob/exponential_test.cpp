@@ -74,3 +74,38 @@ TEST(ProbDistributionsExponential, chiSquareGoodnessFitTest) {
   // Assert that they match
   assert_matches_quantiles(samples, quantiles, 1e-6);
 }
+
+TEST(ProbDistributionsExponential, chiSquareGoodnessFitTestBatch) {
+  stan::math::philox4x32 rng(1234);
+  int N = 10000;
+  int K = stan::math::round(2 * std::pow(N, 0.4));
+
+  Eigen::VectorXd out(N);
+  stan::math::exponential_rng(2.0, rng, out);
+  std::vector<double> samples(out.data(), out.data() + N);
+
+  boost::math::exponential_distribution<> dist(2.0);
+  std::vector<double> quantiles;
+  for (int i = 1; i < K; ++i) {
+    double frac = static_cast<double>(i) / K;
+    quantiles.push_back(quantile(dist, frac));
+  }
+  quantiles.push_back(std::numeric_limits<double>::max());
+
+  assert_matches_quantiles(samples, quantiles, 1e-6);
+}
+
+TEST(ProbDistributionsExponential, batchVectorParameters) {
+  boost::random::mt19937 rng;
+  Eigen::VectorXd beta(3);
+  beta << 1e6, 1.0, 1e-6;
+  Eigen::VectorXd out(3);
+  stan::math::exponential_rng(beta, rng, out);
+  EXPECT_TRUE((out.array() > 0).all());
+  EXPECT_LT(out(0), 1e-3);
+
+  Eigen::VectorXd out_bad(2);
+  EXPECT_THROW(stan::math::exponential_rng(beta, rng, out_bad),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::exponential_rng(0.0, rng, out), std::domain_error);
+}
@@ -80,3 +80,42 @@ TEST(ProbDistributionGamma, chiSquareGoodnessFitTest) {
   // Assert that they match
   assert_matches_quantiles(samples, quantiles, 1e-6);
 }
+
+TEST(ProbDistributionGamma, chiSquareGoodnessFitTestBatch) {
+  stan::math::philox4x32 rng(1234);
+  int N = 10000;
+  int K = stan::math::round(2 * std::pow(N, 0.4));
+
+  // shapes above and below one take different paths of the sampler
+  for (double alpha : {2.0, 0.3}) {
+    Eigen::VectorXd out(N);
+    stan::math::gamma_rng(alpha, 0.5, rng, out);
+    std::vector<double> samples(out.data(), out.data() + N);
+
+    boost::math::gamma_distribution<> dist(alpha, 2.0);
+    std::vector<double> quantiles;
+    for (int i = 1; i < K; ++i) {
+      double frac = static_cast<double>(i) / K;
+      quantiles.push_back(quantile(dist, frac));
+    }
+    quantiles.push_back(std::numeric_limits<double>::max());
+
+    assert_matches_quantiles(samples, quantiles, 1e-6);
+  }
+}
+
+TEST(ProbDistributionGamma, batchVectorParameters) {
+  boost::random::mt19937 rng;
+  std::vector<double> alpha{1e6, 0.5, 3.0};
+  Eigen::VectorXd beta(3);
+  beta << 1e6, 1.0, 2.0;
+  Eigen::VectorXd out(3);
+  stan::math::gamma_rng(alpha, beta, rng, out);
+  EXPECT_TRUE((out.array() > 0).all());
+  EXPECT_NEAR(out(0), 1.0, 0.01);
+
+  Eigen::VectorXd out_bad(2);
+  EXPECT_THROW(stan::math::gamma_rng(alpha, 1.0, rng, out_bad),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::gamma_rng(-1.0, 1.0, rng, out), std::domain_error);
+}
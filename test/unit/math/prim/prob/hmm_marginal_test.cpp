@@ -43,6 +43,79 @@ TEST_F(hmm_test, zero_transitions) {
                         Gamma_unconstrained_, rho_unconstrained_);
 }
 
+TEST_F(hmm_test, batch) {
+  using stan::math::hmm_marginal;
+
+  std::vector<Eigen::MatrixXd> log_omegas{
+      log_omegas_, log_omegas_zero_, log_omegas_.leftCols(4),
+      log_omegas_.rightCols(7)};
+  double expected = 0;
+  for (const auto& log_omega : log_omegas) {
+    expected += hmm_marginal(log_omega, Gamma_, rho_);
+  }
+  EXPECT_FLOAT_EQ(expected, hmm_marginal(log_omegas, Gamma_, rho_));
+  EXPECT_FLOAT_EQ(
+      0, hmm_marginal(std::vector<Eigen::MatrixXd>{}, Gamma_, rho_));
+
+  // Differentiation tests
+  auto hmm_functor = [](const auto& log_omegas, const auto& Gamma_unconstrained,
+                        const auto& rho_unconstrained) {
+    return hmm_marginal_batch_test_wrapper(log_omegas, Gamma_unconstrained,
+                                           rho_unconstrained);
+  };
+
+  stan::test::expect_ad(tols_, hmm_functor, log_omegas, Gamma_unconstrained_,
+                        rho_unconstrained_);
+}
+
+TEST_F(hmm_test, batch_many_sequences) {
+  using stan::math::hmm_marginal;
+  using stan::math::var;
+
+  // more sequences than one parallel chunk
+  std::vector<Eigen::MatrixXd> log_omegas;
+  for (int i = 0; i < 500; ++i) {
+    log_omegas.push_back(log_omegas_.leftCols(1 + i % (n_transitions_ + 1)));
+  }
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> Gamma = Gamma_;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> rho = rho_;
+  var lp = hmm_marginal(log_omegas, Gamma, rho);
+  lp.grad();
+  Eigen::MatrixXd Gamma_adj = Gamma.adj();
+  Eigen::VectorXd rho_adj = rho.adj();
+  stan::math::set_zero_all_adjoints();
+
+  var expected = 0;
+  for (const auto& log_omega : log_omegas) {
+    expected += hmm_marginal(log_omega, Gamma, rho);
+  }
+  expected.grad();
+  EXPECT_FLOAT_EQ(expected.val(), lp.val());
+  for (int i = 0; i < Gamma.size(); ++i) {
+    EXPECT_FLOAT_EQ(Gamma.adj()(i), Gamma_adj(i));
+  }
+  for (int i = 0; i < rho.size(); ++i) {
+    EXPECT_FLOAT_EQ(rho.adj()(i), rho_adj(i));
+  }
+  stan::math::recover_memory();
+}
+
+TEST(hmm_marginal, batch_without_observations) {
+  using stan::math::hmm_marginal;
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, Eigen::Dynamic> Gamma(2, 2);
+  Gamma << 0.8, 0.2, 0.6, 0.4;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> rho(2);
+  rho << 0.65, 0.35;
+  std::vector<Eigen::MatrixXd> log_omegas(3, Eigen::MatrixXd(2, 0));
+  var lp = hmm_marginal(log_omegas, Gamma, rho);
+  EXPECT_FLOAT_EQ(0, lp.val());
+  lp.grad();
+  EXPECT_FLOAT_EQ(0, Gamma.adj().norm());
+  EXPECT_FLOAT_EQ(0, rho.adj().norm());
+  stan::math::recover_memory();
+}
+
 TEST(hmm_marginal, one_state) {
   using stan::math::hmm_marginal;
   int n_states = 1, p1_init = 1, gamma1 = 1, n_transitions = 10, abs_mu = 1,
@@ -130,6 +203,22 @@ TEST(hmm_marginal, exceptions) {
                    "hmm_marginal: rho is not a valid simplex. "
                    "sum(rho) = 2, but should be 1")
 
+  // One sequence of a batch is inconsistent with Gamma
+  std::vector<MatrixXd> log_omegas_batch{log_omegas,
+                                         MatrixXd::Ones(n_states + 1, 3)};
+  EXPECT_THROW_MSG(hmm_marginal(log_omegas_batch, Gamma, rho),
+                   std::invalid_argument,
+                   "hmm_marginal: rho has dimension = 2, expecting dimension "
+                   "= 3")
+  // and so is the reverse mode batch, which checks every sequence
+  Eigen::Matrix<stan::math::var, Eigen::Dynamic, Eigen::Dynamic> Gamma_var
+      = Gamma;
+  EXPECT_THROW_MSG(hmm_marginal(log_omegas_batch, Gamma_var, rho),
+                   std::invalid_argument,
+                   "hmm_marginal: rho has dimension = 2, expecting dimension "
+                   "= 3")
+  stan::math::recover_memory();
+
   // The size of rho is inconsistent with that of log_omega
   VectorXd rho_wrong_size(n_states + 1);
   EXPECT_THROW_MSG(
@@ -43,6 +43,39 @@ inline stan::return_type_t<T_omega, T_Gamma, T_rho> hmm_marginal_test_wrapper(
   return stan::math::hmm_marginal(log_omegas, Gamma, rho);
 }
 
+/**
+ * Batched version of hmm_marginal_test_wrapper for a vector of
+ * log_omegas sharing Gamma and rho.
+ */
+template <typename T_omega, typename T_Gamma, typename T_rho>
+inline stan::return_type_t<T_omega, T_Gamma, T_rho>
+hmm_marginal_batch_test_wrapper(
+    const std::vector<Eigen::Matrix<T_omega, Eigen::Dynamic, Eigen::Dynamic>>&
+        log_omegas,
+    const Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic>&
+        Gamma_unconstrained,
+    const std::vector<T_rho>& rho_unconstrained) {
+  using stan::math::row;
+  using stan::math::sum;
+  int n_states = log_omegas[0].rows();
+
+  Eigen::Matrix<T_Gamma, Eigen::Dynamic, Eigen::Dynamic> Gamma(n_states,
+                                                               n_states);
+  for (int i = 0; i < n_states; i++) {
+    Gamma(i, n_states - 1) = 1 - sum(row(Gamma_unconstrained, i + 1));
+    for (int j = 0; j < n_states - 1; j++) {
+      Gamma(i, j) = Gamma_unconstrained(i, j);
+    }
+  }
+
+  Eigen::Matrix<T_rho, Eigen::Dynamic, 1> rho(n_states);
+  rho(1) = 1 - sum(rho_unconstrained);
+  for (int i = 0; i < n_states - 1; i++)
+    rho(i) = rho_unconstrained[i];
+
+  return stan::math::hmm_marginal(log_omegas, Gamma, rho);
+}
+
 /**
  * In the proposed example, the latent state x determines
  * the observational distribution:
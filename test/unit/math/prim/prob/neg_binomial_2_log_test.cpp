@@ -70,6 +70,53 @@ TEST(ProbDistributionsNegBinomial2Log, error_check) {
   }
 }
 
+TEST(ProbDistributionsNegBinomial2Log, lpmf_error_messages) {
+  using stan::math::neg_binomial_2_log_lpmf;
+
+  // The invalid element comes after valid ones, so the fused loop has
+  // already computed terms before it reaches it.
+  std::vector<int> n{1, 3, -1};
+  std::vector<double> eta{0.5, 1.0, 1.5};
+  std::vector<double> phi{2.0, 3.0, 4.0};
+  std::string error_msg = "neg_binomial_2_log_lpmf: Failures variable[3] is -1";
+  try {
+    neg_binomial_2_log_lpmf(n, eta, phi);
+    FAIL() << "neg_binomial_2_log_lpmf should have thrown" << std::endl;
+  } catch (const std::domain_error& e) {
+    if (std::string(e.what()).find(error_msg) == std::string::npos)
+      FAIL() << "Error message is different than expected" << std::endl
+             << "EXPECTED: " << error_msg << std::endl
+             << "FOUND: " << e.what() << std::endl;
+    SUCCEED();
+  }
+
+  n = {1, 3, 5};
+  phi = {2.0, -0.5, 4.0};
+  error_msg = "neg_binomial_2_log_lpmf: Precision parameter[2] is -0.5";
+  try {
+    neg_binomial_2_log_lpmf(n, eta, phi);
+    FAIL() << "neg_binomial_2_log_lpmf should have thrown" << std::endl;
+  } catch (const std::domain_error& e) {
+    if (std::string(e.what()).find(error_msg) == std::string::npos)
+      FAIL() << "Error message is different than expected" << std::endl
+             << "EXPECTED: " << error_msg << std::endl
+             << "FOUND: " << e.what() << std::endl;
+    SUCCEED();
+  }
+
+  error_msg = "neg_binomial_2_log_lpmf: Precision parameter is 0";
+  try {
+    neg_binomial_2_log_lpmf(5, 1.0, 0.0);
+    FAIL() << "neg_binomial_2_log_lpmf should have thrown" << std::endl;
+  } catch (const std::domain_error& e) {
+    if (std::string(e.what()).find(error_msg) == std::string::npos)
+      FAIL() << "Error message is different than expected" << std::endl
+             << "EXPECTED: " << error_msg << std::endl
+             << "FOUND: " << e.what() << std::endl;
+    SUCCEED();
+  }
+}
+
 TEST(ProbDistributionsNegBinomial2Log, chiSquareGoodnessFitTest) {
   boost::random::mt19937 rng;
   int N = 1000;
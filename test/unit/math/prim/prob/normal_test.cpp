@@ -111,3 +111,40 @@ TEST(ProbDistributionsNormal, chiSquareGoodnessFitTest) {
   // Assert that they match
   assert_matches_quantiles(samples, quantiles, 1e-6);
 }
+
+TEST(ProbDistributionsNormal, chiSquareGoodnessFitTestBatch) {
+  stan::math::philox4x32 rng(1234);
+  int N = 10000;
+  int K = stan::math::round(2 * std::pow(N, 0.4));
+
+  Eigen::VectorXd out(N);
+  stan::math::normal_rng(2.0, 1.5, rng, out);
+  std::vector<double> samples(out.data(), out.data() + N);
+
+  boost::math::normal_distribution<> dist(2.0, 1.5);
+  std::vector<double> quantiles;
+  for (int i = 1; i < K; ++i) {
+    double frac = static_cast<double>(i) / K;
+    quantiles.push_back(quantile(dist, frac));
+  }
+  quantiles.push_back(std::numeric_limits<double>::max());
+
+  assert_matches_quantiles(samples, quantiles, 1e-6);
+}
+
+TEST(ProbDistributionsNormal, batchVectorParameters) {
+  boost::random::mt19937 rng;
+  Eigen::VectorXd mu(3);
+  mu << -100.0, 0.0, 100.0;
+  std::vector<double> sigma{1e-3, 1e-3, 1e-3};
+  Eigen::VectorXd out(3);
+  stan::math::normal_rng(mu, sigma, rng, out);
+  EXPECT_NEAR(out(0), -100.0, 0.1);
+  EXPECT_NEAR(out(1), 0.0, 0.1);
+  EXPECT_NEAR(out(2), 100.0, 0.1);
+
+  Eigen::VectorXd out_bad(4);
+  EXPECT_THROW(stan::math::normal_rng(mu, 1.0, rng, out_bad),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::normal_rng(0.0, -1.0, rng, out), std::domain_error);
+}
@@ -0,0 +1,92 @@
+#include <stan/math/prim.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+TEST(ProbPhilox4x32, knownAnswers) {
+  // known answer tests of the Random123 distribution
+  using stan::math::philox4x32;
+  std::array<std::uint32_t, 4> zero
+      = philox4x32::encrypt({0, 0, 0, 0}, {0, 0});
+  EXPECT_EQ(zero[0], 0x6627e8d5u);
+  EXPECT_EQ(zero[1], 0xe169c58du);
+  EXPECT_EQ(zero[2], 0xbc57ac4cu);
+  EXPECT_EQ(zero[3], 0x9b00dbd8u);
+
+  std::array<std::uint32_t, 4> ones = philox4x32::encrypt(
+      {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+      {0xffffffff, 0xffffffff});
+  EXPECT_EQ(ones[0], 0x408f276du);
+  EXPECT_EQ(ones[1], 0x41c83b0eu);
+  EXPECT_EQ(ones[2], 0xa20bc7c6u);
+  EXPECT_EQ(ones[3], 0x6d5451fdu);
+
+  philox4x32 rng;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(rng(), zero[i]);
+  }
+}
+
+TEST(ProbPhilox4x32, streams) {
+  stan::math::philox4x32 rng(42);
+  stan::math::philox4x32 a = rng.split(3);
+  stan::math::philox4x32 b(42, 3);
+  EXPECT_TRUE(a == b);
+  EXPECT_TRUE(a != rng);
+
+  std::vector<std::uint32_t> draws_a;
+  for (int i = 0; i < 10; ++i) {
+    draws_a.push_back(a());
+    EXPECT_EQ(draws_a.back(), b());
+  }
+
+  stan::math::philox4x32 c = rng.split(4);
+  int n_equal = 0;
+  for (int i = 0; i < 10; ++i) {
+    n_equal += c() == draws_a[i];
+  }
+  EXPECT_LT(n_equal, 2);
+}
+
+TEST(ProbPhilox4x32, discard) {
+  for (unsigned long long z : {0ull, 1ull, 3ull, 4ull, 5ull, 11ull, 100ull}) {
+    stan::math::philox4x32 a(7);
+    stan::math::philox4x32 b(7);
+    a();
+    b();
+    for (unsigned long long i = 0; i < z; ++i) {
+      a();
+    }
+    b.discard(z);
+    EXPECT_TRUE(a == b) << "z = " << z;
+    EXPECT_EQ(a(), b()) << "z = " << z;
+  }
+}
+
+TEST(ProbPhilox4x32, fillUniform01) {
+  stan::math::philox4x32 rng(123);
+  Eigen::ArrayXd u(10001);
+  rng.fill_uniform_01(u.data(), u.size());
+  EXPECT_TRUE((u > 0).all());
+  EXPECT_TRUE((u < 1).all());
+  EXPECT_NEAR(u.mean(), 0.5, 0.02);
+
+  // a fill of blocks continues where the previous one stopped
+  stan::math::philox4x32 split(123);
+  Eigen::ArrayXd first(5000);
+  Eigen::ArrayXd second(5001);
+  split.fill_uniform_01(first.data(), first.size());
+  split.fill_uniform_01(second.data(), second.size());
+  EXPECT_TRUE((first == u.head(5000)).all());
+  EXPECT_TRUE((second == u.tail(5001)).all());
+  EXPECT_TRUE(rng == split);
+}
+
+TEST(ProbPhilox4x32, rngFunctions) {
+  stan::math::philox4x32 rng(1);
+  double x = stan::math::normal_rng(0, 1, rng);
+  EXPECT_TRUE(std::isfinite(x));
+  int n = stan::math::poisson_rng(4.0, rng);
+  EXPECT_GE(n, 0);
+}
@@ -95,3 +95,38 @@ TEST(ProbDistributionsUniform, chiSquareGoodnessFitTest) {
   // Assert that they match.
   assert_matches_quantiles(samples, quantiles, 1e-6);
 }
+
+TEST(ProbDistributionsUniform, chiSquareGoodnessFitTestBatch) {
+  stan::math::philox4x32 rng(1234);
+  int N = 10000;
+  int K = stan::math::round(2 * std::pow(N, 0.4));
+
+  Eigen::VectorXd out(N);
+  stan::math::uniform_rng(1.0, 2.0, rng, out);
+  std::vector<double> samples(out.data(), out.data() + N);
+
+  boost::math::uniform_distribution<> dist(1.0, 2.0);
+  std::vector<double> quantiles;
+  for (int i = 1; i < K; ++i) {
+    double frac = static_cast<double>(i) / K;
+    quantiles.push_back(quantile(dist, frac));
+  }
+  quantiles.push_back(std::numeric_limits<double>::max());
+
+  assert_matches_quantiles(samples, quantiles, 1e-6);
+}
+
+TEST(ProbDistributionsUniform, batchVectorParameters) {
+  boost::random::mt19937 rng;
+  Eigen::VectorXd alpha(3);
+  alpha << -10.0, 0.0, 10.0;
+  Eigen::VectorXd out(3);
+  stan::math::uniform_rng(alpha, (alpha.array() + 1).matrix(), rng, out);
+  EXPECT_TRUE((out.array() > alpha.array()).all());
+  EXPECT_TRUE((out.array() < alpha.array() + 1).all());
+
+  Eigen::VectorXd out_bad(4);
+  EXPECT_THROW(stan::math::uniform_rng(alpha, 20.0, rng, out_bad),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::uniform_rng(1.0, 0.0, rng, out), std::domain_error);
+}
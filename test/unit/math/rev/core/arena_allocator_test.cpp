@@ -35,3 +35,12 @@ void arena_allocator_test() {
 TEST(AgradRev, arena_allocator_test) {
   EXPECT_NO_THROW(arena_allocator_test());
 }
+
+TEST(AgradRev, arena_allocator_aligned_eigen) {
+  stan::math::ChainableStack::instance_->memalloc_.alloc(3);
+  std::vector<Eigen::Matrix4d, stan::math::arena_allocator<Eigen::Matrix4d>> v(
+      3, Eigen::Matrix4d::Identity());
+  EXPECT_TRUE(stan::math::is_aligned(v.data(), alignof(Eigen::Matrix4d)));
+  EXPECT_FLOAT_EQ(12, (v[0] + v[1] + v[2]).sum());
+  stan::math::recover_memory();
+}
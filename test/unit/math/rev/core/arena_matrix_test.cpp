@@ -104,3 +104,21 @@ TEST(AgradRev, arena_matrix_transpose_test) {
 
   stan::math::recover_memory();
 }
+
+TEST(AgradRev, arena_matrix_cache_line_aligned) {
+  using Eigen::MatrixXd;
+  using Eigen::VectorXd;
+  using stan::math::arena_matrix;
+  stan::math::ChainableStack::instance_->memalloc_.alloc(3);
+  arena_matrix<VectorXd> a(3);
+  EXPECT_TRUE(stan::math::is_aligned(a.data(), 64U));
+  arena_matrix<MatrixXd> b(3, 5);
+  EXPECT_TRUE(stan::math::is_aligned(b.data(), 64U));
+  arena_matrix<VectorXd> c(VectorXd::Ones(7));
+  EXPECT_TRUE(stan::math::is_aligned(c.data(), 64U));
+  c = 2 * a;
+  EXPECT_TRUE(stan::math::is_aligned(c.data(), 64U));
+  auto d = stan::math::to_arena(MatrixXd::Ones(2, 2));
+  EXPECT_TRUE(stan::math::is_aligned(d.data(), 64U));
+  stan::math::recover_memory();
+}
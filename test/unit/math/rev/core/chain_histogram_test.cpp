@@ -0,0 +1,45 @@
+#define STAN_CHAIN_HISTOGRAM
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+TEST(AgradRev, chain_histogram) {
+  using stan::math::var;
+  stan::math::reset_chain_histogram();
+  EXPECT_TRUE(stan::math::chain_histogram().empty());
+
+  var x = 0.5;
+  var lp = 0;
+  for (int i = 0; i < 100; ++i) {
+    lp += exp(x * i);
+  }
+  Eigen::Matrix<var, -1, 1> v(3);
+  v << x, x, x;
+  lp += stan::math::dot_self(v);
+  lp.grad();
+  stan::math::recover_memory();
+
+  auto rows = stan::math::chain_histogram();
+  ASSERT_FALSE(rows.empty());
+  size_t total_calls = 0;
+  for (size_t i = 0; i < rows.size(); ++i) {
+    EXPECT_FALSE(rows[i].type_.empty());
+    EXPECT_GT(rows[i].calls_, 0);
+    EXPECT_GE(rows[i].seconds_, 0.0);
+    if (i > 0) {
+      EXPECT_LE(rows[i].seconds_, rows[i - 1].seconds_);
+    }
+    total_calls += rows[i].calls_;
+  }
+  // 99 products (x * 1 is x), 100 exps, 100 sums, one dot_self and the
+  // sum with it
+  EXPECT_EQ(301, total_calls);
+
+  std::stringstream s;
+  stan::math::print_chain_histogram(s);
+  EXPECT_EQ(0, s.str().find("CHAIN HISTOGRAM, types="));
+
+  stan::math::reset_chain_histogram();
+  EXPECT_TRUE(stan::math::chain_histogram().empty());
+}
@@ -90,3 +90,17 @@ TEST(AgradRev, nested_grad_during_chain) {
 
   test_var.grad();
 }
+
+TEST(AgradRev, make_op_vari) {
+  using stan::math::var;
+  var a = 2.0;
+  var b = 3.0;
+  var c = stan::math::make_op_vari(a.val() * a.val(), a.vi_, 2.0 * a.val());
+  var d = stan::math::make_op_vari(c.val() * b.val(), c.vi_, b.vi_, b.val(),
+                                   c.val());
+  d.grad();
+  EXPECT_FLOAT_EQ(12.0, d.val());
+  EXPECT_FLOAT_EQ(12.0, a.adj());
+  EXPECT_FLOAT_EQ(4.0, b.adj());
+  stan::math::recover_memory();
+}
@@ -0,0 +1,240 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+const stan::math::profile_region_stats& find_stats(
+    const std::vector<stan::math::profile_region_stats>& stats,
+    const std::string& path) {
+  for (const auto& s : stats) {
+    if (s.path_ == path) {
+      return s;
+    }
+  }
+  throw std::runtime_error("no region " + path);
+}
+}  // namespace
+
+TEST(Profiler, nested_regions) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof;
+  var lp = 0;
+  {
+    profile_region<var> outer("outer", prof);
+    var a = 2.0;
+    lp += a * a;
+    {
+      profile_region<var> inner("inner", prof);
+      lp += exp(a);
+    }
+    {
+      // same name nested is a separate region
+      profile_region<var> same("outer", prof);
+      lp += log(a);
+    }
+  }
+  {
+    profile_region<double> data("data", prof);
+  }
+  lp.grad();
+  stan::math::recover_memory();
+
+  auto stats = prof.stats();
+  ASSERT_EQ(4, stats.size());
+  const auto& outer = find_stats(stats, "outer");
+  const auto& inner = find_stats(stats, "outer/inner");
+  const auto& same = find_stats(stats, "outer/outer");
+  const auto& data = find_stats(stats, "data");
+  EXPECT_EQ(std::this_thread::get_id(), outer.thread_id_);
+  EXPECT_EQ(1, outer.n_fwd_passes_);
+  EXPECT_EQ(1, outer.n_rev_passes_);
+  EXPECT_EQ(1, inner.n_fwd_passes_);
+  EXPECT_EQ(1, inner.n_rev_passes_);
+  EXPECT_EQ(1, same.n_rev_passes_);
+  EXPECT_EQ(1, data.n_fwd_passes_);
+  EXPECT_EQ(0, data.n_rev_passes_);
+  EXPECT_GE(outer.fwd_time_, inner.fwd_time_ + same.fwd_time_);
+  EXPECT_GE(outer.rev_time_, inner.rev_time_ + same.rev_time_);
+  // inclusive counts: the inner regions' varis and callbacks are included
+  EXPECT_GT(outer.chain_stack_used_, inner.chain_stack_used_);
+  EXPECT_GT(inner.chain_stack_used_, 0);
+  EXPECT_GT(outer.arena_bytes_, inner.arena_bytes_);
+  EXPECT_EQ(0, data.chain_stack_used_);
+}
+
+TEST(Profiler, repeated_passes) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof;
+  for (int i = 0; i < 3; ++i) {
+    var x = 1.5;
+    var y;
+    {
+      profile_region<var> r("f", prof);
+      y = x * x * x;
+    }
+    y.grad();
+    stan::math::recover_memory();
+  }
+  auto stats = prof.stats();
+  ASSERT_EQ(1, stats.size());
+  EXPECT_EQ(3, stats[0].n_fwd_passes_);
+  EXPECT_EQ(3, stats[0].n_rev_passes_);
+  EXPECT_EQ(6, stats[0].chain_stack_used_);
+  EXPECT_GT(stats[0].fwd_time_min_, 0);
+  EXPECT_LE(stats[0].fwd_time_min_, stats[0].fwd_time_max_);
+  EXPECT_LE(3 * stats[0].fwd_time_min_, stats[0].fwd_time_);
+  EXPECT_GE(3 * stats[0].fwd_time_max_, stats[0].fwd_time_);
+  EXPECT_LE(stats[0].rev_time_min_, stats[0].rev_time_max_);
+  EXPECT_TRUE(stats[0].vari_counts_.empty());
+
+  prof.clear();
+  EXPECT_TRUE(prof.stats().empty());
+}
+
+TEST(Profiler, vari_counts) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof(true);
+  EXPECT_TRUE(prof.count_vari_types());
+  var x = 1.5;
+  var y;
+  {
+    profile_region<var> r("f", prof);
+    y = exp(x) + exp(x * x);
+  }
+  auto stats = prof.stats();
+  ASSERT_EQ(1, stats.size());
+  size_t total = 0;
+  for (const auto& count : stats[0].vari_counts_) {
+    EXPECT_FALSE(count.first.empty());
+    total += count.second;
+  }
+  EXPECT_EQ(stats[0].chain_stack_used_ + stats[0].nochain_stack_used_,
+            total);
+  stan::math::recover_memory();
+}
+
+TEST(Profiler, exception) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof;
+  try {
+    profile_region<var> r("throws", prof);
+    throw std::domain_error("error");
+  } catch (const std::domain_error&) {
+  }
+  {
+    profile_region<var> r("after", prof);
+  }
+  auto stats = prof.stats();
+  ASSERT_EQ(2, stats.size());
+  EXPECT_EQ("after", stats[0].path_);
+  EXPECT_EQ("throws", stats[1].path_);
+  stan::math::recover_memory();
+}
+
+TEST(Profiler, threads) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof;
+  auto work = [&prof]() {
+    profile_region<double> r("work", prof);
+    profile_region<double> s("step", prof);
+  };
+  std::thread t1(work);
+  std::thread t2(work);
+  t1.join();
+  t2.join();
+  auto stats = prof.stats();
+  ASSERT_EQ(4, stats.size());
+  EXPECT_NE(stats[0].thread_id_, stats[2].thread_id_);
+  EXPECT_EQ("work", stats[0].path_);
+  EXPECT_EQ("work/step", stats[1].path_);
+}
+
+TEST(Profiler, traces) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof;
+  var lp;
+  {
+    profile_region<var> outer("model \"a\"", prof);
+    var a = 2.0;
+    {
+      profile_region<var> inner("inner", prof);
+      lp = a * a;
+    }
+  }
+  lp.grad();
+  stan::math::recover_memory();
+
+  std::stringstream trace;
+  prof.write_chrome_trace(trace);
+  const std::string t = trace.str();
+  EXPECT_EQ(0, t.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, t.find("\"name\":\"model \\\"a\\\"\""));
+  EXPECT_NE(std::string::npos, t.find("\"cat\":\"reverse\""));
+  EXPECT_NE(std::string::npos, t.find("\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, t.find("\"arena_bytes\":"));
+
+  std::stringstream folded;
+  prof.write_folded_stacks(folded);
+  const std::string f = folded.str();
+  EXPECT_NE(std::string::npos, f.find("forward;model \"a\";inner "));
+  EXPECT_NE(std::string::npos, f.find("reverse;model \"a\";inner "));
+  EXPECT_NE(std::string::npos, f.find("forward;model \"a\" "));
+}
+
+TEST(Profiler, bounded_memory) {
+  using stan::math::profile_region;
+  using stan::math::var;
+  stan::math::profiler prof(false, 16);
+  EXPECT_EQ(16, prof.trace_capacity());
+  auto& buffer = prof.thread_buffer();
+  auto evaluate = [&prof]() {
+    var x = 1.5;
+    var y;
+    {
+      profile_region<var> outer("outer", prof);
+      profile_region<var> inner("inner", prof);
+      y = x * x;
+    }
+    y.grad();
+    stan::math::recover_memory();
+  };
+  for (int i = 0; i < 100; ++i) {
+    evaluate();
+  }
+  const size_t num_regions = buffer.regions_.size();
+  const size_t span_capacity = buffer.spans_.capacity();
+  for (int i = 0; i < 10000; ++i) {
+    evaluate();
+  }
+  EXPECT_EQ(num_regions, buffer.regions_.size());
+  EXPECT_EQ(span_capacity, buffer.spans_.capacity());
+  EXPECT_EQ(16, buffer.spans_.size());
+  EXPECT_TRUE(buffer.open_.empty());
+  EXPECT_TRUE(buffer.rev_open_.empty());
+
+  auto stats = prof.stats();
+  ASSERT_EQ(2, stats.size());
+  EXPECT_EQ(10100, stats[0].n_fwd_passes_);
+  EXPECT_EQ(10100, stats[0].n_rev_passes_);
+  EXPECT_EQ(10100, stats[1].n_fwd_passes_);
+
+  // the trace holds the 16 most recent passes
+  std::stringstream trace;
+  prof.write_chrome_trace(trace);
+  const std::string t = trace.str();
+  size_t num_spans = 0;
+  for (size_t pos = t.find("\"ph\""); pos != std::string::npos;
+       pos = t.find("\"ph\"", pos + 1)) {
+    ++num_spans;
+  }
+  EXPECT_EQ(16, num_spans);
+}
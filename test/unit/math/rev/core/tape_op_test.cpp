@@ -0,0 +1,134 @@
+#define STAN_OPCODE_TAPE
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(AgradRevTapeOp, records_scalar_ops) {
+  using stan::math::var;
+  stan::math::recover_memory();
+  var a = 2.0;
+  var b = 3.0;
+  auto& op_stack = stan::math::ChainableStack::instance_->op_stack_;
+  EXPECT_EQ(0, op_stack.size());
+  var ab = a * b;
+  EXPECT_EQ(1, op_stack.size());
+  EXPECT_EQ(stan::math::op_code::vv, op_stack[0].code_);
+  var f = ab + exp(a) - log(b) / a;
+  EXPECT_EQ(6, op_stack.size());
+
+  f.grad();
+  EXPECT_FLOAT_EQ(2.0 * 3.0 + std::exp(2.0) - std::log(3.0) / 2.0, f.val());
+  EXPECT_FLOAT_EQ(3.0 + std::exp(2.0) + std::log(3.0) / 4.0, a.adj());
+  EXPECT_FLOAT_EQ(2.0 - 1.0 / 6.0, b.adj());
+  stan::math::recover_memory();
+  EXPECT_EQ(0, op_stack.size());
+}
+
+TEST(AgradRevTapeOp, arithmetic_with_doubles) {
+  using stan::math::var;
+  var a = 2.0;
+  var f = -(3.0 * a + 1.0) / 4.0;
+  f = 5.0 / f - (2.0 - a * 2.0);
+  f *= a;
+  f /= 3.0;
+  f.grad();
+  const double g = -(3.0 * 2.0 + 1.0) / 4.0;
+  const double dg = -3.0 / 4.0;
+  const double h = 5.0 / g + 2.0;
+  const double dh = -5.0 / (g * g) * dg + 2.0;
+  EXPECT_FLOAT_EQ(h * 2.0 / 3.0, f.val());
+  EXPECT_FLOAT_EQ((dh * 2.0 + h) / 3.0, a.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeOp, records_branches_on_request) {
+  using stan::math::var;
+  auto& stack = *stan::math::ChainableStack::instance_;
+  var a = 2.0;
+  var b = 3.0;
+  EXPECT_TRUE(a < b);
+  EXPECT_EQ(0, stack.op_stack_.size());
+
+  stack.record_branches_ = true;
+  EXPECT_TRUE(a < b);
+  EXPECT_FALSE(3.0 <= a);
+  stack.record_branches_ = false;
+  ASSERT_EQ(2, stack.op_stack_.size());
+  EXPECT_EQ(stan::math::op_code::branch, stack.op_stack_[0].code_);
+  EXPECT_EQ(stan::math::op_fun::less, stack.op_stack_[0].fun_);
+  EXPECT_TRUE(stack.op_stack_[0].taken_);
+  // a constant first operand is recorded as the mirrored comparison
+  EXPECT_EQ(stan::math::op_fun::greater_equal, stack.op_stack_[1].fun_);
+  EXPECT_EQ(&a.vi_->adj_, stack.op_stack_[1].a_adj_);
+  EXPECT_EQ(nullptr, stack.op_stack_[1].b_adj_);
+  EXPECT_EQ(3.0, stack.op_stack_[1].db_);
+  EXPECT_FALSE(stack.op_stack_[1].taken_);
+
+  var f = a * b;
+  f.grad();
+  EXPECT_FLOAT_EQ(3.0, a.adj());
+  EXPECT_FLOAT_EQ(2.0, b.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeOp, interleaves_with_virtual_chain) {
+  using stan::math::var;
+  var a = 0.5;
+  // sin and pow are chained through the var stack, the rest through ops
+  var b = sin(a * a);
+  var c = exp(b) * pow(a, 3.0) + b;
+  c.grad();
+  const double db_da = std::cos(0.25) * 2 * 0.5;
+  const double expected = std::exp(std::sin(0.25)) * db_da * std::pow(0.5, 3)
+                          + std::exp(std::sin(0.25)) * 3 * std::pow(0.5, 2)
+                          + db_da;
+  EXPECT_FLOAT_EQ(expected, a.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeOp, nested_and_zero_adjoints) {
+  using stan::math::var;
+  var a = 2.0;
+  var outer = a * a;
+  {
+    stan::math::nested_rev_autodiff nested;
+    var b = exp(a) * a;
+    var c = b * 2.0;
+    c.grad();
+    EXPECT_FLOAT_EQ(std::exp(2.0) * 6.0, a.adj());
+    EXPECT_EQ(0, outer.adj());
+    nested.set_zero_all_adjoints();
+    EXPECT_EQ(0, b.adj());
+    EXPECT_EQ(0, c.adj());
+  }
+  EXPECT_EQ(1, stan::math::ChainableStack::instance_->op_stack_.size());
+  stan::math::set_zero_all_adjoints();
+  EXPECT_EQ(0, a.adj());
+  outer.grad();
+  EXPECT_FLOAT_EQ(4.0, a.adj());
+  stan::math::set_zero_all_adjoints();
+  EXPECT_EQ(0, a.adj());
+  EXPECT_EQ(0, outer.adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevTapeOp, gradient_functional) {
+  using stan::math::var;
+  Eigen::VectorXd x(3);
+  x << 1.0, 2.0, 3.0;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  stan::math::gradient(
+      [](const auto& v) {
+        var total = 0;
+        for (int i = 0; i < v.size(); ++i) {
+          total += v(i) * v(i) / (1.0 + exp(-v(i)));
+        }
+        return total;
+      },
+      x, fx, grad_fx);
+  for (int i = 0; i < 3; ++i) {
+    const double s = 1.0 / (1.0 + std::exp(-x(i)));
+    EXPECT_FLOAT_EQ(2 * x(i) * s + x(i) * x(i) * s * (1 - s), grad_fx(i));
+  }
+}
@@ -133,3 +133,64 @@ TEST(AgradRevMatrix, accumulator_check_varis_on_stack) {
   a.add(1);
   test::check_varis_on_stack(a.sum());
 }
+
+TEST(AgradRevMatrix, accumulator_collapse_gradient) {
+  using stan::math::accumulator;
+  using stan::math::var;
+
+  std::vector<var> x;
+  for (int i = 0; i < 5000; ++i)
+    x.push_back(i);
+
+  accumulator<var> a;
+  for (int i = 0; i < 5000; ++i) {
+    a.add(x[i] * 2.0);
+    a.add(0.5);
+  }
+  var s = a.sum();
+  EXPECT_FLOAT_EQ(5000.0 * 4999.0 + 2500.0, s.val());
+  s.grad();
+  for (int i = 0; i < 5000; ++i)
+    EXPECT_FLOAT_EQ(2.0, x[i].adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, accumulator_eigen_expression_gradient) {
+  using stan::math::accumulator;
+  using stan::math::var;
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x(4);
+  x << 1, 2, 3, 4;
+  accumulator<var> a;
+  a.add(stan::math::multiply(3.0, x));
+  a.add(x.head(2));
+  var s = a.sum();
+  EXPECT_FLOAT_EQ(33.0, s.val());
+  s.grad();
+  EXPECT_FLOAT_EQ(4.0, x(0).adj());
+  EXPECT_FLOAT_EQ(4.0, x(1).adj());
+  EXPECT_FLOAT_EQ(3.0, x(2).adj());
+  EXPECT_FLOAT_EQ(3.0, x(3).adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, accumulator_merge_gradient) {
+  using stan::math::accumulator;
+  using stan::math::var;
+
+  var x = 2.0;
+  var y = 3.0;
+  accumulator<var> a;
+  accumulator<var> b;
+  a.add(x);
+  a.add(1.0);
+  b.add(y * y);
+  b.add(2.0);
+  a.add(b);
+  var s = a.sum();
+  EXPECT_FLOAT_EQ(14.0, s.val());
+  s.grad();
+  EXPECT_FLOAT_EQ(1.0, x.adj());
+  EXPECT_FLOAT_EQ(6.0, y.adj());
+  stan::math::recover_memory();
+}
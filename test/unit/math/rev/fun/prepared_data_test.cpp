@@ -0,0 +1,90 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+template <typename F>
+void expect_prepared_gradients(const F& f, const Eigen::VectorXd& x) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_plain = x;
+  var lp_plain = f(x_plain, false);
+  lp_plain.grad();
+  double val_plain = lp_plain.val();
+  Eigen::VectorXd grad_plain = x_plain.adj();
+  stan::math::recover_memory();
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> x_prep = x;
+  var lp_prep = f(x_prep, true);
+  lp_prep.grad();
+  EXPECT_FLOAT_EQ(val_plain, lp_prep.val());
+  for (int i = 0; i < x.size(); ++i) {
+    EXPECT_FLOAT_EQ(grad_plain(i), x_prep.adj()(i));
+  }
+  stan::math::recover_memory();
+}
+}  // namespace
+
+TEST(AgradRev, prepared_data_normal_lpdf) {
+  Eigen::VectorXd y(4);
+  y << 1.5, -2.0, 3.25, 0.5;
+  auto y_prep = stan::math::prepare_data(y);
+  Eigen::VectorXd theta(2);
+  theta << 0.4, 1.3;
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::normal_lpdf(y_prep, x(0), x(1))
+                        : stan::math::normal_lpdf(y, x(0), x(1));
+      },
+      theta);
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::normal_lpdf<true>(y_prep, x(0), 2.0)
+                        : stan::math::normal_lpdf<true>(y, x(0), 2.0);
+      },
+      theta);
+}
+
+TEST(AgradRev, prepared_data_poisson_lpmf) {
+  std::vector<int> n{0, 3, 1, 7};
+  auto n_prep = stan::math::prepare_data(n);
+  Eigen::VectorXd lambda(4);
+  lambda << 2.5, 0.5, 1.0, 6.0;
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::poisson_lpmf(n_prep, x(0))
+                        : stan::math::poisson_lpmf(n, x(0));
+      },
+      lambda);
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::poisson_lpmf(n_prep, x)
+                        : stan::math::poisson_lpmf(n, x);
+      },
+      lambda);
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::poisson_lpmf<true>(n_prep, x)
+                        : stan::math::poisson_lpmf<true>(n, x);
+      },
+      lambda);
+}
+
+TEST(AgradRev, prepared_data_poisson_log_lpmf) {
+  std::vector<int> n{0, 3, 1, 7};
+  auto n_prep = stan::math::prepare_data(n);
+  Eigen::VectorXd alpha(4);
+  alpha << 0.9, -0.5, 0.0, 1.9;
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::poisson_log_lpmf(n_prep, x(0))
+                        : stan::math::poisson_log_lpmf(n, x(0));
+      },
+      alpha);
+  expect_prepared_gradients(
+      [&](const auto& x, bool prepared) {
+        return prepared ? stan::math::poisson_log_lpmf(n_prep, x)
+                        : stan::math::poisson_log_lpmf(n, x);
+      },
+      alpha);
+}
@@ -0,0 +1,341 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+using stan::math::var;
+using stan::math::var_value;
+using sparse_t = Eigen::SparseMatrix<double>;
+using dense_var_t = Eigen::Matrix<var, -1, -1>;
+
+// m x n matrix with a banded pattern plus one far off-diagonal entry
+sparse_t make_sparse(int m, int n, double offset) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int j = 0; j < n; ++j) {
+    for (int i = std::max(0, j - 1); i < std::min(m, j + 2); ++i) {
+      triplets.emplace_back(i, j, offset + 0.5 * i - 0.25 * j);
+    }
+  }
+  triplets.emplace_back(m - 1, 0, offset + 2.0);
+  sparse_t x(m, n);
+  x.setFromTriplets(triplets.begin(), triplets.end());
+  x.makeCompressed();
+  return x;
+}
+
+// symmetric, positive definite precision matrix on an n x n grid
+sparse_t grid_precision(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n * n; ++i) {
+    triplets.emplace_back(i, i, 4.5 + 0.1 * (i % n));
+    if (i % n + 1 < n) {
+      triplets.emplace_back(i, i + 1, -0.5);
+      triplets.emplace_back(i + 1, i, -0.5);
+    }
+    if (i + n < n * n) {
+      triplets.emplace_back(i, i + n, -1.0);
+      triplets.emplace_back(i + n, i, -1.0);
+    }
+  }
+  sparse_t x(n * n, n * n);
+  x.setFromTriplets(triplets.begin(), triplets.end());
+  x.makeCompressed();
+  return x;
+}
+
+dense_var_t to_dense_var(const sparse_t& x) {
+  return Eigen::MatrixXd(x).cast<var>();
+}
+
+// the gradients of the sparse and the dense version are taken in one
+// reverse pass of their sum, as their operands are distinct
+
+// the adjoint of the sparse variable keeps its pattern and matches the
+// gradient of the same function of a dense matrix on the nonzeros
+void expect_sparse_adj(const var_value<sparse_t>& x, const dense_var_t& y) {
+  EXPECT_EQ(x.val().nonZeros(), x.adj().nonZeros());
+  for (int k = 0; k < x.adj().outerSize(); ++k) {
+    for (sparse_t::InnerIterator it(x.adj(), k); it; ++it) {
+      EXPECT_FLOAT_EQ(y(it.row(), it.col()).adj(), it.value())
+          << "(" << it.row() << ", " << it.col() << ")";
+    }
+  }
+}
+
+void expect_dense_adj(const dense_var_t& x, const dense_var_t& y) {
+  for (int j = 0; j < x.cols(); ++j) {
+    for (int i = 0; i < x.rows(); ++i) {
+      EXPECT_FLOAT_EQ(y(i, j).adj(), x(i, j).adj());
+    }
+  }
+}
+}  // namespace
+
+TEST(AgradRevSparse, dot_self) {
+  sparse_t a = make_sparse(5, 4, 1.0);
+  var_value<sparse_t> a_v(a);
+  dense_var_t a_d = to_dense_var(a);
+
+  var lp = stan::math::dot_self(a_v);
+  var lp_d = stan::math::sum(stan::math::square(a_d));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(a_v, a_d);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, multiply_sparse_dense) {
+  sparse_t a = make_sparse(6, 4, 1.0);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(4, 3);
+  var_value<sparse_t> a_v(a);
+  dense_var_t b_v = b.cast<var>();
+  dense_var_t a_d = to_dense_var(a);
+  dense_var_t b_d = b.cast<var>();
+
+  var lp = stan::math::sum(stan::math::square(stan::math::multiply(a_v, b_v)));
+  var lp_d
+      = stan::math::sum(stan::math::square(stan::math::multiply(a_d, b_d)));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(a_v, a_d);
+  expect_dense_adj(b_v, b_d);
+  stan::math::recover_memory();
+
+  // constant sparse matrix and a vector variable
+  var_value<Eigen::VectorXd> c_v(b.col(0));
+  Eigen::Matrix<var, -1, 1> c_d = b.col(0).cast<var>();
+  var_value<Eigen::VectorXd> res = stan::math::multiply(a, c_v);
+  EXPECT_TRUE((Eigen::VectorXd(a * b.col(0))).isApprox(res.val()));
+  lp = stan::math::dot_self(res);
+  lp_d = stan::math::dot_self(stan::math::multiply(Eigen::MatrixXd(a), c_d));
+  (lp + lp_d).grad();
+  for (int i = 0; i < c_d.size(); ++i) {
+    EXPECT_FLOAT_EQ(c_d(i).adj(), c_v.adj()(i));
+  }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, multiply_dense_sparse) {
+  sparse_t b = make_sparse(4, 5, -1.0);
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(3, 4);
+  var_value<sparse_t> b_v(b);
+  dense_var_t a_v = a.cast<var>();
+  dense_var_t a_d = a.cast<var>();
+  dense_var_t b_d = to_dense_var(b);
+
+  var lp = stan::math::sum(stan::math::square(stan::math::multiply(a_v, b_v)));
+  var lp_d
+      = stan::math::sum(stan::math::square(stan::math::multiply(a_d, b_d)));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(b_v, b_d);
+  expect_dense_adj(a_v, a_d);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, multiply_sparse_sparse) {
+  sparse_t a = make_sparse(5, 4, 1.0);
+  sparse_t b = make_sparse(4, 6, 0.5);
+  var_value<sparse_t> a_v(a);
+  var_value<sparse_t> b_v(b);
+  dense_var_t a_d = to_dense_var(a);
+  dense_var_t b_d = to_dense_var(b);
+
+  var_value<sparse_t> res = stan::math::multiply(a_v, b_v);
+  EXPECT_TRUE(Eigen::MatrixXd(a * b).isApprox(Eigen::MatrixXd(res.val())));
+  var lp = stan::math::dot_self(res);
+  var lp_d
+      = stan::math::sum(stan::math::square(stan::math::multiply(a_d, b_d)));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(a_v, a_d);
+  expect_sparse_adj(b_v, b_d);
+  stan::math::recover_memory();
+
+  // a constant operand
+  var_value<sparse_t> c_v(a);
+  dense_var_t c_d = to_dense_var(a);
+  lp = stan::math::dot_self(stan::math::multiply(c_v, b));
+  lp_d = stan::math::sum(
+      stan::math::square(stan::math::multiply(c_d, Eigen::MatrixXd(b))));
+  (lp + lp_d).grad();
+  expect_sparse_adj(c_v, c_d);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, transpose) {
+  sparse_t a = make_sparse(5, 3, 1.0);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(5, 2);
+  var_value<sparse_t> a_v(a);
+  dense_var_t a_d = to_dense_var(a);
+
+  var_value<sparse_t> a_t = stan::math::transpose(a_v);
+  EXPECT_EQ(3, a_t.rows());
+  EXPECT_EQ(5, a_t.cols());
+  EXPECT_EQ(a.nonZeros(), a_t.val().nonZeros());
+  var lp = stan::math::sum(stan::math::multiply(a_t, b));
+  var lp_d = stan::math::sum(
+      stan::math::multiply(stan::math::transpose(a_d), b.cast<var>()));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(a_v, a_d);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, add) {
+  sparse_t a = make_sparse(5, 5, 1.0);
+  sparse_t b(5, 5);
+  b.insert(0, 4) = 3.0;
+  b.insert(2, 2) = -1.0;
+  b.makeCompressed();
+  var_value<sparse_t> a_v(a);
+  var_value<sparse_t> b_v(b);
+  dense_var_t a_d = to_dense_var(a);
+  dense_var_t b_d = to_dense_var(b);
+
+  var_value<sparse_t> res = a_v + b_v;
+  EXPECT_TRUE(Eigen::MatrixXd(a + b).isApprox(Eigen::MatrixXd(res.val())));
+  var lp = stan::math::dot_self(res);
+  var lp_d = stan::math::sum(stan::math::square(stan::math::add(a_d, b_d)));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(a_v, a_d);
+  expect_sparse_adj(b_v, b_d);
+  stan::math::recover_memory();
+
+  var_value<sparse_t> c_v(a);
+  dense_var_t c_d = to_dense_var(a);
+  lp = stan::math::dot_self(stan::math::add(b, c_v));
+  lp_d = stan::math::sum(
+      stan::math::square(stan::math::add(Eigen::MatrixXd(b), c_d)));
+  (lp + lp_d).grad();
+  expect_sparse_adj(c_v, c_d);
+  stan::math::recover_memory();
+
+  EXPECT_THROW(stan::math::add(a_v, sparse_t(4, 5)), std::invalid_argument);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, quad_form_vector) {
+  sparse_t a = make_sparse(5, 5, 1.0);
+  Eigen::VectorXd b = Eigen::VectorXd::Random(5);
+  var_value<sparse_t> a_v(a);
+  Eigen::Matrix<var, -1, 1> b_v = b.cast<var>();
+  dense_var_t a_d = to_dense_var(a);
+  Eigen::Matrix<var, -1, 1> b_d = b.cast<var>();
+
+  var lp = stan::math::quad_form(a_v, b_v);
+  var lp_d = stan::math::quad_form(a_d, b_d);
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(a_v, a_d);
+  for (int i = 0; i < b.size(); ++i) {
+    EXPECT_FLOAT_EQ(b_d(i).adj(), b_v(i).adj());
+  }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, quad_form_matrix) {
+  sparse_t a = make_sparse(5, 5, 1.0);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(5, 3);
+  Eigen::MatrixXd w = Eigen::MatrixXd::Random(3, 3);
+  for (bool symmetric : {false, true}) {
+    var_value<sparse_t> a_v(a);
+    var_value<Eigen::MatrixXd> b_v(b);
+    dense_var_t a_d = to_dense_var(a);
+    dense_var_t b_d = b.cast<var>();
+
+    var_value<Eigen::MatrixXd> res = stan::math::quad_form(a_v, b_v, symmetric);
+    dense_var_t res_d = stan::math::multiply(stan::math::transpose(b_d),
+                                             stan::math::multiply(a_d, b_d));
+    if (symmetric) {
+      res_d = (0.5 * (res_d + res_d.transpose())).eval();
+    }
+    var lp = stan::math::sum(stan::math::elt_multiply(res, w));
+    var lp_d = stan::math::sum(stan::math::elt_multiply(res_d, w));
+    EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+    (lp + lp_d).grad();
+    expect_sparse_adj(a_v, a_d);
+    for (int j = 0; j < b.cols(); ++j) {
+      for (int i = 0; i < b.rows(); ++i) {
+        EXPECT_FLOAT_EQ(b_d(i, j).adj(), b_v.adj()(i, j));
+      }
+    }
+    stan::math::recover_memory();
+  }
+
+  var_value<sparse_t> c_v(make_sparse(5, 4, 1.0));
+  EXPECT_THROW(stan::math::quad_form(c_v, b), std::invalid_argument);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, cholesky_decompose) {
+  sparse_t q = grid_precision(4);
+  Eigen::VectorXd b = Eigen::VectorXd::Random(16);
+  var_value<sparse_t> q_v(q);
+  dense_var_t q_d = to_dense_var(q);
+
+  var_value<sparse_t> L = stan::math::cholesky_decompose(q_v);
+  dense_var_t L_d = stan::math::cholesky_decompose(q_d);
+  EXPECT_TRUE(stan::math::value_of(L_d).isApprox(Eigen::MatrixXd(L.val())));
+  var lp = stan::math::dot_self(stan::math::multiply(L, b));
+  var lp_d = stan::math::dot_self(stan::math::multiply(L_d, b));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(q_v, q_d);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, log_determinant_spd) {
+  sparse_t q = grid_precision(5);
+  var_value<sparse_t> q_v(q);
+  dense_var_t q_d = to_dense_var(q);
+
+  var lp = stan::math::log_determinant_spd(q_v);
+  var lp_d = stan::math::log_determinant_spd(q_d);
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(q_v, q_d);
+  stan::math::recover_memory();
+
+  sparse_t asymmetric = q;
+  asymmetric.coeffRef(1, 0) = 2;
+  EXPECT_THROW(stan::math::log_determinant_spd(var_value<sparse_t>(asymmetric)),
+               std::domain_error);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, mdivide_left_spd) {
+  sparse_t q = grid_precision(4);
+  Eigen::MatrixXd b = Eigen::MatrixXd::Random(16, 2);
+  Eigen::MatrixXd w = Eigen::MatrixXd::Random(16, 2);
+  var_value<sparse_t> q_v(q);
+  dense_var_t b_v = b.cast<var>();
+  dense_var_t q_d = to_dense_var(q);
+  dense_var_t b_d = b.cast<var>();
+
+  var_value<Eigen::MatrixXd> x = stan::math::mdivide_left_spd(q_v, b_v);
+  dense_var_t x_d = stan::math::mdivide_left_spd(q_d, b_d);
+  var lp = stan::math::sum(stan::math::elt_multiply(x, w));
+  var lp_d = stan::math::sum(stan::math::elt_multiply(x_d, w));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  expect_sparse_adj(q_v, q_d);
+  expect_dense_adj(b_v, b_d);
+  stan::math::recover_memory();
+
+  // constant sparse matrix and a vector variable
+  var_value<Eigen::VectorXd> c_v(b.col(0));
+  Eigen::Matrix<var, -1, 1> c_d = b.col(0).cast<var>();
+  lp = stan::math::dot_self(stan::math::mdivide_left_spd(q, c_v));
+  lp_d = stan::math::dot_self(
+      stan::math::mdivide_left_spd(Eigen::MatrixXd(q), c_d));
+  EXPECT_FLOAT_EQ(lp_d.val(), lp.val());
+  (lp + lp_d).grad();
+  for (int i = 0; i < c_d.size(); ++i) {
+    EXPECT_FLOAT_EQ(c_d(i).adj(), c_v.adj()(i));
+  }
+  stan::math::recover_memory();
+}
+
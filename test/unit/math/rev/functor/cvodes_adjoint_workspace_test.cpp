@@ -0,0 +1,237 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// one compartment model with first order absorption, rates theta[0] and
+// theta[1]
+struct pk_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(2);
+    dy << -theta[0] * y(0), theta[0] * y(0) - theta[1] * y(1);
+    return dy;
+  }
+};
+
+struct decay_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    return -theta[0] * y;
+  }
+};
+
+// the states at ten times followed by the gradient of their sum with
+// respect to the initial state and the parameters
+template <typename Solve>
+std::vector<double> solve_grad(const Solve& solve, double ka = 1.0) {
+  using stan::math::var;
+  Eigen::Matrix<var, -1, 1> y0(2);
+  y0 << 100.0, 0.0;
+  std::vector<var> theta{ka, 0.2};
+  std::vector<Eigen::Matrix<var, -1, 1>> ys = solve(y0, theta);
+  std::vector<double> result;
+  var lp = 0;
+  for (const auto& y : ys) {
+    result.push_back(y(0).val());
+    result.push_back(y(1).val());
+    lp += stan::math::sum(y);
+  }
+  lp.grad();
+  result.push_back(y0(0).adj());
+  result.push_back(y0(1).adj());
+  result.push_back(theta[0].adj());
+  result.push_back(theta[1].adj());
+  stan::math::recover_memory();
+  return result;
+}
+
+void expect_near_rel(const std::vector<double>& expected,
+                     const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i],
+                1e-6 * std::max(1.0, std::abs(expected[i])))
+        << "index " << i;
+  }
+}
+
+struct adjoint_solve {
+  std::shared_ptr<stan::math::cvodes_adjoint_workspace> workspace_;
+
+  template <typename T_y0, typename T_theta>
+  auto operator()(const T_y0& y0, const T_theta& theta) const {
+    std::vector<double> ts;
+    for (int i = 1; i <= 10; ++i) {
+      ts.push_back(i);
+    }
+    const Eigen::VectorXd atol = Eigen::VectorXd::Constant(2, 1e-10);
+    if (workspace_ == nullptr) {
+      return stan::math::ode_adjoint_tol_ctl(
+          pk_rhs(), y0, 0.0, ts, 1e-10, atol, 1e-10, atol, 1e-10, 1e-10, 10000,
+          10, CV_HERMITE, CV_BDF, CV_BDF, nullptr, theta);
+    }
+    return stan::math::ode_adjoint_tol_ctl(
+        pk_rhs(), y0, 0.0, ts, 1e-10, atol, 1e-10, atol, 1e-10, 1e-10, 10000,
+        10, CV_HERMITE, CV_BDF, CV_BDF, stan::math::sundials_linear_solver(),
+        workspace_, nullptr, theta);
+  }
+};
+
+}  // namespace
+
+TEST(cvodes_adjoint_workspace, reused_across_calls) {
+  const std::vector<double> expected = solve_grad(adjoint_solve{nullptr});
+
+  auto workspace = std::make_shared<stan::math::cvodes_adjoint_workspace>();
+  for (int rep = 0; rep < 3; ++rep) {
+    expect_near_rel(expected, solve_grad(adjoint_solve{workspace}));
+  }
+  EXPECT_EQ(3, workspace->num_solves());
+  EXPECT_EQ(1, workspace->num_allocations());
+  EXPECT_EQ(0, workspace->num_recomputations());
+  EXPECT_GT(workspace->num_forward_steps(), 0);
+  EXPECT_GT(workspace->num_backward_steps(), 0);
+  EXPECT_GT(workspace->num_checkpoints(), 3);
+  EXPECT_GT(workspace->num_jacobian_evaluations(), 0);
+
+  // a different problem needs new memory
+  std::vector<stan::math::var> theta{1.0, 0.2};
+  Eigen::VectorXd y0 = Eigen::VectorXd::Ones(3);
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(3, 1e-10);
+  stan::math::ode_adjoint_tol_ctl(
+      decay_rhs(), y0, 0.0, std::vector<double>{1.0}, 1e-8, atol, 1e-8, atol,
+      1e-8, 1e-8, 10000, 10, CV_HERMITE, CV_BDF, CV_BDF,
+      stan::math::sundials_linear_solver(), workspace, nullptr, theta);
+  EXPECT_EQ(2, workspace->num_allocations());
+  stan::math::recover_memory();
+}
+
+TEST(cvodes_adjoint_workspace, checkpoint_memory_budget) {
+  const std::vector<double> expected = solve_grad(adjoint_solve{nullptr});
+
+  // room for one checkpoint per output interval
+  auto large_budget
+      = std::make_shared<stan::math::cvodes_adjoint_workspace>(4000);
+  expect_near_rel(expected, solve_grad(adjoint_solve{large_budget}));
+  EXPECT_EQ(10, large_budget->num_recomputations());
+
+  // room for 7 checkpoints, which splits the output intervals
+  auto small_budget
+      = std::make_shared<stan::math::cvodes_adjoint_workspace>(1200);
+  expect_near_rel(expected, solve_grad(adjoint_solve{small_budget}));
+  EXPECT_GT(small_budget->num_recomputations(), 10);
+  EXPECT_GT(small_budget->num_forward_steps(),
+            large_budget->num_forward_steps());
+
+  // each split segment restarts from the state at its start rather than
+  // from the output time, so splitting adds segments but no steps per
+  // segment
+  auto unbudgeted = std::make_shared<stan::math::cvodes_adjoint_workspace>();
+  solve_grad(adjoint_solve{unbudgeted});
+  const double forward_steps = unbudgeted->num_forward_steps();
+  EXPECT_LT((small_budget->num_forward_steps() - forward_steps)
+                / small_budget->num_recomputations(),
+            (large_budget->num_forward_steps() - forward_steps)
+                / large_budget->num_recomputations());
+}
+
+TEST(cvodes_adjoint_workspace, owned_by_solves_until_reverse_pass) {
+  const std::vector<double> expected = solve_grad(adjoint_solve{nullptr});
+
+  // the caller drops its workspace before the reverse pass, which
+  // recomputes the checkpoints in the workspace kept alive by the solve
+  auto workspace
+      = std::make_shared<stan::math::cvodes_adjoint_workspace>(1200);
+  std::weak_ptr<stan::math::cvodes_adjoint_workspace> observer = workspace;
+  adjoint_solve solve{workspace};
+  workspace.reset();
+  auto solve_and_drop = [&solve](const auto& y0, const auto& theta) {
+    auto ys = solve(y0, theta);
+    solve.workspace_.reset();
+    return ys;
+  };
+  expect_near_rel(expected, solve_grad(solve_and_drop));
+  EXPECT_TRUE(observer.expired());
+}
+
+TEST(cvodes_adjoint_workspace, shared_by_solves_of_one_reverse_pass) {
+  using stan::math::var;
+  auto workspace = std::make_shared<stan::math::cvodes_adjoint_workspace>();
+  adjoint_solve shared{workspace};
+  adjoint_solve separate{nullptr};
+
+  // the second solve replaces the checkpoints of the first one, which the
+  // reverse pass then recomputes
+  auto solve_twice = [](const adjoint_solve& solve) {
+    return [&solve](const auto& y0, const auto& theta) {
+      auto ys = solve(y0, theta);
+      std::vector<var> theta_twice{theta[0] * 2.0, theta[1]};
+      auto ys_twice = solve(y0, theta_twice);
+      ys.insert(ys.end(), ys_twice.begin(), ys_twice.end());
+      return ys;
+    };
+  };
+  expect_near_rel(solve_grad(solve_twice(separate)),
+                  solve_grad(solve_twice(shared)));
+  EXPECT_EQ(2, workspace->num_solves());
+  EXPECT_EQ(1, workspace->num_allocations());
+  EXPECT_EQ(10, workspace->num_recomputations());
+}
+
+TEST(cvodes_adjoint_workspace, shared_by_solves_of_different_sizes) {
+  using stan::math::var;
+  // the solve of the three state system replaces the memory of the two
+  // state system, which the reverse pass then prepares again
+  auto solve_both
+      = [](std::shared_ptr<stan::math::cvodes_adjoint_workspace> workspace) {
+          Eigen::Matrix<var, -1, 1> y0(2);
+          y0 << 100.0, 0.0;
+          std::vector<var> theta{1.0, 0.2};
+          Eigen::Matrix<var, -1, 1> z0 = Eigen::VectorXd::Ones(3);
+          std::vector<var> rate{0.5};
+          auto ys = adjoint_solve{workspace}(y0, theta);
+          const Eigen::VectorXd atol = Eigen::VectorXd::Constant(3, 1e-10);
+          const std::vector<double> ts{1.0, 2.0};
+          auto zs = workspace == nullptr
+                        ? stan::math::ode_adjoint_tol_ctl(
+                            decay_rhs(), z0, 0.0, ts, 1e-10, atol, 1e-10,
+                            atol, 1e-10, 1e-10, 10000, 10, CV_HERMITE, CV_BDF,
+                            CV_BDF, nullptr, rate)
+                        : stan::math::ode_adjoint_tol_ctl(
+                            decay_rhs(), z0, 0.0, ts, 1e-10, atol, 1e-10,
+                            atol, 1e-10, 1e-10, 10000, 10, CV_HERMITE, CV_BDF,
+                            CV_BDF, stan::math::sundials_linear_solver(),
+                            workspace, nullptr, rate);
+          var lp = stan::math::sum(ys.back()) + stan::math::sum(zs.back());
+          lp.grad();
+          std::vector<double> result{lp.val(), y0(0).adj(), y0(1).adj(),
+                                     theta[0].adj(), theta[1].adj()};
+          for (int k = 0; k < z0.size(); ++k) {
+            result.push_back(z0(k).adj());
+          }
+          result.push_back(rate[0].adj());
+          stan::math::recover_memory();
+          return result;
+        };
+
+  auto workspace = std::make_shared<stan::math::cvodes_adjoint_workspace>();
+  expect_near_rel(solve_both(nullptr), solve_both(workspace));
+  EXPECT_EQ(2, workspace->num_solves());
+  EXPECT_EQ(3, workspace->num_allocations());
+  EXPECT_EQ(10, workspace->num_recomputations());
+}
+
+TEST(cvodes_adjoint_workspace, errors) {
+  auto workspace
+      = std::make_shared<stan::math::cvodes_adjoint_workspace>(100);
+  EXPECT_THROW(solve_grad(adjoint_solve{workspace}), std::invalid_argument);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,80 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// chain of first order reactions with a rate per state
+struct chain_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int N = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(N);
+    for (int i = 0; i < N; ++i) {
+      dy(i) = -theta[i] * y(i);
+      if (i > 0) {
+        dy(i) += theta[i - 1] * y(i - 1);
+      }
+    }
+    return dy;
+  }
+};
+
+}  // namespace
+
+TEST(cvodes_integrator_adjoint, quad_rhs_adj_overwrites_qBdot) {
+  using stan::math::var;
+  using integrator_vari = stan::math::cvodes_integrator_adjoint_vari<
+      chain_rhs, Eigen::VectorXd, double, double, std::vector<var>>;
+  const int N = 4;
+  std::vector<var> theta{1.2, 0.7, 0.4, 0.9};
+  Eigen::VectorXd y0 = Eigen::VectorXd::Zero(N);
+  y0(0) = 10.0;
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(N, 1e-8);
+  stan::math::ode_adjoint_tol_ctl(chain_rhs(), y0, 0.0,
+                                  std::vector<double>{1.0}, 1e-8, atol, 1e-8,
+                                  atol, 1e-8, 1e-8, 10000, 150, CV_HERMITE,
+                                  CV_BDF, CV_BDF, nullptr, theta);
+  integrator_vari* solve = nullptr;
+  for (auto* vi : stan::math::ChainableStack::instance_->var_stack_) {
+    if (auto* found = dynamic_cast<integrator_vari*>(vi)) {
+      solve = found;
+    }
+  }
+  ASSERT_NE(nullptr, solve);
+
+  N_Vector y = N_VNew_Serial(N);
+  N_Vector yB = N_VNew_Serial(N);
+  N_Vector qBdot = N_VNew_Serial(N);
+  const Eigen::VectorXd y_val = Eigen::VectorXd::LinSpaced(N, 1.0, 4.0);
+  Eigen::VectorXd yB_val(N);
+  yB_val << 0.5, -1.0, 2.0, 0.25;
+  Eigen::Map<Eigen::VectorXd>(NV_DATA_S(y), N) = y_val;
+  Eigen::Map<Eigen::VectorXd>(NV_DATA_S(yB), N) = yB_val;
+
+  // -yB' * df/dtheta, where rate k takes y(k) from state k to state k + 1
+  Eigen::VectorXd expected(N);
+  for (int k = 0; k < N; ++k) {
+    expected(k) = yB_val(k) * y_val(k)
+                  - (k + 1 < N ? yB_val(k + 1) * y_val(k) : 0.0);
+  }
+
+  // CVODES hands in work vectors holding earlier values, which must be
+  // overwritten rather than added to
+  N_VConst(std::numeric_limits<double>::quiet_NaN(), qBdot);
+  for (int rep = 0; rep < 2; ++rep) {
+    EXPECT_EQ(0, integrator_vari::cv_quad_rhs_adj(0.5, y, yB, qBdot, solve));
+    for (int k = 0; k < N; ++k) {
+      EXPECT_FLOAT_EQ(expected(k), NV_DATA_S(qBdot)[k])
+          << "rate " << k << " in call " << rep;
+    }
+  }
+
+  N_VDestroy_Serial(y);
+  N_VDestroy_Serial(yB);
+  N_VDestroy_Serial(qBdot);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,117 @@
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+namespace {
+// sum_{i=start}^{end} normal_lpdf(y[i] | mu[i % 2], sigma)
+struct normal_terms {
+  const std::vector<double>& y_;
+  explicit normal_terms(const std::vector<double>& y) : y_(y) {}
+
+  template <typename T1, typename T2>
+  auto operator()(int start, int end, std::ostream* msgs,
+                  const Eigen::Matrix<T1, -1, 1>& mu, const T2& sigma) const {
+    stan::return_type_t<T1, T2> lp = 0;
+    for (int i = start; i <= end; ++i) {
+      lp += stan::math::normal_lpdf(y_[i], mu(i % 2), sigma);
+    }
+    return lp;
+  }
+};
+
+std::vector<double> make_data(int n) {
+  std::vector<double> y(n);
+  for (int i = 0; i < n; ++i) {
+    y[i] = std::sin(i) * 2.0;
+  }
+  return y;
+}
+}  // namespace
+
+TEST(RevFunctor, independent_sum_gradient) {
+  using stan::math::var;
+  std::vector<double> y = make_data(103);
+  normal_terms f(y);
+
+  for (int grainsize : {1, 7, 50, 103, 1000}) {
+    Eigen::Matrix<var, -1, 1> mu(2);
+    mu << 0.5, -0.3;
+    var sigma = 1.7;
+    var lp = stan::math::independent_sum(f, y.size(), grainsize, nullptr, mu,
+                                         sigma);
+    var lp_serial = f(0, y.size() - 1, nullptr, mu, sigma);
+    EXPECT_FLOAT_EQ(lp_serial.val(), lp.val());
+
+    std::vector<var> theta{mu(0), mu(1), sigma};
+    std::vector<double> g;
+    lp.grad(theta, g);
+    stan::math::set_zero_all_adjoints();
+    std::vector<double> g_serial;
+    lp_serial.grad(theta, g_serial);
+    ASSERT_EQ(g_serial.size(), g.size());
+    for (size_t i = 0; i < g.size(); ++i) {
+      EXPECT_FLOAT_EQ(g_serial[i], g[i]) << "grainsize " << grainsize;
+    }
+    stan::math::recover_memory();
+  }
+}
+
+TEST(RevFunctor, independent_sum_repeated_grad) {
+  using stan::math::var;
+  std::vector<double> y = make_data(20);
+  normal_terms f(y);
+  Eigen::Matrix<var, -1, 1> mu(2);
+  mu << 0.5, -0.3;
+  var sigma = 1.7;
+  var lp = stan::math::independent_sum(f, y.size(), 3, nullptr, mu, sigma);
+  var lp2 = 2.0 * lp;
+
+  lp2.grad();
+  const double g_sigma = sigma.adj();
+  EXPECT_NE(0.0, g_sigma);
+  stan::math::set_zero_all_adjoints();
+  lp2.grad();
+  EXPECT_FLOAT_EQ(g_sigma, sigma.adj());
+  stan::math::set_zero_all_adjoints();
+  lp.grad();
+  EXPECT_FLOAT_EQ(g_sigma / 2.0, sigma.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, independent_sum_data_and_nested) {
+  using stan::math::var;
+  std::vector<double> y = make_data(10);
+  normal_terms f(y);
+  Eigen::VectorXd mu_d(2);
+  mu_d << 0.5, -0.3;
+
+  var sigma = 1.2;
+  {
+    stan::math::nested_rev_autodiff nested;
+    var lp = stan::math::independent_sum(f, y.size(), 4, nullptr, mu_d, sigma);
+    EXPECT_FLOAT_EQ(f(0, y.size() - 1, nullptr, mu_d, 1.2), lp.val());
+    lp.grad();
+    EXPECT_NE(0.0, sigma.adj());
+  }
+  var lp = stan::math::independent_sum(f, 0, 4, nullptr, mu_d, sigma);
+  EXPECT_FLOAT_EQ(0.0, lp.val());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, independent_sum_errors) {
+  using stan::math::var;
+  std::vector<double> y = make_data(10);
+  normal_terms f(y);
+  Eigen::Matrix<var, -1, 1> mu(2);
+  mu << 0.5, -0.3;
+  var sigma = 1.2;
+  EXPECT_THROW(stan::math::independent_sum(f, 10, 0, nullptr, mu, sigma),
+               std::domain_error);
+  EXPECT_THROW(stan::math::independent_sum(f, -1, 1, nullptr, mu, sigma),
+               std::domain_error);
+  var bad_sigma = -1.0;
+  EXPECT_THROW(stan::math::independent_sum(f, 10, 3, nullptr, mu, bad_sigma),
+               std::domain_error);
+  stan::math::recover_memory();
+}
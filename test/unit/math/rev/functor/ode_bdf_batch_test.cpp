@@ -0,0 +1,257 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// one compartment model with first order absorption, rates theta[0] and
+// theta[1]
+struct pk_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(2);
+    dy << -theta[0] * y(0), theta[0] * y(0) - theta[1] * y(1);
+    return dy;
+  }
+};
+
+struct ode_batch_test : public ::testing::Test {
+  const size_t num_subjects = 5;
+  std::vector<Eigen::VectorXd> y0;
+  std::vector<double> t0;
+  std::vector<std::vector<double>> ts;
+  std::vector<std::vector<double>> theta;
+
+  void SetUp() {
+    for (size_t i = 0; i < num_subjects; ++i) {
+      Eigen::VectorXd y0_i(2);
+      y0_i << 100.0 + i, 0.0;
+      y0.push_back(y0_i);
+      t0.push_back(0.1 * i);
+      // subjects are observed at different times
+      std::vector<double> ts_i;
+      for (size_t n = 0; n < 3 + i; ++n) {
+        ts_i.push_back(t0[i] + 0.5 + n);
+      }
+      ts.push_back(ts_i);
+      theta.push_back({1.0 + 0.1 * i, 0.2 + 0.02 * i});
+    }
+  }
+
+  // values of the solutions of all subjects followed by the gradient of
+  // their sum with respect to the initial states, initial times, output
+  // times and parameters
+  template <typename Solve>
+  std::vector<double> solve_grad(const Solve& solve) {
+    using stan::math::var;
+    std::vector<Eigen::Matrix<var, -1, 1>> y0_v;
+    std::vector<var> t0_v;
+    std::vector<std::vector<var>> ts_v;
+    std::vector<std::vector<var>> theta_v;
+    for (size_t i = 0; i < num_subjects; ++i) {
+      y0_v.push_back(y0[i]);
+      t0_v.push_back(t0[i]);
+      ts_v.emplace_back(ts[i].begin(), ts[i].end());
+      theta_v.emplace_back(theta[i].begin(), theta[i].end());
+    }
+    std::vector<std::vector<Eigen::Matrix<var, -1, 1>>> ys
+        = solve(y0_v, t0_v, ts_v, theta_v);
+    std::vector<double> result;
+    var lp = 0;
+    for (const auto& ys_i : ys) {
+      for (const auto& y : ys_i) {
+        for (int k = 0; k < y.size(); ++k) {
+          result.push_back(y(k).val());
+        }
+        lp += stan::math::sum(y);
+      }
+    }
+    lp.grad();
+    for (size_t i = 0; i < num_subjects; ++i) {
+      for (int k = 0; k < y0_v[i].size(); ++k) {
+        result.push_back(y0_v[i](k).adj());
+      }
+      result.push_back(t0_v[i].adj());
+      for (const auto& t : ts_v[i]) {
+        result.push_back(t.adj());
+      }
+      for (const auto& p : theta_v[i]) {
+        result.push_back(p.adj());
+      }
+    }
+    stan::math::recover_memory();
+    return result;
+  }
+};
+
+void expect_near_rel(const std::vector<double>& expected,
+                     const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i],
+                1e-8 * std::max(1.0, std::abs(expected[i])))
+        << "index " << i;
+  }
+}
+
+}  // namespace
+
+TEST_F(ode_batch_test, bdf_matches_single_solves) {
+  auto batch = [](const auto& y0, const auto& t0, const auto& ts,
+                  const auto& theta) {
+    return stan::math::ode_bdf_batch_tol(pk_rhs(), y0, t0, ts, 1e-10, 1e-10,
+                                         10000, nullptr, theta);
+  };
+  auto single = [](const auto& y0, const auto& t0, const auto& ts,
+                   const auto& theta) {
+    std::vector<std::vector<Eigen::Matrix<stan::math::var, -1, 1>>> ys;
+    for (size_t i = 0; i < y0.size(); ++i) {
+      ys.push_back(stan::math::ode_bdf_tol(pk_rhs(), y0[i], t0[i], ts[i],
+                                           1e-10, 1e-10, 10000, nullptr,
+                                           theta[i]));
+    }
+    return ys;
+  };
+  expect_near_rel(solve_grad(single), solve_grad(batch));
+}
+
+TEST_F(ode_batch_test, adams_matches_single_solves) {
+  auto batch = [](const auto& y0, const auto& t0, const auto& ts,
+                  const auto& theta) {
+    return stan::math::ode_adams_batch(pk_rhs(), y0, t0, ts, nullptr, theta);
+  };
+  auto single = [](const auto& y0, const auto& t0, const auto& ts,
+                   const auto& theta) {
+    std::vector<std::vector<Eigen::Matrix<stan::math::var, -1, 1>>> ys;
+    for (size_t i = 0; i < y0.size(); ++i) {
+      ys.push_back(
+          stan::math::ode_adams(pk_rhs(), y0[i], t0[i], ts[i], nullptr,
+                                theta[i]));
+    }
+    return ys;
+  };
+  expect_near_rel(solve_grad(single), solve_grad(batch));
+}
+
+TEST_F(ode_batch_test, rk45_matches_single_solves) {
+  auto batch = [](const auto& y0, const auto& t0, const auto& ts,
+                  const auto& theta) {
+    return stan::math::ode_rk45_batch_tol(pk_rhs(), y0, t0, ts, 1e-8, 1e-8,
+                                          10000, nullptr, theta);
+  };
+  auto single = [](const auto& y0, const auto& t0, const auto& ts,
+                   const auto& theta) {
+    std::vector<std::vector<Eigen::Matrix<stan::math::var, -1, 1>>> ys;
+    for (size_t i = 0; i < y0.size(); ++i) {
+      ys.push_back(stan::math::ode_rk45_tol(pk_rhs(), y0[i], t0[i], ts[i],
+                                            1e-8, 1e-8, 10000, nullptr,
+                                            theta[i]));
+    }
+    return ys;
+  };
+  expect_near_rel(solve_grad(single), solve_grad(batch));
+
+  std::vector<std::vector<Eigen::VectorXd>> ys
+      = stan::math::ode_rk45_batch(pk_rhs(), y0, t0, ts, nullptr, theta);
+  ASSERT_EQ(num_subjects, ys.size());
+  for (size_t i = 0; i < num_subjects; ++i) {
+    std::vector<Eigen::VectorXd> ys_i = stan::math::ode_rk45(
+        pk_rhs(), y0[i], t0[i], ts[i], nullptr, theta[i]);
+    ASSERT_EQ(ys_i.size(), ys[i].size());
+    for (size_t n = 0; n < ys_i.size(); ++n) {
+      for (int k = 0; k < ys_i[n].size(); ++k) {
+        EXPECT_FLOAT_EQ(ys_i[n](k), ys[i][n](k));
+      }
+    }
+  }
+}
+
+TEST_F(ode_batch_test, data_only) {
+  std::vector<std::vector<Eigen::VectorXd>> ys
+      = stan::math::ode_bdf_batch(pk_rhs(), y0, t0, ts, nullptr, theta);
+  ASSERT_EQ(num_subjects, ys.size());
+  for (size_t i = 0; i < num_subjects; ++i) {
+    std::vector<Eigen::VectorXd> ys_i
+        = stan::math::ode_bdf(pk_rhs(), y0[i], t0[i], ts[i], nullptr, theta[i]);
+    ASSERT_EQ(ys_i.size(), ys[i].size());
+    for (size_t n = 0; n < ys_i.size(); ++n) {
+      for (int k = 0; k < ys_i[n].size(); ++k) {
+        EXPECT_NEAR(ys_i[n](k), ys[i][n](k), 1e-8);
+      }
+    }
+  }
+}
+
+TEST_F(ode_batch_test, parameters_only) {
+  using stan::math::var;
+  std::vector<std::vector<var>> theta_v;
+  for (const auto& theta_i : theta) {
+    theta_v.emplace_back(theta_i.begin(), theta_i.end());
+  }
+  auto ys = stan::math::ode_bdf_batch(pk_rhs(), y0, t0, ts, nullptr, theta_v);
+  ys[2][1](1).grad();
+  const std::vector<double> grad{theta_v[2][0].adj(), theta_v[2][1].adj()};
+  EXPECT_FLOAT_EQ(0.0, theta_v[1][0].adj());
+  stan::math::set_zero_all_adjoints();
+
+  auto y = stan::math::ode_bdf(pk_rhs(), y0[2], t0[2], ts[2], nullptr,
+                               theta_v[2]);
+  EXPECT_NEAR(y[1](1).val(), ys[2][1](1).val(), 1e-8);
+  y[1](1).grad();
+  EXPECT_NEAR(theta_v[2][0].adj(), grad[0], 1e-6);
+  EXPECT_NEAR(theta_v[2][1].adj(), grad[1], 1e-6);
+  stan::math::recover_memory();
+}
+
+TEST_F(ode_batch_test, errors) {
+  std::vector<double> t0_short(t0.begin(), t0.end() - 1);
+  EXPECT_THROW(
+      stan::math::ode_bdf_batch(pk_rhs(), y0, t0_short, ts, nullptr, theta),
+      std::invalid_argument);
+  std::vector<std::vector<double>> theta_short(theta.begin(), theta.end() - 1);
+  EXPECT_THROW(
+      stan::math::ode_bdf_batch(pk_rhs(), y0, t0, ts, nullptr, theta_short),
+      std::invalid_argument);
+
+  // errors of a single subject are those of ode_bdf
+  ts[3][1] = ts[3][0] - 0.1;
+  EXPECT_THROW(stan::math::ode_bdf_batch(pk_rhs(), y0, t0, ts, nullptr, theta),
+               std::domain_error);
+}
+
+TEST(cvodes_workspace, reused_for_systems_of_the_same_kind) {
+  using stan::math::var;
+  stan::math::cvodes_workspace workspace;
+  const std::vector<double> ts{1.0, 2.0};
+  Eigen::VectorXd y0(2);
+  y0 << 10.0, 0.0;
+  std::vector<var> theta{0.8, 0.3};
+  using integrator_t
+      = stan::math::cvodes_integrator<CV_BDF, pk_rhs, Eigen::VectorXd, double,
+                                      double, std::vector<var>>;
+
+  std::vector<double> values;
+  for (int rep = 0; rep < 3; ++rep) {
+    integrator_t integrator("test", pk_rhs(), y0, 0.0, ts, 1e-10, 1e-10, 1000,
+                            stan::math::sundials_linear_solver(), nullptr,
+                            theta);
+    auto y = integrator(workspace);
+    values.push_back(y[1](1).val());
+  }
+  EXPECT_EQ(3, workspace.num_solves());
+  EXPECT_EQ(1, workspace.num_allocations());
+  EXPECT_FLOAT_EQ(values[0], values[1]);
+  EXPECT_FLOAT_EQ(values[0], values[2]);
+
+  // a different linear solver needs new memory
+  integrator_t integrator("test", pk_rhs(), y0, 0.0, ts, 1e-10, 1e-10, 1000,
+                          stan::math::sundials_linear_solver::band(1, 1),
+                          nullptr, theta);
+  auto y = integrator(workspace);
+  EXPECT_EQ(2, workspace.num_allocations());
+  EXPECT_NEAR(values[0], y[1](1).val(), 1e-8);
+  stan::math::recover_memory();
+}
@@ -96,6 +96,21 @@ TEST(StanMathRev_reduce_sum, gradient) {
   stan::math::grad(poisson_lpdf_static.vi_);
   const double lambda_adj_static = lambda_v.adj();
   EXPECT_FLOAT_EQ(lambda_adj_static, lambda_ref_adj);
+
+  for (int i = 0; i < 3; ++i) {
+    var poisson_lpdf_auto = stan::math::reduce_sum_auto<count_lpdf<var>>(
+        data, get_new_msg(), vlambda_v, idata);
+    EXPECT_FLOAT_EQ(value_of(poisson_lpdf_auto), value_of(poisson_lpdf_ref));
+
+    stan::math::set_zero_all_adjoints();
+    stan::math::grad(poisson_lpdf_auto.vi_);
+    EXPECT_FLOAT_EQ(lambda_v.adj(), lambda_ref_adj);
+  }
+#ifdef STAN_THREADS
+  auto& tuner = stan::math::internal::reduce_sum_tuner<count_lpdf<var>>();
+  EXPECT_EQ(3, tuner.num_updates());
+  EXPECT_GT(tuner.overhead_per_chunk(), 0.0);
+#endif
   stan::math::recover_memory();
 }
 
@@ -431,3 +446,54 @@ TEST(StanMathRev_reduce_sum, linked_args) {
 
   stan::math::recover_memory();
 }
+
+// each term only depends on one element of a large shared vector
+struct sparse_shared_lpdf {
+  inline stan::math::var operator()(const std::vector<int>& sub_slice,
+                                    std::size_t start, std::size_t end,
+                                    std::ostream* msgs,
+                                    const std::vector<stan::math::var>& theta,
+                                    double scale) const {
+    stan::math::var lp = 0;
+    for (std::size_t i = start; i <= end; ++i) {
+      lp += scale * theta[sub_slice[i - start]] * (i + 1.0);
+    }
+    return lp;
+  }
+};
+
+TEST(StanMathRev_reduce_sum, sparse_shared_args) {
+  using stan::math::var;
+  using stan::math::test::get_new_msg;
+  const int num_theta = 1000;
+  const int num_terms = 200;
+  std::vector<int> index(num_terms);
+  for (int i = 0; i < num_terms; ++i) {
+    index[i] = (7 * i) % num_theta;
+  }
+
+  // repeated calls reuse the stacks of the shared argument copies
+  for (int call = 0; call < 3; ++call) {
+    for (bool deterministic : {false, true}) {
+      std::vector<var> theta;
+      for (int k = 0; k < num_theta; ++k) {
+        theta.emplace_back(1.0);
+      }
+      var lp = deterministic
+                   ? stan::math::reduce_sum_static<sparse_shared_lpdf>(
+                         index, 3, get_new_msg(), theta, 2.0)
+                   : stan::math::reduce_sum<sparse_shared_lpdf>(
+                         index, 3, get_new_msg(), theta, 2.0);
+      EXPECT_FLOAT_EQ(num_terms * (num_terms + 1.0), lp.val());
+      lp.grad();
+      std::vector<double> expected(num_theta, 0.0);
+      for (int i = 0; i < num_terms; ++i) {
+        expected[index[i]] += 2.0 * (i + 1.0);
+      }
+      for (int k = 0; k < num_theta; ++k) {
+        EXPECT_FLOAT_EQ(expected[k], theta[k].adj()) << k;
+      }
+      stan::math::recover_memory();
+    }
+  }
+}
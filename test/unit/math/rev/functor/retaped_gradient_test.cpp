@@ -0,0 +1,249 @@
+#define STAN_OPCODE_TAPE
+#include <stan/math/rev.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using Eigen::VectorXd;
+
+namespace {
+// f(x) = sum(exp(x) .* x) + x(0) * x(1)
+struct fixed_shape_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    T lp = x(0) * x(1);
+    for (int i = 0; i < x.size(); ++i) {
+      lp += stan::math::exp(x(i)) * x(i);
+    }
+    return lp;
+  }
+};
+
+// the number of operations depends on the sign of x(0)
+struct branching_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    if (x(0) > 0) {
+      return stan::math::log(x(0)) * x(1);
+    }
+    return x(0) * x(1);
+  }
+};
+
+// f(x) = x(0) / x(1) - 2 / x(0) + (1 - x(1)) * 3, counting the calls
+struct counting_fun {
+  int* calls_;
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    ++*calls_;
+    return x(0) / x(1) - 2.0 / x(0) + (1.0 - x(1)) * 3.0;
+  }
+};
+
+// lgamma is not recorded on the op tape
+struct lgamma_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    return stan::math::lgamma(x(0)) * x(1);
+  }
+};
+
+struct checked_log_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    stan::math::check_positive("checked_log_fun", "x(0)", x(0));
+    return -stan::math::log(x(0)) * x(1);
+  }
+};
+
+struct throwing_fun {
+  template <typename T>
+  inline T operator()(const Matrix<T, Dynamic, 1>& x) const {
+    if (x(0) < 0) {
+      throw std::domain_error("negative");
+    }
+    return x(0) * x(1);
+  }
+};
+}  // namespace
+
+TEST(RevFunctor, retaped_gradient_matches_gradient) {
+  fixed_shape_fun f;
+  stan::math::retaped_gradient<fixed_shape_fun> g(f);
+  EXPECT_FALSE(g.recorded());
+  for (int k = 0; k < 5; ++k) {
+    VectorXd x = VectorXd::LinSpaced(4, -1.0 + k, 0.5 + k);
+    double fx;
+    VectorXd grad_fx;
+    g(x, fx, grad_fx);
+    double fx_expected;
+    VectorXd grad_fx_expected;
+    stan::math::gradient(f, x, fx_expected, grad_fx_expected);
+    EXPECT_FLOAT_EQ(fx_expected, fx);
+    ASSERT_EQ(grad_fx_expected.size(), grad_fx.size());
+    for (int i = 0; i < grad_fx.size(); ++i) {
+      EXPECT_FLOAT_EQ(grad_fx_expected(i), grad_fx(i));
+    }
+  }
+  EXPECT_TRUE(g.recorded());
+  EXPECT_TRUE(g.replayable());
+  EXPECT_EQ(0, g.num_divergences());
+}
+
+TEST(RevFunctor, retaped_gradient_replays_without_calling_function) {
+  int calls = 0;
+  counting_fun f{&calls};
+  stan::math::retaped_gradient<counting_fun> g(f);
+  for (int k = 0; k < 4; ++k) {
+    VectorXd x(2);
+    x << 1.5 + k, 0.5 - k;
+    double fx;
+    VectorXd grad_fx;
+    g(x, fx, grad_fx);
+    EXPECT_DOUBLE_EQ(x(0) / x(1) - 2.0 / x(0) + (1.0 - x(1)) * 3.0, fx);
+    EXPECT_DOUBLE_EQ(1.0 / x(1) + 2.0 / (x(0) * x(0)), grad_fx(0));
+    EXPECT_DOUBLE_EQ(-x(0) / (x(1) * x(1)) - 3.0, grad_fx(1));
+  }
+  EXPECT_TRUE(g.replayable());
+  EXPECT_EQ(1, calls);
+}
+
+TEST(RevFunctor, retaped_gradient_falls_back_without_op_records) {
+  lgamma_fun f;
+  stan::math::retaped_gradient<lgamma_fun> g(f);
+  VectorXd x(2);
+  double fx;
+  VectorXd grad_fx;
+  for (double x0 : {1.5, 2.5, 3.5}) {
+    x << x0, 2.0;
+    g(x, fx, grad_fx);
+    EXPECT_FLOAT_EQ(std::lgamma(x0) * 2.0, fx);
+    EXPECT_FLOAT_EQ(stan::math::digamma(x0) * 2.0, grad_fx(0));
+    EXPECT_FLOAT_EQ(std::lgamma(x0), grad_fx(1));
+  }
+  EXPECT_TRUE(g.recorded());
+  EXPECT_FALSE(g.replayable());
+}
+
+TEST(RevFunctor, retaped_gradient_runs_checks_for_non_finite_replay) {
+  checked_log_fun f;
+  stan::math::retaped_gradient<checked_log_fun> g(f);
+  VectorXd x(2);
+  double fx;
+  VectorXd grad_fx;
+  x << 2.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_TRUE(g.replayable());
+
+  // log(-1) replays to NaN, the function then runs and its check throws
+  x << -1.0, 3.0;
+  EXPECT_THROW(g(x, fx, grad_fx), std::domain_error);
+  EXPECT_EQ(0, g.num_divergences());
+
+  x << 4.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_FLOAT_EQ(-std::log(4.0) * 3.0, fx);
+  EXPECT_FLOAT_EQ(-3.0 / 4.0, grad_fx(0));
+}
+
+TEST(RevFunctor, retaped_gradient_leaves_main_stack) {
+  using stan::math::var;
+  var a = 2.0;
+  var b = a * a;
+  const size_t var_stack_size
+      = stan::math::ChainableStack::instance_->var_stack_.size();
+  const size_t bytes_used
+      = stan::math::ChainableStack::instance_->memalloc_.bytes_used();
+
+  fixed_shape_fun f;
+  stan::math::retaped_gradient<fixed_shape_fun> g(f);
+  VectorXd x(3);
+  x << 0.1, 0.2, 0.3;
+  double fx;
+  VectorXd grad_fx;
+  g(x, fx, grad_fx);
+  g(x, fx, grad_fx);
+
+  EXPECT_EQ(var_stack_size,
+            stan::math::ChainableStack::instance_->var_stack_.size());
+  EXPECT_EQ(bytes_used,
+            stan::math::ChainableStack::instance_->memalloc_.bytes_used());
+  b.grad();
+  EXPECT_FLOAT_EQ(4.0, a.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevFunctor, retaped_gradient_divergence) {
+  branching_fun f;
+  stan::math::retaped_gradient<branching_fun> g(f);
+  VectorXd x(2);
+  double fx;
+  VectorXd grad_fx;
+
+  x << 2.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_FLOAT_EQ(std::log(2.0) * 3.0, fx);
+  EXPECT_FLOAT_EQ(3.0 / 2.0, grad_fx(0));
+  EXPECT_FLOAT_EQ(std::log(2.0), grad_fx(1));
+  x << 4.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_EQ(0, g.num_divergences());
+
+  x << -2.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_EQ(1, g.num_divergences());
+  EXPECT_FLOAT_EQ(-6.0, fx);
+  EXPECT_FLOAT_EQ(3.0, grad_fx(0));
+  EXPECT_FLOAT_EQ(-2.0, grad_fx(1));
+
+  // the new shape has been recorded
+  x << -1.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_EQ(1, g.num_divergences());
+}
+
+TEST(RevFunctor, retaped_gradient_strict) {
+  branching_fun f;
+  stan::math::retaped_gradient<branching_fun> g(f, true);
+  VectorXd x(2);
+  double fx;
+  VectorXd grad_fx;
+
+  x << 2.0, 3.0;
+  g(x, fx, grad_fx);
+  x << -2.0, 3.0;
+  EXPECT_THROW(g(x, fx, grad_fx), std::domain_error);
+  EXPECT_EQ(1, g.num_divergences());
+
+  // the recording is kept, the original shape still evaluates
+  x << 5.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_FLOAT_EQ(std::log(5.0) * 3.0, fx);
+
+  // after invalidation the other branch is recorded
+  g.invalidate();
+  EXPECT_FALSE(g.recorded());
+  x << -2.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_TRUE(g.recorded());
+  EXPECT_FLOAT_EQ(-6.0, fx);
+  EXPECT_EQ(1, g.num_divergences());
+}
+
+TEST(RevFunctor, retaped_gradient_exception) {
+  throwing_fun f;
+  stan::math::retaped_gradient<throwing_fun> g(f);
+  VectorXd x(2);
+  double fx;
+  VectorXd grad_fx;
+
+  x << -1.0, 3.0;
+  EXPECT_THROW(g(x, fx, grad_fx), std::domain_error);
+  EXPECT_FALSE(g.recorded());
+  x << 1.0, 3.0;
+  g(x, fx, grad_fx);
+  EXPECT_FLOAT_EQ(3.0, fx);
+  EXPECT_FLOAT_EQ(3.0, grad_fx(0));
+  EXPECT_FLOAT_EQ(1.0, grad_fx(1));
+}
@@ -0,0 +1,335 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// method of lines discretization of an advection-diffusion-reaction
+// equation with diffusion theta[0], upwind advection 0.5 * theta[0] and
+// quadratic decay theta[1], whose Jacobian is tridiagonal and not
+// symmetric
+struct advection_diffusion_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int n = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(n);
+    for (int i = 0; i < n; ++i) {
+      const auto left = i > 0 ? y(i - 1) : y(i);
+      const auto right = i + 1 < n ? y(i + 1) : y(i);
+      dy(i) = theta[0] * (left - 2.0 * y(i) + right)
+              + 0.5 * theta[0] * (left - y(i)) - theta[1] * y(i) * y(i);
+    }
+    return dy;
+  }
+};
+
+// Jacobian of advection_diffusion_rhs, counting its calls
+template <bool Sparse>
+struct advection_diffusion_jacobian {
+  int* num_calls_;
+
+  auto operator()(double t, const Eigen::VectorXd& y, std::ostream* msgs,
+                  const std::vector<double>& theta) const {
+    ++*num_calls_;
+    const int n = y.size();
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < n; ++i) {
+      double diagonal = -2.5 * theta[0] - 2.0 * theta[1] * y(i);
+      if (i > 0) {
+        triplets.emplace_back(i, i - 1, 1.5 * theta[0]);
+      } else {
+        diagonal += 1.5 * theta[0];
+      }
+      if (i + 1 < n) {
+        triplets.emplace_back(i, i + 1, theta[0]);
+      } else {
+        diagonal += theta[0];
+      }
+      triplets.emplace_back(i, i, diagonal);
+    }
+    Eigen::SparseMatrix<double> jacobian(n, n);
+    jacobian.setFromTriplets(triplets.begin(), triplets.end());
+    return std::conditional_t<Sparse, Eigen::SparseMatrix<double>,
+                              Eigen::MatrixXd>(jacobian);
+  }
+};
+
+// chemical kinetics DAE of the IDAS examples
+struct chemical_kinetics_dae {
+  template <typename T0, typename TYY, typename TYP, typename TPAR>
+  std::vector<stan::return_type_t<TYY, TYP, TPAR>> operator()(
+      const T0& t, const std::vector<TYY>& yy, const std::vector<TYP>& yp,
+      const std::vector<TPAR>& theta, const std::vector<double>& x_r,
+      const std::vector<int>& x_i, std::ostream* msgs) const {
+    std::vector<stan::return_type_t<TYY, TYP, TPAR>> res(3);
+    res[0] = yp[0] + theta[0] * yy[0] - theta[1] * yy[1] * yy[2];
+    res[1] = yp[1] - theta[0] * yy[0] + theta[1] * yy[1] * yy[2]
+             + theta[2] * yy[1] * yy[1];
+    res[2] = yy[0] + yy[1] + yy[2] - 1.0;
+    return res;
+  }
+};
+
+// dF/dy + cj dF/dy' of chemical_kinetics_dae, counting its calls
+struct chemical_kinetics_jacobian {
+  int* num_calls_;
+
+  Eigen::MatrixXd operator()(double t, const std::vector<double>& yy,
+                             const std::vector<double>& yp, double cj,
+                             const std::vector<double>& theta,
+                             const std::vector<double>& x_r,
+                             const std::vector<int>& x_i,
+                             std::ostream* msgs) const {
+    ++*num_calls_;
+    Eigen::MatrixXd jacobian(3, 3);
+    jacobian << theta[0] + cj, -theta[1] * yy[2], -theta[1] * yy[1],
+        -theta[0], cj + theta[1] * yy[2] + 2.0 * theta[2] * yy[1],
+        theta[1] * yy[1], 1.0, 1.0, 1.0;
+    return jacobian;
+  }
+};
+
+Eigen::SparseMatrix<double> tridiagonal_pattern(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 1); j < std::min(n, i + 2); ++j) {
+      triplets.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(n, n);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  return pattern;
+}
+
+// solve with the given functor and return the values of the states at the
+// last time followed by the gradient of their sum
+template <typename Solve>
+std::vector<double> solve_grad(const Solve& solve) {
+  using stan::math::var;
+  const int n = 20;
+  Eigen::Matrix<var, -1, 1> y0
+      = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5).cast<var>();
+  std::vector<var> theta{50.0, 2.0};
+  std::vector<Eigen::Matrix<var, -1, 1>> ys = solve(y0, theta);
+  const Eigen::VectorXd y_last = stan::math::value_of(ys.back());
+  std::vector<double> result(y_last.data(), y_last.data() + n);
+  stan::math::sum(ys.back()).grad();
+  for (int i = 0; i < n; ++i) {
+    result.push_back(y0(i).adj());
+  }
+  result.push_back(theta[0].adj());
+  result.push_back(theta[1].adj());
+  stan::math::recover_memory();
+  return result;
+}
+
+void expect_near_rel(const std::vector<double>& expected,
+                     const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i],
+                1e-5 * std::max(1.0, std::abs(expected[i])))
+        << "index " << i;
+  }
+}
+
+std::vector<stan::math::sundials_linear_solver> linear_solvers(int n) {
+  using stan::math::sundials_linear_solver;
+  return {sundials_linear_solver(), sundials_linear_solver::band(1, 1),
+          sundials_linear_solver::sparse(tridiagonal_pattern(n))};
+}
+
+// product of a vector with the Jacobian of f stored in the matrix of a
+// linear solver, possibly transposed and scaled
+template <typename F>
+Eigen::VectorXd stored_jacobian_times(
+    const F& f, const stan::math::sundials_linear_solver& linear_solver,
+    bool transpose, double scale, const Eigen::VectorXd& x) {
+  const int n = x.size();
+  const Eigen::VectorXd y = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5);
+  SUNMatrix J = linear_solver.make_matrix(n);
+  SUNMatZero(J);
+  stan::math::internal::sundials_ode_jacobian<F>::store(
+      "test", f, 0.0, y, nullptr, std::make_tuple(std::vector<double>{50, 2}),
+      linear_solver, J, transpose, scale);
+  Eigen::VectorXd x_copy = x;
+  Eigen::VectorXd b(n);
+  N_Vector nv_x = N_VMake_Serial(n, x_copy.data());
+  N_Vector nv_b = N_VMake_Serial(n, b.data());
+  SUNMatMatvec(J, nv_x, nv_b);
+  N_VDestroy_Serial(nv_x);
+  N_VDestroy_Serial(nv_b);
+  SUNMatDestroy(J);
+  return b;
+}
+
+}  // namespace
+
+TEST(analytic_jacobian, stored_jacobian) {
+  const int n = 20;
+  int num_calls = 0;
+  const advection_diffusion_rhs f;
+  const auto f_dense = stan::math::analytic_jacobian(
+      f, advection_diffusion_jacobian<false>{&num_calls});
+  const auto f_sparse = stan::math::analytic_jacobian(
+      f, advection_diffusion_jacobian<true>{&num_calls});
+  const Eigen::MatrixXd jacobian = advection_diffusion_jacobian<false>{
+      &num_calls}(0.0, Eigen::VectorXd::LinSpaced(n, 0.5, 1.5), nullptr,
+                  {50, 2});
+  const Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(n, -1.0, 2.0);
+
+  for (const auto& linear_solver : linear_solvers(n)) {
+    for (bool transpose : {false, true}) {
+      // the backward problem of the adjoint solver stores -J^T with the
+      // transposed solver
+      const auto solver
+          = transpose ? linear_solver.transpose() : linear_solver;
+      const double scale = transpose ? -1.0 : 1.0;
+      const Eigen::VectorXd expected
+          = transpose ? Eigen::VectorXd(-jacobian.transpose() * x)
+                      : Eigen::VectorXd(jacobian * x);
+      for (const Eigen::VectorXd& b :
+           {stored_jacobian_times(f, solver, transpose, scale, x),
+            stored_jacobian_times(f_dense, solver, transpose, scale, x),
+            stored_jacobian_times(f_sparse, solver, transpose, scale, x)}) {
+        for (int i = 0; i < n; ++i) {
+          EXPECT_NEAR(expected(i), b(i), 1e-10) << "row " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(analytic_jacobian, ode_bdf_and_ode_adams) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  int num_calls = 0;
+  auto bdf = [&](const auto& f, const sundials_linear_solver& linear_solver) {
+    return [&, linear_solver](const auto& y0, const auto& theta) {
+      return stan::math::ode_bdf_tol(f, y0, 0.0, ts, 1e-10, 1e-10, 100000,
+                                     linear_solver, nullptr, theta);
+    };
+  };
+  auto adams
+      = [&](const auto& f, const sundials_linear_solver& linear_solver) {
+          return [&, linear_solver](const auto& y0, const auto& theta) {
+            return stan::math::ode_adams_tol(f, y0, 0.0, ts, 1e-10, 1e-10,
+                                             100000, linear_solver, nullptr,
+                                             theta);
+          };
+        };
+  const advection_diffusion_rhs f;
+  const auto f_dense = stan::math::analytic_jacobian(
+      f, advection_diffusion_jacobian<false>{&num_calls});
+  const auto f_sparse = stan::math::analytic_jacobian(
+      f, advection_diffusion_jacobian<true>{&num_calls});
+
+  const std::vector<double> expected_bdf
+      = solve_grad(bdf(f, sundials_linear_solver()));
+  const std::vector<double> expected_adams
+      = solve_grad(adams(f, sundials_linear_solver()));
+  for (const auto& linear_solver : linear_solvers(20)) {
+    num_calls = 0;
+    expect_near_rel(expected_bdf, solve_grad(bdf(f_dense, linear_solver)));
+    expect_near_rel(expected_bdf, solve_grad(bdf(f_sparse, linear_solver)));
+    expect_near_rel(expected_adams,
+                    solve_grad(adams(f_sparse, linear_solver)));
+    EXPECT_GT(num_calls, 0);
+  }
+}
+
+TEST(analytic_jacobian, ode_adjoint) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(20, 1e-10);
+  int num_calls = 0;
+  auto adjoint
+      = [&](const auto& f, const sundials_linear_solver& linear_solver) {
+          return [&, linear_solver](const auto& y0, const auto& theta) {
+            return stan::math::ode_adjoint_tol_ctl(
+                f, y0, 0.0, ts, 1e-10, atol, 1e-10, atol, 1e-10, 1e-10,
+                100000, 150, CV_HERMITE, CV_BDF, CV_BDF, linear_solver,
+                nullptr, theta);
+          };
+        };
+  const advection_diffusion_rhs f;
+  const auto f_sparse = stan::math::analytic_jacobian(
+      f, advection_diffusion_jacobian<true>{&num_calls});
+
+  // the Jacobian is not symmetric, so the backward problem must use its
+  // transpose
+  const std::vector<double> expected
+      = solve_grad(adjoint(f, sundials_linear_solver()));
+  for (const auto& linear_solver : linear_solvers(20)) {
+    num_calls = 0;
+    expect_near_rel(expected, solve_grad(adjoint(f_sparse, linear_solver)));
+    EXPECT_GT(num_calls, 0);
+  }
+}
+
+TEST(analytic_jacobian, integrate_dae) {
+  using stan::math::sundials_linear_solver;
+  using stan::math::var;
+  const std::vector<double> yy0{1.0, 0.0, 0.0};
+  const std::vector<double> yp0{-0.04, 0.04, 0.0};
+  const std::vector<double> ts{0.4, 4.0, 40.0};
+  const std::vector<double> x_r;
+  const std::vector<int> x_i;
+  int num_calls = 0;
+
+  auto solve_dae = [&](const auto& f,
+                       const sundials_linear_solver& linear_solver) {
+    std::vector<var> theta{0.040, 1.0e4, 3.0e7};
+    auto yy = stan::math::integrate_dae(f, yy0, yp0, 0.0, ts, theta, x_r, x_i,
+                                        1e-8, 1e-10, 10000, linear_solver);
+    std::vector<double> result;
+    for (size_t i = 0; i < 3; ++i) {
+      result.push_back(yy.back()[i].val());
+      stan::math::set_zero_all_adjoints();
+      yy.back()[i].grad();
+      for (const auto& p : theta) {
+        result.push_back(p.adj());
+      }
+    }
+    stan::math::recover_memory();
+    return result;
+  };
+
+  const chemical_kinetics_dae f;
+  const auto f_jacobian = stan::math::analytic_jacobian(
+      f, chemical_kinetics_jacobian{&num_calls});
+  const std::vector<double> expected = solve_dae(f, sundials_linear_solver());
+  for (const auto& linear_solver :
+       {sundials_linear_solver(), sundials_linear_solver::band(2, 2)}) {
+    num_calls = 0;
+    const std::vector<double> result = solve_dae(f_jacobian, linear_solver);
+    EXPECT_GT(num_calls, 0);
+    ASSERT_EQ(expected.size(), result.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(expected[i], result[i],
+                  1e-4 * std::max(1e-6, std::abs(expected[i])))
+          << "index " << i;
+    }
+  }
+}
+
+TEST(analytic_jacobian, errors) {
+  struct wrong_size_jacobian {
+    Eigen::MatrixXd operator()(double t, const Eigen::VectorXd& y,
+                               std::ostream* msgs,
+                               const std::vector<double>& theta) const {
+      return Eigen::MatrixXd::Identity(y.size() - 1, y.size());
+    }
+  };
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  Eigen::VectorXd y0 = Eigen::VectorXd::Ones(20);
+  const std::vector<double> theta{50.0, 2.0};
+  EXPECT_THROW(stan::math::ode_bdf(stan::math::analytic_jacobian(
+                                       advection_diffusion_rhs(),
+                                       wrong_size_jacobian()),
+                                   y0, 0.0, ts, nullptr, theta),
+               std::invalid_argument);
+}
@@ -0,0 +1,225 @@
+#include <stan/math/rev.hpp>
+#include <test/unit/math/rev/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// method of lines discretization of a diffusion-reaction equation with
+// diffusion theta[0] and quadratic decay theta[1], whose Jacobian is
+// tridiagonal
+struct diffusion_reaction_rhs {
+  template <typename T0, typename T1, typename T2>
+  Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> operator()(
+      const T0& t, const T1& y, std::ostream* msgs,
+      const std::vector<T2>& theta) const {
+    const int n = y.size();
+    Eigen::Matrix<stan::return_type_t<T1, T2>, -1, 1> dy(n);
+    for (int i = 0; i < n; ++i) {
+      const auto left = i > 0 ? y(i - 1) : y(i);
+      const auto right = i + 1 < n ? y(i + 1) : y(i);
+      dy(i) = theta[0] * (left - 2.0 * y(i) + right) - theta[1] * y(i) * y(i);
+    }
+    return dy;
+  }
+};
+
+// chemical kinetics DAE of the IDAS examples
+struct chemical_kinetics_dae {
+  template <typename T0, typename TYY, typename TYP, typename TPAR>
+  std::vector<stan::return_type_t<TYY, TYP, TPAR>> operator()(
+      const T0& t, const std::vector<TYY>& yy, const std::vector<TYP>& yp,
+      const std::vector<TPAR>& theta, const std::vector<double>& x_r,
+      const std::vector<int>& x_i, std::ostream* msgs) const {
+    std::vector<stan::return_type_t<TYY, TYP, TPAR>> res(3);
+    res[0] = yp[0] + theta[0] * yy[0] - theta[1] * yy[1] * yy[2];
+    res[1] = yp[1] - theta[0] * yy[0] + theta[1] * yy[1] * yy[2]
+             + theta[2] * yy[1] * yy[1];
+    res[2] = yy[0] + yy[1] + yy[2] - 1.0;
+    return res;
+  }
+};
+
+Eigen::SparseMatrix<double> tridiagonal_pattern(int n) {
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 1); j < std::min(n, i + 2); ++j) {
+      triplets.emplace_back(i, j, 1.0);
+    }
+  }
+  Eigen::SparseMatrix<double> pattern(n, n);
+  pattern.setFromTriplets(triplets.begin(), triplets.end());
+  return pattern;
+}
+
+std::vector<stan::math::sundials_linear_solver> tridiagonal_solvers(int n) {
+  using stan::math::sundials_linear_solver;
+  return {sundials_linear_solver::band(1, 1),
+          sundials_linear_solver::sparse(tridiagonal_pattern(n)),
+          sundials_linear_solver::spgmr(),
+          sundials_linear_solver::spgmr(10, 1, 1)};
+}
+
+// solve with the given functor and return the values of the states at the
+// last time followed by the gradient of their sum
+template <typename Solve>
+std::vector<double> solve_grad(const Solve& solve) {
+  using stan::math::var;
+  const int n = 20;
+  Eigen::Matrix<var, -1, 1> y0
+      = Eigen::VectorXd::LinSpaced(n, 0.5, 1.5).cast<var>();
+  std::vector<var> theta{50.0, 2.0};
+  std::vector<Eigen::Matrix<var, -1, 1>> ys = solve(y0, theta);
+  const Eigen::VectorXd y_last = stan::math::value_of(ys.back());
+  std::vector<double> result(y_last.data(), y_last.data() + n);
+  stan::math::sum(ys.back()).grad();
+  for (int i = 0; i < n; ++i) {
+    result.push_back(y0(i).adj());
+  }
+  result.push_back(theta[0].adj());
+  result.push_back(theta[1].adj());
+  stan::math::recover_memory();
+  return result;
+}
+
+void expect_near_rel(const std::vector<double>& expected,
+                     const std::vector<double>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i],
+                1e-5 * std::max(1.0, std::abs(expected[i])))
+        << "index " << i;
+  }
+}
+
+}  // namespace
+
+TEST(sundials_linear_solver, ode_bdf_matches_dense) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  auto bdf = [&](const sundials_linear_solver& linear_solver) {
+    return [&, linear_solver](const auto& y0, const auto& theta) {
+      return stan::math::ode_bdf_tol(diffusion_reaction_rhs(), y0, 0.0, ts,
+                                     1e-10, 1e-10, 100000, linear_solver,
+                                     nullptr, theta);
+    };
+  };
+  const std::vector<double> dense = solve_grad(bdf(sundials_linear_solver()));
+  for (const auto& linear_solver : tridiagonal_solvers(20)) {
+    expect_near_rel(dense, solve_grad(bdf(linear_solver)));
+  }
+}
+
+TEST(sundials_linear_solver, ode_adams_matches_dense) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  auto adams = [&](const sundials_linear_solver& linear_solver) {
+    return [&, linear_solver](const auto& y0, const auto& theta) {
+      return stan::math::ode_adams_tol(diffusion_reaction_rhs(), y0, 0.0, ts,
+                                       1e-10, 1e-10, 100000, linear_solver,
+                                       nullptr, theta);
+    };
+  };
+  const std::vector<double> dense
+      = solve_grad(adams(sundials_linear_solver()));
+  for (const auto& linear_solver : tridiagonal_solvers(20)) {
+    expect_near_rel(dense, solve_grad(adams(linear_solver)));
+  }
+}
+
+TEST(sundials_linear_solver, ode_adjoint_matches_dense) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  const Eigen::VectorXd atol = Eigen::VectorXd::Constant(20, 1e-10);
+  auto adjoint = [&](const sundials_linear_solver& linear_solver) {
+    return [&, linear_solver](const auto& y0, const auto& theta) {
+      return stan::math::ode_adjoint_tol_ctl(
+          diffusion_reaction_rhs(), y0, 0.0, ts, 1e-10, atol, 1e-10, atol,
+          1e-10, 1e-10, 100000, 150, CV_HERMITE, CV_BDF, CV_BDF, linear_solver,
+          nullptr, theta);
+    };
+  };
+  const std::vector<double> dense
+      = solve_grad(adjoint(sundials_linear_solver()));
+  for (const auto& linear_solver : tridiagonal_solvers(20)) {
+    expect_near_rel(dense, solve_grad(adjoint(linear_solver)));
+  }
+
+  // structural zeros above the band make the pattern nonsymmetric, so the
+  // backward problem must use its transpose
+  Eigen::SparseMatrix<double> pattern = tridiagonal_pattern(20);
+  for (int i = 0; i + 2 < 20; ++i) {
+    pattern.coeffRef(i, i + 2) = 1.0;
+  }
+  expect_near_rel(dense, solve_grad(adjoint(
+                             sundials_linear_solver::sparse(pattern))));
+}
+
+TEST(sundials_linear_solver, integrate_dae_matches_dense) {
+  using stan::math::sundials_linear_solver;
+  using stan::math::var;
+  const std::vector<double> yy0{1.0, 0.0, 0.0};
+  const std::vector<double> yp0{-0.04, 0.04, 0.0};
+  const std::vector<double> ts{0.4, 4.0, 40.0};
+  const std::vector<double> x_r;
+  const std::vector<int> x_i;
+
+  auto solve_dae = [&](const sundials_linear_solver& linear_solver) {
+    std::vector<var> theta{0.040, 1.0e4, 3.0e7};
+    auto yy = stan::math::integrate_dae(chemical_kinetics_dae(), yy0, yp0,
+                                        0.0, ts, theta, x_r, x_i, 1e-8, 1e-10,
+                                        10000, linear_solver);
+    std::vector<double> result;
+    for (size_t i = 0; i < 3; ++i) {
+      result.push_back(yy.back()[i].val());
+      stan::math::set_zero_all_adjoints();
+      yy.back()[i].grad();
+      for (const auto& p : theta) {
+        result.push_back(p.adj());
+      }
+    }
+    stan::math::recover_memory();
+    return result;
+  };
+
+  Eigen::SparseMatrix<double> pattern(3, 3);
+  pattern.insert(0, 1) = 1.0;
+  pattern.insert(0, 2) = 1.0;
+  pattern.insert(1, 0) = 1.0;
+  pattern.insert(1, 2) = 1.0;
+  pattern.insert(2, 0) = 1.0;
+  pattern.insert(2, 1) = 1.0;
+
+  const std::vector<double> dense = solve_dae(sundials_linear_solver());
+  for (const auto& linear_solver :
+       {sundials_linear_solver::band(2, 2),
+        sundials_linear_solver::sparse(pattern),
+        sundials_linear_solver::spgmr(0, 2, 2)}) {
+    const std::vector<double> result = solve_dae(linear_solver);
+    ASSERT_EQ(dense.size(), result.size());
+    for (size_t i = 0; i < dense.size(); ++i) {
+      EXPECT_NEAR(dense[i], result[i],
+                  1e-4 * std::max(1e-6, std::abs(dense[i])))
+          << "index " << i;
+    }
+  }
+}
+
+TEST(sundials_linear_solver, errors) {
+  using stan::math::sundials_linear_solver;
+  const std::vector<double> ts{0.1, 0.5, 1.0};
+  Eigen::VectorXd y0 = Eigen::VectorXd::Ones(20);
+  const std::vector<double> theta{50.0, 2.0};
+
+  EXPECT_THROW(sundials_linear_solver::band(-1, 1), std::domain_error);
+  EXPECT_THROW(sundials_linear_solver::spgmr(-1), std::domain_error);
+  EXPECT_THROW(
+      sundials_linear_solver::sparse(Eigen::SparseMatrix<double>(3, 4)),
+      std::invalid_argument);
+  EXPECT_THROW(stan::math::ode_bdf_tol(diffusion_reaction_rhs(), y0, 0.0, ts,
+                                       1e-8, 1e-8, 1000,
+                                       sundials_linear_solver::sparse(
+                                           tridiagonal_pattern(19)),
+                                       nullptr, theta),
+               std::invalid_argument);
+}
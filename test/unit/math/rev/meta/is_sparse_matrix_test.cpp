@@ -0,0 +1,22 @@
+#include <stan/math/rev/meta.hpp>
+#include <stan/math/rev/core.hpp>
+#include <gtest/gtest.h>
+
+TEST(MetaTraitsRevScal, is_sparse_matrix_test) {
+  using stan::is_sparse_matrix;
+  using stan::is_var_sparse_matrix;
+  using stan::math::var;
+  using stan::math::var_value;
+  using sparse_t = Eigen::SparseMatrix<double>;
+  EXPECT_TRUE((is_var_sparse_matrix<var_value<sparse_t>>::value));
+  EXPECT_FALSE((is_var_sparse_matrix<sparse_t>::value));
+  EXPECT_FALSE((is_var_sparse_matrix<var_value<Eigen::MatrixXd>>::value));
+  EXPECT_FALSE((is_var_sparse_matrix<Eigen::Matrix<var, -1, -1>>::value));
+  EXPECT_FALSE((is_var_sparse_matrix<var>::value));
+
+  EXPECT_TRUE((is_sparse_matrix<var_value<sparse_t>>::value));
+  EXPECT_TRUE((is_sparse_matrix<sparse_t>::value));
+  EXPECT_FALSE((is_sparse_matrix<var_value<Eigen::MatrixXd>>::value));
+  EXPECT_FALSE((is_sparse_matrix<Eigen::MatrixXd>::value));
+  EXPECT_FALSE((is_sparse_matrix<double>::value));
+}